@@ -489,6 +489,18 @@ public:
   //------------------------------------------------------------------
   const char *GetConditionText() const;
 
+  //------------------------------------------------------------------
+  /// Make the breakpoint a tracepoint that records \a collect at every hit
+  /// instead of stopping, see BreakpointOptions::SetTracepointCollect.
+  //------------------------------------------------------------------
+  void SetTracepointCollect(const std::vector<std::string> &collect);
+
+  //------------------------------------------------------------------
+  /// Let the process re-send the conditions and tracepoints its stub
+  /// handles for our sites, e.g. after options were copied over wholesale.
+  //------------------------------------------------------------------
+  void UpdateSiteConditions();
+
   //------------------------------------------------------------------
   // The next section are various utility functions.
   //------------------------------------------------------------------
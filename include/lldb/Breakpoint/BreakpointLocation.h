@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <map>
 #include <memory>
 #include <mutex>
 
@@ -20,6 +21,8 @@
 #include "lldb/Breakpoint/BreakpointOptions.h"
 #include "lldb/Breakpoint/StoppointLocation.h"
 #include "lldb/Core/Address.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/Tracepoint.h"
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-private.h"
 
@@ -170,6 +173,76 @@ public:
 
   bool ConditionSaysStop(ExecutionContext &exe_ctx, Status &error);
 
+  //------------------------------------------------------------------
+  /// Compile the condition into bytecode that a remote stub can evaluate
+  /// when this location is hit, so hits where it is false never have to
+  /// be reported.  The result is cached until the condition changes.
+  ///
+  /// @param[in] thread
+  ///     A thread of the process the location is in.
+  ///
+  /// @param[in] reg_kind
+  ///     The register numbering the stub uses.
+  ///
+  /// @return
+  ///     \b false if there is no condition, if an ignore count is set
+  ///     (hits the stub skips would not be counted against it), or if the
+  ///     condition is beyond what ConditionCompiler handles.
+  //------------------------------------------------------------------
+  bool GetCompiledCondition(Thread &thread, lldb::RegisterKind reg_kind,
+                            AgentExpression &expr);
+
+  //------------------------------------------------------------------
+  /// Make this location a tracepoint that records \a collect at every hit
+  /// instead of stopping, see BreakpointOptions::SetTracepointCollect.
+  //------------------------------------------------------------------
+  void SetTracepointCollect(const std::vector<std::string> &collect);
+
+  const std::vector<std::string> &
+  GetTracepointCollect(size_t *hash = nullptr) const;
+
+  bool IsTracepoint() const;
+
+  //------------------------------------------------------------------
+  /// The ID the records of this location carry, and the location an ID
+  /// belongs to.
+  //------------------------------------------------------------------
+  uint64_t GetTracepointID() const;
+
+  static lldb::BreakpointLocationSP
+  FindTracepointLocation(Target &target, uint64_t tracepoint_id);
+
+  //------------------------------------------------------------------
+  /// Compile the collect list and the condition of this tracepoint for a
+  /// remote stub, which then records hits without reporting them.  The
+  /// result is cached until either changes.
+  ///
+  /// @param[in] thread
+  ///     A thread of the process the location is in.
+  ///
+  /// @param[in] reg_kind
+  ///     The register numbering the stub uses.
+  ///
+  /// @return
+  ///     \b false if this isn't a tracepoint, if it has an ignore count or
+  ///     a thread specification (the stub can't check either), or if any
+  ///     item or the condition is beyond what ConditionCompiler handles.
+  //------------------------------------------------------------------
+  bool GetCompiledTracepoint(Thread &thread, lldb::RegisterKind reg_kind,
+                             TracepointSpec &spec);
+
+  //------------------------------------------------------------------
+  /// Record a hit of this tracepoint in the process's tracepoint buffer,
+  /// unless the stub already did.  Called once the condition has passed.
+  //------------------------------------------------------------------
+  void CollectTracepoint(ExecutionContext &exe_ctx);
+
+  //------------------------------------------------------------------
+  /// Let the process re-send the conditions and tracepoints its stub
+  /// handles for our site.
+  //------------------------------------------------------------------
+  void UpdateSiteConditions();
+
   //------------------------------------------------------------------
   /// Set the valid thread to be checked when the breakpoint is hit.
   ///
@@ -416,6 +489,17 @@ private:
                                 /// multiple processes.
   size_t m_condition_hash; ///< For testing whether the condition source code
                            ///changed.
+  std::mutex m_compiled_condition_mutex; ///< Guards the members below.
+  std::map<lldb::RegisterKind, AgentExpression>
+      m_compiled_conditions; ///< The condition as agent bytecode for each
+                             ///register numbering it was requested for,
+                             ///empty if it couldn't be compiled.
+  size_t m_compiled_condition_hash = 0; ///< The condition that was compiled.
+  std::map<lldb::RegisterKind, TracepointSpec>
+      m_compiled_tracepoints; ///< The collect list as agent bytecode for
+                              ///each register numbering, with no actions if
+                              ///it couldn't be compiled.
+  size_t m_compiled_tracepoint_hash = 0; ///< The list that was compiled.
 
   void SetShouldResolveIndirectFunctions(bool do_resolve) {
     m_should_resolve_indirect_functions = do_resolve;
@@ -423,6 +507,13 @@ private:
 
   void SendBreakpointLocationChangedEvent(lldb::BreakpointEventType eventKind);
 
+  bool CompileCondition(Thread &thread, lldb::RegisterKind reg_kind,
+                        const char *condition_text, size_t condition_hash,
+                        AgentExpression &expr);
+
+  bool CompileTracepoint(Thread &thread, lldb::RegisterKind reg_kind,
+                         TracepointSpec &spec);
+
   DISALLOW_COPY_AND_ASSIGN(BreakpointLocation);
 };
 
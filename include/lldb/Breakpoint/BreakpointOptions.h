@@ -14,6 +14,7 @@
 // C++ Includes
 #include <memory>
 #include <string>
+#include <vector>
 
 // Other libraries and framework includes
 // Project includes
@@ -46,8 +47,9 @@ public:
     eThreadSpec   = 1 << 4,
     eCondition    = 1 << 5,
     eAutoContinue = 1 << 6,
+    eTracepoint   = 1 << 7,
     eAllOptions   = (eCallback | eEnabled | eOneShot | eIgnoreCount | eThreadSpec
-                     | eCondition | eAutoContinue)
+                     | eCondition | eAutoContinue | eTracepoint)
   };
   struct CommandData {
     CommandData()
@@ -292,6 +294,27 @@ public:
   //------------------------------------------------------------------
   const char *GetConditionText(size_t *hash = nullptr) const;
 
+  //------------------------------------------------------------------
+  // Tracepoints
+  //------------------------------------------------------------------
+
+  //------------------------------------------------------------------
+  /// Turn the breakpoint into a tracepoint, which records the items in
+  /// \a collect each time it is hit (and its condition is true) instead of
+  /// stopping.  See ConditionCompiler::CompileTracepointAction for the
+  /// syntax of an item.  An empty list makes it a breakpoint again.
+  //------------------------------------------------------------------
+  void SetTracepointCollect(const std::vector<std::string> &collect);
+
+  //------------------------------------------------------------------
+  /// Return the items a tracepoint collects, empty if this isn't a
+  /// tracepoint.  \a hash, if given, changes whenever the list does.
+  //------------------------------------------------------------------
+  const std::vector<std::string> &
+  GetTracepointCollect(size_t *hash = nullptr) const;
+
+  bool IsTracepoint() const { return !m_tracepoint_collect.empty(); }
+
   //------------------------------------------------------------------
   // Enabled/Ignore Count
   //------------------------------------------------------------------
@@ -421,6 +444,7 @@ protected:
     EnabledState,
     OneShotState,
     AutoContinue,
+    TracepointCollect,
     LastOptionName
   };
   static const char *g_option_names[(size_t)OptionNames::LastOptionName];
@@ -452,6 +476,9 @@ private:
   size_t m_condition_text_hash; // Its hash, so that locations know when the
                                 // condition is updated.
   bool m_auto_continue;         // If set, auto-continue from breakpoint.
+  std::vector<std::string>
+      m_tracepoint_collect;         // What a tracepoint records at a hit.
+  size_t m_tracepoint_collect_hash; // Its hash, for the same reason.
   Flags m_set_flags;            // Which options are set at this level.  Drawn
                                 // from BreakpointOptions::SetOptionsFlags.
 };
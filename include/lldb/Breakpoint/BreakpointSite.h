@@ -15,12 +15,15 @@
 // C++ Includes
 #include <list>
 #include <mutex>
+#include <vector>
 
 // Other libraries and framework includes
 
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocationCollection.h"
 #include "lldb/Breakpoint/StoppointLocation.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/Tracepoint.h"
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-forward.h"
 
@@ -193,6 +196,63 @@ public:
   //------------------------------------------------------------------
   bool ValidForThisThread(Thread *thread);
 
+  //------------------------------------------------------------------
+  /// Compile the conditions of all the owners of this site so a remote
+  /// stub can evaluate them, see BreakpointLocation::GetCompiledCondition.
+  ///
+  /// @param[in] thread
+  ///     A thread of the process the site is in.
+  ///
+  /// @param[in] reg_kind
+  ///     The register numbering the stub uses.
+  ///
+  /// @param[out] conditions
+  ///     One expression per owner.  The stub may skip a hit only if all
+  ///     of them are false.  Tracepoints the stub collects never stop.
+  ///
+  /// @return
+  ///     \b true if every owner has a condition, or is a tracepoint the
+  ///     stub collects, and all of them could be compiled, \b false
+  ///     otherwise.
+  //------------------------------------------------------------------
+  bool GetAgentConditions(Thread &thread, lldb::RegisterKind reg_kind,
+                          std::vector<AgentExpression> &conditions);
+
+  //------------------------------------------------------------------
+  /// Compile the tracepoints among the owners of this site so a remote
+  /// stub can collect them, see BreakpointLocation::GetCompiledTracepoint.
+  ///
+  /// @return
+  ///     \b false, with no specs, if any tracepoint owner can't be handed
+  ///     to the stub.
+  //------------------------------------------------------------------
+  bool GetTracepoints(Thread &thread, lldb::RegisterKind reg_kind,
+                      std::vector<TracepointSpec> &specs);
+
+  //------------------------------------------------------------------
+  /// Whether the stub records the hits of the tracepoint owners of this
+  /// site.  If not, the debugger has to stop at each hit and collect them.
+  //------------------------------------------------------------------
+  void SetStubCollectsTracepoints(bool stub_collects) {
+    m_stub_collects_tracepoints = stub_collects;
+  }
+
+  bool GetStubCollectsTracepoints() const {
+    return m_stub_collects_tracepoints;
+  }
+
+  //------------------------------------------------------------------
+  /// The conditions the stub was last given with this site, so that the
+  /// breakpoint is only re-inserted when they change.
+  //------------------------------------------------------------------
+  void SetStubConditions(std::vector<AgentExpression> conditions) {
+    m_stub_conditions = std::move(conditions);
+  }
+
+  const std::vector<AgentExpression> &GetStubConditions() const {
+    return m_stub_conditions;
+  }
+
   //------------------------------------------------------------------
   /// Print a description of this breakpoint site to the stream \a s.
   /// GetDescription tells you about the breakpoint site's owners. Use
@@ -262,6 +322,9 @@ private:
                              ///breakpoint if it is a software breakpoint site.
   bool
       m_enabled; ///< Boolean indicating if this breakpoint site enabled or not.
+  bool m_stub_collects_tracepoints; ///< The stub records our tracepoints.
+  std::vector<AgentExpression>
+      m_stub_conditions; ///< The conditions the stub evaluates.
 
   // Consider adding an optimization where if there is only one owner, we don't
   // store a list.  The usual case will be only one owner...
@@ -0,0 +1,166 @@
+//===-- ConditionCompiler.h -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ConditionCompiler_h_
+#define liblldb_ConditionCompiler_h_
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+#include "llvm/ADT/StringRef.h"
+
+// Project includes
+#include "lldb/Core/Address.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/Status.h"
+#include "lldb/Utility/Tracepoint.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class ConditionCompiler ConditionCompiler.h
+/// "lldb/Breakpoint/ConditionCompiler.h"
+/// Compiles simple breakpoint conditions into agent expressions.
+///
+/// Only a small C-like grammar is understood: integer literals, integer,
+/// enumeration and pointer variables visible at the breakpoint address and
+/// their data members ("a.b", "p->b"), registers ("$rsp"), arithmetic,
+/// comparisons and the logical operators.  Variable locations come from the
+/// debug info and are resolved for the breakpoint address, so evaluating the
+/// result only takes register and memory reads.  Inside methods, names that
+/// aren't locals are rejected rather than looked up as globals, since they
+/// may name class members.  Anything else is rejected, and the condition has
+/// to go through the expression parser as usual.
+//----------------------------------------------------------------------
+class ConditionCompiler {
+public:
+  //------------------------------------------------------------------
+  /// @param[in] thread
+  ///     Any thread of the process; it supplies the register layout and
+  ///     the unwind information used to find the frame's CFA.
+  ///
+  /// @param[in] address
+  ///     The address the breakpoint is set at.
+  ///
+  /// @param[in] reg_kind
+  ///     The register numbering the consumer of the bytecode uses,
+  ///     e.g. eRegisterKindProcessPlugin for a remote stub.
+  //------------------------------------------------------------------
+  ConditionCompiler(Thread &thread, const Address &address,
+                    lldb::RegisterKind reg_kind);
+
+  //------------------------------------------------------------------
+  /// Compile \a condition.
+  ///
+  /// @return
+  ///     True if the whole condition was compiled into \a expr.
+  ///     Otherwise \a error says what couldn't be handled.
+  //------------------------------------------------------------------
+  bool Compile(llvm::StringRef condition, AgentExpression &expr,
+               Status &error);
+
+  //------------------------------------------------------------------
+  /// Compile one item of a tracepoint's collect list.  "$reg" collects
+  /// the raw bytes of a register, "<expr>@<size>" collects \a size bytes
+  /// of memory at the address \a expr computes, and any other expression
+  /// collects its value.
+  ///
+  /// @return
+  ///     True if \a item was compiled into \a action.  Otherwise \a error
+  ///     says what couldn't be handled.
+  //------------------------------------------------------------------
+  bool CompileTracepointAction(llvm::StringRef item, TracepointAction &action,
+                               Status &error);
+
+private:
+  // The C type of a value on the bytecode stack.  Values are always kept
+  // sign or zero extended to 64 bits according to this type.
+  struct ValueType {
+    uint8_t byte_size;
+    bool is_signed;
+    bool is_pointer;
+  };
+
+  enum class Token {
+    Eof,
+    Integer,
+    Identifier,
+    LParen,
+    RParen,
+    Plus,
+    Minus,
+    Star,
+    Slash,
+    Percent,
+    Amp,
+    Pipe,
+    Caret,
+    Tilde,
+    Bang,
+    AmpAmp,
+    PipePipe,
+    EqualEqual,
+    BangEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    LessLess,
+    GreaterGreater,
+    Dot,
+    Arrow,
+    Invalid
+  };
+
+  static ValueType IntType() { return {4, true, false}; }
+  static ValueType Promote(ValueType type);
+  static int GetPrecedence(Token token);
+
+  bool CompileExpression(llvm::StringRef text, ValueType &type,
+                         Status &error);
+
+  void Lex();
+
+  bool ParseLogicalOr(ValueType &type);
+  bool ParseLogicalAnd(ValueType &type);
+  bool ParseBinary(int min_precedence, ValueType &type);
+  bool ParseUnary(ValueType &type);
+  bool ParsePrimary(ValueType &type);
+
+  bool EmitBinaryOperator(Token op, ValueType lhs, ValueType rhs,
+                          ValueType &result);
+  bool EmitVariable(llvm::StringRef name, ValueType &type);
+  bool EmitLocation(const DataExtractor &data, lldb::RegisterKind reg_kind,
+                    const SymbolContext &sc, bool is_frame_base,
+                    bool &is_register_value);
+  bool EmitFrameBase(const SymbolContext &sc);
+  bool EmitRegister(lldb::RegisterKind kind, uint32_t reg_num);
+  bool EmitNamedRegister(llvm::StringRef name, ValueType &type);
+  const RegisterInfo *FindRegister(llvm::StringRef name);
+  void EmitConvert(ValueType from, ValueType to);
+
+  bool SetError(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+  Thread &m_thread;
+  Address m_address;
+  lldb::RegisterKind m_reg_kind;
+  AgentExpression m_expr;
+  Status m_error;
+
+  llvm::StringRef m_text;
+  Token m_token = Token::Eof;
+  llvm::StringRef m_token_text;
+  uint64_t m_token_value = 0;
+  bool m_token_unsigned = false;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_ConditionCompiler_h_
@@ -0,0 +1,87 @@
+//===-- FunctionLookupCache.h -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_FunctionLookupCache_h_
+#define liblldb_FunctionLookupCache_h_
+
+// C Includes
+// C++ Includes
+#include <map>
+#include <mutex>
+#include <tuple>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Module.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class FunctionLookupCache FunctionLookupCache.h
+/// "lldb/Breakpoint/FunctionLookupCache.h"
+/// Share function lookups between the breakpoints resolved against a batch
+/// of newly loaded modules.
+///
+/// When modules load, every breakpoint is resolved against them one after
+/// the other, and name breakpoints often look up the same names: the
+/// internal breakpoints of the runtimes, breakpoints on common method names,
+/// and the several lookups a single C++ or Objective-C name expands to.
+/// Between BeginBatch() and EndBatch() each distinct lookup is run once per
+/// module and its results are handed to every breakpoint that asks for it.
+/// Outside of a batch lookups go straight to the module, since the module's
+/// symbols may change in between.
+//----------------------------------------------------------------------
+class FunctionLookupCache {
+public:
+  // Batches nest; results are dropped when the outermost one ends.
+  void BeginBatch();
+
+  void EndBatch();
+
+  //------------------------------------------------------------------
+  /// Append to \a sc_list what Module::FindFunctions() appends for the name
+  /// and name type mask of \a lookup, without a declaration context.
+  ///
+  /// Functions and symbols already in \a sc_list aren't added again.  The
+  /// results aren't pruned with \a lookup.
+  ///
+  /// @return
+  ///     The number of symbol contexts added to \a sc_list.
+  //------------------------------------------------------------------
+  size_t FindFunctions(Module &module, const Module::LookupInfo &lookup,
+                       bool include_symbols, bool include_inlines,
+                       SymbolContextList &sc_list);
+
+  // The number of lookups run on modules and answered from the cache in
+  // the current batch.
+  size_t GetNumLookups() const;
+
+  size_t GetNumReused() const;
+
+private:
+  typedef std::tuple<Module *, const char *, uint32_t, bool, bool> Key;
+
+  struct Entry {
+    // Keeps the module, and so the key, from being reused in the batch.
+    lldb::ModuleSP module_sp;
+    SymbolContextList sc_list;
+  };
+
+  mutable std::mutex m_mutex;
+  uint32_t m_batch_depth = 0;
+  std::map<Key, Entry> m_entries;
+  size_t m_num_lookups = 0;
+  size_t m_num_reused = 0;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_FunctionLookupCache_h_
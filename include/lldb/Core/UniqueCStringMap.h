@@ -19,6 +19,7 @@
 // Project includes
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/TrigramIndex.h"
 
 namespace lldb_private {
 
@@ -183,9 +184,22 @@ public:
                    std::vector<T> &values) const {
     const size_t start_size = values.size();
 
+    // Rule out names without the literal text of the regular expression
+    // before running it, and run it once for the entries of a name that
+    // sorting put next to each other.
+    std::vector<std::string> literals;
+    TrigramIndex::GetRequiredLiterals(regex.GetText(), literals);
+    ConstString prev_cstring;
+    bool prev_match = false;
     const_iterator pos, end = m_map.end();
     for (pos = m_map.begin(); pos != end; ++pos) {
-      if (regex.Execute(pos->cstring.GetCString()))
+      if (pos == m_map.begin() || pos->cstring != prev_cstring) {
+        llvm::StringRef name = pos->cstring.GetStringRef();
+        prev_cstring = pos->cstring;
+        prev_match = TrigramIndex::ContainsLiterals(name, literals) &&
+                     regex.Execute(name);
+      }
+      if (prev_match)
         values.push_back(pos->value);
     }
 
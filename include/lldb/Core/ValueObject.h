@@ -674,6 +674,10 @@ public:
 
   void Dump(Stream &s, const DumpValueObjectOptions &options);
 
+  // Like Dump(), then sets the child cursor of \a options to the first child
+  // that was left out, so that the next call prints the following page.
+  void DumpPage(Stream &s, DumpValueObjectOptions &options);
+
   static lldb::ValueObjectSP
   CreateValueObjectFromExpression(llvm::StringRef name,
                                   llvm::StringRef expression,
@@ -16,6 +16,7 @@
 
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Utility/Timeout.h"
 #include "lldb/lldb-private.h"
 #include "lldb/lldb-public.h"
 
@@ -58,6 +59,44 @@ public:
     operator bool() { return m_element_count > 0; }
   };
 
+  // Limits how much output a single print of a value may produce. Once the
+  // budget is exhausted no further children are generated, the printer closes
+  // the open aggregates with "..." and records where it stopped in the
+  // ChildCursor so the next page can be printed later.
+  struct OutputBudget {
+    size_t m_max_bytes;
+    Timeout<std::milli> m_max_time;
+
+    OutputBudget() : m_max_bytes(0), m_max_time(llvm::None) {}
+
+    OutputBudget(size_t max_bytes, Timeout<std::milli> max_time = llvm::None)
+        : m_max_bytes(max_bytes), m_max_time(max_time) {}
+
+    operator bool() const { return m_max_bytes > 0 || m_max_time; }
+  };
+
+  // An opaque position among the children of the root value. A printer that
+  // ran out of budget hands one back; passing it to SetChildCursor() makes the
+  // next print start at the first child that was not printed, without
+  // generating any of the earlier ones again. A cursor taken before the
+  // process resumed is stale and printing restarts from the first child.
+  class ChildCursor {
+  public:
+    ChildCursor() : m_next_index(0), m_stop_id(0), m_valid(false) {}
+
+    // Returns true if there are children left to print from this position.
+    bool IsValid() const { return m_valid; }
+
+    void Clear() { *this = ChildCursor(); }
+
+  private:
+    friend class ValueObjectPrinter;
+
+    size_t m_next_index;
+    uint32_t m_stop_id;
+    bool m_valid;
+  };
+
   typedef std::function<bool(ConstString, ConstString,
                              const DumpValueObjectOptions &, Stream &)>
       DeclPrintingHelper;
@@ -135,6 +174,12 @@ public:
   DumpValueObjectOptions &
   SetPointerAsArray(const PointerAsArraySettings &ptr_array);
 
+  DumpValueObjectOptions &
+  SetOutputBudget(const OutputBudget &budget = OutputBudget());
+
+  DumpValueObjectOptions &
+  SetChildCursor(const ChildCursor &cursor = ChildCursor());
+
 public:
   uint32_t m_max_depth = UINT32_MAX;
   lldb::DynamicValueType m_use_dynamic = lldb::eNoDynamicValues;
@@ -146,6 +191,8 @@ public:
   PointerDepth m_max_ptr_depth;
   DeclPrintingHelper m_decl_printing_helper;
   PointerAsArraySettings m_pointer_as_array;
+  OutputBudget m_output_budget;
+  ChildCursor m_child_cursor;
   bool m_use_synthetic : 1;
   bool m_scope_already_checked : 1;
   bool m_flat_output : 1;
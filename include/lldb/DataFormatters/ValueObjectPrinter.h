@@ -13,6 +13,7 @@
 
 // C Includes
 // C++ Includes
+#include <chrono>
 
 // Other libraries and framework includes
 // Project includes
@@ -37,11 +38,32 @@ public:
 
   bool PrintValueObject();
 
+  // After PrintValueObject() returns, this tells where the printing of the
+  // root value's children stopped, either because of the
+  // target.max-children-count cap or because the output budget ran out. Pass
+  // it back through DumpValueObjectOptions::SetChildCursor() to print the
+  // next page.
+  const DumpValueObjectOptions::ChildCursor &GetChildCursor() const {
+    return m_child_cursor;
+  }
+
 protected:
   typedef std::set<uint64_t> InstancePointersSet;
   typedef std::shared_ptr<InstancePointersSet> InstancePointersSetSP;
 
+  // The output budget is shared by the root printer and all the printers it
+  // creates for its children, so that a deeply nested child running out of
+  // budget stops the whole print.
+  struct OutputBudgetState {
+    size_t m_bytes_limit = 0;
+    bool m_has_deadline = false;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_exhausted = false;
+  };
+  typedef std::shared_ptr<OutputBudgetState> OutputBudgetStateSP;
+
   InstancePointersSetSP m_printed_instance_pointers;
+  OutputBudgetStateSP m_output_budget;
 
   // only this class (and subclasses, if any) should ever be concerned with the
   // depth mechanism
@@ -49,7 +71,8 @@ protected:
                      const DumpValueObjectOptions &options,
                      const DumpValueObjectOptions::PointerDepth &ptr_depth,
                      uint32_t curr_depth,
-                     InstancePointersSetSP printed_instance_pointers);
+                     InstancePointersSetSP printed_instance_pointers,
+                     OutputBudgetStateSP output_budget);
 
   // we should actually be using delegating constructors here but some versions
   // of GCC still have trouble with those
@@ -57,7 +80,8 @@ protected:
             const DumpValueObjectOptions &options,
             const DumpValueObjectOptions::PointerDepth &ptr_depth,
             uint32_t curr_depth,
-            InstancePointersSetSP printed_instance_pointers);
+            InstancePointersSetSP printed_instance_pointers,
+            OutputBudgetStateSP output_budget);
 
   bool GetMostSpecializedValue();
 
@@ -116,9 +140,17 @@ protected:
 
   lldb::ValueObjectSP GenerateChild(ValueObject *synth_valobj, size_t idx);
 
-  void PrintChild(lldb::ValueObjectSP child_sp,
+  // Returns false if the output budget ran out before the whole child was
+  // printed.
+  bool PrintChild(lldb::ValueObjectSP child_sp,
                   const DumpValueObjectOptions::PointerDepth &curr_ptr_depth);
 
+  bool IsOutputBudgetExhausted();
+
+  size_t GetFirstChildIndexToPrint();
+
+  void UpdateChildCursor(size_t next_index);
+
   uint32_t GetMaxNumChildrenToPrint(bool &print_dotdotdot);
 
   void
@@ -151,6 +183,9 @@ private:
   std::string m_error;
   bool m_val_summary_ok;
   std::pair<TypeValidatorResult, std::string> m_validation;
+  DumpValueObjectOptions::ChildCursor m_child_cursor;
+  // Set when the output budget ran out before all the children were printed.
+  bool m_stopped_early;
 
   friend struct StringSummaryFormat;
 
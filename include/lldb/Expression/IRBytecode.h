@@ -0,0 +1,159 @@
+//===-- IRBytecode.h --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_IRBytecode_h_
+#define liblldb_IRBytecode_h_
+
+// C Includes
+// C++ Includes
+#include <stdint.h>
+#include <vector>
+
+// Other libraries and framework includes
+#include "llvm/ADT/ArrayRef.h"
+
+// Project includes
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+class IRMemoryMap;
+
+//----------------------------------------------------------------------
+/// @class IRBytecode IRBytecode.h "lldb/Expression/IRBytecode.h"
+/// A function lowered from LLVM IR into register machine code for the
+/// IRInterpreter.
+///
+/// Every SSA value gets a 64-bit register, and constants are resolved
+/// into registers once, when the function is lowered.  Only memory that
+/// the expression takes the address of (allocas, and everything reached
+/// through the argument struct) lives in the IRMemoryMap, so running an
+/// expression again doesn't have to walk llvm::Instructions or go through
+/// the memory map for every intermediate value.
+///
+/// Register values are kept zero extended from the bit width of their
+/// LLVM type.
+//----------------------------------------------------------------------
+class IRBytecode {
+public:
+  enum Opcode : uint8_t {
+    eOpMove,  // dst = a
+    eOpAdd,   // dst = a + b
+    eOpSub,   // dst = a - b
+    eOpMul,   // dst = a * b
+    eOpSDiv,  // dst = a / b, signed
+    eOpUDiv,  // dst = a / b, unsigned
+    eOpSRem,  // dst = a % b, signed
+    eOpURem,  // dst = a % b, unsigned
+    eOpShl,   // dst = a << b
+    eOpLShr,  // dst = a >> b, logical
+    eOpAShr,  // dst = a >> b, arithmetic
+    eOpAnd,   // dst = a & b
+    eOpOr,    // dst = a | b
+    eOpXor,   // dst = a ^ b
+    eOpCmpEQ, // dst = a == b
+    eOpCmpNE, // dst = a != b
+    eOpCmpUGT,
+    eOpCmpUGE,
+    eOpCmpULT,
+    eOpCmpULE,
+    eOpCmpSGT,
+    eOpCmpSGE,
+    eOpCmpSLT,
+    eOpCmpSLE,
+    eOpSExt,   // dst = a sign extended from src_width bits
+    eOpIndex,  // dst = a + (b sign extended from src_width bits) * imm
+    eOpAlloca, // dst = imm bytes aligned to size bytes on the frame
+    eOpLoad,   // dst = the size bytes at address a
+    eOpStore,  // store the low size bytes of a at address b
+    eOpJump,   // continue at imm, having run size more IR instructions
+    eOpBranch, // continue at imm if a is nonzero, else at b
+    eOpReturn,
+    kNumOpcodes
+  };
+
+  struct Instruction {
+    Opcode op;
+    uint8_t width;     // Bit width of the result, or of the operands for
+                       // comparisons.
+    uint8_t src_width; // Bit width of the operand eOpSExt and eOpIndex
+                       // extend.
+    uint32_t size;     // Memory access size, alignment or step count.
+    uint32_t dst;
+    uint32_t a;
+    uint32_t b;
+    uint64_t imm;
+  };
+
+  // Interpretation stops with an error after this many IR instructions, the
+  // same budget the IRInterpreter gives an llvm::Function.
+  static constexpr uint32_t kMaxSteps = 4096;
+
+  IRBytecode(lldb::ByteOrder byte_order, uint32_t num_arguments)
+      : m_byte_order(byte_order), m_num_arguments(num_arguments),
+        m_registers(num_arguments, 0) {}
+
+  //------------------------------------------------------------------
+  // Building
+  //------------------------------------------------------------------
+
+  // Returns a new register, initialized to \a value on every run.
+  uint32_t AddRegister(uint64_t value = 0) {
+    m_registers.push_back(value);
+    return m_registers.size() - 1;
+  }
+
+  uint32_t GetArgumentRegister(uint32_t index) const { return index; }
+
+  size_t AddInstruction(const Instruction &inst) {
+    m_code.push_back(inst);
+    return m_code.size() - 1;
+  }
+
+  Instruction &GetInstruction(size_t index) { return m_code[index]; }
+
+  size_t GetNumInstructions() const { return m_code.size(); }
+
+  // The number of IR instructions in the entry block, which are run
+  // without a jump to account for them.
+  void SetEntrySteps(uint32_t steps) { m_entry_steps = steps; }
+
+  void Dump(Stream &s) const;
+
+  //------------------------------------------------------------------
+  /// Run the function.
+  ///
+  /// @param[in] args
+  ///     The values of the function's arguments.
+  ///
+  /// @param[in] memory_map
+  ///     Where loads and stores go.
+  ///
+  /// @param[in] stack_frame_bottom
+  /// @param[in] stack_frame_top
+  ///     The region allocas are carved out of.
+  ///
+  /// @return
+  ///     True if the function returned, false with \a error set otherwise.
+  //------------------------------------------------------------------
+  bool Run(llvm::ArrayRef<lldb::addr_t> args, IRMemoryMap &memory_map,
+           lldb::addr_t stack_frame_bottom, lldb::addr_t stack_frame_top,
+           Status &error) const;
+
+private:
+  lldb::ByteOrder m_byte_order;
+  uint32_t m_num_arguments;
+  uint32_t m_entry_steps = 0;
+  std::vector<uint64_t> m_registers; ///< Initial register values.
+  std::vector<Instruction> m_code;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_IRBytecode_h_
@@ -19,6 +19,7 @@
 #include <vector>
 
 // Other libraries and framework includes
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/IR/Module.h"
 
@@ -40,6 +41,7 @@ class ObjectCache;
 
 namespace lldb_private {
 
+class IRBytecode;
 class Status;
 
 //----------------------------------------------------------------------
@@ -90,6 +92,20 @@ public:
   void GetRunnableInfo(Status &error, lldb::addr_t &func_addr,
                        lldb::addr_t &func_end);
 
+  //------------------------------------------------------------------
+  /// Get the IRInterpreter's bytecode for GetFunction().
+  ///
+  /// @param[in] lower
+  ///     Lowers the function.  It is only called the first time the
+  ///     bytecode is asked for, so evaluating the same expression again
+  ///     reuses the result.
+  ///
+  /// @return
+  ///     The bytecode, or nullptr if the function couldn't be lowered.
+  //------------------------------------------------------------------
+  IRBytecode *GetInterpreterBytecode(
+      llvm::function_ref<std::unique_ptr<IRBytecode>()> lower);
+
   //------------------------------------------------------------------
   /// Accessors for IRForTarget and other clients that may want binary data
   /// placed on their behalf.  The binary data is owned by the IRExecutionUnit
@@ -415,6 +431,8 @@ private:
   std::unique_ptr<llvm::LLVMContext> m_context_ap;
   std::unique_ptr<llvm::ExecutionEngine> m_execution_engine_ap;
   std::unique_ptr<llvm::ObjectCache> m_object_cache_ap;
+  std::unique_ptr<IRBytecode> m_interpreter_bytecode_ap;
+  std::once_flag m_interpreter_bytecode_once;
   std::unique_ptr<llvm::Module>
       m_module_ap; ///< Holder for the module until it's been handed off
   lldb::ModuleWP m_jit_module_wp;
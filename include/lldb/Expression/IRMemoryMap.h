@@ -74,6 +74,34 @@ public:
   void GetMemoryData(DataExtractor &extractor, lldb::addr_t process_address,
                      size_t size, Status &error);
 
+  //------------------------------------------------------------------
+  /// Hold back the process writes to a mirrored allocation.
+  ///
+  /// Until EndBatch is called, writes into the allocation containing
+  /// \a process_address only go to its host copy, and reads from it are
+  /// served from there too.  EndBatch then writes everything that changed
+  /// with a single process write, so filling in a struct field by field
+  /// doesn't cost a round trip per field.  Only one allocation can be
+  /// batched at a time; for allocations that aren't mirrored this does
+  /// nothing.
+  ///
+  /// @param[in] process_address
+  ///     An address inside the allocation.
+  ///
+  /// @param[in] fetch
+  ///     If true, the host copy is first brought up to date with a single
+  ///     process read, e.g. because code in the process has written to it.
+  ///
+  /// @param[out] error
+  ///     Set if the host copy couldn't be fetched.
+  //------------------------------------------------------------------
+  void BeginBatch(lldb::addr_t process_address, bool fetch, Status &error);
+  void EndBatch(Status &error);
+
+  // The number of process memory reads and writes made through this map.
+  uint32_t GetNumProcessReads() const { return m_num_process_reads; }
+  uint32_t GetNumProcessWrites() const { return m_num_process_writes; }
+
   lldb::ByteOrder GetByteOrder();
   uint32_t GetAddressByteSize();
 
@@ -121,8 +149,18 @@ private:
   lldb::TargetWP m_target_wp;
   typedef std::map<lldb::addr_t, Allocation> AllocationMap;
   AllocationMap m_allocations;
+  // The allocation BeginBatch was called for, and the range of it that has
+  // been written since.
+  lldb::addr_t m_batch_start = LLDB_INVALID_ADDRESS;
+  size_t m_batch_dirty_begin = 0;
+  size_t m_batch_dirty_end = 0;
+  uint32_t m_num_process_reads = 0;
+  uint32_t m_num_process_writes = 0;
 
   lldb::addr_t FindSpace(size_t size);
+  bool IsBatched(const Allocation &allocation) const {
+    return allocation.m_process_start == m_batch_start;
+  }
   bool ContainsHostOnlyAllocations();
   AllocationMap::iterator FindAllocation(lldb::addr_t addr, size_t size);
 
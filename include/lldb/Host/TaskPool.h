@@ -11,6 +11,7 @@
 #define utility_TaskPool_h_
 
 #include "llvm/ADT/STLExtras.h"
+#include <atomic>     // for atomic
 #include <functional> // for bind, function
 #include <future>
 #include <list>
@@ -20,13 +21,64 @@
 
 namespace lldb_private {
 
+// The lane a task is queued in. Workers always take the highest priority
+// task there is, so work a user is waiting on should be High and work nobody
+// is waiting on yet, like indexing in the background, should be Low.
+enum class TaskPriority { High, Normal, Low };
+
+// A flag shared by everything that was handed the same token. Tasks that are
+// still queued when it is cancelled are dropped without running, and running
+// tasks can poll IsCancelled() to stop early.
+class CancellationToken {
+public:
+  CancellationToken()
+      : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+  void Cancel() { *m_cancelled = true; }
+
+  bool IsCancelled() const { return *m_cancelled; }
+
+private:
+  std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+struct TaskGroupState;
+
+// A set of tasks that can be waited on together. Wait() runs the group's
+// queued tasks while it isn't done instead of blocking, so tasks on the pool
+// can add and wait on groups of their own without running out of workers.
+// It also runs the tasks of groups added by the group's tasks, but never
+// those of unrelated groups or of a lower priority, nor AddTask tasks.
+class TaskGroup {
+public:
+  explicit TaskGroup(TaskPriority priority = TaskPriority::Normal,
+                     CancellationToken token = CancellationToken());
+
+  // Waits for the tasks that were added.
+  ~TaskGroup();
+
+  void Add(std::function<void()> &&task_fn);
+
+  void Wait();
+
+  const CancellationToken &GetCancellationToken() const;
+
+private:
+  std::shared_ptr<TaskGroupState> m_state;
+
+  TaskGroup(const TaskGroup &) = delete;
+  const TaskGroup &operator=(const TaskGroup &) = delete;
+};
+
 // Global TaskPool class for running tasks in parallel on a set of worker
-// thread created the first time the task pool is used. The TaskPool provide no
-// guarantee about the order the task will be run and about what tasks will run
-// in parallel. None of the task added to the task pool should block on
-// something (mutex, future, condition variable) what will be set only by the
-// completion of an other task on the task pool as they may run on the same
-// thread sequentally.
+// threads created the first time the task pool is used. Each worker has a
+// deque per priority that the tasks it adds go to; a worker without work
+// takes tasks from the shared queues and then steals from the other workers.
+// The TaskPool provides no guarantee about the order the tasks will be run
+// in or about what tasks will run in parallel. A task may wait on a TaskGroup
+// or on RunTasks and TaskMapOverInt, which help run tasks while they wait,
+// but it shouldn't block on a future from AddTask: the task behind that
+// future may be queued behind the waiting one on the same thread.
 class TaskPool {
 public:
   // Add a new task to the task pool and return a std::future belonging to the
@@ -39,8 +91,7 @@ public:
   // Run all of the specified tasks on the task pool and wait until all of them
   // are finished before returning. This method is intended to be used for
   // small number tasks where listing them as function arguments is acceptable.
-  // For running large number of tasks you should use AddTask for each task and
-  // then call wait() on each returned future.
+  // For running large number of tasks you should use a TaskGroup.
   template <typename... T> static void RunTasks(T &&... tasks);
 
 private:
@@ -64,27 +115,28 @@ TaskPool::AddTask(F &&f, Args &&... args) {
 }
 
 template <typename... T> void TaskPool::RunTasks(T &&... tasks) {
-  RunTaskImpl<T...>::Run(std::forward<T>(tasks)...);
+  TaskGroup group;
+  RunTaskImpl<T...>::Run(group, std::forward<T>(tasks)...);
+  group.Wait();
 }
 
 template <typename Head, typename... Tail>
 struct TaskPool::RunTaskImpl<Head, Tail...> {
-  static void Run(Head &&h, Tail &&... t) {
-    auto f = AddTask(std::forward<Head>(h));
-    RunTaskImpl<Tail...>::Run(std::forward<Tail>(t)...);
-    f.wait();
+  static void Run(TaskGroup &group, Head &&h, Tail &&... t) {
+    group.Add(std::function<void()>(std::forward<Head>(h)));
+    RunTaskImpl<Tail...>::Run(group, std::forward<Tail>(t)...);
   }
 };
 
 template <> struct TaskPool::RunTaskImpl<> {
-  static void Run() {}
+  static void Run(TaskGroup &group) {}
 };
 
-// Run 'func' on every value from begin .. end-1.  Each worker will grab
-// 'batch_size' numbers at a time to work on, so for very fast functions, batch
-// should be large enough to avoid too much cache line contention.
+// Run 'func' on every value from begin .. end-1 on the calling thread and
+// on as many workers as are free, and wait until all of them are done.
 void TaskMapOverInt(size_t begin, size_t end,
-                    const llvm::function_ref<void(size_t)> &func);
+                    const llvm::function_ref<void(size_t)> &func,
+                    TaskPriority priority = TaskPriority::Normal);
 
 unsigned GetHardwareConcurrencyHint();
 
@@ -10,8 +10,11 @@
 #ifndef liblldb_NativeBreakpoint_h_
 #define liblldb_NativeBreakpoint_h_
 
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/lldb-types.h"
 
+#include <vector>
+
 namespace lldb_private {
 class NativeBreakpointList;
 
@@ -34,9 +37,20 @@ public:
 
   virtual bool IsSoftwareBreakpoint() const = 0;
 
+  // Conditions sent along with the Z packet that set this breakpoint.  A hit
+  // only needs to be reported if one of them is true (or fails to evaluate).
+  void SetConditions(std::vector<AgentExpression> conditions) {
+    m_conditions = std::move(conditions);
+  }
+
+  const std::vector<AgentExpression> &GetConditions() const {
+    return m_conditions;
+  }
+
 protected:
   const lldb::addr_t m_addr;
   int32_t m_ref_count;
+  std::vector<AgentExpression> m_conditions;
 
   virtual Status DoEnable() = 0;
 
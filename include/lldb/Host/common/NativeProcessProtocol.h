@@ -15,9 +15,11 @@
 #include "NativeWatchpointList.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/MainLoop.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/TraceOptions.h"
+#include "lldb/Utility/Tracepoint.h"
 #include "lldb/lldb-private-forward.h"
 #include "lldb/lldb-types.h"
 #include "llvm/ADT/ArrayRef.h"
@@ -25,6 +27,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <map>
 #include <vector>
 
 namespace lldb_private {
@@ -81,6 +84,10 @@ public:
   virtual Status GetMemoryRegionInfo(lldb::addr_t load_addr,
                                      MemoryRegionInfo &range_info);
 
+  // Get every mapped region, in increasing address order.  The default walks
+  // the address space with GetMemoryRegionInfo().
+  virtual Status GetMemoryRegions(std::vector<MemoryRegionInfo> &regions);
+
   virtual Status ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                             size_t &bytes_read) = 0;
 
@@ -115,6 +122,34 @@ public:
 
   virtual Status DisableBreakpoint(lldb::addr_t addr);
 
+  //------------------------------------------------------------------
+  /// Replace the conditions of the software breakpoint at \a addr.
+  ///
+  /// A breakpoint with conditions only stops the process when at least
+  /// one of them evaluates to true; an empty list makes the breakpoint
+  /// unconditional again.  Conditions are only honoured if
+  /// SupportsBreakpointConditions() returns true.
+  //------------------------------------------------------------------
+  Status SetBreakpointConditions(lldb::addr_t addr,
+                                 std::vector<AgentExpression> conditions);
+
+  virtual bool SupportsBreakpointConditions() const { return false; }
+
+  //------------------------------------------------------------------
+  /// Replace the tracepoints collected at the software breakpoint at
+  /// \a addr; an empty list removes them.
+  ///
+  /// Each hit of the breakpoint appends a record for every tracepoint
+  /// whose condition is true to GetTracepointBuffer(), before the
+  /// breakpoint's conditions decide whether to stop.  Tracepoints need
+  /// SupportsBreakpointConditions(), and may be set before the breakpoint
+  /// itself.
+  //------------------------------------------------------------------
+  Status SetBreakpointTracepoints(lldb::addr_t addr,
+                                  std::vector<TracepointSpec> specs);
+
+  TracepointBuffer &GetTracepointBuffer() { return m_tracepoint_buffer; }
+
   //----------------------------------------------------------------------
   // Hardware Breakpoint functions
   //----------------------------------------------------------------------
@@ -418,6 +453,8 @@ protected:
   NativeBreakpointList m_breakpoint_list;
   NativeWatchpointList m_watchpoint_list;
   HardwareBreakpointMap m_hw_breakpoints_map;
+  std::map<lldb::addr_t, std::vector<TracepointSpec>> m_tracepoints;
+  TracepointBuffer m_tracepoint_buffer;
   int m_terminal_fd;
   uint32_t m_stop_id = 0;
 
@@ -448,6 +485,15 @@ protected:
   // -----------------------------------------------------------
   Status SetSoftwareBreakpoint(lldb::addr_t addr, uint32_t size_hint);
 
+  // Returns false only if the software breakpoint at \a addr has
+  // conditions and all of them evaluate to false for \a thread.
+  bool BreakpointConditionsSayStop(NativeThreadProtocol &thread,
+                                   lldb::addr_t addr);
+
+  // Record a hit of the tracepoints at \a addr by \a thread, which must be
+  // stopped at the breakpoint with its PC moved back to \a addr.
+  void CollectTracepoints(NativeThreadProtocol &thread, lldb::addr_t addr);
+
   virtual Status
   GetSoftwareBreakpointTrapOpcode(size_t trap_opcode_size_hint,
                                   size_t &actual_opcode_size,
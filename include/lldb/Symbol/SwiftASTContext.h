@@ -26,10 +26,12 @@
 #include "lldb/Utility/Either.h"
 #include "lldb/Utility/Status.h"
 
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/Support/Threading.h"
 
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace swift {
@@ -351,7 +353,7 @@ public:
 
   swift::IRGenOptions &GetIRGenOptions();
 
-  void ModulesDidLoad(ModuleList &module_list);
+  virtual void ModulesDidLoad(ModuleList &module_list);
 
   void ClearModuleDependentCaches();
 
@@ -361,6 +363,11 @@ public:
 
   bool CheckProcessChanged();
 
+  // Called when CheckProcessChanged() returns true.  Returns true if the
+  // context switched over to the target's new process and can still be
+  // used, false if it has to be replaced.
+  virtual bool AdoptCurrentProcess() { return false; }
+
   // FIXME: this should be removed once we figure out who should really own the
   // DebuggerClient's that we are sticking into the Swift Modules.
   void AddDebuggerClient(swift::DebuggerClient *debugger_client);
@@ -804,7 +811,8 @@ protected:
 
   bool LoadLibraryUsingPaths(Process &process, llvm::StringRef library_name,
                              std::vector<std::string> &search_paths,
-                             bool check_rpath, StreamString &all_dlopen_errors);
+                             bool check_rpath, StreamString &all_dlopen_errors,
+                             bool check_search_paths = true);
 
   bool TargetHasNoSDK();
 
@@ -840,6 +848,10 @@ protected:
   lldb_private::Process *m_process; // Only if this AST belongs to a target, and
                                     // an expression has been evaluated will the
                                     // target's process pointer be filled in
+  // The modules whose link libraries LoadModule() has already loaded into
+  // the process with unique ID m_loaded_modules_process_id.
+  llvm::DenseSet<swift::ModuleDecl *> m_modules_loaded_into_process;
+  uint32_t m_loaded_modules_process_id = 0;
   std::string m_platform_sdk_path;
 
   typedef std::map<Module *, std::vector<lldb::DataBufferSP>> ASTFileDataMap;
@@ -921,8 +933,24 @@ public:
 
   PersistentExpressionState *GetPersistentExpressionState() override;
 
+  void ModulesDidLoad(ModuleList &module_list) override;
+
+  bool AdoptCurrentProcess() override;
+
 private:
+  friend class SwiftASTContext;
+
+  // Add an image's search paths and register its Swift modules, unless
+  // that has already been done.
+  void AddImage(const lldb::ModuleSP &module_sp);
+
   std::unique_ptr<SwiftPersistentExpressionState> m_persistent_state_up;
+
+  bool m_use_all_compiler_flags = true;
+  std::mutex m_images_mutex;
+  std::map<const Module *, lldb::ModuleWP> m_images;
+  std::vector<lldb::ModuleWP> m_swift_images; // Images whose Swift modules
+                                              // were registered.
 };
 
 void printASTValidationInfo(
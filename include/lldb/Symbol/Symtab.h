@@ -10,12 +10,14 @@
 #ifndef liblldb_Symtab_h_
 #define liblldb_Symtab_h_
 
+#include <memory>
 #include <mutex>
 #include <vector>
 
 #include "lldb/Core/RangeMap.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Symbol/Symbol.h"
+#include "lldb/Utility/TrigramIndex.h"
 #include "lldb/lldb-private.h"
 
 namespace lldb_private {
@@ -156,6 +158,24 @@ protected:
   void InitNameIndexes();
   void InitAddressIndexes();
 
+  // The distinct symbol names and the symbols having each, for regular
+  // expression lookups.  The symbols of name ID i are
+  // symbol_indexes[first_symbol[i]] up to symbol_indexes[first_symbol[i+1]].
+  struct RegexIndex {
+    TrigramIndex names;
+    std::vector<uint32_t> first_symbol;
+    std::vector<uint32_t> symbol_indexes;
+  };
+
+  // Built by the first regular expression lookup, since most sessions
+  // never do one.
+  const RegexIndex &GetRegexIndex();
+
+  // Get the indexes of the symbols whose name \a regex matches, in
+  // ascending order.
+  void FindSymbolIndexesMatchingRegex(const RegularExpression &regex,
+                                      std::vector<uint32_t> &indexes);
+
   ObjectFile *m_objfile;
   collection m_symbols;
   FileRangeToIndexMap m_file_addr_to_index;
@@ -163,6 +183,7 @@ protected:
   UniqueCStringMap<uint32_t> m_basename_to_index;
   UniqueCStringMap<uint32_t> m_method_to_index;
   UniqueCStringMap<uint32_t> m_selector_to_index;
+  std::unique_ptr<RegexIndex> m_regex_index;
   mutable std::recursive_mutex
       m_mutex; // Provide thread safety for this symbol table
   bool m_file_addr_to_index_computed : 1, m_name_indexes_computed : 1;
@@ -22,6 +22,8 @@
 
 #include <stddef.h> // for size_t
 #include <stdint.h> // for int64_t
+
+#include <vector>
 namespace lldb_private {
 class ModuleList;
 }
@@ -259,6 +261,24 @@ public:
                                              lldb::addr_t base_addr,
                                              bool base_addr_is_offset);
 
+  //------------------------------------------------------------------
+  /// Load the module that contains a load address, if the dynamic loader
+  /// knows about one it hasn't loaded yet.
+  ///
+  /// Dynamic loaders that defer loading modules until they are needed
+  /// override this.  The unwinder calls it for PCs that aren't in any
+  /// loaded module.
+  ///
+  /// @param[in] load_addr
+  ///     The load address that isn't in a loaded module.
+  ///
+  /// @return
+  ///     The module that was loaded, or an empty module if there is none.
+  //------------------------------------------------------------------
+  virtual lldb::ModuleSP LoadModuleContainingAddress(lldb::addr_t load_addr) {
+    return lldb::ModuleSP();
+  }
+
   //------------------------------------------------------------------
   /// Get information about the shared cache for a process, if possible.
   ///
@@ -332,6 +352,18 @@ protected:
   void UpdateLoadedSectionsCommon(lldb::ModuleSP module, lldb::addr_t base_addr,
                                   bool base_addr_is_offset);
 
+  /// Finds or creates the modules for @p files and reads their object
+  /// files, section lists and symbol files on several threads, preloading
+  /// symbols if the target wants that, so that the LoadModuleAtAddress
+  /// calls that follow find them ready.
+  ///
+  /// @param files The files the dynamic loader is about to load.
+  ///
+  /// @return The modules, in the order of @p files, with empty entries for
+  /// files that weren't prepared.  Hold on to them until they are loaded.
+  std::vector<lldb::ModuleSP>
+  PrepareModules(const std::vector<lldb_private::FileSpec> &files);
+
   /// Removes the loaded sections from the target in @p module.
   ///
   /// @param module The module to traverse.
@@ -187,6 +187,10 @@ public:
   GetPossibleFormattersMatches(ValueObject &valobj,
                                lldb::DynamicValueType use_dynamic);
 
+  // The StringPrinter copies runs of printable ASCII characters other than
+  // quotes and backslash straight to the output, so the helper returned here
+  // is only consulted for the remaining characters and must not change the
+  // rendering of those.
   virtual lldb_private::formatters::StringPrinter::EscapingHelper
       GetStringPrinterEscapingHelper(
           lldb_private::formatters::StringPrinter::GetPrintableElementType);
@@ -54,10 +54,43 @@ public:
   void AddL1CacheData(lldb::addr_t addr,
                       const lldb::DataBufferSP &data_buffer_sp);
 
+  // Counters that live across Clear() for the life of the process.
+  struct Statistics {
+    uint64_t reads = 0;            // Calls to Read()
+    uint64_t misses = 0;           // Reads that had to go to the inferior
+    uint64_t inferior_reads = 0;   // Reads made from the inferior
+    uint64_t bytes_read = 0;       // Bytes read from the inferior
+    uint64_t bytes_prefetched = 0; // Bytes read ahead of what was asked for
+  };
+
+  Statistics GetStatistics();
+
 protected:
   typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
   typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
   typedef Range<lldb::addr_t, lldb::addr_t> AddrRange;
+
+  // What a memory region holds decides how much we read ahead in it.
+  enum RegionKind {
+    eRegionKindUnknown,
+    eRegionKindData,
+    eRegionKindStack,
+    eRegionKindText
+  };
+  typedef RangeDataVector<lldb::addr_t, lldb::addr_t, RegionKind> RegionKinds;
+
+  // Read the L2 cache line at \a line_addr from the inferior, along with the
+  // lines around it when the misses before it walked through memory in
+  // order.  \a bytes_needed counts from \a line_addr.
+  bool FillL2Cache(lldb::addr_t line_addr, size_t bytes_needed, Status &error);
+
+  bool CanPrefetchL2Line(lldb::addr_t line_addr,
+                         const AddrRange &region) const;
+
+  // Look up the region around \a addr, only asking the process about it
+  // when \a ask_process is true and we haven't already.
+  RegionKind GetRegionKind(lldb::addr_t addr, AddrRange &region,
+                           bool ask_process);
   //------------------------------------------------------------------
   // Classes that inherit from MemoryCache can see and modify these
   //------------------------------------------------------------------
@@ -70,6 +103,13 @@ protected:
   InvalidRanges m_invalid_ranges;
   Process &m_process;
   uint32_t m_L2_cache_line_byte_size;
+  uint32_t m_max_fill_lines; // The most L2 lines one miss may read
+  uint32_t m_fill_lines;     // How many lines the next in-order miss reads
+  AddrRange m_last_fill;     // The lines the last miss read
+  RegionKinds m_region_kinds;
+  bool m_region_info_supported;
+  bool m_getting_region_info;
+  Statistics m_stats;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(MemoryCache);
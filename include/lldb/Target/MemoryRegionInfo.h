@@ -25,7 +25,8 @@ public:
 
   MemoryRegionInfo()
       : m_range(), m_read(eDontKnow), m_write(eDontKnow), m_execute(eDontKnow),
-        m_mapped(eDontKnow), m_flash(eDontKnow), m_blocksize(0) {}
+        m_mapped(eDontKnow), m_flash(eDontKnow), m_blocksize(0),
+        m_file_offset(LLDB_INVALID_OFFSET) {}
 
   ~MemoryRegionInfo() {}
 
@@ -66,6 +67,14 @@ public:
 
   void SetBlocksize(lldb::offset_t blocksize) { m_blocksize = blocksize; }
 
+  // The offset into the file named by GetName() that the region starts at,
+  // or LLDB_INVALID_OFFSET if it isn't known.
+  lldb::offset_t GetFileOffset() const { return m_file_offset; }
+
+  void SetFileOffset(lldb::offset_t file_offset) {
+    m_file_offset = file_offset;
+  }
+
   //----------------------------------------------------------------------
   // Get permissions as a uint32_t that is a mask of one or more bits from the
   // lldb::Permissions
@@ -108,6 +117,7 @@ protected:
   ConstString m_name;
   OptionalBool m_flash;
   lldb::offset_t m_blocksize;
+  lldb::offset_t m_file_offset;
 };
 }
 
@@ -870,12 +870,56 @@ public:
                                lldb_private::Status &error,
                                lldb_private::FileSpec *loaded_path);
 
+  //------------------------------------------------------------------
+  /// Load several shared libraries into this process at once.
+  ///
+  /// Platforms that load images by running code in the inferior can
+  /// open all of them with a single function call, which is much
+  /// cheaper than a LoadImage call per library.
+  ///
+  /// @param[in] process
+  ///     The process to load the images.
+  ///
+  /// @param[in] remote_files
+  ///     The paths of the shared libraries on the target.
+  ///
+  /// @param[out] errors
+  ///     Filled in with one error object per entry of \a remote_files.
+  ///
+  /// @return
+  ///     One token per entry of \a remote_files, LLDB_INVALID_IMAGE_TOKEN
+  ///     for the libraries that couldn't be opened.
+  //------------------------------------------------------------------
+  std::vector<uint32_t>
+  LoadImages(lldb_private::Process *process,
+             const std::vector<lldb_private::FileSpec> &remote_files,
+             std::vector<lldb_private::Status> &errors);
+
+  //------------------------------------------------------------------
+  /// Like LoadImageUsingPaths, but looks for several libraries along the
+  /// same set of paths at once.
+  ///
+  /// @see LoadImages
+  //------------------------------------------------------------------
+  std::vector<uint32_t>
+  LoadImagesUsingPaths(lldb_private::Process *process,
+                       const std::vector<lldb_private::FileSpec> &library_names,
+                       const std::vector<std::string> &paths,
+                       std::vector<lldb_private::Status> &errors);
+
   virtual uint32_t DoLoadImage(lldb_private::Process *process,
                                const lldb_private::FileSpec &remote_file,
                                const std::vector<std::string> *paths,
                                lldb_private::Status &error,
                                lldb_private::FileSpec *loaded_path = nullptr);
 
+  // The default implementation calls DoLoadImage for each file.
+  virtual std::vector<uint32_t>
+  DoLoadImages(lldb_private::Process *process,
+               const std::vector<lldb_private::FileSpec> &remote_files,
+               const std::vector<std::string> *paths,
+               std::vector<lldb_private::Status> &errors);
+
   virtual Status UnloadImage(lldb_private::Process *process,
                              uint32_t image_token);
 
@@ -51,6 +51,7 @@
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/StructuredData.h"
 #include "lldb/Utility/TraceOptions.h"
+#include "lldb/Utility/Tracepoint.h"
 #include "lldb/lldb-private.h"
 
 #include "llvm/ADT/ArrayRef.h"
@@ -75,6 +76,8 @@ public:
 
   uint64_t GetMemoryCacheLineSize() const;
 
+  uint64_t GetMemoryCachePrefetchSize() const;
+
   Args GetExtraStartupCommands() const;
 
   void SetExtraStartupCommands(const Args &args);
@@ -103,6 +106,8 @@ public:
 
   bool GetStopOnExec() const;
 
+  bool GetReadTextFromObjectFiles() const;
+
 protected:
   static void OptionValueChangedCallback(void *baton,
                                          OptionValue *option_value);
@@ -1778,6 +1783,33 @@ public:
   virtual size_t ReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                             Status &error);
 
+  //------------------------------------------------------------------
+  /// Point \a data at process memory without copying it.
+  ///
+  /// Processes that already hold their memory, like the ones for core
+  /// files, can hand out the bytes they have instead of copying them into
+  /// a caller's buffer.  The bytes are read-only and \a data keeps them
+  /// alive.  The byte order and address size of \a data aren't changed.
+  ///
+  /// @param[in] vm_addr
+  ///     A virtual load address that indicates where to start reading
+  ///     memory from.
+  ///
+  /// @param[in] size
+  ///     The number of bytes wanted.
+  ///
+  /// @param[out] data
+  ///     Set to exactly \a size bytes of memory starting at \a vm_addr.
+  ///
+  /// @return
+  ///     True if \a data was set.  False if the range can't be shared,
+  ///     in which case the caller should use ReadMemory().
+  //------------------------------------------------------------------
+  virtual bool GetSharedMemoryData(lldb::addr_t vm_addr, size_t size,
+                                   DataExtractor &data) {
+    return false;
+  }
+
   //------------------------------------------------------------------
   /// Read a NULL terminated string from memory
   ///
@@ -1828,6 +1860,20 @@ public:
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  //------------------------------------------------------------------
+  /// Get the hit, miss and byte counters of the memory cache since the
+  /// process started.
+  //------------------------------------------------------------------
+  MemoryCache::Statistics GetMemoryCacheStatistics() {
+    return m_memory_cache.GetStatistics();
+  }
+
+  //------------------------------------------------------------------
+  /// Get the number of memory reads that were served from the object
+  /// files of modules instead of the process.
+  //------------------------------------------------------------------
+  uint64_t GetObjectFileTextReadCount();
+
   //------------------------------------------------------------------
   /// Reads an unsigned integer of the specified byte size from process
   /// memory.
@@ -2352,6 +2398,36 @@ public:
     return error;
   }
 
+  //------------------------------------------------------------------
+  /// Called when the owners of \a bp_site or their conditions change.
+  /// Processes that hand breakpoint conditions to their stub (see
+  /// BreakpointSite::GetAgentConditions) re-send them from here; the
+  /// default does nothing.
+  //------------------------------------------------------------------
+  virtual Status UpdateBreakpointSiteConditions(BreakpointSite *bp_site) {
+    return Status();
+  }
+
+  //------------------------------------------------------------------
+  /// Collect the records of all tracepoint hits since the last call,
+  /// both those the stub recorded without stopping and those the
+  /// debugger recorded itself, oldest first per source.
+  ///
+  /// @param[out] records
+  ///     The records are appended here.
+  ///
+  /// @param[out] num_dropped
+  ///     The number of records lost because a buffer was full.
+  //------------------------------------------------------------------
+  Status GetTracepointRecords(std::vector<TracepointRecord> &records,
+                              uint64_t &num_dropped);
+
+  //------------------------------------------------------------------
+  /// The buffer tracepoint hits the debugger collects itself go to, see
+  /// BreakpointLocation::CollectTracepoint.
+  //------------------------------------------------------------------
+  TracepointBuffer &GetTracepointBuffer() { return m_tracepoint_buffer; }
+
   // This is implemented completely using the lldb::Process API. Subclasses
   // don't need to implement this function unless the standard flow of read
   // existing opcode, write breakpoint opcode, verify breakpoint opcode doesn't
@@ -2865,6 +2941,15 @@ public:
   }
 
 protected:
+  //------------------------------------------------------------------
+  /// Drain the tracepoint records the stub collected, see
+  /// GetTracepointRecords.  The default has none.
+  //------------------------------------------------------------------
+  virtual Status DoGetTracepointRecords(std::vector<TracepointRecord> &records,
+                                        uint64_t &num_dropped) {
+    return Status();
+  }
+
   void SetState(lldb::EventSP &event_sp);
 
   lldb::StateType GetPrivateState();
@@ -3096,6 +3181,8 @@ protected:
   std::vector<lldb::addr_t> m_image_tokens;
   lldb::ListenerSP m_listener_sp; ///< Shared pointer to the listener used for
                                   ///public events.  Can not be empty.
+  TracepointBuffer m_tracepoint_buffer; ///< Tracepoint hits the debugger
+                                        ///collected itself.
   BreakpointSiteList m_breakpoint_site_list; ///< This is the list of breakpoint
                                              ///locations we intend to insert in
                                              ///the target.
@@ -3123,6 +3210,17 @@ protected:
   Predicate<uint32_t> m_iohandler_sync;
   MemoryCache m_memory_cache;
   AllocatedMemoryCache m_allocated_memory_cache;
+  // Read-only code sections of loaded modules, keyed by load address, that
+  // ReadMemory can take from the object file once a sample of the section
+  // has been found to match the process.
+  struct ObjectFileText {
+    lldb::addr_t end;
+    lldb::SectionWP section_wp;
+    LazyBool matches_process;
+  };
+  std::map<lldb::addr_t, ObjectFileText> m_object_file_text;
+  std::mutex m_object_file_text_mutex;
+  uint64_t m_object_file_text_reads;
   bool m_should_detach; /// Should we detach if the process object goes away
                         /// with an explicit call to Kill or Detach?
   LanguageRuntimeCollection m_language_runtimes;
@@ -3218,6 +3316,17 @@ protected:
   size_t WriteMemoryPrivate(lldb::addr_t addr, const void *buf, size_t size,
                             Status &error);
 
+  // Remember the read-only code sections in \a sections that are loaded.
+  void AddObjectFileText(const SectionList &sections);
+
+  // Read \a addr from the object file of the module whose code it is in.
+  // Returns zero if the read has to go to the process.
+  size_t ReadMemoryFromObjectFileText(lldb::addr_t addr, void *buf,
+                                      size_t size);
+
+  bool ObjectFileTextMatchesProcess(Section &section, lldb::addr_t base,
+                                    lldb::addr_t end);
+
   void AppendSTDOUT(const char *s, size_t len);
 
   void AppendSTDERR(const char *s, size_t len);
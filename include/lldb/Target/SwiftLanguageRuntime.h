@@ -332,6 +332,16 @@ public:
                           ConstString member_name,
                           Status *error = nullptr);
 
+  /// Hit and miss counts of the cache mapping class metadata pointers
+  /// to the dynamic type they describe.
+  struct DynamicTypeCacheStatistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t size = 0;
+  };
+
+  DynamicTypeCacheStatistics GetDynamicTypeCacheStatistics() const;
+
   void AddToLibraryNegativeCache(const char *library_name);
 
   bool IsInLibraryNegativeCache(const char *library_name);
@@ -473,6 +483,17 @@ protected:
   std::unordered_map<const char *, lldb::SyntheticChildrenSP>
       m_bridged_synthetics_map;
 
+  /// Cached dynamic types of class instances, keyed by the metadata
+  /// pointer found in the instance's isa. Metadata is never freed by
+  /// the Swift runtime, but its address can be reused by an image
+  /// loaded later, so the cache is flushed whenever modules load.
+  typename KeyHasher<swift::ASTContext *, lldb::addr_t,
+                     swift::TypeBase *>::MapType m_dynamic_types;
+  DynamicTypeCacheStatistics m_dynamic_types_stats;
+  /// Dynamic types are resolved by formatters and the expression
+  /// evaluator alike, possibly on different threads.
+  mutable std::mutex m_dynamic_types_mutex;
+
   /// Cached member variable offsets.
   typename KeyHasher<const swift::TypeBase *, const char *, uint64_t>::MapType
     m_member_offsets;
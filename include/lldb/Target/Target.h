@@ -25,6 +25,7 @@
 #include "Plugins/ExpressionParser/Clang/ClangPersistentVariables.h"
 #include "lldb/Breakpoint/BreakpointList.h"
 #include "lldb/Breakpoint/BreakpointName.h"
+#include "lldb/Breakpoint/FunctionLookupCache.h"
 #include "lldb/Breakpoint/WatchpointList.h"
 #include "lldb/Core/Architecture.h"
 #include "lldb/Core/Broadcaster.h"
@@ -105,6 +106,8 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -150,6 +153,10 @@ public:
 
   bool GetSwiftCreateModuleContextsInParallel() const;
 
+  bool GetUseInterpreterBytecode() const;
+
+  bool GetBatchMaterialization() const;
+
   bool GetEnableAutoImportClangModules() const;
 
   bool GetUseAllCompilerFlags() const;
@@ -160,6 +167,8 @@ public:
 
   bool GetEnableSaveObjects() const;
 
+  FileSpec GetExpressionCachePath() const;
+
   bool GetEnableSyntheticValue() const;
 
   uint32_t GetMaximumNumberOfChildrenToDisplay() const;
@@ -835,6 +844,11 @@ public:
 
   void SymbolsDidLoad(ModuleList &module_list);
 
+  // Lookups that breakpoints resolving against newly loaded modules share.
+  FunctionLookupCache &GetFunctionLookupCache() {
+    return m_function_lookup_cache;
+  }
+
   void ClearModules(bool delete_locations);
 
   //------------------------------------------------------------------
@@ -1370,6 +1384,11 @@ public:
   /// has not already been displayed.
   bool RegisterSwiftContextMessageKey(std::string Key);
 
+  // Resolve all breakpoints against newly loaded modules, sharing their
+  // function lookups, and log how long it took.
+  void ResolveBreakpointsInLoadedModules(ModuleList &module_list,
+                                         const char *reason);
+
 protected:
   //------------------------------------------------------------------
   /// Implementing of ModuleList::Notifier.
@@ -1413,6 +1432,7 @@ protected:
   BreakpointList m_internal_breakpoint_list;
   using BreakpointNameList = std::map<ConstString, BreakpointName *>;
   BreakpointNameList m_breakpoint_names;
+  FunctionLookupCache m_function_lookup_cache;
   
   lldb::BreakpointSP m_last_created_breakpoint;
   WatchpointList m_watchpoint_list;
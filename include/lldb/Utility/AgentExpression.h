@@ -0,0 +1,176 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_AgentExpression_h_
+#define liblldb_AgentExpression_h_
+
+#include "lldb/Utility/Status.h"
+#include "lldb/lldb-types.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class AgentExpression AgentExpression.h
+/// "lldb/Utility/AgentExpression.h"
+/// A small stack machine program in the GDB remote protocol "agent
+/// expression" bytecode format.
+///
+/// Agent expressions are what a debugger sends along with a Z0 packet to
+/// have the stub evaluate a breakpoint condition itself, so that a hit
+/// whose condition is false never has to be reported.  Only the integer
+/// subset of the bytecode is supported: constants, registers, memory
+/// references, arithmetic, comparisons and jumps.  All operands in the
+/// bytecode are big endian, as the GDB documentation specifies.
+///
+/// The same class is used to build an expression on the debugger side and
+/// to evaluate it in the stub, where register and memory accesses go
+/// through an AgentExpression::Context.
+//----------------------------------------------------------------------
+class AgentExpression {
+public:
+  enum Opcode : uint8_t {
+    eOpAdd = 0x02,
+    eOpSub = 0x03,
+    eOpMul = 0x04,
+    eOpDivSigned = 0x05,
+    eOpDivUnsigned = 0x06,
+    eOpRemSigned = 0x07,
+    eOpRemUnsigned = 0x08,
+    eOpLsh = 0x09,
+    eOpRshSigned = 0x0a,
+    eOpRshUnsigned = 0x0b,
+    eOpLogNot = 0x0e,
+    eOpBitAnd = 0x0f,
+    eOpBitOr = 0x10,
+    eOpBitXor = 0x11,
+    eOpBitNot = 0x12,
+    eOpEqual = 0x13,
+    eOpLessSigned = 0x14,
+    eOpLessUnsigned = 0x15,
+    eOpExt = 0x16,
+    eOpRef8 = 0x17,
+    eOpRef16 = 0x18,
+    eOpRef32 = 0x19,
+    eOpRef64 = 0x1a,
+    eOpIfGoto = 0x20,
+    eOpGoto = 0x21,
+    eOpConst8 = 0x22,
+    eOpConst16 = 0x23,
+    eOpConst32 = 0x24,
+    eOpConst64 = 0x25,
+    eOpReg = 0x26,
+    eOpEnd = 0x27,
+    eOpDup = 0x28,
+    eOpPop = 0x29,
+    eOpZeroExt = 0x2a,
+    eOpSwap = 0x2b
+  };
+
+  //------------------------------------------------------------------
+  /// Register and memory access for Evaluate().  Registers are
+  /// identified by the number the consumer of the expression uses for
+  /// them; for lldb-server that is its own register index.
+  //------------------------------------------------------------------
+  class Context {
+  public:
+    virtual ~Context() = default;
+
+    virtual bool ReadRegister(uint32_t reg_num, uint64_t &value) = 0;
+
+    // Read an unsigned integer of \a byte_size bytes at \a addr in the
+    // byte order of the target.
+    virtual bool ReadUnsigned(lldb::addr_t addr, size_t byte_size,
+                              uint64_t &value) = 0;
+  };
+
+  // Evaluation gives up after this many instructions, so a malformed
+  // expression with a backward jump can't hang the stub.
+  static constexpr size_t kMaxSteps = 4096;
+
+  // The largest value stack an expression may use.
+  static constexpr size_t kMaxStackDepth = 64;
+
+  AgentExpression() = default;
+
+  AgentExpression(llvm::ArrayRef<uint8_t> bytes)
+      : m_bytes(bytes.begin(), bytes.end()) {}
+
+  llvm::ArrayRef<uint8_t> GetBytes() const { return m_bytes; }
+
+  bool IsEmpty() const { return m_bytes.empty(); }
+
+  bool operator==(const AgentExpression &rhs) const {
+    return m_bytes == rhs.m_bytes;
+  }
+
+  bool operator!=(const AgentExpression &rhs) const { return !(*this == rhs); }
+
+  void Clear() { m_bytes.clear(); }
+
+  //------------------------------------------------------------------
+  // Building expressions
+  //------------------------------------------------------------------
+  void AppendOpcode(Opcode op) { m_bytes.push_back(op); }
+
+  // Push \a value using the smallest constant opcode that can hold it.
+  void AppendConstant(uint64_t value);
+
+  void AppendRegister(uint16_t reg_num);
+
+  // Replace the address on top of the stack by the zero extended
+  // \a byte_size byte value stored there.  Returns false if \a byte_size
+  // isn't 1, 2, 4 or 8.
+  bool AppendDereference(size_t byte_size);
+
+  void AppendSignExtend(uint8_t bits);
+
+  void AppendZeroExtend(uint8_t bits);
+
+  // Append a goto or if_goto whose destination isn't known yet and return
+  // the offset to hand to PatchJump() once it is.
+  size_t AppendJump(Opcode op);
+
+  void PatchJump(size_t jump_offset, size_t destination);
+
+  size_t GetCurrentOffset() const { return m_bytes.size(); }
+
+  // Append every instruction of \a rhs except a trailing eOpEnd, adjusting
+  // its jump destinations so they still point into the copied code.
+  void AppendExpression(const AgentExpression &rhs);
+
+  //------------------------------------------------------------------
+  /// Run the expression and return the value left on top of the stack.
+  ///
+  /// @param[in] context
+  ///     Provides register and memory reads.
+  ///
+  /// @param[out] result
+  ///     The top of the stack when eOpEnd is reached.
+  ///
+  /// @return
+  ///     An error if the bytecode is malformed, uses an unsupported
+  ///     opcode, divides by zero or a register or memory read fails.
+  //------------------------------------------------------------------
+  Status Evaluate(Context &context, uint64_t &result) const;
+
+private:
+  void AppendBigEndian(uint64_t value, size_t byte_size);
+
+  std::vector<uint8_t> m_bytes;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_AgentExpression_h_
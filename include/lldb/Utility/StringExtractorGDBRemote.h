@@ -108,6 +108,7 @@ public:
     eServerPacketType_QSetEnableAsyncProfiling,
     eServerPacketType_QSyncThreadState,
     eServerPacketType_QThreadSuffixSupported,
+    eServerPacketType_QTracepoint,
 
     eServerPacketType_jThreadsInfo,
     eServerPacketType_qsThreadInfo,
@@ -126,12 +127,14 @@ public:
     eServerPacketType_qSyncThreadStateSupported,
     eServerPacketType_qThreadExtraInfo,
     eServerPacketType_qThreadStopInfo,
+    eServerPacketType_qTracepointBuffer,
     eServerPacketType_qVAttachOrWaitSupported,
     eServerPacketType_qWatchpointSupportInfo,
     eServerPacketType_qWatchpointSupportInfoSupported,
     eServerPacketType_qXfer_auxv_read,
 
     eServerPacketType_jSignalsInfo,
+    eServerPacketType_jMemoryRegions,
     eServerPacketType_jModulesInfo,
 
     eServerPacketType_vAttach,
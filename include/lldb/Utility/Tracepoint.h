@@ -0,0 +1,170 @@
+//===-- Tracepoint.h --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_Tracepoint_h_
+#define liblldb_Tracepoint_h_
+
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/lldb-defines.h"
+#include "lldb/lldb-enumerations.h"
+#include "lldb/lldb-types.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace lldb_private {
+
+struct TracepointRecord;
+
+//----------------------------------------------------------------------
+/// Register and memory access for collecting a tracepoint.  Registers are
+/// numbered as in AgentExpression::Context.
+//----------------------------------------------------------------------
+class TracepointContext : public AgentExpression::Context {
+public:
+  // Read the raw bytes of a register, in the byte order of the target.
+  virtual bool ReadRegisterBytes(uint32_t reg_num,
+                                 std::vector<uint8_t> &bytes) = 0;
+
+  virtual bool ReadMemory(lldb::addr_t addr, size_t size,
+                          std::vector<uint8_t> &bytes) = 0;
+
+  virtual lldb::ByteOrder GetByteOrder() = 0;
+};
+
+//----------------------------------------------------------------------
+/// One thing a tracepoint collects each time it is hit.
+//----------------------------------------------------------------------
+struct TracepointAction {
+  enum Kind : uint8_t {
+    // The raw bytes of register \a reg_num.
+    eKindRegister = 'R',
+    // The value \a expr leaves on the stack, truncated to \a size bytes.
+    eKindValue = 'X',
+    // \a size bytes of memory at the address \a expr leaves on the stack.
+    eKindMemory = 'M'
+  };
+
+  // The most memory a single action may collect.
+  static constexpr uint32_t kMaxMemorySize = 4096;
+
+  Kind kind = eKindValue;
+  uint32_t reg_num = 0;
+  uint32_t size = 0;
+  AgentExpression expr;
+};
+
+//----------------------------------------------------------------------
+/// What to collect at one breakpoint location, and when.
+//----------------------------------------------------------------------
+struct TracepointSpec {
+  // Identifies the location the records belong to; the debugger packs the
+  // breakpoint and location IDs into it.
+  uint64_t id = 0;
+  // Only hits where this is true are recorded.  Empty means every hit.
+  AgentExpression condition;
+  std::vector<TracepointAction> actions;
+
+  // True if the condition is empty or true.  A condition that fails to
+  // evaluate records the hit as well, so the failure shows up somewhere.
+  bool ShouldCollect(AgentExpression::Context &context) const;
+
+  // Run the actions and replace the values of \a record with the results.
+  void Collect(TracepointContext &context, TracepointRecord &record) const;
+};
+
+//----------------------------------------------------------------------
+/// The data collected for one hit of a tracepoint.
+//----------------------------------------------------------------------
+struct TracepointRecord {
+  struct Value {
+    // False if the register or memory couldn't be read, or the expression
+    // failed to evaluate.
+    bool collected = false;
+    std::vector<uint8_t> bytes;
+  };
+
+  uint64_t id = 0;
+  lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+  lldb::addr_t pc = LLDB_INVALID_ADDRESS;
+  // One value per action of the spec, in the same order.
+  std::vector<Value> values;
+};
+
+//----------------------------------------------------------------------
+/// @class TracepointBuffer Tracepoint.h "lldb/Utility/Tracepoint.h"
+/// A bounded FIFO of tracepoint records.
+///
+/// lldb-server appends a record at every tracepoint hit without telling
+/// the client, and the client drains the buffer in bulk.  Once the buffer
+/// is full the oldest records are dropped to make room, and counted, so a
+/// hot tracepoint can never grow it without bound.
+///
+/// Records are kept in their wire encoding, which is also what Drain()
+/// returns: a little endian header of {u32 record size, u64 id, u64 tid,
+/// u64 pc, u32 value count}, then for each value a u32 byte count followed
+/// by the bytes.  A byte count of UINT32_MAX marks a value that couldn't be
+/// collected.
+//----------------------------------------------------------------------
+class TracepointBuffer {
+public:
+  static constexpr size_t kDefaultCapacity = 1024 * 1024;
+
+  explicit TracepointBuffer(size_t capacity = kDefaultCapacity)
+      : m_capacity(capacity) {}
+
+  void Append(const TracepointRecord &record);
+
+  //------------------------------------------------------------------
+  /// Remove whole records from the front of the buffer and append their
+  /// encoding to \a data.
+  ///
+  /// @param[in] max_bytes
+  ///     Stop before the encoded records exceed this many bytes.  At least
+  ///     one record is returned if the buffer isn't empty, so a record
+  ///     bigger than \a max_bytes can't get stuck.
+  ///
+  /// @return
+  ///     The number of records drained.
+  //------------------------------------------------------------------
+  size_t Drain(size_t max_bytes, std::vector<uint8_t> &data);
+
+  // Return the number of records dropped since the last call and reset it.
+  uint64_t TakeNumDropped();
+
+  size_t GetNumBytes() const;
+
+  bool IsEmpty() const { return GetNumBytes() == 0; }
+
+  void Clear();
+
+  static void Encode(const TracepointRecord &record,
+                     std::vector<uint8_t> &data);
+
+  // Decode the records in \a data, as returned by Drain(), and append them
+  // to \a records.  Returns false if \a data is malformed.
+  static bool Decode(llvm::ArrayRef<uint8_t> data,
+                     std::vector<TracepointRecord> &records);
+
+private:
+  mutable std::mutex m_mutex;
+  std::deque<std::vector<uint8_t>> m_records;
+  size_t m_num_bytes = 0;
+  size_t m_capacity;
+  uint64_t m_num_dropped = 0;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_Tracepoint_h_
@@ -0,0 +1,102 @@
+//===-- TrigramIndex.h ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_TrigramIndex_h_
+#define liblldb_TrigramIndex_h_
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace lldb_private {
+
+class RegularExpression;
+
+//----------------------------------------------------------------------
+/// @class TrigramIndex TrigramIndex.h "lldb/Utility/TrigramIndex.h"
+/// Find the names a regular expression matches without running it on
+/// every name.
+///
+/// Most regular expressions people use to look up symbols contain literal
+/// text that every match has to contain, like "Foo" in "^Foo::.*Bar$".
+/// The index maps every three character substring of every name to the
+/// names containing it, so the names that contain all trigrams of the
+/// literals can be found by intersecting a few sorted lists.  Only those
+/// candidates are then checked with the literals and the full regular
+/// expression.  Regular expressions without usable literals fall back to
+/// checking every name.
+///
+/// Names are given IDs in the order they are appended; they must outlive
+/// the index, which is the case for ConstStrings.
+//----------------------------------------------------------------------
+class TrigramIndex {
+public:
+  // Add \a name and return its ID.
+  uint32_t Append(llvm::StringRef name);
+
+  // Build the index.  Must be called after the last Append() and before
+  // the first Find().
+  void Finalize();
+
+  size_t GetSize() const { return m_names.size(); }
+
+  llvm::StringRef GetName(uint32_t id) const { return m_names[id]; }
+
+  // Append the IDs of the names \a regex matches to \a ids, in ascending
+  // order.
+  void Find(const RegularExpression &regex, std::vector<uint32_t> &ids) const;
+
+  //------------------------------------------------------------------
+  /// Get strings that every string \a regex matches must contain.
+  ///
+  /// The analysis is conservative: text that is optional, repeated,
+  /// inside a group, or part of an alternation isn't reported.
+  ///
+  /// @param[in] regex
+  ///     A POSIX extended regular expression, as RegularExpression
+  ///     compiles them.
+  ///
+  /// @param[out] literals
+  ///     The required strings, none of them empty.  Nothing is reported if
+  ///     the expression can't be analysed.
+  //------------------------------------------------------------------
+  static void GetRequiredLiterals(llvm::StringRef regex,
+                                  std::vector<std::string> &literals);
+
+  // True if \a name contains every string in \a literals.
+  static bool ContainsLiterals(llvm::StringRef name,
+                               llvm::ArrayRef<std::string> literals);
+
+private:
+  typedef uint32_t Trigram;
+
+  static Trigram MakeTrigram(const char *chars);
+
+  // Fill \a trigrams with the distinct trigrams of \a name, sorted.
+  static void GetTrigrams(llvm::StringRef name, std::vector<Trigram> &trigrams);
+
+  // Fill \a ids with the names containing every trigram of \a literals.
+  // Returns false if the literals are too short to have trigrams.
+  bool GetCandidates(llvm::ArrayRef<std::string> literals,
+                     std::vector<uint32_t> &ids) const;
+
+  std::vector<llvm::StringRef> m_names;
+  // The index proper, in compressed form: the name IDs of m_trigrams[i]
+  // are m_postings[m_offsets[i]] up to m_postings[m_offsets[i + 1]].
+  std::vector<Trigram> m_trigrams;
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_postings;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_TrigramIndex_h_
@@ -0,0 +1,78 @@
+"""
+Benchmark how many conditional breakpoint hits per second lldb handles.
+"""
+
+from __future__ import print_function
+
+
+import os
+import time
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkConditions(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # Must match the loop count in main.cpp.
+    iterations = 2000
+
+    # Too much for the simple condition compiler, but parsed only once and
+    # then interpreted on every hit.
+    interpreted_condition = (
+        "({ unsigned n = 0; for (int k = 0; k < 64; ++k) "
+        "n += counter->flags; n; }) == 1000")
+
+    @benchmarks_test
+    def test_run_command(self):
+        """Benchmark hits per second of a conditional breakpoint"""
+        self.build()
+        # A condition the fast path compiles, and one that only the
+        # expression parser can handle.
+        self.run_to_end("i == -1 && counter->flags != 7")
+        self.run_to_end("(i == -1) != (int)(counter->flags == 7.5)")
+
+    @benchmarks_test
+    def test_interpreter_bytecode(self):
+        """Benchmark an interpreted condition with and without bytecode"""
+        self.build()
+        self.addTearDownHook(
+            lambda: self.runCmd(
+                "settings clear target.experimental.use-interpreter-bytecode"))
+        for use_bytecode in ["true", "false"]:
+            self.runCmd(
+                "settings set target.experimental.use-interpreter-bytecode " +
+                use_bytecode)
+            print("use-interpreter-bytecode %s" % use_bytecode)
+            self.run_to_end(self.interpreted_condition)
+
+    def setUp(self):
+        # Call super's setUp().
+        BenchBase.setUp(self)
+
+    def run_to_end(self, condition):
+        """Continue past every false hit of 'condition' to the end"""
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "break here", lldb.SBFileSpec("main.cpp"))
+        bkpt.SetCondition(condition)
+        target.BreakpointCreateBySourceRegex(
+            "// done", lldb.SBFileSpec("main.cpp"))
+
+        sw = Stopwatch()
+        with sw:
+            process = target.LaunchSimple(
+                None, None, self.get_process_working_directory())
+            self.assertTrue(process, PROCESS_IS_VALID)
+        self.assertEqual(bkpt.GetHitCount(), 0)
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+        process.Kill()
+
+        print("%s: %.0f hits/s (%s)" %
+              (condition, self.iterations / sw.avg(), sw))
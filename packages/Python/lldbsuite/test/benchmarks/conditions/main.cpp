@@ -0,0 +1,21 @@
+struct Counter {
+    int count;
+    unsigned flags;
+};
+
+static const int iterations = 2000;
+
+static void
+update(Counter *counter, int i)
+{
+    counter->count = i;
+    counter->flags = i % 3; // break here
+}
+
+int main()
+{
+    Counter counter = { 0, 0 };
+    for (int i = 0; i < iterations; ++i)
+        update(&counter, i);
+    return counter.count; // done
+}
@@ -110,6 +110,12 @@ class DisassembleDriverMainLoop(BenchBase):
             child.sendline('next')
             child.expect_exact(prompt)
 
+        # Each read served from an object file is a trip to the process saved.
+        child.sendline('process status --statistics')
+        child.expect('Reads from object files: ([0-9]+)')
+        object_file_reads = int(child.match.group(1))
+        child.expect_exact(prompt)
+
         child.sendline('quit')
         try:
             self.child.expect(pexpect.EOF)
@@ -117,6 +123,7 @@ class DisassembleDriverMainLoop(BenchBase):
             pass
 
         self.lldb_avg = self.stopwatch.avg()
+        print("lldb reads from object files:", object_file_reads)
         if self.TraceOn():
             print("lldb disassembly benchmark:", str(self.stopwatch))
         self.child = None
@@ -0,0 +1,66 @@
+"""
+Benchmark resolving "breakpoint set --func-regex" for common patterns in
+a large binary: lldb itself, or the executable LLDB_EXEC points at.
+"""
+
+from __future__ import print_function
+
+
+import os
+import lldb
+from lldbsuite.test import configuration
+from lldbsuite.test import lldbtest_config
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+
+
+class TestBenchmarkRegexBreakpoints(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # Literal names, prefixes, suffixes, C++ and Objective-C methods, and
+    # patterns without any literal text for the index to use.
+    patterns = [
+        "^main$",
+        "Process::Resume",
+        "^lldb_private::Target::",
+        "::GetName\\(",
+        "Create.*Breakpoint",
+        "std::vector<.*>::push_back",
+        "_ZN4llvm",
+        "^-\\[NS.* init",
+        "[Ss]et[A-Z][a-z]*Value",
+        "(Read|Write)Memory$",
+        ".",
+    ]
+
+    count = 5
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.exe = lldbtest_config.lldbExec
+
+    @benchmarks_test
+    @no_debug_info_test
+    def test_regex_breakpoints(self):
+        """Benchmark setting breakpoints by function regex"""
+        print()
+        print("exe: %s" % self.exe)
+        for pattern in self.patterns:
+            self.run_regex_breakpoint(pattern)
+
+    def run_regex_breakpoint(self, pattern):
+        sw = Stopwatch()
+        num_locations = 0
+        for i in range(self.count):
+            # A fresh target each time, but the modules stay in the shared
+            # module cache.  The first round also builds the indexes.
+            target = self.dbg.CreateTarget(self.exe)
+            self.assertTrue(target, VALID_TARGET)
+            with sw:
+                bkpt = target.BreakpointCreateByRegex(pattern)
+            num_locations = bkpt.GetNumLocations()
+            self.dbg.DeleteTarget(target)
+
+        print("%-32s %6d locations, %s" % (pattern, num_locations, sw))
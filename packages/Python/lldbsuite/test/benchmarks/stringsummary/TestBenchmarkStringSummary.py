@@ -0,0 +1,66 @@
+"""
+Benchmark the rendering of very long C string summaries.
+"""
+
+from __future__ import print_function
+
+
+import os
+import time
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkStringSummary(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @benchmarks_test
+    def test_run_command(self):
+        """Benchmark the summary of 1 MB char * strings"""
+        self.build()
+        self.data_formatter_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        BenchBase.setUp(self)
+
+    def data_formatter_commands(self):
+        """Benchmark the summary of 1 MB char * strings"""
+        self.runCmd("file " + self.getBuildArtifact("a.out"),
+                    CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_source_regexp(self, "break here")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+                    substrs=['stopped',
+                             'stop reason = breakpoint'])
+
+        def cleanup():
+            self.runCmd(
+                "settings clear target.max-string-summary-length",
+                check=False)
+
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        self.runCmd(
+            "settings set target.max-string-summary-length %d" %
+            (2 * 1024 * 1024))
+
+        # Read the memory once so that both measurements below time the
+        # rendering rather than the first trip to the inferior.
+        self.runCmd("memory read -f x -c 1 plain_ptr")
+
+        for name in ['plain_ptr', 'mixed_ptr']:
+            sw = Stopwatch()
+            for i in range(5):
+                with sw:
+                    self.runCmd('frame variable ' + name)
+            print("%s: %s" % (name, sw))
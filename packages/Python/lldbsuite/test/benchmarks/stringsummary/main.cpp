@@ -0,0 +1,15 @@
+#include <string.h>
+
+static char plain[1024 * 1024 + 1];
+static char mixed[1024 * 1024 + 1];
+
+int main()
+{
+    memset(plain, 'a', sizeof(plain) - 1);
+    memset(mixed, 'b', sizeof(mixed) - 1);
+    for (unsigned i = 0; i < sizeof(mixed) - 1; i += 64)
+        mixed[i] = '\n';
+    const char *plain_ptr = plain;
+    const char *mixed_ptr = mixed;
+    return plain_ptr[0] + mixed_ptr[0]; // break here
+}
@@ -0,0 +1,81 @@
+# coding=utf-8
+
+# TestBenchmarkSwiftExpression.py
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ------------------------------------------------------------------------------
+
+"""
+Benchmark the latency of Swift expressions, before and after the scratch
+context has imported the program's modules.
+"""
+
+from __future__ import print_function
+
+
+import os
+import time
+import lldb
+from lldbsuite.test.lldbbench import *
+import lldbsuite.test.decorators as decorators
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class TestBenchmarkSwiftExpression(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # How many expressions to time once the modules are imported.
+    count = 20
+
+    @decorators.benchmarks_test
+    def test_run_command(self):
+        """Benchmark time to first and subsequent po"""
+        self.build()
+        self.expression_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        BenchBase.setUp(self)
+
+    def run_to_breakpoint(self):
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+                    substrs=['stopped',
+                             'stop reason = breakpoint'])
+
+    def expression_commands(self):
+        """Benchmark time to first and subsequent po"""
+        self.runCmd("file " + self.getBuildArtifact("a.out"),
+                    CURRENT_EXECUTABLE_SET)
+        lldbutil.run_break_set_by_source_regexp(self, "break here")
+        self.run_to_breakpoint()
+
+        first = Stopwatch()
+        with first:
+            self.expect("po points[3]", substrs=['x : 3', 'y : 6'])
+
+        subsequent = Stopwatch()
+        for i in range(self.count):
+            with subsequent:
+                self.expect("po names[%d]" % (i % 16),
+                            substrs=['point %d' % (i % 16)])
+
+        # Running again keeps the imported modules, so the first
+        # expression of the new process shouldn't pay for them again.
+        self.runCmd("process kill")
+        self.run_to_breakpoint()
+        rerun = Stopwatch()
+        with rerun:
+            self.expect("po points[3]", substrs=['x : 3', 'y : 6'])
+
+        print("time to first po: %s" % first)
+        print("time to subsequent po: %s" % subsequent)
+        print("time to first po after re-run: %s" % rerun)
@@ -0,0 +1,14 @@
+import Foundation
+
+struct Point {
+    var x: Int
+    var y: Int
+}
+
+func main() -> Int {
+    let points = (0..<16).map { Point(x: $0, y: $0 * 2) }
+    let names = points.map { "point \($0.x)" }
+    return points.count + names.count // break here
+}
+
+print(main())
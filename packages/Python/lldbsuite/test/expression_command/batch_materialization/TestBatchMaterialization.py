@@ -0,0 +1,53 @@
+"""
+Test that target.experimental.batch-materialization writes the argument
+struct of an expression to the process with a single write.
+"""
+
+from __future__ import print_function
+
+import re
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class BatchMaterializationTestCase(TestBase):
+    mydir = TestBase.compute_mydir(__file__)
+
+    def count_writes(self, frame, batch):
+        """Evaluate an expression using four locals, and return how many
+        process writes materializing its arguments took"""
+        self.runCmd("settings set target.experimental.batch-materialization " +
+                    ("true" if batch else "false"))
+        value = frame.EvaluateExpression("a + b + c + d")
+        self.assertTrue(value.GetError().Success(), value.GetError())
+        self.assertEqual(value.GetValueAsSigned(), 10)
+
+        with open(self.log, "r") as f:
+            counts = re.findall(
+                r"materialized with (\d+) process reads and (\d+) process "
+                r"writes", f.read())
+        self.assertTrue(counts, "Materialization was logged")
+        return int(counts[-1][1])
+
+    def test_batch_materialization(self):
+        self.build()
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.c"))
+        frame = thread.frames[0]
+
+        self.log = self.getBuildArtifact("expression.log")
+        self.runCmd("log enable -f %s lldb expr" % self.log)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.batch-materialization"))
+
+        # Each variable's address is written into the struct separately...
+        unbatched_writes = self.count_writes(frame, False)
+        self.assertTrue(unbatched_writes >= 4,
+                        "%d writes without batching" % unbatched_writes)
+
+        # ...unless the struct is filled in on the host and written at once.
+        batched_writes = self.count_writes(frame, True)
+        self.assertEqual(batched_writes, 1)
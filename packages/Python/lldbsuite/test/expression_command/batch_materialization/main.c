@@ -0,0 +1,7 @@
+int main(int argc, char const *argv[]) {
+  int a = argc;
+  int b = a + 1;
+  int c = b + 1;
+  int d = c + 1;
+  return a + b + c + d; // break here
+}
@@ -87,6 +87,69 @@ class IRInterpreterTestCase(TestBase):
                 "While evaluating " +
                 expression)
 
+    @add_test_categories(['pyapi'])
+    def test_bytecode_matches_interpreter(self):
+        """Test that the bytecode and the IRInterpreter agree on edge cases"""
+        self.build_and_run()
+
+        options = lldb.SBExpressionOptions()
+        options.SetLanguage(lldb.eLanguageTypeC_plus_plus)
+        options.SetAllowJIT(False)
+
+        set_up_expressions = ["int $zero = 0",
+                              "int $minus_one = -1",
+                              "int $min = -2147483647 - 1",
+                              "int $seven = 7",
+                              "int $neg = -7",
+                              "int $width = 32",
+                              "int $past = 33",
+                              "long long $lneg = -7",
+                              "long long $lwidth = 64"]
+
+        # Division by zero isn't defined in C, but both interpreters give 0
+        # rather than failing the expression.  So do shifts by the width of
+        # the type or more, except that arithmetic shifts fill with the sign.
+        expressions = [("$seven / $zero", 0),
+                       ("$neg % $zero", 0),
+                       ("(unsigned)$seven / (unsigned)$zero", 0),
+                       ("(unsigned)$neg % (unsigned)$zero", 0),
+                       ("$min / $minus_one", -2147483648),
+                       ("$min % $minus_one", 0),
+                       ("$seven << $width", 0),
+                       ("$seven << $past", 0),
+                       ("$lneg << $lwidth", 0),
+                       ("(unsigned)$neg >> $width", 0),
+                       ("$neg >> $width", -1),
+                       ("$neg >> $past", -1),
+                       ("$lneg >> $lwidth", -1),
+                       ("$neg < $seven", 1),
+                       ("(unsigned)$neg < (unsigned)$seven", 0),
+                       ("$neg > $seven", 0),
+                       ("(unsigned)$neg > (unsigned)$seven", 1)]
+
+        for expression in set_up_expressions:
+            self.frame().EvaluateExpression(expression, options)
+
+        def evaluate(expression, use_bytecode):
+            self.runCmd(
+                "settings set target.experimental.use-interpreter-bytecode %s" %
+                ("true" if use_bytecode else "false"))
+            value = self.frame().EvaluateExpression(expression, options)
+            self.assertTrue(value.GetError().Success(),
+                            "While evaluating " + expression)
+            return value.GetValueAsSigned()
+
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.experimental.use-interpreter-bytecode"))
+
+        for expression, expected in expressions:
+            bytecode_result = evaluate(expression, True)
+            interp_result = evaluate(expression, False)
+            self.assertEqual(bytecode_result, interp_result,
+                             "While evaluating " + expression)
+            self.assertEqual(bytecode_result, expected,
+                             "While evaluating " + expression)
+
     def test_type_conversions(self):
         target = self.dbg.GetDummyTarget()
         short_val = target.EvaluateExpression("(short)-1")
@@ -0,0 +1,54 @@
+"""
+Test that target.expression-cache-path keeps the object code of an
+expression for the next debug session.
+"""
+
+from __future__ import print_function
+
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ExpressionObjectCacheTestCase(TestBase):
+    mydir = TestBase.compute_mydir(__file__)
+
+    def read_log(self):
+        with open(self.log, "r") as f:
+            return f.read()
+
+    def evaluate_in_new_session(self):
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.c"))
+        options = lldb.SBExpressionOptions()
+        options.SetAllowJIT(True)
+        value = thread.frames[0].EvaluateExpression("square(7) + 1", options)
+        self.assertTrue(value.GetError().Success(), value.GetError())
+        self.assertEqual(value.GetValueAsSigned(), 50)
+        process.Kill()
+
+    @expectedFailureAll(oslist=["windows"])
+    def test_object_cache(self):
+        self.build()
+        cache = self.getBuildArtifact("expression-cache")
+        self.log = self.getBuildArtifact("expression.log")
+        self.runCmd("settings set target.expression-cache-path " + cache)
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.expression-cache-path"))
+        self.runCmd("log enable -f %s lldb expr" % self.log)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb expr"))
+
+        self.evaluate_in_new_session()
+        log = self.read_log()
+        self.assertTrue("Expression object cache miss" in log)
+        self.assertFalse("Expression object cache hit" in log)
+        self.assertTrue(any(f.startswith("llvmcache-")
+                            for f in os.listdir(cache)))
+
+        # The same expression in the next session is loaded from the cache,
+        # and gives the same result.
+        self.evaluate_in_new_session()
+        log = self.read_log()
+        self.assertTrue("Expression object cache hit" in log)
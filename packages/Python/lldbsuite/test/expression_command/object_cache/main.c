@@ -0,0 +1,5 @@
+int square(int x) { return x * x; }
+
+int main(int argc, char const *argv[]) {
+  return square(argc); // break here
+}
@@ -0,0 +1,82 @@
+"""
+Test that breakpoints resolved while a shared library loads, which share
+their function lookups, get the same locations as breakpoints set after
+it has loaded.
+"""
+
+from __future__ import print_function
+
+import re
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class BatchedModuleResolutionTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    # Several breakpoints on the same names, so the lookups are shared.
+    breakpoints = [("Area", lldb.eFunctionNameTypeAuto),
+                   ("Area", lldb.eFunctionNameTypeAuto),
+                   ("Area", lldb.eFunctionNameTypeMethod),
+                   ("Area", lldb.eFunctionNameTypeBase),
+                   ("Area", lldb.eFunctionNameTypeFull),
+                   ("Square::Area", lldb.eFunctionNameTypeAuto),
+                   ("geometry::Area", lldb.eFunctionNameTypeFull),
+                   ("Scale", lldb.eFunctionNameTypeMethod)]
+
+    def locations(self, bkpt):
+        return sorted((loc.GetLoadAddress(),
+                       loc.GetAddress().GetFunction().GetName())
+                      for loc in bkpt)
+
+    def create_breakpoints(self, target):
+        return [target.BreakpointCreateByName(name, mask,
+                                              lldb.SBFileSpecList(),
+                                              lldb.SBFileSpecList())
+                for (name, mask) in self.breakpoints]
+
+    @skipIfWindows
+    def test_batched_module_resolution(self):
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        log = self.getBuildArtifact("breakpoints.log")
+        self.runCmd("log enable -f %s lldb break" % log)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb break"))
+
+        # Leave the library out of the target, so that the breakpoints are
+        # resolved against it only when it loads.
+        error = lldb.SBError()
+        target = self.dbg.CreateTarget(exe, None, None, False, error)
+        self.assertTrue(target, VALID_TARGET)
+        batched = self.create_breakpoints(target)
+        for bkpt in batched:
+            self.assertEqual(bkpt.GetNumLocations(), 0)
+
+        main_bkpt = target.BreakpointCreateBySourceRegex(
+            "break here", lldb.SBFileSpec("main.cpp"))
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process,
+                                                             main_bkpt)
+        self.assertEqual(len(threads), 1)
+
+        with open(log, "r") as f:
+            reused = [int(n) for n in re.findall(
+                r"ModulesDidLoad: resolved breakpoints .* (\d+) reused",
+                f.read())]
+        self.assertTrue(any(n > 0 for n in reused),
+                        "Lookups were shared while the library loaded")
+
+        # Breakpoints set now resolve without the lookup cache.
+        direct = self.create_breakpoints(target)
+        for (name, mask), cached, uncached in zip(self.breakpoints, batched,
+                                                  direct):
+            self.assertTrue(uncached.GetNumLocations() > 0,
+                            "%s has locations" % name)
+            self.assertEqual(self.locations(cached), self.locations(uncached),
+                             "Locations of %s (name type mask %d)" %
+                             (name, mask))
@@ -0,0 +1,11 @@
+#include "shapes.h"
+
+int main(int argc, char const *argv[]) {
+  Square square = {argc};
+  Circle circle = {argc};
+  int total = 0; // break here
+  square.Scale(2);
+  total += square.Area() + circle.Area();
+  total += Area(argc) + geometry::Area(argc, 2);
+  return total;
+}
@@ -0,0 +1,11 @@
+#include "shapes.h"
+
+int Square::Area() const { return side * side; }
+
+void Square::Scale(int factor) { side *= factor; }
+
+int Circle::Area() const { return 3 * radius * radius; }
+
+int Area(int side) { return side * side; }
+
+int geometry::Area(int width, int height) { return width * height; }
@@ -0,0 +1,16 @@
+struct LLDB_TEST_API Square {
+  int side;
+  int Area() const;
+  void Scale(int factor);
+};
+
+struct LLDB_TEST_API Circle {
+  int radius;
+  int Area() const;
+};
+
+LLDB_TEST_API int Area(int side);
+
+namespace geometry {
+LLDB_TEST_API int Area(int width, int height);
+}
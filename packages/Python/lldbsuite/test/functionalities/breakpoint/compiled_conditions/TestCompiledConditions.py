@@ -0,0 +1,87 @@
+"""
+Test which breakpoint conditions lldb evaluates without the expression
+parser, and that they stop in the same places as parsed ones.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class CompiledConditionsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    COMPILED = "Compiled condition evaluated"
+    PARSED = "needs the expression parser"
+
+    def run_with_condition(self, marker, condition):
+        """Run to the line with marker, stopping only when condition holds.
+        Returns the stopped frame and the breakpoint log."""
+        self.build()
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+
+        log = self.getBuildArtifact("breakpoints.log")
+        self.runCmd("log enable -f %s lldb break" % log)
+        self.addTearDownHook(lambda: self.runCmd("log disable lldb break"))
+
+        bkpt = target.BreakpointCreateBySourceRegex(
+            marker, lldb.SBFileSpec("main.cpp"))
+        self.assertTrue(bkpt.GetNumLocations() == 1, VALID_BREAKPOINT)
+        bkpt.SetCondition(condition)
+
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        threads = lldbutil.get_threads_stopped_at_breakpoint(process, bkpt)
+        self.assertEqual(len(threads), 1, "stopped at " + condition)
+        self.assertEqual(bkpt.GetHitCount(), 1)
+
+        self.runCmd("log disable lldb break")
+        with open(log, "r") as f:
+            return threads[0].GetFrameAtIndex(0), f.read()
+
+    def test_local(self):
+        """A condition on a local variable is compiled."""
+        frame, log = self.run_with_condition("break in function",
+                                             "local == 8")
+        self.assertEqual(frame.FindVariable("n").GetValueAsSigned(), 4)
+        self.assertTrue(self.COMPILED in log)
+        self.assertFalse(self.PARSED in log)
+
+    def test_global(self):
+        """A global outside of any method is compiled too."""
+        frame, log = self.run_with_condition("break in function",
+                                             "local > g_limit * 4")
+        self.assertEqual(frame.FindVariable("n").GetValueAsSigned(), 7)
+        self.assertTrue(self.COMPILED in log)
+        self.assertFalse(self.PARSED in log)
+
+    def test_member_shadows_global(self):
+        """In a method, an unqualified name is left to the expression
+        parser, which finds the member rather than the global."""
+        frame, log = self.run_with_condition("break in method", "count == 5")
+        self.assertEqual(frame.EvaluateExpression("this->count")
+                         .GetValueAsSigned(), 5)
+        self.assertTrue("may be a member of the method's class" in log)
+        self.assertFalse(self.COMPILED in log)
+
+        # Through "this" the member is a plain data member access.
+        frame, log = self.run_with_condition("break in method",
+                                             "this->count == 5")
+        self.assertEqual(frame.EvaluateExpression("this->count")
+                         .GetValueAsSigned(), 5)
+        self.assertTrue(self.COMPILED in log)
+
+    def test_unsupported_expression(self):
+        """Conditions outside of the compiled grammar are still parsed."""
+        frame, log = self.run_with_condition("break in function",
+                                             "local + 0.5 > 8.0")
+        self.assertEqual(frame.FindVariable("n").GetValueAsSigned(), 4)
+        self.assertTrue(self.PARSED in log)
+        self.assertFalse(self.COMPILED in log)
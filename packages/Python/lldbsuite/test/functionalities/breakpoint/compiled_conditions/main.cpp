@@ -0,0 +1,26 @@
+int count = 100;
+int g_limit = 3;
+
+struct Counter {
+  int count;
+
+  int Step(int n) {
+    count += n;
+    return count; // break in method
+  }
+};
+
+int Twice(int n) {
+  int local = n * 2;
+  return local; // break in function
+}
+
+int main() {
+  Counter counter = {0};
+  int total = 0;
+  for (int i = 0; i < 10; ++i) {
+    total += Twice(i);
+    total += counter.Step(1);
+  }
+  return total + count;
+}
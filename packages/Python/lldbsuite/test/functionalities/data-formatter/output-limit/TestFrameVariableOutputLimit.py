@@ -0,0 +1,123 @@
+"""
+Test that frame variable --output-limit stops printing children once the
+limit is reached and that --continue resumes where the last print stopped.
+"""
+
+from __future__ import print_function
+
+
+import re
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class FrameVariableOutputLimitTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def child_indexes(self, output):
+        return [int(i) for i in re.findall(r"^\s*\[(\d+)\] = ", output,
+                                           re.MULTILINE)]
+
+    def top_level_indexes(self, output):
+        return [int(i) for i in re.findall(r"^  \[(\d+)\] = ", output,
+                                           re.MULTILINE)]
+
+    def run_command(self, command):
+        result = lldb.SBCommandReturnObject()
+        self.dbg.GetCommandInterpreter().HandleCommand(command, result)
+        self.assertTrue(result.Succeeded(), command)
+        return result.GetOutput()
+
+    def test_output_limit(self):
+        """Test that printing stops at the limit and resumes after it."""
+        self.build()
+        lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+
+        first = self.run_command("frame variable --output-limit 100 numbers")
+        first_indexes = self.child_indexes(first)
+        self.assertTrue(len(first_indexes) > 0)
+        self.assertTrue(len(first_indexes) < 20)
+        self.assertEqual(first_indexes, list(range(len(first_indexes))))
+        self.assertTrue("..." in first)
+        self.assertTrue("frame variable --continue numbers" in first)
+
+        # The next page starts at the first child that was left out, and
+        # keeps the limit of the first print.
+        second = self.run_command("frame variable --continue numbers")
+        second_indexes = self.child_indexes(second)
+        self.assertTrue(len(second_indexes) > 0)
+        self.assertTrue(len(second_indexes) < 20)
+        self.assertEqual(second_indexes[0], first_indexes[-1] + 1)
+        self.assertEqual(
+            second_indexes,
+            list(range(second_indexes[0],
+                       second_indexes[0] + len(second_indexes))))
+        self.assertTrue("[%d] = %d" % (second_indexes[0],
+                                       second_indexes[0] * 2) in second)
+
+        # A larger limit on the continued print takes over.
+        third = self.run_command(
+            "frame variable --continue --output-limit 100000 numbers")
+        third_indexes = self.child_indexes(third)
+        self.assertEqual(third_indexes[0], second_indexes[-1] + 1)
+
+        # Without a limit the output is the same as it always was.
+        self.expect("frame variable numbers", substrs=["[0] = 0", "[255] = 510"])
+        self.expect("frame variable numbers", matching=False,
+                    substrs=["--continue"])
+
+    def test_output_limit_nested(self):
+        """Test that the limit is shared with the children's children."""
+        self.build()
+        lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+
+        first = self.run_command("frame variable --output-limit 200 points")
+        first_indexes = self.child_indexes(first)
+        self.assertTrue(len(first_indexes) > 0)
+        self.assertTrue(len(first_indexes) < 20)
+
+        # A point whose one-line summary was cut short is printed again.
+        last = first_indexes[-1]
+        cut = re.search(r"\[%d\] = \([^)]*\.\.\.\)" % last, first)
+        second = self.run_command("frame variable --continue points")
+        second_indexes = self.child_indexes(second)
+        self.assertEqual(second_indexes[0], last if cut else last + 1)
+        self.assertTrue("x = %d" % second_indexes[0] in second)
+
+    def test_output_limit_inside_child(self):
+        """Test that a child cut short is printed again by --continue."""
+        self.build()
+        lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+
+        # The limit runs out in the middle of rows[0].values.
+        first = self.run_command("frame variable --output-limit 200 rows")
+        self.assertEqual(self.top_level_indexes(first), [0])
+        self.assertTrue("[0] = 0" in first)
+        self.assertFalse("[49] = 49" in first)
+
+        second = self.run_command(
+            "frame variable --continue --output-limit 100000 rows")
+        self.assertEqual(self.top_level_indexes(second), list(range(10)))
+        self.assertTrue("[49] = 49" in second)
+
+    def test_continue_errors(self):
+        """Test --continue without an earlier partial print."""
+        self.build()
+        lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+
+        self.expect("frame variable --continue numbers", error=True,
+                    substrs=["no children of 'numbers' left to print"])
+        self.expect("frame variable --continue", error=True,
+                    substrs=["--continue takes exactly one variable path"])
+
+        # Everything fit, so there is nothing to continue.
+        self.run_command("frame variable --output-limit 100000 points")
+        self.expect("frame variable --continue points", error=True,
+                    substrs=["no children of 'points' left to print"])
@@ -0,0 +1,24 @@
+struct Point {
+  int x;
+  int y;
+};
+
+struct Row {
+  int values[50];
+};
+
+int main() {
+  int numbers[1000];
+  Point points[100];
+  Row rows[10];
+  for (int i = 0; i < 1000; ++i)
+    numbers[i] = i * 2;
+  for (int i = 0; i < 100; ++i) {
+    points[i].x = i;
+    points[i].y = -i;
+  }
+  for (int i = 0; i < 10; ++i)
+    for (int j = 0; j < 50; ++j)
+      rows[i].values[j] = i * 100 + j;
+  return numbers[999] + points[99].x + rows[9].values[49]; // break here
+}
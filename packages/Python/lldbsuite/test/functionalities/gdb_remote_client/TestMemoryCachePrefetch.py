@@ -0,0 +1,82 @@
+from __future__ import print_function
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test.decorators import *
+from gdbclientutils import *
+
+
+class TestMemoryCachePrefetch(GDBRemoteTestBase):
+
+    # Two readable pages, each with unreadable memory on either side.
+    FORWARD_PAGE = 0x2000
+    BACKWARD_PAGE = 0x5000
+    PAGE_SIZE = 0x1000
+
+    def setUp(self):
+        super(TestMemoryCachePrefetch, self).setUp()
+        self.runCmd("settings set target.process.memory-cache-line-size 512")
+        self.runCmd(
+            "settings set target.process.memory-cache-prefetch-size 4096")
+
+    def tearDown(self):
+        self.runCmd("settings clear target.process.memory-cache-line-size")
+        self.runCmd(
+            "settings clear target.process.memory-cache-prefetch-size")
+        super(TestMemoryCachePrefetch, self).tearDown()
+
+    @skipIfXmlSupportMissing
+    @skipIfRemote
+    def test(self):
+        """
+        Test that when a stub doesn't describe its memory regions and fails
+        a whole read that runs into unreadable memory, reading ahead of or
+        behind the line we need falls back to reading just that line.
+        """
+        pages = [self.FORWARD_PAGE, self.BACKWARD_PAGE]
+        page_size = self.PAGE_SIZE
+
+        class MyResponder(MockGDBServerResponder):
+
+            def qXferRead(self, obj, annex, offset, length):
+                if annex == "target.xml":
+                    return """<?xml version="1.0"?>
+                        <target version="1.0">
+                          <architecture>i386:x86-64</architecture>
+                          <feature name="org.gnu.gdb.i386.core">
+                            <reg name="rip" bitsize="64" regnum="0" type="code_ptr" group="general"/>
+                          </feature>
+                        </target>""", False
+                else:
+                    return None, False
+
+            def readMemory(self, addr, length):
+                for page in pages:
+                    if page <= addr and addr + length <= page + page_size:
+                        return "".join("%02x" % (b & 0xff)
+                                       for b in range(addr, addr + length))
+                return "E01"
+
+        self.server.responder = MyResponder()
+        self.dbg.SetDefaultArchitecture("x86_64")
+        target = self.dbg.CreateTargetWithFileAndArch(None, None)
+        process = self.connect(target)
+
+        def walk(page, offsets):
+            for offset in offsets:
+                error = lldb.SBError()
+                value = process.ReadUnsignedFromMemory(page + offset, 1, error)
+                self.assertTrue(error.Success(),
+                                "Read at 0x%x: %s" % (page + offset, error))
+                self.assertEqual(value, (page + offset) & 0xff)
+
+        # Each miss that picks up where the last one stopped reads twice as
+        # many lines, until the read ahead of 0x2e00, and the one behind
+        # 0x5000, runs into unreadable memory and fails as a whole.
+        walk(self.FORWARD_PAGE, range(0, page_size, 64))
+        walk(self.BACKWARD_PAGE, range(page_size - 1, -1, -64))
+        self.assertPacketLogContains([
+            "m2e00,1000",
+            "m2e00,200",
+            "m4200,1000",
+            "m5000,200",
+        ])
@@ -359,6 +359,38 @@ class LoadUnloadTestCase(TestBase):
                     substrs=['stopped',
                              'stop reason = step over'])
 
+    @skipIfFreeBSD  # llvm.org/pr14424 - missing FreeBSD Makefiles/testcase support
+    @skipIfWindows  # Windows doesn't have dlopen and friends, dynamic libraries work differently
+    def test_parallel_module_load(self):
+        """Test that preparing modules on several threads loads the same images as loading them one at a time."""
+        self.copy_shlibs_to_remote()
+
+        exe = self.getBuildArtifact("a.out")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.parallel-module-load"))
+
+        def image_list(parallel):
+            self.runCmd("settings set target.parallel-module-load %s" %
+                        ("true" if parallel else "false"))
+            self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+            lldbutil.run_break_set_by_file_and_line(
+                self, "main.cpp", self.line, num_expected_locations=1,
+                loc_exact=True)
+            self.runCmd("run", RUN_SUCCEEDED)
+
+            # Loading libloadunload_a loads libloadunload_b along with it.
+            self.runCmd("thread step-over")
+            self.runCmd("image list")
+            output = self.res.GetOutput()
+            self.runCmd("process kill")
+            self.runCmd("target delete")
+            return output
+
+        serial = image_list(False)
+        self.assertTrue("libloadunload_a" in serial)
+        self.assertTrue("libloadunload_b" in serial)
+        self.assertEqual(image_list(True), serial)
+
     # We can't find a breakpoint location for d_init before launching because
     # executable dependencies are resolved relative to the debuggers PWD. Bug?
     @expectedFailureAll(oslist=["linux"])
@@ -140,4 +140,21 @@ class LoadUsingPathsTestCase(TestBase):
         self.assertNotEqual(token, lldb.LLDB_INVALID_IMAGE_TOKEN, "Got a valid token")
         self.assertEqual(out_spec, lldb.SBFileSpec(self.hidden_lib), "Found the expected library")
 
-
+    @skipIfFreeBSD  # llvm.org/pr14424 - missing FreeBSD Makefiles/testcase support
+    @not_remote_testsuite_ready
+    @skipIfWindows  # Windows doesn't have dlopen and friends, dynamic libraries work differently
+    def test_load_two_missing_libraries(self):
+        """Test that loading two missing libraries at once reports each one's own error."""
+        lldbutil.run_to_source_breakpoint(self,
+                                          "Break here to do the load using paths",
+                                          lldb.SBFileSpec("main.cpp"))
+
+        # Both libraries go to a single dlopen call in the inferior, so the
+        # error for the first mustn't be overwritten by the second.
+        missing_a = os.path.join(self.wd, "no_such_dir", "libmissing_a.so")
+        missing_b = os.path.join(self.wd, "no_such_dir", "libmissing_b.so")
+        self.expect("process load %s %s" % (missing_a, missing_b), error=True,
+                    patterns=["failed to load '%s': dlopen error: [^\n]*%s" %
+                              (re.escape(missing_a), re.escape(missing_a)),
+                              "failed to load '%s': dlopen error: [^\n]*%s" %
+                              (re.escape(missing_b), re.escape(missing_b))])
@@ -64,3 +64,111 @@ class MemoryCacheTestCase(TestBase):
         # Check the value of my_ints[0] have been updated correctly.
         line = self.res.GetOutput().splitlines()[100]
         self.assertTrue(0x000000AA == int(line.split(':')[1], 0))
+
+    @expectedFlakeyOS(oslist=["windows"])
+    def test_memory_cache_prefetch(self):
+        """Test that the memory cache reads ahead when memory is read in order."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line(
+            self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+                    substrs=['stopped', 'stop reason = breakpoint'])
+
+        self.expect("process status --statistics",
+                    substrs=['Memory cache statistics:', 'misses:',
+                             'bytes prefetched:'])
+
+        # Walk through my_buffer so that every miss picks up where the last
+        # one stopped.
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        frame = process.GetSelectedThread().GetFrameAtIndex(0)
+        addr = frame.EvaluateExpression("&my_buffer").GetValueAsUnsigned()
+        for offset in range(0, 16384, 64):
+            error = lldb.SBError()
+            process.ReadUnsignedFromMemory(addr + offset, 4, error)
+            self.assertTrue(error.Success())
+
+        self.runCmd("process status --statistics")
+        prefetched = re.search(r"bytes prefetched: (\d+)",
+                               self.res.GetOutput())
+        self.assertTrue(prefetched and int(prefetched.group(1)) > 0)
+
+    @skipIfWindows  # The test program uses mmap and mprotect.
+    def test_memory_cache_prefetch_at_unreadable_page(self):
+        """Test that reading ahead into an unreadable page, in either direction, doesn't fail reads of the readable lines before it."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line(
+            self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+                    substrs=['stopped', 'stop reason = breakpoint'])
+
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        frame = process.GetSelectedThread().GetFrameAtIndex(0)
+        addr = frame.FindVariable("my_guarded_page").GetValueAsUnsigned()
+        self.assertNotEqual(addr, 0)
+        page_size = frame.FindVariable("my_page_size").GetValueAsSigned()
+
+        def walk(offsets):
+            for offset in offsets:
+                error = lldb.SBError()
+                value = process.ReadUnsignedFromMemory(addr + offset, 1, error)
+                self.assertTrue(error.Success(),
+                                "Read at offset %d: %s" % (offset, error))
+                self.assertEqual(value, offset & 0xff)
+
+        # Walk forward up to the unreadable page after this one, then, with
+        # an empty cache, backward down to the one before it.
+        walk(range(0, page_size, 64))
+        self.assertTrue(frame.EvaluateExpression("resume()").IsValid())
+        walk(range(page_size - 1, -1, -64))
+
+    @expectedFlakeyOS(oslist=["windows"])
+    def test_read_text_from_object_file(self):
+        """Test that reads of code in main are served from the executable."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line(
+            self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+                    substrs=['stopped', 'stop reason = breakpoint'])
+
+        target = self.dbg.GetSelectedTarget()
+        process = target.GetProcess()
+        frame = process.GetSelectedThread().GetFrameAtIndex(0)
+        pc = frame.GetPCAddress().GetLoadAddress(target)
+
+        def object_file_reads():
+            self.runCmd("process status --statistics")
+            reads = re.search(r"Reads from object files: (\d+)",
+                              self.res.GetOutput())
+            self.assertTrue(reads)
+            return int(reads.group(1))
+
+        before = object_file_reads()
+        error = lldb.SBError()
+        file_bytes = process.ReadMemory(pc, 4, error)
+        self.assertTrue(error.Success())
+        after = object_file_reads()
+        self.assertTrue(after > before)
+
+        # The bytes must be the ones in the process, minus our breakpoint.
+        self.runCmd(
+            "settings set target.process.read-text-from-object-files false")
+        process_bytes = process.ReadMemory(pc, 4, error)
+        self.assertTrue(error.Success())
+        self.assertEqual(object_file_reads(), after)
+        self.assertEqual(file_bytes, process_bytes)
@@ -7,8 +7,35 @@
 //
 //===----------------------------------------------------------------------===//
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+char my_buffer[16384];
+
+// A readable page with an unreadable page on either side.
+char *my_guarded_page;
+long my_page_size;
+
+// Running the process to call this empties the memory cache.
+int resume() { return 0; }
+
 int main ()
 {
+#ifndef _WIN32
+    my_page_size = sysconf(_SC_PAGESIZE);
+    char *pages = (char *)mmap(nullptr, 3 * my_page_size,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages != MAP_FAILED) {
+        mprotect(pages, my_page_size, PROT_NONE);
+        mprotect(pages + 2 * my_page_size, my_page_size, PROT_NONE);
+        my_guarded_page = pages + my_page_size;
+        for (long i = 0; i < my_page_size; ++i)
+            my_guarded_page[i] = (char)i;
+    }
+#endif
     int my_ints[] = {0x42};
     return 0; // Set break point at this line.
 }
@@ -84,6 +84,44 @@ class LinuxCoreTestCase(TestBase):
         self.do_test("linux-x86_64", self._x86_64_pid, self._x86_64_regions,
         "a.out")
 
+    @expectedFailureAll(bugnumber="llvm.org/pr37371", hostoslist=["windows"])
+    @skipIf(triple='^mips')
+    @skipIfLLVMTargetMissing("X86")
+    def test_x86_64_shared_memory_data(self):
+        """Test that variables read from the core's mapped memory match a copying read, and that changing them leaves the core alone."""
+        target = self.dbg.CreateTarget("linux-x86_64.out")
+        process = target.LoadCore("linux-x86_64.core")
+        self.assertTrue(process, PROCESS_IS_VALID)
+        thread = process.GetSelectedThread()
+
+        for frame in thread.frames:
+            # The value's data shares the core file's buffer, while
+            # ReadMemory copies out of it.
+            value = frame.FindVariable("F")
+            name = frame.GetFunctionName()
+            expected = ord(name[0])
+            address = value.GetLoadAddress()
+            error = lldb.SBError()
+            memory = process.ReadMemory(address, 1, error)
+            self.assertTrue(error.Success(), str(error))
+            self.assertEqual(struct.unpack("B", memory)[0], expected)
+            self.assertEqual(value.GetData().GetUnsignedInt8(error, 0),
+                             expected)
+            thread.SetSelectedFrame(frame.GetFrameID())
+            self.expect("frame variable -f x F",
+                        substrs=["F = 0x%02x" % expected])
+
+            # A core can't be written to, and trying to must not write into
+            # the shared buffer behind the read-only view either.
+            self.assertFalse(value.SetValueFromCString("'z'", error))
+            self.expect("expression -- F = 'z'", error=True)
+            memory = process.ReadMemory(address, 1, error)
+            self.assertEqual(struct.unpack("B", memory)[0], expected)
+            self.assertEqual(
+                frame.FindVariable("F").GetValueAsUnsigned(), expected)
+
+        self.dbg.DeleteTarget(target)
+
     @expectedFailureAll(bugnumber="llvm.org/pr37371", hostoslist=["windows"])
     @skipIf(triple='^mips')
     @skipIfLLVMTargetMissing("SystemZ")
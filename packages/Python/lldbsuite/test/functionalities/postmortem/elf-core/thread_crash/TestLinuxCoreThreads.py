@@ -38,6 +38,60 @@ class LinuxCoreThreadsTestCase(TestBase):
         """Test that lldb can read the process information from an x86_64 linux core file."""
         self.do_test("linux-x86_64", self._x86_64_pid, self._x86_64_tid)
 
+    @skipIf(oslist=['windows'])
+    @skipIf(triple='^mips')
+    def test_x86_64_load_modules_on_demand(self):
+        """Test that the crashed thread of an x86_64 linux core file can be
+        backtraced when modules are loaded on demand."""
+        (eager_frames, _) = self.backtrace_crashed_thread(
+            "linux-x86_64", self._x86_64_tid, False)
+
+        self.runCmd(
+            "settings set plugin.process.elf-core.load-modules-on-demand true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear plugin.process.elf-core.load-modules-on-demand"))
+        (frames, frame_modules) = self.backtrace_crashed_thread(
+            "linux-x86_64", self._x86_64_tid, True)
+
+        # The backtrace is the same, and every module it goes through got
+        # loaded on the way.  How many modules are loaded up front isn't
+        # compared: unless this host has the core's libraries, neither way
+        # loads more than the executable.
+        self.assertEqual(frames, eager_frames)
+        for (frame, loaded) in zip(frames, frame_modules):
+            if frame[1]:
+                self.assertTrue(loaded, "%s is loaded" % frame[1])
+
+    def backtrace_crashed_thread(self, filename, tid, on_demand):
+        """Load the core and backtrace the thread that crashed.  Returns the
+        (function, module) pair of each frame, and whether each frame's
+        module is now in the target's image list."""
+        target = self.dbg.CreateTarget("")
+        process = target.LoadCore(filename + ".core")
+        self.assertTrue(process, PROCESS_IS_VALID)
+        self.assertEqual(process.GetNumThreads(), 3)
+
+        thread = process.GetThreadByID(tid)
+        self.assertTrue(thread.IsValid())
+        self.assertEqual(thread.GetStopReason(), lldb.eStopReasonSignal)
+        self.assertTrue(thread.GetNumFrames() > 0)
+        self.assertNotEqual(thread.GetFrameAtIndex(0).GetPC(),
+                            lldb.LLDB_INVALID_ADDRESS)
+
+        frames = []
+        frame_modules = []
+        for frame in thread:
+            module = frame.GetModule()
+            name = module.GetFileSpec().GetFilename() if module else None
+            frames.append((frame.GetFunctionName(), name))
+            frame_modules.append(bool(module) and
+                                 target.FindModule(module.GetFileSpec())
+                                 .IsValid())
+
+        self.dbg.DeleteTarget(target)
+        lldb.DBG.SetSelectedPlatform(self._initial_platform)
+        return (frames, frame_modules)
+
     def do_test(self, filename, pid, tid):
         target = self.dbg.CreateTarget("")
         process = target.LoadCore(filename + ".core")
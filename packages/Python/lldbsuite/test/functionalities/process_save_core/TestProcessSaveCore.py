@@ -65,3 +65,33 @@ class ProcessSaveCoreTestCase(TestBase):
             self.assertTrue(self.dbg.DeleteTarget(target))
             if (os.path.isfile(core)):
                 os.unlink(core)
+
+    @not_remote_testsuite_ready
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64", "aarch64"]))
+    def test_save_linux_elf_core(self):
+        """Test that we can save a Linux ELF core and load it back."""
+        self.build()
+        exe = self.getBuildArtifact("a.out")
+        core = self.getBuildArtifact("core.elf")
+        target = self.dbg.CreateTarget(exe)
+        breakpoint = target.BreakpointCreateByName("bar")
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+        pc = process.GetSelectedThread().GetFrameAtIndex(0).GetPC()
+        error = process.SaveCore(core)
+        self.assertTrue(error.Success(), error.GetCString())
+        self.assertTrue(os.path.isfile(core))
+        self.assertTrue(process.Kill().Success())
+
+        target = self.dbg.CreateTarget(exe)
+        process = target.LoadCore(core)
+        self.assertTrue(process.IsValid())
+        thread = process.GetSelectedThread()
+        self.assertEqual(thread.GetFrameAtIndex(0).GetPC(), pc)
+        self.assertEqual(thread.GetFrameAtIndex(0).GetFunctionName(), "bar")
+        self.assertEqual(thread.GetFrameAtIndex(1).GetFunctionName(), "foo")
+        self.assertEqual(
+            target.FindFirstGlobalVariable("global").GetValueAsSigned(), 42)
+        self.assertTrue(self.dbg.DeleteTarget(target))
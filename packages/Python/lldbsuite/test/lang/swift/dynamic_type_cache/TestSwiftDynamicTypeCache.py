@@ -0,0 +1,64 @@
+# TestSwiftDynamicTypeCache.py
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ------------------------------------------------------------------------------
+"""
+Test the cache of class dynamic types and 'language swift statistics'
+"""
+import lldb
+from lldbsuite.test.lldbtest import *
+import lldbsuite.test.decorators as decorators
+import lldbsuite.test.lldbutil as lldbutil
+import re
+import unittest2
+
+
+class TestSwiftDynamicTypeCache(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def get_statistics(self):
+        self.runCmd("language swift statistics")
+        match = re.search(r"(\d+) entries, (\d+) hits, (\d+) misses",
+                          self.res.GetOutput())
+        self.assertTrue(match, "unexpected output: " + self.res.GetOutput())
+        return [int(n) for n in match.groups()]
+
+    @decorators.swiftTest
+    @decorators.add_test_categories(["swiftpr"])
+    def test_dynamic_type_cache(self):
+        """Test that the second lookup of a class' metadata is a hit"""
+        self.build()
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        self.expect("language swift statistics", error=True)
+
+        lldbutil.run_to_source_breakpoint(
+            self, '// break here', lldb.SBFileSpec("main.swift"))
+
+        self.expect("frame variable -d run -- objects",
+                    substrs=["a.Derived", "a.MoreDerived", "z = 3"])
+        (size, hits, misses) = self.get_statistics()
+        self.assertTrue(size >= 2)
+        self.assertTrue(misses >= 2)
+
+        # Both classes are cached now: printing the objects again, as new
+        # values, only hits.
+        self.expect("expression -d run -- objects",
+                    substrs=["a.Derived", "a.MoreDerived", "z = 3"])
+        (size2, hits2, misses2) = self.get_statistics()
+        self.assertTrue(size2 >= size)
+        self.assertTrue(hits2 > hits)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lldb.SBDebugger.Terminate)
+    unittest2.main()
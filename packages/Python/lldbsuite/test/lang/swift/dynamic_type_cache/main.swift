@@ -0,0 +1,18 @@
+class Base {
+  var x = 1
+}
+
+class Derived : Base {
+  var y = 2
+}
+
+class MoreDerived : Derived {
+  var z = 3
+}
+
+func main() {
+  let objects: [Base] = [Derived(), MoreDerived(), Derived(), MoreDerived()]
+  print(objects.count) // break here
+}
+
+main()
@@ -0,0 +1,102 @@
+# TestSwiftLargeContainers.py
+#
+# This source file is part of the Swift.org open source project
+#
+# Copyright (c) 2014 - 2018 Apple Inc. and the Swift project authors
+# Licensed under Apache License v2.0 with Runtime Library Exception
+#
+# See https://swift.org/LICENSE.txt for license information
+# See https://swift.org/CONTRIBUTORS.txt for the list of Swift project authors
+#
+# ------------------------------------------------------------------------------
+"""
+Test arrays, dictionaries and sets that are larger than one chunk of the
+formatters' element reads
+"""
+import lldb
+from lldbsuite.test.lldbtest import *
+import lldbsuite.test.decorators as decorators
+import lldbsuite.test.lldbutil as lldbutil
+import unittest2
+
+
+class TestSwiftLargeContainers(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        TestBase.setUp(self)
+        self.main_source_spec = lldb.SBFileSpec("main.swift")
+
+    def get_frame(self):
+        self.build()
+        (target, process, thread, bkpt) = lldbutil.run_to_source_breakpoint(
+            self, '// break here', self.main_source_spec)
+        return thread.frames[0]
+
+    @decorators.swiftTest
+    @decorators.add_test_categories(["swiftpr"])
+    def test_large_arrays(self):
+        """Test elements on both sides of the array chunk boundaries"""
+        frame = self.get_frame()
+
+        # An Int is 8 bytes, so the chunks start at 2048 and 4096.
+        ints = frame.FindVariable("ints")
+        self.assertEqual(ints.GetNumChildren(), 5000)
+        for idx in [4999, 0, 1, 2047, 2048, 2049, 4095, 4096, 2048, 0]:
+            self.assertEqual(
+                ints.GetChildAtIndex(idx).GetValueAsSigned(), idx)
+
+        # A Pair is 16 bytes, so the chunks start at 1024, 2048, ...
+        pairs = frame.FindVariable("pairs")
+        self.assertEqual(pairs.GetNumChildren(), 3000)
+        for idx in [0, 1023, 1024, 2047, 2048, 2999, 1024]:
+            child = pairs.GetChildAtIndex(idx)
+            self.assertEqual(
+                child.GetChildMemberWithName("a").GetValueAsSigned(), idx)
+            self.assertEqual(
+                child.GetChildMemberWithName("b").GetValueAsSigned(), -idx)
+
+        self.expect(
+            'frame variable --show-all-children ints',
+            substrs=['[2047] = 2047', '[2048] = 2048', '[4096] = 4096',
+                     '[4999] = 4999'])
+        self.expect(
+            'frame variable --show-all-children pairs',
+            substrs=['[1023] = (a = 1023, b = -1023)',
+                     '[1024] = (a = 1024, b = -1024)',
+                     '[2999] = (a = 2999, b = -2999)'])
+
+    @decorators.swiftTest
+    @decorators.add_test_categories(["swiftpr"])
+    def test_large_hashed_containers(self):
+        """Test that every bucket of a dictionary and a set is read right"""
+        frame = self.get_frame()
+
+        dict = frame.FindVariable("dict")
+        self.assertEqual(dict.GetNumChildren(), 5000)
+        keys = set()
+        for idx in range(dict.GetNumChildren()):
+            child = dict.GetChildAtIndex(idx)
+            key = child.GetChildMemberWithName("key").GetValueAsSigned()
+            value = child.GetChildMemberWithName("value").GetValueAsSigned()
+            self.assertEqual(value, key * 2)
+            keys.add(key)
+        self.assertEqual(keys, set(range(5000)))
+
+        values = frame.FindVariable("set")
+        self.assertEqual(values.GetNumChildren(), 5000)
+        elements = set(values.GetChildAtIndex(idx).GetValueAsSigned()
+                       for idx in range(values.GetNumChildren()))
+        self.assertEqual(elements, set(range(5000)))
+
+        self.expect(
+            'frame variable --show-all-children dict',
+            substrs=['key = 0, value = 0', 'key = 2048, value = 4096',
+                     'key = 4999, value = 9998'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lldb.SBDebugger.Terminate)
+    unittest2.main()
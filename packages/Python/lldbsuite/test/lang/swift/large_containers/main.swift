@@ -0,0 +1,18 @@
+struct Pair {
+  var a: Int
+  var b: Int
+}
+
+func main() {
+  // Larger than one 16K read of element storage or of hashed buckets.
+  let ints = Array(0..<5000)
+  let pairs = (0..<3000).map { Pair(a: $0, b: -$0) }
+  var dict = [Int: Int]()
+  for i in 0..<5000 {
+    dict[i] = i * 2
+  }
+  let set = Set(0..<5000)
+  print(ints.count + pairs.count + dict.count + set.count) // break here
+}
+
+main()
@@ -10,6 +10,7 @@
 // C Includes
 // C++ Includes
 // Other libraries and framework includes
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/Casting.h"
 
 // Project includes
@@ -24,6 +25,7 @@
 #include "lldb/Core/SearchFilter.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/Symbol.h"
@@ -315,6 +317,7 @@ void Breakpoint::SetIgnoreCount(uint32_t n) {
 
   m_options_up->SetIgnoreCount(n);
   SendBreakpointChangedEvent(eBreakpointEventTypeIgnoreChanged);
+  UpdateSiteConditions();
 }
 
 void Breakpoint::DecrementIgnoreCount() {
@@ -420,12 +423,32 @@ const char *Breakpoint::GetQueueName() const {
 void Breakpoint::SetCondition(const char *condition) {
   m_options_up->SetCondition(condition);
   SendBreakpointChangedEvent(eBreakpointEventTypeConditionChanged);
+  UpdateSiteConditions();
+}
+
+void Breakpoint::UpdateSiteConditions() {
+  ProcessSP process_sp = m_target.GetProcessSP();
+  if (!process_sp || !process_sp->IsAlive())
+    return;
+  const size_t num_locations = m_locations.GetSize();
+  for (size_t i = 0; i < num_locations; ++i) {
+    BreakpointSiteSP bp_site_sp =
+        m_locations.GetByIndex(i)->GetBreakpointSite();
+    if (bp_site_sp)
+      process_sp->UpdateBreakpointSiteConditions(bp_site_sp.get());
+  }
 }
 
 const char *Breakpoint::GetConditionText() const {
   return m_options_up->GetConditionText();
 }
 
+void Breakpoint::SetTracepointCollect(const std::vector<std::string> &collect) {
+  m_options_up->SetTracepointCollect(collect);
+  SendBreakpointChangedEvent(eBreakpointEventTypeCommandChanged);
+  UpdateSiteConditions();
+}
+
 // This function is used when "baton" doesn't need to be freed
 void Breakpoint::SetCallback(BreakpointHitCallback callback, void *baton,
                              bool is_synchronous) {
@@ -514,25 +537,30 @@ void Breakpoint::ModulesChanged(ModuleList &module_list, bool load,
   std::lock_guard<std::recursive_mutex> guard(module_list.GetMutex());
   if (load) {
     // The logic for handling new modules is:
-    // 1) If the filter rejects this module, then skip it. 2) Run through the
-    // current location list and if there are any locations
-    //    for that module, we mark the module as "seen" and we don't try to
-    //    re-resolve
-    //    breakpoint locations for that module.
-    //    However, we do add breakpoint sites to these locations if needed.
+    // 1) If the filter rejects this module, then skip it.
+    // 2) Run through the current location list and if there are any
+    //    locations for that module, we mark the module as "seen" and we don't
+    //    try to re-resolve breakpoint locations for that module.  However, we
+    //    do add breakpoint sites to these locations if needed.
     // 3) If we don't see this module in our breakpoint location list, call
-    // ResolveInModules.
+    //    ResolveInModules.
+    //
+    // A whole batch of modules often loads at once, so the locations are
+    // walked once for all of them rather than once per module.
+
+    llvm::SmallPtrSet<Module *, 16> modules_to_check;
+    for (ModuleSP module_sp : module_list.ModulesNoLocking()) {
+      if (m_filter_sp->ModulePasses(module_sp))
+        modules_to_check.insert(module_sp.get());
+    }
 
     ModuleList new_modules; // We'll stuff the "unseen" modules in this list,
                             // and then resolve
     // them after the locations pass.  Have to do it this way because resolving
     // breakpoints will add new locations potentially.
 
-    for (ModuleSP module_sp : module_list.ModulesNoLocking()) {
-      bool seen = false;
-      if (!m_filter_sp->ModulePasses(module_sp))
-        continue;
-
+    if (!modules_to_check.empty()) {
+      llvm::SmallPtrSet<Module *, 16> seen_modules;
       BreakpointLocationCollection locations_with_no_section;
       for (BreakpointLocationSP break_loc_sp :
            m_locations.BreakpointLocations()) {
@@ -545,36 +573,43 @@ void Breakpoint::ModulesChanged(ModuleList &module_list, bool load,
           locations_with_no_section.Add(break_loc_sp);
           continue;
         }
-          
+
         if (!break_loc_sp->IsEnabled())
           continue;
-        
+
         SectionSP section_sp(section_addr.GetSection());
-        
+
         // If we don't have a Section, that means this location is a raw
         // address that we haven't resolved to a section yet.  So we'll have to
         // look in all the new modules to resolve this location. Otherwise, if
-        // it was set in this module, re-resolve it here.
-        if (section_sp && section_sp->GetModule() == module_sp) {
-          if (!seen)
-            seen = true;
-
-          if (!break_loc_sp->ResolveBreakpointSite()) {
-            if (log)
-              log->Printf("Warning: could not set breakpoint site for "
-                          "breakpoint location %d of breakpoint %d.\n",
-                          break_loc_sp->GetID(), GetID());
-          }
+        // it was set in one of the new modules, re-resolve it here.
+        if (!section_sp)
+          continue;
+        ModuleSP section_module_sp(section_sp->GetModule());
+        if (!section_module_sp ||
+            !modules_to_check.count(section_module_sp.get()))
+          continue;
+
+        seen_modules.insert(section_module_sp.get());
+
+        if (!break_loc_sp->ResolveBreakpointSite()) {
+          if (log)
+            log->Printf("Warning: could not set breakpoint site for "
+                        "breakpoint location %d of breakpoint %d.\n",
+                        break_loc_sp->GetID(), GetID());
         }
       }
-      
+
       size_t num_to_delete = locations_with_no_section.GetSize();
-      
+
       for (size_t i = 0; i < num_to_delete; i++)
         m_locations.RemoveLocation(locations_with_no_section.GetByIndex(i));
 
-      if (!seen)
-        new_modules.AppendIfNeeded(module_sp);
+      for (ModuleSP module_sp : module_list.ModulesNoLocking()) {
+        if (modules_to_check.count(module_sp.get()) &&
+            !seen_modules.count(module_sp.get()))
+          new_modules.AppendIfNeeded(module_sp);
+      }
     }
 
     if (new_modules.GetSize() > 0) {
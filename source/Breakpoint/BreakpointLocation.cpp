@@ -13,9 +13,11 @@
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/BreakpointID.h"
+#include "lldb/Breakpoint/ConditionCompiler.h"
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Expression/DiagnosticManager.h"
 #include "lldb/Expression/ExpressionVariable.h"
@@ -24,6 +26,8 @@
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/TypeSystem.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadSpec.h"
@@ -224,6 +228,7 @@ void BreakpointLocation::ClearCallback() {
 void BreakpointLocation::SetCondition(const char *condition) {
   GetLocationOptions()->SetCondition(condition);
   SendBreakpointLocationChangedEvent(eBreakpointEventTypeConditionChanged);
+  UpdateSiteConditions();
 }
 
 const char *BreakpointLocation::GetConditionText(size_t *hash) const {
@@ -231,6 +236,240 @@ const char *BreakpointLocation::GetConditionText(size_t *hash) const {
       ->GetConditionText(hash);
 }
 
+namespace {
+// Register and memory reads for conditions and tracepoints compiled with
+// eRegisterKindLLDB numbers, evaluated against the frame the breakpoint
+// stopped in.
+class FrameConditionContext : public TracepointContext {
+public:
+  FrameConditionContext(RegisterContext &reg_ctx, Process &process)
+      : m_reg_ctx(reg_ctx), m_process(process) {}
+
+  bool ReadRegister(uint32_t reg_num, uint64_t &value) override {
+    const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoAtIndex(reg_num);
+    RegisterValue reg_value;
+    if (!reg_info || !m_reg_ctx.ReadRegister(reg_info, reg_value))
+      return false;
+    bool success = false;
+    value = reg_value.GetAsUInt64(0, &success);
+    return success;
+  }
+
+  bool ReadUnsigned(lldb::addr_t addr, size_t byte_size,
+                    uint64_t &value) override {
+    Status error;
+    value = m_process.ReadUnsignedIntegerFromMemory(addr, byte_size, 0, error);
+    return error.Success();
+  }
+
+  bool ReadRegisterBytes(uint32_t reg_num,
+                         std::vector<uint8_t> &bytes) override {
+    const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoAtIndex(reg_num);
+    RegisterValue reg_value;
+    if (!reg_info || !m_reg_ctx.ReadRegister(reg_info, reg_value))
+      return false;
+    bytes.resize(reg_info->byte_size);
+    Status error;
+    return reg_value.GetAsMemoryData(reg_info, bytes.data(), bytes.size(),
+                                     GetByteOrder(), error) == bytes.size();
+  }
+
+  bool ReadMemory(lldb::addr_t addr, size_t size,
+                  std::vector<uint8_t> &bytes) override {
+    bytes.resize(size);
+    Status error;
+    return m_process.ReadMemory(addr, bytes.data(), size, error) == size;
+  }
+
+  lldb::ByteOrder GetByteOrder() override { return m_process.GetByteOrder(); }
+
+private:
+  RegisterContext &m_reg_ctx;
+  Process &m_process;
+};
+} // namespace
+
+bool BreakpointLocation::GetCompiledCondition(Thread &thread,
+                                              lldb::RegisterKind reg_kind,
+                                              AgentExpression &expr) {
+  if (GetIgnoreCount() != 0 || m_owner.GetIgnoreCount() != 0)
+    return false;
+
+  size_t condition_hash;
+  const char *condition_text = GetConditionText(&condition_hash);
+  if (!condition_text)
+    return false;
+  return CompileCondition(thread, reg_kind, condition_text, condition_hash,
+                          expr);
+}
+
+bool BreakpointLocation::CompileCondition(Thread &thread,
+                                          lldb::RegisterKind reg_kind,
+                                          const char *condition_text,
+                                          size_t condition_hash,
+                                          AgentExpression &expr) {
+  std::lock_guard<std::mutex> guard(m_compiled_condition_mutex);
+  if (condition_hash != m_compiled_condition_hash) {
+    m_compiled_conditions.clear();
+    m_compiled_condition_hash = condition_hash;
+  }
+
+  auto pos = m_compiled_conditions.find(reg_kind);
+  if (pos == m_compiled_conditions.end()) {
+    Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS);
+    AgentExpression compiled;
+    Status error;
+    ConditionCompiler compiler(thread, m_address, reg_kind);
+    if (!compiler.Compile(condition_text, compiled, error)) {
+      if (log)
+        log->Printf("Condition \"%s\" needs the expression parser: %s",
+                    condition_text, error.AsCString());
+      compiled.Clear();
+    }
+    pos = m_compiled_conditions.emplace(reg_kind, compiled).first;
+  }
+
+  if (pos->second.IsEmpty())
+    return false;
+  expr = pos->second;
+  return true;
+}
+
+void BreakpointLocation::SetTracepointCollect(
+    const std::vector<std::string> &collect) {
+  GetLocationOptions()->SetTracepointCollect(collect);
+  SendBreakpointLocationChangedEvent(eBreakpointEventTypeCommandChanged);
+  UpdateSiteConditions();
+}
+
+const std::vector<std::string> &
+BreakpointLocation::GetTracepointCollect(size_t *hash) const {
+  return GetOptionsSpecifyingKind(BreakpointOptions::eTracepoint)
+      ->GetTracepointCollect(hash);
+}
+
+bool BreakpointLocation::IsTracepoint() const {
+  return !GetTracepointCollect().empty();
+}
+
+uint64_t BreakpointLocation::GetTracepointID() const {
+  return (static_cast<uint64_t>(m_owner.GetID()) << 32) |
+         static_cast<uint32_t>(GetID());
+}
+
+BreakpointLocationSP
+BreakpointLocation::FindTracepointLocation(Target &target,
+                                           uint64_t tracepoint_id) {
+  BreakpointSP bp_sp = target.GetBreakpointByID(
+      static_cast<break_id_t>(tracepoint_id >> 32));
+  if (!bp_sp)
+    return BreakpointLocationSP();
+  return bp_sp->FindLocationByID(
+      static_cast<break_id_t>(tracepoint_id & UINT32_MAX));
+}
+
+bool BreakpointLocation::GetCompiledTracepoint(Thread &thread,
+                                               lldb::RegisterKind reg_kind,
+                                               TracepointSpec &spec) {
+  if (!IsTracepoint())
+    return false;
+  if (GetIgnoreCount() != 0 || m_owner.GetIgnoreCount() != 0)
+    return false;
+  const ThreadSpec *thread_spec =
+      GetOptionsSpecifyingKind(BreakpointOptions::eThreadSpec)
+          ->GetThreadSpecNoCreate();
+  if (thread_spec && thread_spec->HasSpecification())
+    return false;
+
+  AgentExpression condition;
+  size_t condition_hash;
+  const char *condition_text = GetConditionText(&condition_hash);
+  if (condition_text &&
+      !CompileCondition(thread, reg_kind, condition_text, condition_hash,
+                        condition))
+    return false;
+
+  if (!CompileTracepoint(thread, reg_kind, spec))
+    return false;
+  spec.condition = condition;
+  return true;
+}
+
+bool BreakpointLocation::CompileTracepoint(Thread &thread,
+                                           lldb::RegisterKind reg_kind,
+                                           TracepointSpec &spec) {
+  size_t collect_hash;
+  const std::vector<std::string> &collect = GetTracepointCollect(&collect_hash);
+  if (collect.empty())
+    return false;
+
+  std::lock_guard<std::mutex> guard(m_compiled_condition_mutex);
+  if (collect_hash != m_compiled_tracepoint_hash) {
+    m_compiled_tracepoints.clear();
+    m_compiled_tracepoint_hash = collect_hash;
+  }
+
+  auto pos = m_compiled_tracepoints.find(reg_kind);
+  if (pos == m_compiled_tracepoints.end()) {
+    Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS);
+    TracepointSpec compiled;
+    compiled.id = GetTracepointID();
+    ConditionCompiler compiler(thread, m_address, reg_kind);
+    for (const std::string &item : collect) {
+      TracepointAction action;
+      Status error;
+      if (!compiler.CompileTracepointAction(item, action, error)) {
+        if (log)
+          log->Printf("Can't collect \"%s\" for tracepoint %" PRIx64 ": %s",
+                      item.c_str(), compiled.id, error.AsCString());
+        compiled.actions.clear();
+        break;
+      }
+      compiled.actions.push_back(action);
+    }
+    pos = m_compiled_tracepoints.emplace(reg_kind, compiled).first;
+  }
+
+  if (pos->second.actions.empty())
+    return false;
+  spec = pos->second;
+  return true;
+}
+
+void BreakpointLocation::CollectTracepoint(ExecutionContext &exe_ctx) {
+  Thread *thread = exe_ctx.GetThreadPtr();
+  Process *process = exe_ctx.GetProcessPtr();
+  if (!thread || !process)
+    return;
+  if (m_bp_site_sp && m_bp_site_sp->GetStubCollectsTracepoints())
+    return;
+
+  TracepointRecord record;
+  record.id = GetTracepointID();
+  record.tid = thread->GetID();
+  record.pc = m_address.GetOpcodeLoadAddress(&GetTarget());
+
+  // Items that can't be compiled are still logged, as not collected, so
+  // the hit itself shows up.
+  TracepointSpec spec;
+  RegisterContextSP reg_ctx_sp = thread->GetRegisterContext();
+  if (reg_ctx_sp && CompileTracepoint(*thread, eRegisterKindLLDB, spec)) {
+    FrameConditionContext context(*reg_ctx_sp, *process);
+    spec.Collect(context, record);
+  } else {
+    record.values.resize(GetTracepointCollect().size());
+  }
+  process->GetTracepointBuffer().Append(record);
+}
+
+void BreakpointLocation::UpdateSiteConditions() {
+  if (!m_bp_site_sp)
+    return;
+  ProcessSP process_sp = m_owner.GetTarget().GetProcessSP();
+  if (process_sp && process_sp->IsAlive())
+    process_sp->UpdateBreakpointSiteConditions(m_bp_site_sp.get());
+}
+
 bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
                                            Status &error) {
   Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS);
@@ -247,6 +486,32 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
 
   error.Clear();
 
+  // Simple conditions are compiled once and evaluated straight from the
+  // stopped frame's registers and memory.  Anything the compiler doesn't
+  // handle, or that fails to evaluate, goes through the expression parser.
+  Thread *thread = exe_ctx.GetThreadPtr();
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  Process *process = exe_ctx.GetProcessPtr();
+  AgentExpression compiled_condition;
+  if (thread && frame && process && frame->GetFrameIndex() == 0 &&
+      CompileCondition(*thread, eRegisterKindLLDB, condition_text,
+                       condition_hash, compiled_condition)) {
+    RegisterContextSP reg_ctx_sp = frame->GetRegisterContext();
+    if (reg_ctx_sp) {
+      FrameConditionContext context(*reg_ctx_sp, *process);
+      uint64_t result = 0;
+      Status eval_error = compiled_condition.Evaluate(context, result);
+      if (eval_error.Success()) {
+        if (log)
+          log->Printf("Compiled condition evaluated, result is %s.",
+                      result ? "true" : "false");
+        return result != 0;
+      }
+      if (log)
+        log->Printf("Compiled condition failed: %s.", eval_error.AsCString());
+    }
+  }
+
   DiagnosticManager diagnostics;
 
   if (condition_hash != m_condition_hash || !m_user_expression_sp ||
@@ -347,6 +612,7 @@ uint32_t BreakpointLocation::GetIgnoreCount() {
 void BreakpointLocation::SetIgnoreCount(uint32_t n) {
   GetLocationOptions()->SetIgnoreCount(n);
   SendBreakpointLocationChangedEvent(eBreakpointEventTypeIgnoreChanged);
+  UpdateSiteConditions();
 }
 
 void BreakpointLocation::DecrementIgnoreCount() {
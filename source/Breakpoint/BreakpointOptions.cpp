@@ -115,7 +115,7 @@ BreakpointOptions::CommandData::CreateFromStructuredData(
 const char *BreakpointOptions::g_option_names[(
     size_t)BreakpointOptions::OptionNames::LastOptionName]{
     "ConditionText", "IgnoreCount", 
-    "EnabledState", "OneShotState", "AutoContinue"};
+    "EnabledState", "OneShotState", "AutoContinue", "TracepointCollect"};
 
 bool BreakpointOptions::NullCallback(void *baton,
                                      StoppointCallbackContext *context,
@@ -132,7 +132,7 @@ BreakpointOptions::BreakpointOptions(bool all_flags_set)
       m_baton_is_command_baton(false), m_callback_is_synchronous(false),
       m_enabled(true), m_one_shot(false), m_ignore_count(0), m_thread_spec_ap(),
       m_condition_text(), m_condition_text_hash(0), m_auto_continue(false),
-      m_set_flags(0) {
+      m_tracepoint_collect(), m_tracepoint_collect_hash(0), m_set_flags(0) {
         if (all_flags_set)
           m_set_flags.Set(~((Flags::ValueType) 0));
       }
@@ -143,7 +143,8 @@ BreakpointOptions::BreakpointOptions(const char *condition, bool enabled,
     : m_callback(nullptr), m_baton_is_command_baton(false),
       m_callback_is_synchronous(false), m_enabled(enabled),
       m_one_shot(one_shot), m_ignore_count(ignore),
-      m_condition_text_hash(0), m_auto_continue(auto_continue)
+      m_condition_text_hash(0), m_auto_continue(auto_continue),
+      m_tracepoint_collect_hash(0)
 {
     m_set_flags.Set(eEnabled | eIgnoreCount | eOneShot 
                    | eAutoContinue);
@@ -162,6 +163,8 @@ BreakpointOptions::BreakpointOptions(const BreakpointOptions &rhs)
       m_enabled(rhs.m_enabled), m_one_shot(rhs.m_one_shot),
       m_ignore_count(rhs.m_ignore_count), m_thread_spec_ap(),
       m_auto_continue(rhs.m_auto_continue),
+      m_tracepoint_collect(rhs.m_tracepoint_collect),
+      m_tracepoint_collect_hash(rhs.m_tracepoint_collect_hash),
       m_set_flags(rhs.m_set_flags) {
   if (rhs.m_thread_spec_ap.get() != nullptr)
     m_thread_spec_ap.reset(new ThreadSpec(*rhs.m_thread_spec_ap.get()));
@@ -186,6 +189,8 @@ operator=(const BreakpointOptions &rhs) {
   m_condition_text = rhs.m_condition_text;
   m_condition_text_hash = rhs.m_condition_text_hash;
   m_auto_continue = rhs.m_auto_continue;
+  m_tracepoint_collect = rhs.m_tracepoint_collect;
+  m_tracepoint_collect_hash = rhs.m_tracepoint_collect_hash;
   m_set_flags = rhs.m_set_flags;
   return *this;
 }
@@ -233,6 +238,8 @@ void BreakpointOptions::CopyOverSetOptions(const BreakpointOptions &incoming)
     m_auto_continue = incoming.m_auto_continue;
     m_set_flags.Set(eAutoContinue);
   }
+  if (incoming.m_set_flags.Test(eTracepoint))
+    SetTracepointCollect(incoming.m_tracepoint_collect);
   if (incoming.m_set_flags.Test(eThreadSpec) && incoming.m_thread_spec_ap)
   {
     if (!m_thread_spec_ap)
@@ -256,6 +263,7 @@ std::unique_ptr<BreakpointOptions> BreakpointOptions::CreateFromStructuredData(
   bool auto_continue = false;
   int32_t ignore_count = 0;
   llvm::StringRef condition_ref("");
+  std::vector<std::string> tracepoint_collect;
   Flags set_options;
 
   const char *key = GetKey(OptionNames::EnabledState);
@@ -314,6 +322,21 @@ std::unique_ptr<BreakpointOptions> BreakpointOptions::CreateFromStructuredData(
     set_options.Set(eCondition);
   }
 
+  StructuredData::Array *collect_array;
+  key = GetKey(OptionNames::TracepointCollect);
+  if (key && options_dict.GetValueForKeyAsArray(key, collect_array)) {
+    const size_t num_items = collect_array->GetSize();
+    for (size_t i = 0; i < num_items; ++i) {
+      llvm::StringRef item;
+      if (!collect_array->GetItemAtIndexAsString(i, item)) {
+        error.SetErrorStringWithFormat("%s item is not a string.",
+                                       GetKey(OptionNames::TracepointCollect));
+        return nullptr;
+      }
+      tracepoint_collect.push_back(item.str());
+    }
+  }
+
   std::unique_ptr<CommandData> cmd_data_up;
   StructuredData::Dictionary *cmds_dict;
   success = options_dict.GetValueForKeyAsDictionary(
@@ -332,6 +355,8 @@ std::unique_ptr<BreakpointOptions> BreakpointOptions::CreateFromStructuredData(
   auto bp_options = llvm::make_unique<BreakpointOptions>(
       condition_ref.str().c_str(), enabled, 
       ignore_count, one_shot, auto_continue);
+  if (!tracepoint_collect.empty())
+    bp_options->SetTracepointCollect(tracepoint_collect);
   if (cmd_data_up.get()) {
     if (cmd_data_up->interpreter == eScriptLanguageNone)
       bp_options->SetCommandDataCallback(cmd_data_up);
@@ -398,6 +423,14 @@ StructuredData::ObjectSP BreakpointOptions::SerializeToStructuredData() {
   if (m_set_flags.Test(eCondition))
     options_dict_sp->AddStringItem(GetKey(OptionNames::ConditionText),
                                    m_condition_text);
+  if (m_set_flags.Test(eTracepoint)) {
+    StructuredData::ArraySP collect_sp(new StructuredData::Array());
+    for (const std::string &item : m_tracepoint_collect)
+      collect_sp->AddItem(StructuredData::StringSP(
+          new StructuredData::String(item)));
+    options_dict_sp->AddItem(GetKey(OptionNames::TracepointCollect),
+                             collect_sp);
+  }
          
   if (m_set_flags.Test(eCallback) && m_baton_is_command_baton) {
     auto cmd_baton =
@@ -514,6 +547,28 @@ void BreakpointOptions::SetCondition(const char *condition) {
   m_condition_text_hash = hasher(m_condition_text);
 }
 
+void BreakpointOptions::SetTracepointCollect(
+    const std::vector<std::string> &collect) {
+  if (collect.empty())
+    m_set_flags.Clear(eTracepoint);
+  else
+    m_set_flags.Set(eTracepoint);
+
+  m_tracepoint_collect = collect;
+  std::hash<std::string> hasher;
+  size_t hash = 0;
+  for (const std::string &item : m_tracepoint_collect)
+    hash = hash * 31 + hasher(item);
+  m_tracepoint_collect_hash = hash;
+}
+
+const std::vector<std::string> &
+BreakpointOptions::GetTracepointCollect(size_t *hash) const {
+  if (hash)
+    *hash = m_tracepoint_collect_hash;
+  return m_tracepoint_collect;
+}
+
 const char *BreakpointOptions::GetConditionText(size_t *hash) const {
   if (!m_condition_text.empty()) {
     if (hash)
@@ -599,6 +654,15 @@ void BreakpointOptions::GetDescription(Stream *s,
       s->Printf("Condition: %s\n", m_condition_text.c_str());
     }
   }
+  if (!m_tracepoint_collect.empty()) {
+    if (level != eDescriptionLevelBrief) {
+      s->EOL();
+      s->PutCString("Tracepoint collects:");
+      for (const std::string &item : m_tracepoint_collect)
+        s->Printf(" %s", item.c_str());
+      s->EOL();
+    }
+  }
 }
 
 void BreakpointOptions::CommandBaton::GetDescription(
@@ -694,4 +758,6 @@ void BreakpointOptions::Clear()
   m_callback_is_synchronous = false;
   m_enabled = false;
   m_condition_text.clear();
+  m_tracepoint_collect.clear();
+  m_tracepoint_collect_hash = 0;
 }
@@ -16,6 +16,7 @@
 #include "Plugins/Language/CPlusPlus/CPlusPlusLanguage.h"
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/FunctionLookupCache.h"
 #include "lldb/Core/Architecture.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Symbol/Block.h"
@@ -293,11 +294,15 @@ BreakpointResolverName::SearchCallback(SearchFilter &filter,
   switch (m_match_type) {
   case Breakpoint::Exact:
     if (context.module_sp) {
+      // Other breakpoints resolving against the same new modules are likely
+      // to look up some of the same names.
+      FunctionLookupCache &lookup_cache =
+          m_breakpoint->GetTarget().GetFunctionLookupCache();
       for (const auto &lookup : m_lookups) {
         const size_t start_func_idx = func_list.GetSize();
-        context.module_sp->FindFunctions(
-            lookup.GetLookupName(), nullptr, lookup.GetNameTypeMask(),
-            include_symbols, include_inlines, append, func_list);
+        lookup_cache.FindFunctions(*context.module_sp, lookup,
+                                   include_symbols, include_inlines,
+                                   func_list);
 
         const size_t end_func_idx = func_list.GetSize();
 
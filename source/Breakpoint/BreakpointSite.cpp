@@ -32,7 +32,7 @@ BreakpointSite::BreakpointSite(BreakpointSiteList *list,
       m_saved_opcode(), m_trap_opcode(),
       m_enabled(false), // Need to create it disabled, so the first enable turns
                         // it on.
-      m_owners(), m_owners_mutex() {
+      m_stub_collects_tracepoints(false), m_owners(), m_owners_mutex() {
   m_owners.Add(owner);
 }
 
@@ -146,6 +146,50 @@ bool BreakpointSite::ValidForThisThread(Thread *thread) {
   return m_owners.ValidForThisThread(thread);
 }
 
+bool BreakpointSite::GetAgentConditions(
+    Thread &thread, lldb::RegisterKind reg_kind,
+    std::vector<AgentExpression> &conditions) {
+  conditions.clear();
+  std::lock_guard<std::recursive_mutex> guard(m_owners_mutex);
+  if (m_owners.GetSize() == 0)
+    return false;
+  for (BreakpointLocationSP loc_sp : m_owners.BreakpointLocations()) {
+    AgentExpression expr;
+    if (loc_sp->IsTracepoint()) {
+      if (!m_stub_collects_tracepoints) {
+        conditions.clear();
+        return false;
+      }
+      // The stub records the hit itself, so it never has to stop for it.
+      expr.AppendConstant(0);
+      expr.AppendOpcode(AgentExpression::eOpEnd);
+    } else if (!loc_sp->GetCompiledCondition(thread, reg_kind, expr)) {
+      conditions.clear();
+      return false;
+    }
+    conditions.push_back(expr);
+  }
+  return true;
+}
+
+bool BreakpointSite::GetTracepoints(Thread &thread,
+                                    lldb::RegisterKind reg_kind,
+                                    std::vector<TracepointSpec> &specs) {
+  specs.clear();
+  std::lock_guard<std::recursive_mutex> guard(m_owners_mutex);
+  for (BreakpointLocationSP loc_sp : m_owners.BreakpointLocations()) {
+    if (!loc_sp->IsTracepoint())
+      continue;
+    TracepointSpec spec;
+    if (!loc_sp->GetCompiledTracepoint(thread, reg_kind, spec)) {
+      specs.clear();
+      return false;
+    }
+    specs.push_back(spec);
+  }
+  return true;
+}
+
 void BreakpointSite::BumpHitCounts() {
   std::lock_guard<std::recursive_mutex> guard(m_owners_mutex);
   for (BreakpointLocationSP loc_sp : m_owners.BreakpointLocations()) {
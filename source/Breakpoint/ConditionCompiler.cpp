@@ -0,0 +1,953 @@
+//===-- ConditionCompiler.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+#include <stdarg.h>
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Breakpoint/ConditionCompiler.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Expression/DWARFExpression.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/CompilerType.h"
+#include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/Language.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Utility/DataExtractor.h"
+
+#include "llvm/ADT/StringSwitch.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+ConditionCompiler::ConditionCompiler(Thread &thread, const Address &address,
+                                     lldb::RegisterKind reg_kind)
+    : m_thread(thread), m_address(address), m_reg_kind(reg_kind) {}
+
+bool ConditionCompiler::SetError(const char *format, ...) {
+  if (m_error.Success()) {
+    va_list args;
+    va_start(args, format);
+    m_error.SetErrorStringWithVarArg(format, args);
+    va_end(args);
+  }
+  return false;
+}
+
+bool ConditionCompiler::Compile(llvm::StringRef condition,
+                                AgentExpression &expr, Status &error) {
+  ValueType type;
+  if (!CompileExpression(condition, type, error))
+    return false;
+  expr = m_expr;
+  return true;
+}
+
+bool ConditionCompiler::CompileTracepointAction(llvm::StringRef item,
+                                                TracepointAction &action,
+                                                Status &error) {
+  item = item.trim();
+  action = TracepointAction();
+
+  // A register on its own is collected whole, even if it is wider than the
+  // 64 bits an expression can hold.
+  if (item.startswith("$") &&
+      item.find_if_not([](char c) { return isalnum(c) || c == '_'; }, 1) ==
+          llvm::StringRef::npos) {
+    m_error.Clear();
+    const RegisterInfo *reg_info = FindRegister(item.drop_front());
+    if (!reg_info) {
+      error = m_error;
+      return false;
+    }
+    const uint32_t reg_num = reg_info->kinds[m_reg_kind];
+    if (reg_num == LLDB_INVALID_REGNUM) {
+      error.SetErrorStringWithFormat(
+          "register %s has no number for the tracepoint collector",
+          reg_info->name);
+      return false;
+    }
+    action.kind = TracepointAction::eKindRegister;
+    action.reg_num = reg_num;
+    action.size = reg_info->byte_size;
+    error.Clear();
+    return true;
+  }
+
+  // "<expr>@<size>" collects memory at the address <expr> computes.
+  llvm::StringRef address_text, size_text;
+  std::tie(address_text, size_text) = item.rsplit('@');
+  uint32_t size = 0;
+  if (!size_text.empty() && !size_text.trim().getAsInteger(0, size)) {
+    if (size == 0 || size > TracepointAction::kMaxMemorySize) {
+      error.SetErrorStringWithFormat(
+          "can't collect %u bytes of memory, the limit is %u", size,
+          TracepointAction::kMaxMemorySize);
+      return false;
+    }
+    ValueType type;
+    if (!CompileExpression(address_text, type, error))
+      return false;
+    action.kind = TracepointAction::eKindMemory;
+    action.size = size;
+    action.expr = m_expr;
+    return true;
+  }
+
+  ValueType type;
+  if (!CompileExpression(item, type, error))
+    return false;
+  action.kind = TracepointAction::eKindValue;
+  action.size = type.byte_size;
+  action.expr = m_expr;
+  return true;
+}
+
+bool ConditionCompiler::CompileExpression(llvm::StringRef text,
+                                          ValueType &type, Status &error) {
+  m_expr.Clear();
+  m_error.Clear();
+
+  // The grammar is C's; other languages read the same text differently.
+  CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
+  const LanguageType language =
+      comp_unit ? comp_unit->GetLanguage() : eLanguageTypeUnknown;
+  if (language != eLanguageTypeUnknown && !Language::LanguageIsC(language) &&
+      !Language::LanguageIsCPlusPlus(language) &&
+      !Language::LanguageIsObjC(language)) {
+    error.SetErrorStringWithFormat(
+        "conditions in %s aren't supported",
+        Language::GetNameForLanguageType(language));
+    return false;
+  }
+
+  m_text = text;
+  Lex();
+
+  bool success = ParseLogicalOr(type);
+  if (success && m_token != Token::Eof)
+    success = SetError("unexpected '%s' in condition",
+                       m_token_text.str().c_str());
+  if (!success) {
+    error = m_error;
+    return false;
+  }
+
+  m_expr.AppendOpcode(AgentExpression::eOpEnd);
+  error.Clear();
+  return true;
+}
+
+//----------------------------------------------------------------------
+// Lexer
+//----------------------------------------------------------------------
+
+void ConditionCompiler::Lex() {
+  m_text = m_text.ltrim();
+  if (m_text.empty()) {
+    m_token = Token::Eof;
+    m_token_text = m_text;
+    return;
+  }
+
+  const char c = m_text.front();
+  if (isdigit(c)) {
+    // Integer literal with an optional radix prefix and u/l suffixes.
+    size_t length = 1;
+    unsigned radix = 10;
+    if (c == '0' && m_text.size() > 1 && tolower(m_text[1]) == 'x') {
+      radix = 16;
+      length = 2;
+    } else if (c == '0') {
+      radix = 8;
+    }
+    while (length < m_text.size() && isxdigit(m_text[length]))
+      ++length;
+    llvm::StringRef digits = m_text.take_front(length);
+    if (radix == 16)
+      digits = digits.drop_front(2);
+    m_token_unsigned = false;
+    while (length < m_text.size() && strchr("uUlL", m_text[length])) {
+      if (tolower(m_text[length]) == 'u')
+        m_token_unsigned = true;
+      ++length;
+    }
+    m_token_text = m_text.take_front(length);
+    m_text = m_text.drop_front(length);
+    if (digits.empty() || digits.getAsInteger(radix, m_token_value))
+      m_token = Token::Invalid;
+    else
+      m_token = Token::Integer;
+    return;
+  }
+
+  if (isalpha(c) || c == '_' || c == '$') {
+    // Identifiers starting with '$' name registers.
+    size_t length = 1;
+    while (length < m_text.size() &&
+           (isalnum(m_text[length]) || m_text[length] == '_'))
+      ++length;
+    m_token = Token::Identifier;
+    m_token_text = m_text.take_front(length);
+    m_text = m_text.drop_front(length);
+    return;
+  }
+
+  static const struct {
+    const char *text;
+    Token token;
+  } g_punctuators[] = {
+      {"&&", Token::AmpAmp},      {"||", Token::PipePipe},
+      {"==", Token::EqualEqual},  {"!=", Token::BangEqual},
+      {"<=", Token::LessEqual},   {">=", Token::GreaterEqual},
+      {"<<", Token::LessLess},    {">>", Token::GreaterGreater},
+      {"->", Token::Arrow},       {".", Token::Dot},
+      {"(", Token::LParen},       {")", Token::RParen},
+      {"+", Token::Plus},         {"-", Token::Minus},
+      {"*", Token::Star},         {"/", Token::Slash},
+      {"%", Token::Percent},      {"&", Token::Amp},
+      {"|", Token::Pipe},         {"^", Token::Caret},
+      {"~", Token::Tilde},        {"!", Token::Bang},
+      {"<", Token::Less},         {">", Token::Greater},
+  };
+  for (const auto &punctuator : g_punctuators) {
+    if (m_text.startswith(punctuator.text)) {
+      m_token = punctuator.token;
+      m_token_text = m_text.take_front(strlen(punctuator.text));
+      m_text = m_text.drop_front(m_token_text.size());
+      return;
+    }
+  }
+
+  m_token = Token::Invalid;
+  m_token_text = m_text.take_front(1);
+  m_text = m_text.drop_front(1);
+}
+
+//----------------------------------------------------------------------
+// Parser.  Code is emitted as the condition is parsed, so each Parse
+// function leaves its operand on top of the bytecode stack.
+//----------------------------------------------------------------------
+
+bool ConditionCompiler::ParseLogicalOr(ValueType &type) {
+  if (!ParseLogicalAnd(type))
+    return false;
+
+  while (m_token == Token::PipePipe) {
+    Lex();
+    // lhs ? 1 : !!rhs
+    const size_t lhs_true = m_expr.AppendJump(AgentExpression::eOpIfGoto);
+    if (!ParseLogicalAnd(type))
+      return false;
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    const size_t done = m_expr.AppendJump(AgentExpression::eOpGoto);
+    m_expr.PatchJump(lhs_true, m_expr.GetCurrentOffset());
+    m_expr.AppendConstant(1);
+    m_expr.PatchJump(done, m_expr.GetCurrentOffset());
+    type = IntType();
+  }
+  return true;
+}
+
+bool ConditionCompiler::ParseLogicalAnd(ValueType &type) {
+  if (!ParseBinary(0, type))
+    return false;
+
+  while (m_token == Token::AmpAmp) {
+    Lex();
+    // lhs ? !!rhs : 0
+    const size_t lhs_true = m_expr.AppendJump(AgentExpression::eOpIfGoto);
+    m_expr.AppendConstant(0);
+    const size_t done = m_expr.AppendJump(AgentExpression::eOpGoto);
+    m_expr.PatchJump(lhs_true, m_expr.GetCurrentOffset());
+    if (!ParseBinary(0, type))
+      return false;
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    m_expr.PatchJump(done, m_expr.GetCurrentOffset());
+    type = IntType();
+  }
+  return true;
+}
+
+// C precedence of the binary operators below && and ||, or -1 for tokens
+// that aren't one.
+int ConditionCompiler::GetPrecedence(Token token) {
+  switch (token) {
+  case Token::Pipe:
+    return 1;
+  case Token::Caret:
+    return 2;
+  case Token::Amp:
+    return 3;
+  case Token::EqualEqual:
+  case Token::BangEqual:
+    return 4;
+  case Token::Less:
+  case Token::LessEqual:
+  case Token::Greater:
+  case Token::GreaterEqual:
+    return 5;
+  case Token::LessLess:
+  case Token::GreaterGreater:
+    return 6;
+  case Token::Plus:
+  case Token::Minus:
+    return 7;
+  case Token::Star:
+  case Token::Slash:
+  case Token::Percent:
+    return 8;
+  default:
+    return -1;
+  }
+}
+
+bool ConditionCompiler::ParseBinary(int min_precedence, ValueType &type) {
+  if (!ParseUnary(type))
+    return false;
+
+  while (true) {
+    const Token op = m_token;
+    const int precedence = GetPrecedence(op);
+    if (precedence < 0 || precedence < min_precedence)
+      return true;
+    Lex();
+
+    ValueType rhs;
+    if (!ParseBinary(precedence + 1, rhs))
+      return false;
+    if (!EmitBinaryOperator(op, type, rhs, type))
+      return false;
+  }
+}
+
+// Integer promotion: everything narrower than int becomes int.
+ConditionCompiler::ValueType ConditionCompiler::Promote(ValueType type) {
+  if (type.byte_size < 4)
+    return IntType();
+  type.is_pointer = false;
+  return type;
+}
+
+bool ConditionCompiler::ParseUnary(ValueType &type) {
+  const Token op = m_token;
+  if (op != Token::Bang && op != Token::Minus && op != Token::Tilde &&
+      op != Token::Plus)
+    return ParsePrimary(type);
+
+  Lex();
+  if (!ParseUnary(type))
+    return false;
+
+  if (op == Token::Bang) {
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    type = IntType();
+    return true;
+  }
+
+  if (type.is_pointer)
+    return SetError("unsupported operator '%s' on a pointer",
+                    op == Token::Minus ? "-" : op == Token::Tilde ? "~" : "+");
+
+  const ValueType promoted = Promote(type);
+  if (op == Token::Minus) {
+    // -x == ~x + 1
+    m_expr.AppendOpcode(AgentExpression::eOpBitNot);
+    m_expr.AppendConstant(1);
+    m_expr.AppendOpcode(AgentExpression::eOpAdd);
+  } else if (op == Token::Tilde) {
+    m_expr.AppendOpcode(AgentExpression::eOpBitNot);
+  }
+  EmitConvert({8, type.is_signed, false}, promoted);
+  type = promoted;
+  return true;
+}
+
+bool ConditionCompiler::ParsePrimary(ValueType &type) {
+  switch (m_token) {
+  case Token::LParen:
+    Lex();
+    if (!ParseLogicalOr(type))
+      return false;
+    if (m_token != Token::RParen)
+      return SetError("expected ')' in condition");
+    Lex();
+    return true;
+
+  case Token::Integer: {
+    const uint64_t value = m_token_value;
+    if (!m_token_unsigned && value <= INT32_MAX)
+      type = IntType();
+    else if (value <= UINT32_MAX && (m_token_unsigned || value > INT32_MAX))
+      type = {4, false, false};
+    else if (!m_token_unsigned && value <= INT64_MAX)
+      type = {8, true, false};
+    else
+      type = {8, false, false};
+    m_expr.AppendConstant(value);
+    Lex();
+    return true;
+  }
+
+  case Token::Identifier: {
+    const llvm::StringRef name = m_token_text;
+    Lex();
+    const int keyword_value = llvm::StringSwitch<int>(name)
+                                  .Case("true", 1)
+                                  .Case("false", 0)
+                                  .Cases("nullptr", "NULL", 0)
+                                  .Default(-1);
+    if (keyword_value >= 0) {
+      m_expr.AppendConstant(keyword_value);
+      type = IntType();
+      return true;
+    }
+    if (name.startswith("$"))
+      return EmitNamedRegister(name.drop_front(), type);
+    return EmitVariable(name, type);
+  }
+
+  case Token::Eof:
+    return SetError("unexpected end of condition");
+
+  default:
+    return SetError("unsupported '%s' in condition",
+                    m_token_text.str().c_str());
+  }
+}
+
+//----------------------------------------------------------------------
+// Code generation
+//----------------------------------------------------------------------
+
+void ConditionCompiler::EmitConvert(ValueType from, ValueType to) {
+  if (to.byte_size >= 8 ||
+      (from.byte_size == to.byte_size && from.is_signed == to.is_signed))
+    return;
+  const uint8_t bits = to.byte_size * 8;
+  if (to.is_signed)
+    m_expr.AppendSignExtend(bits);
+  else
+    m_expr.AppendZeroExtend(bits);
+}
+
+bool ConditionCompiler::EmitBinaryOperator(Token op, ValueType lhs,
+                                           ValueType rhs, ValueType &result) {
+  const bool is_comparison = GetPrecedence(op) == 4 ||
+                             GetPrecedence(op) == 5;
+  if ((lhs.is_pointer || rhs.is_pointer) && !is_comparison)
+    return SetError("unsupported pointer arithmetic in condition");
+
+  if (op == Token::LessLess || op == Token::GreaterGreater) {
+    result = Promote(lhs);
+    if (op == Token::LessLess)
+      m_expr.AppendOpcode(AgentExpression::eOpLsh);
+    else
+      m_expr.AppendOpcode(result.is_signed ? AgentExpression::eOpRshSigned
+                                           : AgentExpression::eOpRshUnsigned);
+    EmitConvert({8, result.is_signed, false}, result);
+    return true;
+  }
+
+  // The usual arithmetic conversions.
+  const ValueType plhs = Promote(lhs);
+  const ValueType prhs = Promote(rhs);
+  ValueType common;
+  if (plhs.byte_size == prhs.byte_size)
+    common = {plhs.byte_size, plhs.is_signed && prhs.is_signed, false};
+  else
+    common = plhs.byte_size > prhs.byte_size ? plhs : prhs;
+
+  EmitConvert(rhs, common);
+  if (lhs.byte_size != common.byte_size ||
+      lhs.is_signed != common.is_signed) {
+    m_expr.AppendOpcode(AgentExpression::eOpSwap);
+    EmitConvert(lhs, common);
+    m_expr.AppendOpcode(AgentExpression::eOpSwap);
+  }
+
+  const bool is_signed = common.is_signed;
+  const AgentExpression::Opcode less = is_signed
+                                           ? AgentExpression::eOpLessSigned
+                                           : AgentExpression::eOpLessUnsigned;
+  switch (op) {
+  case Token::EqualEqual:
+    m_expr.AppendOpcode(AgentExpression::eOpEqual);
+    break;
+  case Token::BangEqual:
+    m_expr.AppendOpcode(AgentExpression::eOpEqual);
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    break;
+  case Token::Less:
+    m_expr.AppendOpcode(less);
+    break;
+  case Token::Greater:
+    m_expr.AppendOpcode(AgentExpression::eOpSwap);
+    m_expr.AppendOpcode(less);
+    break;
+  case Token::LessEqual:
+    m_expr.AppendOpcode(AgentExpression::eOpSwap);
+    m_expr.AppendOpcode(less);
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    break;
+  case Token::GreaterEqual:
+    m_expr.AppendOpcode(less);
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    break;
+  case Token::Plus:
+    m_expr.AppendOpcode(AgentExpression::eOpAdd);
+    break;
+  case Token::Minus:
+    m_expr.AppendOpcode(AgentExpression::eOpSub);
+    break;
+  case Token::Star:
+    m_expr.AppendOpcode(AgentExpression::eOpMul);
+    break;
+  case Token::Slash:
+    m_expr.AppendOpcode(is_signed ? AgentExpression::eOpDivSigned
+                                  : AgentExpression::eOpDivUnsigned);
+    break;
+  case Token::Percent:
+    m_expr.AppendOpcode(is_signed ? AgentExpression::eOpRemSigned
+                                  : AgentExpression::eOpRemUnsigned);
+    break;
+  case Token::Amp:
+    m_expr.AppendOpcode(AgentExpression::eOpBitAnd);
+    break;
+  case Token::Pipe:
+    m_expr.AppendOpcode(AgentExpression::eOpBitOr);
+    break;
+  case Token::Caret:
+    m_expr.AppendOpcode(AgentExpression::eOpBitXor);
+    break;
+  default:
+    return SetError("unsupported operator in condition");
+  }
+
+  if (is_comparison) {
+    result = IntType();
+  } else {
+    // Wrap the result around the way the target would.
+    EmitConvert({8, is_signed, false}, common);
+    result = common;
+  }
+  return true;
+}
+
+static void EmitAddOffset(AgentExpression &expr, int64_t offset) {
+  if (offset == 0)
+    return;
+  if (offset > 0) {
+    expr.AppendConstant(offset);
+    expr.AppendOpcode(AgentExpression::eOpAdd);
+  } else {
+    expr.AppendConstant(-static_cast<uint64_t>(offset));
+    expr.AppendOpcode(AgentExpression::eOpSub);
+  }
+}
+
+// Look for a data member called \a name in \a type or any of its direct base
+// classes.  \a bit_offset is set to the member's offset from the start of
+// \a type.
+static bool FindMember(const CompilerType &type, llvm::StringRef name,
+                       uint64_t &bit_offset, CompilerType &member_type) {
+  const CompilerType record_type = type.GetCanonicalType();
+  const uint32_t num_fields = record_type.GetNumFields();
+  for (uint32_t i = 0; i < num_fields; ++i) {
+    std::string field_name;
+    uint64_t field_bit_offset = 0;
+    uint32_t bitfield_bit_size = 0;
+    bool is_bitfield = false;
+    CompilerType field_type = record_type.GetFieldAtIndex(
+        i, field_name, &field_bit_offset, &bitfield_bit_size, &is_bitfield);
+    if (field_name != name)
+      continue;
+    if (is_bitfield)
+      return false;
+    bit_offset = field_bit_offset;
+    member_type = field_type;
+    return true;
+  }
+
+  const uint32_t num_bases = record_type.GetNumDirectBaseClasses();
+  for (uint32_t i = 0; i < num_bases; ++i) {
+    uint32_t base_bit_offset = 0;
+    CompilerType base_type =
+        record_type.GetDirectBaseClassAtIndex(i, &base_bit_offset);
+    if (FindMember(base_type, name, bit_offset, member_type)) {
+      bit_offset += base_bit_offset;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ConditionCompiler::EmitVariable(llvm::StringRef name, ValueType &type) {
+  SymbolContext sc;
+  m_address.CalculateSymbolContext(&sc, eSymbolContextModule |
+                                            eSymbolContextCompUnit |
+                                            eSymbolContextFunction |
+                                            eSymbolContextBlock);
+  const ConstString var_name(name);
+
+  // Look for locals first, innermost block outwards, then for globals unless
+  // the name could also be a class member.
+  VariableSP var_sp;
+  if (sc.block) {
+    VariableList locals;
+    sc.block->AppendVariables(true, true, true,
+                              [](Variable *) { return true; }, &locals);
+    var_sp = locals.FindVariable(var_name);
+  }
+  if (!var_sp) {
+    // In a method, an unqualified name may be a member of the method's class
+    // (or of "self"), which the expression parser would pick over any global.
+    LanguageType method_language = eLanguageTypeUnknown;
+    bool is_instance_method = false;
+    ConstString object_name;
+    if (sc.GetFunctionMethodInfo(method_language, is_instance_method,
+                                 object_name))
+      return SetError("'%s' may be a member of the method's class",
+                      var_name.AsCString());
+  }
+  if (!var_sp && sc.comp_unit) {
+    VariableListSP globals_sp = sc.comp_unit->GetVariableList(true);
+    if (globals_sp)
+      var_sp = globals_sp->FindVariable(var_name);
+  }
+  if (!var_sp) {
+    VariableList globals;
+    m_thread.GetProcess()->GetTarget().GetImages().FindGlobalVariables(
+        var_name, 2, globals);
+    if (globals.GetSize() == 1)
+      var_sp = globals.GetVariableAtIndex(0);
+  }
+  if (!var_sp)
+    return SetError("no unique variable named '%s'", var_name.AsCString());
+  if (!var_sp->LocationIsValidForAddress(m_address))
+    return SetError("'%s' isn't available at the breakpoint",
+                    var_name.AsCString());
+
+  Type *var_type = var_sp->GetType();
+  if (!var_type)
+    return SetError("'%s' has no type", var_name.AsCString());
+  CompilerType compiler_type = var_type->GetFullCompilerType();
+
+  DWARFExpression &location = var_sp->LocationExpression();
+  DataExtractor data;
+  if (location.IsLocationList() || !location.GetExpressionData(data))
+    return SetError("'%s' has an unsupported location", var_name.AsCString());
+
+  SymbolContext var_sc;
+  var_sp->CalculateSymbolContext(&var_sc);
+  if (!var_sc.module_sp)
+    var_sc.module_sp = sc.module_sp;
+  var_sc.function = sc.function;
+
+  bool is_register_value = false;
+  if (!EmitLocation(data, static_cast<RegisterKind>(location.GetRegisterKind()),
+                    var_sc, false, is_register_value))
+    return false;
+
+  // Member accesses only move the address on top of the stack, except that
+  // "->" first loads the pointer.
+  std::string path = var_name.GetStringRef().str();
+  while (m_token == Token::Dot || m_token == Token::Arrow) {
+    const bool is_arrow = m_token == Token::Arrow;
+    Lex();
+    if (m_token != Token::Identifier)
+      return SetError("expected a member name after '%s'", path.c_str());
+    const std::string member_name = m_token_text.str();
+    Lex();
+
+    if (is_arrow) {
+      compiler_type = compiler_type.GetCanonicalType();
+      if (!compiler_type.IsPointerType())
+        return SetError("'%s' isn't a pointer", path.c_str());
+      if (!is_register_value &&
+          !m_expr.AppendDereference(compiler_type.GetByteSize(nullptr)))
+        return SetError("'%s' has an unsupported size", path.c_str());
+      compiler_type = compiler_type.GetPointeeType();
+      is_register_value = false;
+    } else if (is_register_value) {
+      return SetError("'%s' lives in a register", path.c_str());
+    }
+
+    uint64_t bit_offset = 0;
+    CompilerType member_type;
+    if (!FindMember(compiler_type, member_name, bit_offset, member_type))
+      return SetError("'%s' has no member named '%s'", path.c_str(),
+                      member_name.c_str());
+    if (bit_offset % 8 != 0)
+      return SetError("bit-field members are not supported");
+    EmitAddOffset(m_expr, bit_offset / 8);
+    compiler_type = member_type;
+    path += is_arrow ? "->" : ".";
+    path += member_name;
+  }
+
+  CompilerType value_type = compiler_type.GetCanonicalType();
+  bool is_signed = false;
+  type.is_pointer = false;
+  if (value_type.IsPointerType()) {
+    type.is_pointer = true;
+  } else if (!value_type.IsIntegerOrEnumerationType(is_signed)) {
+    return SetError("'%s' isn't an integer or a pointer", path.c_str());
+  }
+  type.is_signed = is_signed;
+  const uint64_t byte_size = value_type.GetByteSize(nullptr);
+  if (byte_size != 1 && byte_size != 2 && byte_size != 4 && byte_size != 8)
+    return SetError("'%s' has an unsupported size", path.c_str());
+  type.byte_size = byte_size;
+
+  if (is_register_value) {
+    EmitConvert({8, type.is_signed, false}, type);
+  } else {
+    m_expr.AppendDereference(byte_size);
+    if (type.is_signed && byte_size < 8)
+      m_expr.AppendSignExtend(byte_size * 8);
+  }
+  return true;
+}
+
+bool ConditionCompiler::EmitRegister(lldb::RegisterKind kind,
+                                     uint32_t reg_num) {
+  RegisterContextSP reg_ctx_sp = m_thread.GetRegisterContext();
+  if (!reg_ctx_sp)
+    return SetError("no register context");
+  const uint32_t lldb_reg_num =
+      reg_ctx_sp->ConvertRegisterKindToRegisterNumber(kind, reg_num);
+  const RegisterInfo *reg_info =
+      lldb_reg_num == LLDB_INVALID_REGNUM
+          ? nullptr
+          : reg_ctx_sp->GetRegisterInfoAtIndex(lldb_reg_num);
+  if (!reg_info)
+    return SetError("unknown register %u", reg_num);
+  const uint32_t target_reg_num = reg_info->kinds[m_reg_kind];
+  if (target_reg_num == LLDB_INVALID_REGNUM || target_reg_num > UINT16_MAX)
+    return SetError("register %s has no number for the condition evaluator",
+                    reg_info->name);
+  m_expr.AppendRegister(target_reg_num);
+  return true;
+}
+
+const RegisterInfo *ConditionCompiler::FindRegister(llvm::StringRef name) {
+  RegisterContextSP reg_ctx_sp = m_thread.GetRegisterContext();
+  if (!reg_ctx_sp) {
+    SetError("no register context");
+    return nullptr;
+  }
+  const RegisterInfo *reg_info =
+      name.empty() ? nullptr : reg_ctx_sp->GetRegisterInfoByName(name);
+  if (!reg_info)
+    SetError("unknown register '$%s'", name.str().c_str());
+  return reg_info;
+}
+
+bool ConditionCompiler::EmitNamedRegister(llvm::StringRef name,
+                                          ValueType &type) {
+  const RegisterInfo *reg_info = FindRegister(name);
+  if (!reg_info)
+    return false;
+  const uint32_t byte_size = reg_info->byte_size;
+  if (byte_size != 1 && byte_size != 2 && byte_size != 4 && byte_size != 8)
+    return SetError("register '$%s' has an unsupported size",
+                    name.str().c_str());
+  if (!EmitRegister(eRegisterKindLLDB, reg_info->kinds[eRegisterKindLLDB]))
+    return false;
+  type = {static_cast<uint8_t>(byte_size), false, false};
+  return true;
+}
+
+bool ConditionCompiler::EmitFrameBase(const SymbolContext &sc) {
+  if (!sc.function)
+    return SetError("no function for the frame base");
+  DWARFExpression &frame_base = sc.function->GetFrameBaseExpression();
+  DataExtractor data;
+  if (frame_base.IsLocationList() || !frame_base.GetExpressionData(data))
+    return SetError("unsupported frame base");
+  // Whether the frame base is a register or an address computation, the
+  // value it leaves on the stack is the frame base address.
+  bool is_register_value = false;
+  return EmitLocation(data,
+                      static_cast<RegisterKind>(frame_base.GetRegisterKind()),
+                      sc, true, is_register_value);
+}
+
+bool ConditionCompiler::EmitLocation(const DataExtractor &data,
+                                     lldb::RegisterKind reg_kind,
+                                     const SymbolContext &sc,
+                                     bool is_frame_base,
+                                     bool &is_register_value) {
+  is_register_value = false;
+  lldb::offset_t offset = 0;
+  while (data.ValidOffset(offset)) {
+    // A register location or a stack value has to be the whole expression.
+    if (is_register_value)
+      return SetError("unsupported composite location");
+
+    const uint8_t op = data.GetU8(&offset);
+    if (op >= DW_OP_lit0 && op <= DW_OP_lit31) {
+      m_expr.AppendConstant(op - DW_OP_lit0);
+      continue;
+    }
+    if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+      if (!EmitRegister(reg_kind, op - DW_OP_reg0))
+        return false;
+      is_register_value = true;
+      continue;
+    }
+    if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+      const int64_t reg_offset = data.GetSLEB128(&offset);
+      if (!EmitRegister(reg_kind, op - DW_OP_breg0))
+        return false;
+      EmitAddOffset(m_expr, reg_offset);
+      continue;
+    }
+
+    switch (op) {
+    case DW_OP_addr: {
+      const lldb::addr_t file_addr = data.GetAddress(&offset);
+      Address so_addr;
+      if (!sc.module_sp || !sc.module_sp->ResolveFileAddress(file_addr, so_addr))
+        return SetError("can't resolve address 0x%" PRIx64, file_addr);
+      const lldb::addr_t load_addr =
+          so_addr.GetLoadAddress(&m_thread.GetProcess()->GetTarget());
+      if (load_addr == LLDB_INVALID_ADDRESS)
+        return SetError("address 0x%" PRIx64 " isn't loaded", file_addr);
+      m_expr.AppendConstant(load_addr);
+    } break;
+
+    case DW_OP_regx: {
+      const uint32_t reg_num = data.GetULEB128(&offset);
+      if (!EmitRegister(reg_kind, reg_num))
+        return false;
+      is_register_value = true;
+    } break;
+
+    case DW_OP_bregx: {
+      const uint32_t reg_num = data.GetULEB128(&offset);
+      const int64_t reg_offset = data.GetSLEB128(&offset);
+      if (!EmitRegister(reg_kind, reg_num))
+        return false;
+      EmitAddOffset(m_expr, reg_offset);
+    } break;
+
+    case DW_OP_fbreg: {
+      if (is_frame_base)
+        return SetError("frame base refers to itself");
+      const int64_t fb_offset = data.GetSLEB128(&offset);
+      if (!EmitFrameBase(sc))
+        return false;
+      EmitAddOffset(m_expr, fb_offset);
+    } break;
+
+    case DW_OP_call_frame_cfa: {
+      // The CFA at the breakpoint address is a fixed register plus offset
+      // for any sane unwind plan, so it can be computed from registers.
+      if (!sc.function || !sc.module_sp || !sc.module_sp->GetObjectFile())
+        return SetError("no unwind information for the CFA");
+      SymbolContext unwind_sc(sc);
+      FuncUnwindersSP unwinders_sp =
+          sc.module_sp->GetObjectFile()
+              ->GetUnwindTable()
+              .GetFuncUnwindersContainingAddress(m_address, unwind_sc);
+      const int function_offset =
+          m_address.GetFileAddress() -
+          sc.function->GetAddressRange().GetBaseAddress().GetFileAddress();
+      UnwindPlanSP plan_sp =
+          unwinders_sp
+              ? unwinders_sp->GetUnwindPlanAtNonCallSite(
+                    m_thread.GetProcess()->GetTarget(), m_thread,
+                    function_offset)
+              : UnwindPlanSP();
+      UnwindPlan::RowSP row_sp =
+          plan_sp ? plan_sp->GetRowForFunctionOffset(function_offset)
+                  : UnwindPlan::RowSP();
+      if (!row_sp || !row_sp->GetCFAValue().IsRegisterPlusOffset())
+        return SetError("unsupported CFA rule at the breakpoint");
+      if (!EmitRegister(plan_sp->GetRegisterKind(),
+                        row_sp->GetCFAValue().GetRegisterNumber()))
+        return false;
+      EmitAddOffset(m_expr, row_sp->GetCFAValue().GetOffset());
+    } break;
+
+    case DW_OP_plus_uconst:
+      m_expr.AppendConstant(data.GetULEB128(&offset));
+      m_expr.AppendOpcode(AgentExpression::eOpAdd);
+      break;
+    case DW_OP_constu:
+      m_expr.AppendConstant(data.GetULEB128(&offset));
+      break;
+    case DW_OP_consts:
+      m_expr.AppendConstant(data.GetSLEB128(&offset));
+      break;
+    case DW_OP_const1u:
+      m_expr.AppendConstant(data.GetU8(&offset));
+      break;
+    case DW_OP_const2u:
+      m_expr.AppendConstant(data.GetU16(&offset));
+      break;
+    case DW_OP_const4u:
+      m_expr.AppendConstant(data.GetU32(&offset));
+      break;
+    case DW_OP_const8u:
+      m_expr.AppendConstant(data.GetU64(&offset));
+      break;
+    case DW_OP_const1s:
+      m_expr.AppendConstant(static_cast<int8_t>(data.GetU8(&offset)));
+      break;
+    case DW_OP_const2s:
+      m_expr.AppendConstant(static_cast<int16_t>(data.GetU16(&offset)));
+      break;
+    case DW_OP_const4s:
+      m_expr.AppendConstant(static_cast<int32_t>(data.GetU32(&offset)));
+      break;
+    case DW_OP_const8s:
+      m_expr.AppendConstant(data.GetU64(&offset));
+      break;
+    case DW_OP_plus:
+      m_expr.AppendOpcode(AgentExpression::eOpAdd);
+      break;
+    case DW_OP_minus:
+      m_expr.AppendOpcode(AgentExpression::eOpSub);
+      break;
+    case DW_OP_deref:
+      if (!m_expr.AppendDereference(data.GetAddressByteSize()))
+        return SetError("unsupported address size");
+      break;
+    case DW_OP_stack_value:
+      // The value itself rather than its address is on the stack, just as
+      // for a register location.
+      is_register_value = true;
+      break;
+    default:
+      return SetError("unsupported DWARF operation 0x%2.2x", op);
+    }
+  }
+  return true;
+}
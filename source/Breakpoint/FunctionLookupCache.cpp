@@ -0,0 +1,75 @@
+//===-- FunctionLookupCache.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Breakpoint/FunctionLookupCache.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+void FunctionLookupCache::BeginBatch() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_batch_depth++ == 0) {
+    m_num_lookups = 0;
+    m_num_reused = 0;
+  }
+}
+
+void FunctionLookupCache::EndBatch() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_batch_depth > 0 && --m_batch_depth == 0)
+    m_entries.clear();
+}
+
+size_t FunctionLookupCache::FindFunctions(Module &module,
+                                          const Module::LookupInfo &lookup,
+                                          bool include_symbols,
+                                          bool include_inlines,
+                                          SymbolContextList &sc_list) {
+  const bool append = true;
+  const Key key(&module, lookup.GetLookupName().GetCString(),
+                lookup.GetNameTypeMask(), include_symbols, include_inlines);
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_batch_depth == 0)
+      return module.FindFunctions(lookup.GetLookupName(), nullptr,
+                                  lookup.GetNameTypeMask(), include_symbols,
+                                  include_inlines, append, sc_list);
+    auto pos = m_entries.find(key);
+    if (pos != m_entries.end()) {
+      ++m_num_reused;
+      return sc_list.AppendIfUnique(pos->second.sc_list, true);
+    }
+  }
+
+  // Don't hold the lock while looking in the module, which takes the
+  // module's own locks.  Two threads may then both run the lookup, and the
+  // first result stored wins.
+  Entry entry;
+  entry.module_sp = module.shared_from_this();
+  module.FindFunctions(lookup.GetLookupName(), nullptr,
+                       lookup.GetNameTypeMask(), include_symbols,
+                       include_inlines, append, entry.sc_list);
+  const size_t num_added = sc_list.AppendIfUnique(entry.sc_list, true);
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  ++m_num_lookups;
+  if (m_batch_depth > 0)
+    m_entries.emplace(key, std::move(entry));
+  return num_added;
+}
+
+size_t FunctionLookupCache::GetNumLookups() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_num_lookups;
+}
+
+size_t FunctionLookupCache::GetNumReused() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_num_reused;
+}
@@ -28,6 +28,7 @@
 #include "lldb/Interpreter/OptionValueUInt64.h"
 #include "lldb/Interpreter/Options.h"
 #include "lldb/Target/Language.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
@@ -60,6 +61,7 @@ static constexpr OptionDefinition g_breakpoint_modify_options[] = {
   { LLDB_OPT_SET_1, false, "queue-name",   'q', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeQueueName,   "The breakpoint stops only for threads in the queue whose name is given by this argument." },
   { LLDB_OPT_SET_1, false, "condition",    'c', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeExpression,  "The breakpoint stops only if this condition expression evaluates to true." },
   { LLDB_OPT_SET_1, false, "auto-continue",'G', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeBoolean,     "The breakpoint will auto-continue after running its commands." },
+  { LLDB_OPT_SET_1, false, "collect",      'Y', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeExpression,  "Make the breakpoint a tracepoint that records this register ($name), value (expression) or memory (expression@size) each time its condition is true, without stopping.  Can be provided more than once.  Use \"breakpoint trace\" to read the records." },
   { LLDB_OPT_SET_2, false, "enable",       'e', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,        "Enable the breakpoint." },
   { LLDB_OPT_SET_3, false, "disable",      'd', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,        "Disable the breakpoint." },
   { LLDB_OPT_SET_4, false, "command",      'C', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeCommand,     "A command to run when the breakpoint is hit, can be provided more than once, the commands will get run in order left to right." },
@@ -93,6 +95,9 @@ public:
     case 'C':
       m_commands.push_back(option_arg);
       break;
+    case 'Y':
+      m_collect.push_back(option_arg);
+      break;
     case 'd':
       m_bp_opts.SetEnabled(false);
       break;
@@ -170,9 +175,12 @@ public:
   void OptionParsingStarting(ExecutionContext *execution_context) override {
     m_bp_opts.Clear();
     m_commands.clear();
+    m_collect.clear();
   }
   
   Status OptionParsingFinished(ExecutionContext *execution_context) override {
+    if (!m_collect.empty())
+      m_bp_opts.SetTracepointCollect(m_collect);
     if (!m_commands.empty())
     {
       if (!m_commands.empty())
@@ -195,6 +203,7 @@ public:
   }
 
   std::vector<std::string> m_commands;
+  std::vector<std::string> m_collect;
   BreakpointOptions m_bp_opts;
 
 };
@@ -888,6 +897,7 @@ protected:
     // Now set the various options that were passed in:
     if (bp_sp) {
       bp_sp->GetOptions()->CopyOverSetOptions(m_bp_opts.GetBreakpointOptions());
+      bp_sp->UpdateSiteConditions();
 
       if (!m_options.m_breakpoint_names.empty()) {
         Status name_error;
@@ -1034,12 +1044,15 @@ protected:
           if (cur_bp_id.GetLocationID() != LLDB_INVALID_BREAK_ID) {
             BreakpointLocation *location =
                 bp->FindLocationByID(cur_bp_id.GetLocationID()).get();
-            if (location)
+            if (location) {
               location->GetLocationOptions()
                   ->CopyOverSetOptions(m_bp_opts.GetBreakpointOptions());
+              location->UpdateSiteConditions();
+            }
           } else {
             bp->GetOptions()
                 ->CopyOverSetOptions(m_bp_opts.GetBreakpointOptions());
+            bp->UpdateSiteConditions();
           }
         }
       }
@@ -2522,6 +2535,92 @@ private:
   CommandOptions m_options;
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectBreakpointTrace
+//-------------------------------------------------------------------------
+#pragma mark Trace
+class CommandObjectBreakpointTrace : public CommandObjectParsed {
+public:
+  CommandObjectBreakpointTrace(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "breakpoint trace",
+                            "Print and discard the records tracepoints have "
+                            "collected since the last time.  Breakpoints "
+                            "become tracepoints with \"breakpoint set "
+                            "--collect\".",
+                            "breakpoint trace",
+                            eCommandRequiresProcess) {}
+
+  ~CommandObjectBreakpointTrace() override = default;
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (!command.empty()) {
+      result.AppendErrorWithFormat("%s takes no arguments.",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    Process *process = m_exe_ctx.GetProcessPtr();
+    std::vector<TracepointRecord> records;
+    uint64_t num_dropped = 0;
+    Status error = process->GetTracepointRecords(records, num_dropped);
+    if (error.Fail()) {
+      result.AppendErrorWithFormat("error reading tracepoint records: %s.",
+                                   error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    Stream &strm = result.GetOutputStream();
+    Target &target = process->GetTarget();
+    for (const TracepointRecord &record : records) {
+      BreakpointLocationSP loc_sp =
+          BreakpointLocation::FindTracepointLocation(target, record.id);
+      if (loc_sp)
+        strm.Printf("%d.%d", loc_sp->GetBreakpoint().GetID(), loc_sp->GetID());
+      else
+        strm.Printf("<unknown tracepoint 0x%" PRIx64 ">", record.id);
+      strm.Printf(": tid = 0x%" PRIx64 ", pc = 0x%" PRIx64 "\n", record.tid,
+                  record.pc);
+
+      // The collect list may have changed since the record was taken; only
+      // name the values while it still lines up.
+      std::vector<std::string> names;
+      if (loc_sp)
+        names = loc_sp->GetTracepointCollect();
+      if (names.size() != record.values.size())
+        names.clear();
+      strm.IndentMore();
+      for (size_t i = 0; i < record.values.size(); ++i) {
+        const TracepointRecord::Value &value = record.values[i];
+        strm.Indent();
+        if (names.empty())
+          strm.Printf("[%zu]", i);
+        else
+          strm.PutCString(names[i]);
+        strm.PutCString(" = ");
+        if (value.collected) {
+          strm.PutCString("0x");
+          strm.PutBytesAsRawHex8(value.bytes.data(), value.bytes.size());
+        } else
+          strm.PutCString("<unavailable>");
+        strm.EOL();
+      }
+      strm.IndentLess();
+    }
+    if (num_dropped > 0)
+      strm.Printf("%" PRIu64 " records were dropped because the buffer was "
+                  "full.\n",
+                  num_dropped);
+    if (records.empty() && num_dropped == 0)
+      strm.PutCString("No tracepoint records.\n");
+
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectMultiwordBreakpoint
 //-------------------------------------------------------------------------
@@ -2555,6 +2654,8 @@ CommandObjectMultiwordBreakpoint::CommandObjectMultiwordBreakpoint(
       new CommandObjectBreakpointWrite(interpreter));
   CommandObjectSP read_command_object(
       new CommandObjectBreakpointRead(interpreter));
+  CommandObjectSP trace_command_object(
+      new CommandObjectBreakpointTrace(interpreter));
 
   list_command_object->SetCommandName("breakpoint list");
   enable_command_object->SetCommandName("breakpoint enable");
@@ -2567,6 +2668,7 @@ CommandObjectMultiwordBreakpoint::CommandObjectMultiwordBreakpoint(
   name_command_object->SetCommandName("breakpoint name");
   write_command_object->SetCommandName("breakpoint write");
   read_command_object->SetCommandName("breakpoint read");
+  trace_command_object->SetCommandName("breakpoint trace");
 
   LoadSubCommand("list", list_command_object);
   LoadSubCommand("enable", enable_command_object);
@@ -2579,6 +2681,7 @@ CommandObjectMultiwordBreakpoint::CommandObjectMultiwordBreakpoint(
   LoadSubCommand("name", name_command_object);
   LoadSubCommand("write", write_command_object);
   LoadSubCommand("read", read_command_object);
+  LoadSubCommand("trace", trace_command_object);
 }
 
 CommandObjectMultiwordBreakpoint::~CommandObjectMultiwordBreakpoint() = default;
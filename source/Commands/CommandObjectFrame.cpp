@@ -417,6 +417,61 @@ protected:
 };
 
 #pragma mark CommandObjectFrameVariable
+
+static constexpr OptionDefinition g_frame_variable_paging_options[] = {
+    // clang-format off
+  {LLDB_OPT_SET_1, false, "output-limit", 'B', OptionParser::eRequiredArgument, nullptr, {}, 0, eArgTypeByteSize, "Stop printing the children of a variable once about this many bytes were printed." },
+  {LLDB_OPT_SET_1, false, "continue",     'C', OptionParser::eNoArgument,       nullptr, {}, 0, eArgTypeNone,     "Print the children of the variable that the previous 'frame variable' of the same variable path left out." },
+    // clang-format on
+};
+
+class OptionGroupFrameVariablePaging : public OptionGroup {
+public:
+  OptionGroupFrameVariablePaging() : m_output_limit(0), m_continue(false) {}
+
+  ~OptionGroupFrameVariablePaging() override = default;
+
+  llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+    return llvm::makeArrayRef(g_frame_variable_paging_options);
+  }
+
+  Status SetOptionValue(uint32_t option_idx, llvm::StringRef option_value,
+                        ExecutionContext *execution_context) override {
+    Status error;
+    const int short_option =
+        g_frame_variable_paging_options[option_idx].short_option;
+
+    switch (short_option) {
+    case 'B':
+      if (option_value.getAsInteger(0, m_output_limit) ||
+          m_output_limit == 0) {
+        m_output_limit = 0;
+        error.SetErrorStringWithFormat("invalid output limit '%s'",
+                                       option_value.str().c_str());
+      }
+      break;
+
+    case 'C':
+      m_continue = true;
+      break;
+
+    default:
+      error.SetErrorStringWithFormat("unrecognized short option '%c'",
+                                     short_option);
+      break;
+    }
+    return error;
+  }
+
+  void OptionParsingStarting(ExecutionContext *execution_context) override {
+    m_output_limit = 0;
+    m_continue = false;
+  }
+
+  size_t m_output_limit;
+  bool m_continue;
+};
+
 //----------------------------------------------------------------------
 // List images with associated information
 //----------------------------------------------------------------------
@@ -447,7 +502,8 @@ public:
         m_option_variable(
             true), // Include the frame specific options by passing "true"
         m_option_format(eFormatDefault),
-        m_varobj_options() {
+        m_varobj_options(), m_paging_options(), m_next_page_path(),
+        m_next_page_stack_id(), m_next_page_output_limit(0) {
     CommandArgumentEntry arg;
     CommandArgumentData var_name_arg;
 
@@ -468,6 +524,7 @@ public:
                               OptionGroupFormat::OPTION_GROUP_GDB_FMT,
                           LLDB_OPT_SET_1);
     m_option_group.Append(&m_varobj_options, LLDB_OPT_SET_ALL, LLDB_OPT_SET_1);
+    m_option_group.Append(&m_paging_options, LLDB_OPT_SET_ALL, LLDB_OPT_SET_1);
     m_option_group.Finalize();
   }
 
@@ -508,6 +565,35 @@ protected:
     return llvm::StringRef::withNullAsEmpty(nullptr);
   }
 
+  // Prints the value of the variable path \a path, starting at the child the
+  // previous print of the same path stopped at if --continue was given, and
+  // remembers where this print stopped.
+  void DumpVariablePage(ValueObjectSP valobj_sp, llvm::StringRef path,
+                        StackFrame &frame, DumpValueObjectOptions &options,
+                        CommandReturnObject &result) {
+    size_t output_limit = m_paging_options.m_output_limit;
+    options.SetChildCursor();
+    if (m_paging_options.m_continue) {
+      options.SetChildCursor(m_next_page_cursor);
+      if (output_limit == 0)
+        output_limit = m_next_page_output_limit;
+    }
+    options.SetOutputBudget(
+        DumpValueObjectOptions::OutputBudget(output_limit));
+
+    valobj_sp->DumpPage(result.GetOutputStream(), options);
+
+    m_next_page_cursor = options.m_child_cursor;
+    m_next_page_path = path;
+    m_next_page_stack_id = frame.GetStackID();
+    m_next_page_output_limit = output_limit;
+    if (m_next_page_cursor.IsValid() && output_limit)
+      result.GetOutputStream().Printf(
+          "note: output limit reached, use 'frame variable --continue %s' to "
+          "print more.\n",
+          path.str().c_str());
+  }
+
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     // No need to check "frame" for validity as eCommandRequiresFrame ensures
     // it is valid
@@ -538,6 +624,24 @@ protected:
     DumpValueObjectOptions options(m_varobj_options.GetAsDumpOptions(
         eLanguageRuntimeDescriptionDisplayVerbosityFull, eFormatDefault,
         summary_format_sp));
+    options.SetOutputBudget(
+        DumpValueObjectOptions::OutputBudget(m_paging_options.m_output_limit));
+
+    if (m_paging_options.m_continue) {
+      if (command.GetArgumentCount() != 1 || m_option_variable.use_regex) {
+        result.AppendError("--continue takes exactly one variable path.");
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+      if (!m_next_page_cursor.IsValid() ||
+          command[0].ref != m_next_page_path ||
+          frame->GetStackID() != m_next_page_stack_id) {
+        result.AppendErrorWithFormat("no children of '%s' left to print.\n",
+                                     command[0].c_str());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+    }
 
     const SymbolContext &sym_ctx =
         frame->GetSymbolContext(eSymbolContextFunction);
@@ -637,7 +741,7 @@ protected:
               Stream &output_stream = result.GetOutputStream();
               options.SetRootValueObjectName(
                   valobj_sp->GetParent() ? entry.c_str() : nullptr);
-              valobj_sp->Dump(output_stream, options);
+              DumpVariablePage(valobj_sp, entry.ref, *frame, options, result);
             } else {
               const char *error_cstr = error.AsCString(nullptr);
               if (error_cstr)
@@ -755,6 +859,12 @@ protected:
   OptionGroupVariable m_option_variable;
   OptionGroupFormat m_option_format;
   OptionGroupValueObjectDisplay m_varobj_options;
+  OptionGroupFrameVariablePaging m_paging_options;
+  // Where the last print of a single variable path stopped.
+  DumpValueObjectOptions::ChildCursor m_next_page_cursor;
+  std::string m_next_page_path;
+  StackID m_next_page_stack_id;
+  size_t m_next_page_output_limit;
 };
 
 #pragma mark CommandObjectFrameRecognizer
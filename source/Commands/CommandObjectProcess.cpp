@@ -1015,19 +1015,32 @@ public:
 protected:
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     Process *process = m_exe_ctx.GetProcessPtr();
+    PlatformSP platform = process->GetTarget().GetPlatform();
+
+    // Images that don't need installing are all opened with one call.
+    if (!m_options.do_install) {
+      std::vector<FileSpec> image_specs;
+      for (auto &entry : command.entries()) {
+        FileSpec image_spec(entry.ref, false);
+        platform->ResolveRemotePath(image_spec, image_spec);
+        image_specs.push_back(image_spec);
+      }
+
+      std::vector<Status> errors;
+      std::vector<uint32_t> image_tokens =
+          platform->LoadImages(process, image_specs, errors);
+      for (size_t i = 0; i < image_tokens.size(); ++i)
+        AppendLoadResult(command.entries()[i].ref, image_tokens[i], errors[i],
+                         result);
+      return result.Succeeded();
+    }
 
     for (auto &entry : command.entries()) {
       Status error;
-      PlatformSP platform = process->GetTarget().GetPlatform();
       llvm::StringRef image_path = entry.ref;
       uint32_t image_token = LLDB_INVALID_IMAGE_TOKEN;
 
-      if (!m_options.do_install) {
-        FileSpec image_spec(image_path, false);
-        platform->ResolveRemotePath(image_spec, image_spec);
-        image_token =
-            platform->LoadImage(process, FileSpec(), image_spec, error);
-      } else if (m_options.install_path) {
+      if (m_options.install_path) {
         FileSpec image_spec(image_path, true);
         platform->ResolveRemotePath(m_options.install_path,
                                     m_options.install_path);
@@ -1039,21 +1052,26 @@ protected:
             platform->LoadImage(process, image_spec, FileSpec(), error);
       }
 
-      if (image_token != LLDB_INVALID_IMAGE_TOKEN) {
-        result.AppendMessageWithFormat(
-            "Loading \"%s\"...ok\nImage %u loaded.\n", image_path.str().c_str(),
-            image_token);
-        result.SetStatus(eReturnStatusSuccessFinishResult);
-      } else {
-        result.AppendErrorWithFormat("failed to load '%s': %s",
-                                     image_path.str().c_str(),
-                                     error.AsCString());
-        result.SetStatus(eReturnStatusFailed);
-      }
+      AppendLoadResult(image_path, image_token, error, result);
     }
     return result.Succeeded();
   }
 
+  void AppendLoadResult(llvm::StringRef image_path, uint32_t image_token,
+                        const Status &error, CommandReturnObject &result) {
+    if (image_token != LLDB_INVALID_IMAGE_TOKEN) {
+      result.AppendMessageWithFormat(
+          "Loading \"%s\"...ok\nImage %u loaded.\n", image_path.str().c_str(),
+          image_token);
+      result.SetStatus(eReturnStatusSuccessFinishResult);
+    } else {
+      result.AppendErrorWithFormat("failed to load '%s': %s",
+                                   image_path.str().c_str(),
+                                   error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+    }
+  }
+
   CommandOptions m_options;
 };
 
@@ -1310,17 +1328,61 @@ protected:
 //-------------------------------------------------------------------------
 #pragma mark CommandObjectProcessStatus
 
+static constexpr OptionDefinition g_process_status_options[] = {
+    // clang-format off
+  { LLDB_OPT_SET_1, false, "statistics", 's', OptionParser::eNoArgument, nullptr, {}, 0, eArgTypeNone, "Show how many memory reads the memory cache and module object files answered, and how much was read from the process." },
+    // clang-format on
+};
+
 class CommandObjectProcessStatus : public CommandObjectParsed {
 public:
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options() { OptionParsingStarting(nullptr); }
+
+    ~CommandOptions() override = default;
+
+    Status SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                          ExecutionContext *execution_context) override {
+      Status error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 's':
+        m_statistics = true;
+        break;
+      default:
+        error.SetErrorStringWithFormat("invalid short option character '%c'",
+                                       short_option);
+        break;
+      }
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      m_statistics = false;
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_process_status_options);
+    }
+
+    // Instance variables to hold the values for command options.
+    bool m_statistics;
+  };
+
   CommandObjectProcessStatus(CommandInterpreter &interpreter)
       : CommandObjectParsed(
             interpreter, "process status",
             "Show status and stop location for the current target process.",
             "process status",
-            eCommandRequiresProcess | eCommandTryTargetAPILock) {}
+            eCommandRequiresProcess | eCommandTryTargetAPILock),
+        m_options() {}
 
   ~CommandObjectProcessStatus() override = default;
 
+  Options *GetOptions() override { return &m_options; }
+
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     Stream &strm = result.GetOutputStream();
     result.SetStatus(eReturnStatusSuccessFinishNoResult);
@@ -1335,8 +1397,22 @@ public:
     process->GetStatus(strm);
     process->GetThreadStatus(strm, only_threads_with_stop_reason, start_frame,
                              num_frames, num_frames_with_source, stop_format);
+    if (m_options.m_statistics) {
+      MemoryCache::Statistics stats = process->GetMemoryCacheStatistics();
+      strm.PutCString("Memory cache statistics:\n");
+      strm.Printf("  reads: %" PRIu64 "\n", stats.reads);
+      strm.Printf("  hits: %" PRIu64 "\n", stats.reads - stats.misses);
+      strm.Printf("  misses: %" PRIu64 "\n", stats.misses);
+      strm.Printf("  process reads: %" PRIu64 "\n", stats.inferior_reads);
+      strm.Printf("  bytes read: %" PRIu64 "\n", stats.bytes_read);
+      strm.Printf("  bytes prefetched: %" PRIu64 "\n", stats.bytes_prefetched);
+      strm.Printf("Reads from object files: %" PRIu64 "\n",
+                  process->GetObjectFileTextReadCount());
+    }
     return result.Succeeded();
   }
+
+  CommandOptions m_options;
 };
 
 //-------------------------------------------------------------------------
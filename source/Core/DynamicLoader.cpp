@@ -14,15 +14,19 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/TaskPool.h"
 #include "lldb/Symbol/ObjectFile.h" // for ObjectFile
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/ConstString.h"     // for ConstString
+#include "lldb/Utility/Log.h"
 #include "lldb/lldb-private-interfaces.h" // for DynamicLoaderCreateInstance
 
 #include "llvm/ADT/StringRef.h" // for StringRef
 
+#include <chrono>
 #include <memory> // for shared_ptr, unique_ptr
 
 #include <assert.h> // for assert
@@ -152,6 +156,50 @@ DynamicLoader::GetSectionListFromModule(const ModuleSP module) const {
   return sections;
 }
 
+std::vector<ModuleSP>
+DynamicLoader::PrepareModules(const std::vector<FileSpec> &files) {
+  Target &target = m_process->GetTarget();
+  std::vector<ModuleSP> modules(files.size());
+  // Only local files: a remote platform may have to fetch every file, and it
+  // doesn't expect to be asked from several threads.  Image search paths
+  // send Target::GetSharedModule to other files than the ones named here, so
+  // leave those targets to it too.
+  PlatformSP platform_sp = target.GetPlatform();
+  if (files.size() < 2 || !target.GetParallelModuleLoad() || !platform_sp ||
+      !platform_sp->IsHost() || target.GetImageSearchPathList().GetSize())
+    return modules;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_DYNAMIC_LOADER));
+  const auto start = std::chrono::steady_clock::now();
+  const ArchSpec arch = target.GetArchitecture();
+  const FileSpecList search_paths = target.GetExecutableSearchPaths();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  // Preloading symbols indexes the DWARF in a group of its own, which the
+  // task preparing the module helps run while it waits.
+  TaskMapOverInt(0, files.size(), [&](size_t i) {
+    // Finding the module takes the shared module list lock, the parsing
+    // after it doesn't.
+    ModuleSpec module_spec(files[i], arch);
+    ModuleSP module_sp;
+    Status error = ModuleList::GetSharedModule(module_spec, module_sp,
+                                               &search_paths, nullptr, nullptr);
+    if (error.Fail() || !module_sp || !module_sp->GetObjectFile())
+      return;
+    module_sp->GetSectionList();
+    module_sp->GetSymbolVendor();
+    if (preload_symbols)
+      module_sp->PreloadSymbols();
+    modules[i] = module_sp;
+  });
+
+  LLDB_LOG(log, "prepared {0} modules on the task pool in {1} ms",
+           files.size(),
+           std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+               .count());
+  return modules;
+}
+
 ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
                                             addr_t link_map_addr,
                                             addr_t base_addr,
@@ -524,6 +524,16 @@ Status Value::GetValueAsData(ExecutionContext *exe_ctx, DataExtractor &data,
            SwiftASTContext::IsPossibleZeroSizeType(GetCompilerType()))
     return error;
 
+  // A process that already holds its memory, like a core file, can share
+  // the bytes of a load address with "data" instead of copying them.
+  if (data_offset == 0 && byte_size > 0 && exe_ctx &&
+      (address_type == eAddressTypeLoad || address_type == eAddressTypeFile) &&
+      !file_so_addr.IsValid()) {
+    Process *process = exe_ctx->GetProcessPtr();
+    if (process && process->GetSharedMemoryData(address, byte_size, data))
+      return error;
+  }
+
   // Make sure we have enough room within "data", and if we don't make
   // something large enough that does
   if (!data.ValidOffsetForDataOfSize(data_offset, byte_size)) {
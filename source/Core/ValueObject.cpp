@@ -2853,6 +2853,13 @@ void ValueObject::Dump(Stream &s, const DumpValueObjectOptions &options) {
   printer.PrintValueObject();
 }
 
+void ValueObject::DumpPage(Stream &s, DumpValueObjectOptions &options) {
+  auto swift_scratch_ctx_lock = SwiftASTContextLock(GetSwiftExeCtx(*this));
+  ValueObjectPrinter printer(this, &s, options);
+  printer.PrintValueObject();
+  options.SetChildCursor(printer.GetChildCursor());
+}
+
 ValueObjectSP ValueObject::CreateConstantValue(const ConstString &name) {
   ValueObjectSP valobj_sp;
 
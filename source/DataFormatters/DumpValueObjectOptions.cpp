@@ -22,7 +22,8 @@ using namespace lldb_private;
 DumpValueObjectOptions::DumpValueObjectOptions()
     : m_summary_sp(), m_root_valobj_name(),
       m_max_ptr_depth(PointerDepth{PointerDepth::Mode::Default, 0}),
-      m_decl_printing_helper(), m_pointer_as_array(), m_use_synthetic(true),
+      m_decl_printing_helper(), m_pointer_as_array(), m_output_budget(),
+      m_child_cursor(), m_use_synthetic(true),
       m_scope_already_checked(false), m_flat_output(false), m_ignore_cap(false),
       m_show_types(false), m_show_location(false), m_use_objc(false),
       m_hide_root_type(false), m_hide_name(false), m_hide_value(false),
@@ -204,3 +205,15 @@ DumpValueObjectOptions &DumpValueObjectOptions::SetPointerAsArray(
   m_pointer_as_array = ptr_array;
   return *this;
 }
+
+DumpValueObjectOptions &
+DumpValueObjectOptions::SetOutputBudget(const OutputBudget &budget) {
+  m_output_budget = budget;
+  return *this;
+}
+
+DumpValueObjectOptions &
+DumpValueObjectOptions::SetChildCursor(const ChildCursor &cursor) {
+  m_child_cursor = cursor;
+  return *this;
+}
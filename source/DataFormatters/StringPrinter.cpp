@@ -18,9 +18,15 @@
 #include "lldb/Utility/Status.h"
 
 #include "llvm/Support/ConvertUTF.h"
+#include "llvm/Support/MathExtras.h"
 
 #include <ctype.h>
 #include <locale>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace lldb;
 using namespace lldb_private;
@@ -262,6 +268,113 @@ StringPrinter::GetDefaultEscapingHelper(GetPrintableElementType elem_type) {
   llvm_unreachable("bad element type");
 }
 
+// Printable ASCII characters are copied verbatim by every escaping helper,
+// except for the quotes and the backslash, which some languages escape. Those
+// are the only bytes the fast path below is allowed to skip over.
+static inline bool IsVerbatimASCII(uint8_t c) {
+  return c >= 0x20 && c < 0x7F && c != '"' && c != '\'' && c != '\\';
+}
+
+// Returns true if any of the 8 bytes packed in word is not IsVerbatimASCII.
+static inline bool HasNonVerbatimByte(uint64_t word) {
+  const uint64_t ones = ~0ULL / 255;
+  const uint64_t highs = ones * 0x80;
+  auto has_byte = [&](uint8_t c) {
+    uint64_t x = word ^ (ones * c);
+    return ((x - ones) & ~x & highs) != 0;
+  };
+  // any byte < 0x20, or with the high bit set
+  if (((word - ones * 0x20) | word) & highs)
+    return true;
+  return has_byte(0x7F) || has_byte('"') || has_byte('\'') ||
+         has_byte('\\');
+}
+
+// Returns the first byte in [begin, end) that cannot be copied to the output
+// as-is, i.e. one that needs escaping, transcoding or terminates the string.
+// Long runs of plain ASCII (by far the most common contents of a summary) are
+// scanned 16 or 8 bytes at a time.
+static const uint8_t *FindEndOfVerbatimRun(const uint8_t *begin,
+                                           const uint8_t *end) {
+  const uint8_t *pos = begin;
+#if defined(__SSE2__)
+  const __m128i space = _mm_set1_epi8(0x20);
+  const __m128i del = _mm_set1_epi8(0x7F);
+  const __m128i dquote = _mm_set1_epi8('"');
+  const __m128i squote = _mm_set1_epi8('\'');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  while (end - pos >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+    // Signed compare: bytes >= 0x80 are negative, so this catches them too.
+    __m128i bad = _mm_cmplt_epi8(chunk, space);
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi8(chunk, del));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi8(chunk, dquote));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi8(chunk, squote));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi8(chunk, backslash));
+    if (int mask = _mm_movemask_epi8(bad))
+      return pos + llvm::countTrailingZeros(static_cast<uint32_t>(mask));
+    pos += 16;
+  }
+#endif
+  while (end - pos >= 8) {
+    uint64_t word;
+    memcpy(&word, pos, sizeof(word));
+    if (HasNonVerbatimByte(word))
+      break;
+    pos += 8;
+  }
+  while (pos < end && IsVerbatimASCII(*pos))
+    ++pos;
+  return pos;
+}
+
+// Prints [data, data_end) to the stream, running the escaping helper (if
+// any) only on the characters that are not plain ASCII. Stops at the first
+// NUL if zero_is_terminator is set.
+static void DumpPrintableBufferToStream(
+    Stream &stream, uint8_t *data, uint8_t *data_end, bool zero_is_terminator,
+    const StringPrinter::EscapingHelper &escaping_callback) {
+  if (!escaping_callback) {
+    if (zero_is_terminator) {
+      if (uint8_t *nul = static_cast<uint8_t *>(
+              memchr(data, 0, std::distance(data, data_end))))
+        data_end = nul;
+    }
+    stream.Write(data, std::distance(data, data_end));
+    return;
+  }
+
+  // since we tend to accept partial data (and even partially malformed data)
+  // we might end up with no NULL terminator before the end_ptr hence we need
+  // to take a slower route and ensure we stay within boundaries
+  while (data < data_end) {
+    uint8_t *run_end =
+        const_cast<uint8_t *>(FindEndOfVerbatimRun(data, data_end));
+    if (run_end != data) {
+      stream.Write(data, std::distance(data, run_end));
+      data = run_end;
+      continue;
+    }
+
+    if (zero_is_terminator && !*data)
+      break;
+
+    uint8_t *next_data = nullptr;
+    auto printable = escaping_callback(data, data_end, next_data);
+    auto printable_bytes = printable.GetBytes();
+    auto printable_size = printable.GetSize();
+    if (!printable_bytes || !next_data) {
+      // GetPrintable() failed on us - print one byte in a desperate resync
+      // attempt
+      printable_bytes = data;
+      printable_size = 1;
+      next_data = data + 1;
+    }
+    stream.Write(printable_bytes, printable_size);
+    data = next_data;
+  }
+}
+
 // use this call if you already have an LLDB-side buffer for the data
 template <typename SourceDataType>
 static bool DumpUTFBufferToStream(
@@ -341,34 +454,8 @@ static bool DumpUTFBufferToStream(
                     GetPrintableElementType::UTF8);
     }
 
-    // since we tend to accept partial data (and even partially malformed data)
-    // we might end up with no NULL terminator before the end_ptr hence we need
-    // to take a slower route and ensure we stay within boundaries
-    for (; utf8_data_ptr < utf8_data_end_ptr;) {
-      if (zero_is_terminator && !*utf8_data_ptr)
-        break;
-
-      if (escape_non_printables) {
-        uint8_t *next_data = nullptr;
-        auto printable =
-            escaping_callback(utf8_data_ptr, utf8_data_end_ptr, next_data);
-        auto printable_bytes = printable.GetBytes();
-        auto printable_size = printable.GetSize();
-        if (!printable_bytes || !next_data) {
-          // GetPrintable() failed on us - print one byte in a desperate resync
-          // attempt
-          printable_bytes = utf8_data_ptr;
-          printable_size = 1;
-          next_data = utf8_data_ptr + 1;
-        }
-        for (unsigned c = 0; c < printable_size; c++)
-          stream.Printf("%c", *(printable_bytes + c));
-        utf8_data_ptr = (uint8_t *)next_data;
-      } else {
-        stream.Printf("%c", *utf8_data_ptr);
-        utf8_data_ptr++;
-      }
-    }
+    DumpPrintableBufferToStream(stream, utf8_data_ptr, utf8_data_end_ptr,
+                                zero_is_terminator, escaping_callback);
   }
   if (dump_options.GetQuote() != 0)
     stream.Printf("%c", dump_options.GetQuote());
@@ -469,30 +556,8 @@ bool StringPrinter::ReadStringAndDumpToStream<
                   ASCII);
   }
 
-  // since we tend to accept partial data (and even partially malformed data)
-  // we might end up with no NULL terminator before the end_ptr hence we need
-  // to take a slower route and ensure we stay within boundaries
-  for (uint8_t *data = buffer_sp->GetBytes(); *data && (data < data_end);) {
-    if (escape_non_printables) {
-      uint8_t *next_data = nullptr;
-      auto printable = escaping_callback(data, data_end, next_data);
-      auto printable_bytes = printable.GetBytes();
-      auto printable_size = printable.GetSize();
-      if (!printable_bytes || !next_data) {
-        // GetPrintable() failed on us - print one byte in a desperate resync
-        // attempt
-        printable_bytes = data;
-        printable_size = 1;
-        next_data = data + 1;
-      }
-      for (unsigned c = 0; c < printable_size; c++)
-        options.GetStream()->Printf("%c", *(printable_bytes + c));
-      data = (uint8_t *)next_data;
-    } else {
-      options.GetStream()->Printf("%c", *data);
-      data++;
-    }
-  }
+  DumpPrintableBufferToStream(*options.GetStream(), buffer_sp->GetBytes(),
+                              data_end, true, escaping_callback);
 
   const char *suffix_token = options.GetSuffixToken();
 
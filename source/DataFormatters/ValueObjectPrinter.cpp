@@ -26,29 +26,32 @@ using namespace lldb_private;
 ValueObjectPrinter::ValueObjectPrinter(ValueObject *valobj, Stream *s) {
   if (valobj) {
     DumpValueObjectOptions options(*valobj);
-    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr);
+    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr, nullptr);
   } else {
     DumpValueObjectOptions options;
-    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr);
+    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr, nullptr);
   }
 }
 
 ValueObjectPrinter::ValueObjectPrinter(ValueObject *valobj, Stream *s,
                                        const DumpValueObjectOptions &options) {
-  Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr);
+  Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr, nullptr);
 }
 
 ValueObjectPrinter::ValueObjectPrinter(
     ValueObject *valobj, Stream *s, const DumpValueObjectOptions &options,
     const DumpValueObjectOptions::PointerDepth &ptr_depth, uint32_t curr_depth,
-    InstancePointersSetSP printed_instance_pointers) {
-  Init(valobj, s, options, ptr_depth, curr_depth, printed_instance_pointers);
+    InstancePointersSetSP printed_instance_pointers,
+    OutputBudgetStateSP output_budget) {
+  Init(valobj, s, options, ptr_depth, curr_depth, printed_instance_pointers,
+       output_budget);
 }
 
 void ValueObjectPrinter::Init(
     ValueObject *valobj, Stream *s, const DumpValueObjectOptions &options,
     const DumpValueObjectOptions::PointerDepth &ptr_depth, uint32_t curr_depth,
-    InstancePointersSetSP printed_instance_pointers) {
+    InstancePointersSetSP printed_instance_pointers,
+    OutputBudgetStateSP output_budget) {
   m_orig_valobj = valobj;
   m_valobj = nullptr;
   m_stream = s;
@@ -73,6 +76,21 @@ void ValueObjectPrinter::Init(
       printed_instance_pointers
           ? printed_instance_pointers
           : InstancePointersSetSP(new InstancePointersSet());
+  m_child_cursor.Clear();
+  m_stopped_early = false;
+  m_output_budget = output_budget;
+  if (!m_output_budget && m_options.m_output_budget) {
+    m_output_budget = std::make_shared<OutputBudgetState>();
+    if (m_options.m_output_budget.m_max_bytes > 0)
+      m_output_budget->m_bytes_limit =
+          m_stream->GetWrittenBytes() + m_options.m_output_budget.m_max_bytes;
+    if (m_options.m_output_budget.m_max_time) {
+      m_output_budget->m_has_deadline = true;
+      m_output_budget->m_deadline =
+          std::chrono::steady_clock::now() +
+          *m_options.m_output_budget.m_max_time;
+    }
+  }
 }
 
 bool ValueObjectPrinter::PrintValueObject() {
@@ -581,7 +599,7 @@ void ValueObjectPrinter::PrintChildrenPreamble() {
   }
 }
 
-void ValueObjectPrinter::PrintChild(
+bool ValueObjectPrinter::PrintChild(
     ValueObjectSP child_sp,
     const DumpValueObjectOptions::PointerDepth &curr_ptr_depth) {
   const uint32_t consumed_depth = (!m_options.m_pointer_as_array) ? 1 : 0;
@@ -599,15 +617,54 @@ void ValueObjectPrinter::PrintChild(
                                ? child_options.m_omit_summary_depth -
                                      consumed_depth
                                : 0)
-      .SetElementCount(0);
+      .SetElementCount(0)
+      .SetChildCursor();
 
   if (child_sp.get()) {
     ValueObjectPrinter child_printer(
         child_sp.get(), m_stream, child_options,
         does_consume_ptr_depth ? --curr_ptr_depth : curr_ptr_depth,
-        m_curr_depth + consumed_depth, m_printed_instance_pointers);
+        m_curr_depth + consumed_depth, m_printed_instance_pointers,
+        m_output_budget);
     child_printer.PrintValueObject();
+    return !child_printer.m_stopped_early;
   }
+  return true;
+}
+
+bool ValueObjectPrinter::IsOutputBudgetExhausted() {
+  if (!m_output_budget)
+    return false;
+  if (m_output_budget->m_exhausted)
+    return true;
+  if (m_output_budget->m_bytes_limit &&
+      m_stream->GetWrittenBytes() >= m_output_budget->m_bytes_limit)
+    m_output_budget->m_exhausted = true;
+  else if (m_output_budget->m_has_deadline &&
+           std::chrono::steady_clock::now() >= m_output_budget->m_deadline)
+    m_output_budget->m_exhausted = true;
+  return m_output_budget->m_exhausted;
+}
+
+size_t ValueObjectPrinter::GetFirstChildIndexToPrint() {
+  // Only the root value can be resumed; nested values always start over.
+  const DumpValueObjectOptions::ChildCursor &cursor = m_options.m_child_cursor;
+  if (m_curr_depth != 0 || !cursor.IsValid())
+    return 0;
+  // If the process ran since the cursor was handed out, the children may be
+  // completely different now.
+  if (m_valobj->GetUpdatePoint().GetModID().GetStopID() != cursor.m_stop_id)
+    return 0;
+  return cursor.m_next_index;
+}
+
+void ValueObjectPrinter::UpdateChildCursor(size_t next_index) {
+  if (m_curr_depth != 0)
+    return;
+  m_child_cursor.m_next_index = next_index;
+  m_child_cursor.m_stop_id =
+      m_valobj->GetUpdatePoint().GetModID().GetStopID();
+  m_child_cursor.m_valid = true;
 }
 
 uint32_t ValueObjectPrinter::GetMaxNumChildrenToPrint(bool &print_dotdotdot) {
@@ -616,16 +673,23 @@ uint32_t ValueObjectPrinter::GetMaxNumChildrenToPrint(bool &print_dotdotdot) {
   if (m_options.m_pointer_as_array)
     return m_options.m_pointer_as_array.m_element_count;
 
-  size_t num_children = synth_m_valobj->GetNumChildren();
   print_dotdotdot = false;
-  if (num_children) {
-    const size_t max_num_children =
-        m_valobj->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
-
-    if (num_children > max_num_children && !m_options.m_ignore_cap) {
-      print_dotdotdot = true;
-      return max_num_children;
-    }
+  if (m_options.m_ignore_cap)
+    return synth_m_valobj->GetNumChildren();
+
+  // The value returned is the index one past the last child to print. Only
+  // ask for one more child than we are going to show, so that providers that
+  // can count lazily don't have to walk the whole container just to tell us
+  // that it is too large.
+  const uint64_t first_child = GetFirstChildIndexToPrint();
+  const uint64_t max_num_children =
+      m_valobj->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
+  const uint64_t last_child = first_child + max_num_children;
+  size_t num_children = synth_m_valobj->GetNumChildren(
+      last_child < UINT32_MAX ? last_child + 1 : UINT32_MAX);
+  if (num_children > last_child) {
+    print_dotdotdot = true;
+    return last_child;
   }
   return num_children;
 }
@@ -695,16 +759,30 @@ void ValueObjectPrinter::PrintChildren(
   if (num_children) {
     bool any_children_printed = false;
 
-    for (size_t idx = 0; idx < num_children; ++idx) {
+    size_t idx = GetFirstChildIndexToPrint();
+    for (; idx < num_children; ++idx) {
+      if (IsOutputBudgetExhausted()) {
+        print_dotdotdot = true;
+        break;
+      }
       if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx)) {
         if (!any_children_printed) {
           PrintChildrenPreamble();
           any_children_printed = true;
         }
-        PrintChild(child_sp, curr_ptr_depth);
+        if (!PrintChild(child_sp, curr_ptr_depth)) {
+          // Resume with the child that was cut short, not the one after it.
+          print_dotdotdot = true;
+          break;
+        }
       }
     }
 
+    if (print_dotdotdot) {
+      m_stopped_early = idx < num_children;
+      UpdateChildCursor(idx);
+    }
+
     if (any_children_printed)
       PrintChildrenPostamble(print_dotdotdot);
     else {
@@ -745,13 +823,20 @@ bool ValueObjectPrinter::PrintChildrenOneLiner(bool hide_names) {
   if (num_children) {
     m_stream->PutChar('(');
 
-    for (uint32_t idx = 0; idx < num_children; ++idx) {
+    const size_t first_child = GetFirstChildIndexToPrint();
+    size_t idx = first_child;
+    for (; idx < num_children; ++idx) {
+      if (IsOutputBudgetExhausted()) {
+        print_dotdotdot = true;
+        m_stopped_early = true;
+        break;
+      }
       lldb::ValueObjectSP child_sp(synth_m_valobj->GetChildAtIndex(idx, true));
       if (child_sp)
         child_sp = child_sp->GetQualifiedRepresentationIfAvailable(
             m_options.m_use_dynamic, m_options.m_use_synthetic);
       if (child_sp) {
-        if (idx)
+        if (idx != first_child)
           m_stream->PutCString(", ");
         if (!hide_names) {
           const char *name = child_sp.get()->GetName().AsCString();
@@ -767,9 +852,10 @@ bool ValueObjectPrinter::PrintChildrenOneLiner(bool hide_names) {
       }
     }
 
-    if (print_dotdotdot)
-      m_stream->PutCString(", ...)");
-    else
+    if (print_dotdotdot) {
+      UpdateChildCursor(idx);
+      m_stream->PutCString(idx != first_child ? ", ...)" : "...)");
+    } else
       m_stream->PutChar(')');
   }
   return true;
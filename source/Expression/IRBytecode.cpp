@@ -0,0 +1,247 @@
+//===-- IRBytecode.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/IRBytecode.h"
+#include "lldb/Expression/IRMemoryMap.h"
+#include "lldb/Utility/Status.h"
+#include "lldb/Utility/Stream.h"
+
+#include <inttypes.h>
+
+using namespace lldb_private;
+
+static const char *g_opcode_names[] = {
+    "move",   "add",    "sub",    "mul",    "sdiv",   "udiv",  "srem",
+    "urem",   "shl",    "lshr",   "ashr",   "and",    "or",    "xor",
+    "cmp.eq", "cmp.ne", "cmp.ugt", "cmp.uge", "cmp.ult", "cmp.ule",
+    "cmp.sgt", "cmp.sge", "cmp.slt", "cmp.sle", "sext",  "index",
+    "alloca", "load",   "store",  "jump",   "branch", "return"};
+static_assert(sizeof(g_opcode_names) / sizeof(g_opcode_names[0]) ==
+                  IRBytecode::kNumOpcodes,
+              "missing opcode name");
+
+static inline uint64_t Mask(uint64_t value, uint8_t width) {
+  return width >= 64 ? value : value & ((1ULL << width) - 1);
+}
+
+static inline int64_t SignExtend(uint64_t value, uint8_t width) {
+  if (width == 0 || width >= 64)
+    return static_cast<int64_t>(value);
+  const uint64_t sign_bit = 1ULL << (width - 1);
+  return static_cast<int64_t>((Mask(value, width) ^ sign_bit) - sign_bit);
+}
+
+void IRBytecode::Dump(Stream &s) const {
+  s.Printf("%u arguments, %zu registers\n", m_num_arguments,
+           m_registers.size());
+  for (size_t i = m_num_arguments; i < m_registers.size(); ++i) {
+    if (m_registers[i] != 0)
+      s.Printf("  r%zu = 0x%" PRIx64 "\n", i, m_registers[i]);
+  }
+  for (size_t pc = 0; pc < m_code.size(); ++pc) {
+    const Instruction &inst = m_code[pc];
+    s.Printf("%4zu: %-8s i%u r%u, r%u, r%u, size %u, imm 0x%" PRIx64 "\n", pc,
+             g_opcode_names[inst.op], inst.width, inst.dst, inst.a, inst.b,
+             inst.size, inst.imm);
+  }
+}
+
+bool IRBytecode::Run(llvm::ArrayRef<lldb::addr_t> args,
+                     IRMemoryMap &memory_map, lldb::addr_t stack_frame_bottom,
+                     lldb::addr_t stack_frame_top, Status &error) const {
+  if (args.size() < m_num_arguments) {
+    error.SetErrorString("Not enough arguments passed in to function");
+    return false;
+  }
+
+  std::vector<uint64_t> registers(m_registers);
+  for (uint32_t i = 0; i < m_num_arguments; ++i)
+    registers[i] = args[i];
+  uint64_t *const r = registers.data();
+
+  const bool little_endian = m_byte_order == lldb::eByteOrderLittle;
+  lldb::addr_t stack_pointer = stack_frame_top;
+  uint32_t steps = m_entry_steps;
+  uint8_t bytes[8];
+  const Instruction *const code = m_code.data();
+  size_t pc = 0;
+
+  for (;;) {
+    const Instruction *const inst = &code[pc++];
+    switch (inst->op) {
+    case eOpMove:
+      r[inst->dst] = Mask(r[inst->a], inst->width);
+      break;
+    case eOpAdd:
+      r[inst->dst] = Mask(r[inst->a] + r[inst->b], inst->width);
+      break;
+    case eOpSub:
+      r[inst->dst] = Mask(r[inst->a] - r[inst->b], inst->width);
+      break;
+    case eOpMul:
+      r[inst->dst] = Mask(r[inst->a] * r[inst->b], inst->width);
+      break;
+    case eOpSDiv: {
+      // Division by zero gives 0, as it does in the IRInterpreter.
+      const int64_t lhs = SignExtend(r[inst->a], inst->width);
+      const int64_t rhs = SignExtend(r[inst->b], inst->width);
+      uint64_t result = 0;
+      if (rhs == -1)
+        result = 0 - static_cast<uint64_t>(lhs);
+      else if (rhs != 0)
+        result = static_cast<uint64_t>(lhs / rhs);
+      r[inst->dst] = Mask(result, inst->width);
+      break;
+    }
+    case eOpUDiv:
+      r[inst->dst] = r[inst->b] ? r[inst->a] / r[inst->b] : 0;
+      break;
+    case eOpSRem: {
+      const int64_t lhs = SignExtend(r[inst->a], inst->width);
+      const int64_t rhs = SignExtend(r[inst->b], inst->width);
+      uint64_t result = 0;
+      if (rhs != 0 && rhs != -1)
+        result = static_cast<uint64_t>(lhs % rhs);
+      r[inst->dst] = Mask(result, inst->width);
+      break;
+    }
+    case eOpURem:
+      r[inst->dst] = r[inst->b] ? r[inst->a] % r[inst->b] : 0;
+      break;
+    case eOpShl:
+      r[inst->dst] = r[inst->b] < inst->width
+                         ? Mask(r[inst->a] << r[inst->b], inst->width)
+                         : 0;
+      break;
+    case eOpLShr:
+      r[inst->dst] =
+          r[inst->b] < inst->width ? r[inst->a] >> r[inst->b] : 0;
+      break;
+    case eOpAShr: {
+      const uint64_t shift =
+          r[inst->b] < inst->width ? r[inst->b] : inst->width - 1;
+      r[inst->dst] = Mask(
+          static_cast<uint64_t>(SignExtend(r[inst->a], inst->width) >> shift),
+          inst->width);
+      break;
+    }
+    case eOpAnd:
+      r[inst->dst] = r[inst->a] & r[inst->b];
+      break;
+    case eOpOr:
+      r[inst->dst] = r[inst->a] | r[inst->b];
+      break;
+    case eOpXor:
+      r[inst->dst] = r[inst->a] ^ r[inst->b];
+      break;
+    case eOpCmpEQ:
+      r[inst->dst] = r[inst->a] == r[inst->b];
+      break;
+    case eOpCmpNE:
+      r[inst->dst] = r[inst->a] != r[inst->b];
+      break;
+    case eOpCmpUGT:
+      r[inst->dst] = r[inst->a] > r[inst->b];
+      break;
+    case eOpCmpUGE:
+      r[inst->dst] = r[inst->a] >= r[inst->b];
+      break;
+    case eOpCmpULT:
+      r[inst->dst] = r[inst->a] < r[inst->b];
+      break;
+    case eOpCmpULE:
+      r[inst->dst] = r[inst->a] <= r[inst->b];
+      break;
+    case eOpCmpSGT:
+      r[inst->dst] = SignExtend(r[inst->a], inst->width) >
+                     SignExtend(r[inst->b], inst->width);
+      break;
+    case eOpCmpSGE:
+      r[inst->dst] = SignExtend(r[inst->a], inst->width) >=
+                     SignExtend(r[inst->b], inst->width);
+      break;
+    case eOpCmpSLT:
+      r[inst->dst] = SignExtend(r[inst->a], inst->width) <
+                     SignExtend(r[inst->b], inst->width);
+      break;
+    case eOpCmpSLE:
+      r[inst->dst] = SignExtend(r[inst->a], inst->width) <=
+                     SignExtend(r[inst->b], inst->width);
+      break;
+    case eOpSExt:
+      r[inst->dst] = Mask(
+          static_cast<uint64_t>(SignExtend(r[inst->a], inst->src_width)),
+          inst->width);
+      break;
+    case eOpIndex:
+      r[inst->dst] =
+          Mask(r[inst->a] + static_cast<uint64_t>(
+                                SignExtend(r[inst->b], inst->src_width)) *
+                                inst->imm,
+               inst->width);
+      break;
+    case eOpAlloca: {
+      lldb::addr_t addr = stack_pointer - inst->imm;
+      addr -= addr % inst->size;
+      if (addr < stack_frame_bottom || addr > stack_pointer) {
+        error.SetErrorString("Interpreter couldn't allocate memory");
+        return false;
+      }
+      stack_pointer = addr;
+      r[inst->dst] = addr;
+      break;
+    }
+    case eOpLoad: {
+      Status read_error;
+      memory_map.ReadMemory(bytes, r[inst->a], inst->size, read_error);
+      if (!read_error.Success()) {
+        error.SetErrorString("Interpreter couldn't read from memory");
+        return false;
+      }
+      uint64_t value = 0;
+      for (uint32_t i = 0; i < inst->size; ++i) {
+        const uint32_t byte_index = little_endian ? inst->size - 1 - i : i;
+        value = (value << 8) | bytes[byte_index];
+      }
+      r[inst->dst] = Mask(value, inst->width);
+      break;
+    }
+    case eOpStore: {
+      const uint64_t value = r[inst->a];
+      for (uint32_t i = 0; i < inst->size; ++i) {
+        const uint32_t byte_index = little_endian ? i : inst->size - 1 - i;
+        bytes[byte_index] = static_cast<uint8_t>(value >> (i * 8));
+      }
+      Status write_error;
+      memory_map.WriteMemory(r[inst->b], bytes, inst->size, write_error);
+      if (!write_error.Success()) {
+        error.SetErrorString("Interpreter couldn't write to memory");
+        return false;
+      }
+      break;
+    }
+    case eOpJump:
+      steps += inst->size;
+      if (steps >= kMaxSteps) {
+        error.SetErrorString("Interpreter ran for too many cycles");
+        return false;
+      }
+      pc = inst->imm;
+      break;
+    case eOpBranch:
+      pc = r[inst->a] ? inst->imm : inst->b;
+      break;
+    case eOpReturn:
+      return true;
+    case kNumOpcodes:
+      error.SetErrorString("Interpreter encountered an internal error");
+      return false;
+    }
+  }
+}
@@ -12,6 +12,11 @@
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -19,6 +24,7 @@
 #include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Expression/IRBytecode.h"
 #include "lldb/Expression/IRExecutionUnit.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/SymbolContext.h"
@@ -33,6 +39,9 @@
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
 
+#include <mutex>
+#include <set>
+
 #include "lldb/../../source/Plugins/Language/CPlusPlus/CPlusPlusLanguage.h"
 #include "lldb/../../source/Plugins/ObjectFile/JIT/ObjectFileJIT.h"
 
@@ -236,6 +245,120 @@ void IRExecutionUnit::ReportSymbolLookupError(const ConstString &name) {
   m_failed_lookups.push_back(name);
 }
 
+namespace {
+//----------------------------------------------------------------------
+// Keeps the object code MCJIT generates for a module in a directory, so a
+// later debug session that builds the same module can skip code generation.
+// The object is cached before relocation, so reusing it is no different
+// from compiling the module again.
+//----------------------------------------------------------------------
+class PersistentObjectCache : public llvm::ObjectCache {
+public:
+  PersistentObjectCache(std::string directory, std::string key)
+      : m_directory(std::move(directory)), m_key(std::move(key)) {
+    PruneOnce(m_directory);
+  }
+
+  void notifyObjectCompiled(const llvm::Module *module,
+                            llvm::MemoryBufferRef object) override {
+    if (llvm::sys::fs::create_directories(m_directory))
+      return;
+
+    // Write to a unique name and rename it into place, so other debuggers
+    // using the same directory never see a partial object.
+    llvm::SmallString<256> model(m_directory);
+    llvm::sys::path::append(model, "llvmcache-tmp-%%%%%%");
+    int fd = -1;
+    llvm::SmallString<256> temp_path;
+    if (llvm::sys::fs::createUniqueFile(model, fd, temp_path))
+      return;
+    {
+      llvm::raw_fd_ostream stream(fd, true);
+      stream.write(object.getBufferStart(), object.getBufferSize());
+      if (stream.has_error()) {
+        stream.clear_error();
+        llvm::sys::fs::remove(temp_path);
+        return;
+      }
+    }
+    if (llvm::sys::fs::rename(temp_path, GetPath()))
+      llvm::sys::fs::remove(temp_path);
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer>
+  getObject(const llvm::Module *module) override {
+    auto buffer_or_error = llvm::MemoryBuffer::getFile(GetPath());
+    Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+    if (!buffer_or_error) {
+      if (log)
+        log->Printf("Expression object cache miss for %s", m_key.c_str());
+      return nullptr;
+    }
+    if (log)
+      log->Printf("Expression object cache hit for %s", m_key.c_str());
+    return std::move(*buffer_or_error);
+  }
+
+private:
+  std::string GetPath() const {
+    llvm::SmallString<256> path(m_directory);
+    llvm::sys::path::append(path, "llvmcache-" + m_key);
+    return path.str().str();
+  }
+
+  // Trim each cache directory once per debugger process; the pruning policy
+  // limits it further to once an hour.
+  static void PruneOnce(const std::string &directory) {
+    static std::mutex s_mutex;
+    static std::set<std::string> s_pruned;
+    std::lock_guard<std::mutex> guard(s_mutex);
+    if (!s_pruned.insert(directory).second)
+      return;
+    auto policy = llvm::parseCachePruningPolicy(
+        "prune_interval=1h:prune_after=168h:cache_size_bytes=128m");
+    if (policy)
+      llvm::pruneCache(directory, *policy);
+    else
+      llvm::consumeError(policy.takeError());
+  }
+
+  const std::string m_directory;
+  const std::string m_key;
+};
+} // namespace
+
+// The cache key covers everything code generation depends on.  The IR text
+// already includes the expression itself, the declarations it was compiled
+// against and every address IRForTarget resolved in the target's images.
+static std::string GetObjectCacheKey(const llvm::Module &module,
+                                     llvm::Reloc::Model reloc_model,
+                                     const std::vector<std::string> &features) {
+  std::string ir;
+  llvm::raw_string_ostream stream(ir);
+  module.print(stream, nullptr);
+  stream.flush();
+
+  llvm::MD5 md5;
+  md5.update(lldb_private::GetVersion());
+  md5.update(module.getTargetTriple());
+  md5.update(llvm::StringRef(reloc_model == llvm::Reloc::Static ? "static"
+                                                                : "pic"));
+  for (const std::string &feature : features)
+    md5.update(feature);
+  md5.update(ir);
+
+  llvm::MD5::MD5Result result;
+  md5.final(result);
+  return result.digest().str();
+}
+
+IRBytecode *IRExecutionUnit::GetInterpreterBytecode(
+    llvm::function_ref<std::unique_ptr<IRBytecode>()> lower) {
+  std::call_once(m_interpreter_bytecode_once,
+                 [&]() { m_interpreter_bytecode_ap = lower(); });
+  return m_interpreter_bytecode_ap.get();
+}
+
 void IRExecutionUnit::GetRunnableInfo(Status &error, lldb::addr_t &func_addr,
                                       lldb::addr_t &func_end) {
   lldb::ProcessSP process_sp(GetProcessWP().lock());
@@ -290,6 +413,12 @@ void IRExecutionUnit::GetRunnableInfo(Status &error, lldb::addr_t &func_addr,
   m_module_ap->getContext().setInlineAsmDiagnosticHandler(ReportInlineAsmError,
                                                           &error);
 
+  // Compute the cache key before the execution engine takes the module.
+  std::string object_cache_key;
+  const FileSpec cache_path = process_sp->GetTarget().GetExpressionCachePath();
+  if (cache_path && !process_sp->GetTarget().GetEnableSaveObjects())
+    object_cache_key = GetObjectCacheKey(*m_module, relocModel, m_cpu_features);
+
   llvm::EngineBuilder builder(std::move(m_module_ap));
 
   builder.setEngineKind(llvm::EngineKind::JIT)
@@ -342,9 +471,15 @@ void IRExecutionUnit::GetRunnableInfo(Status &error, lldb::addr_t &func_addr,
     }
   };
 
+  // Saving objects for inspection bypasses the cache, so that every
+  // expression is really compiled.
   if (process_sp->GetTarget().GetEnableSaveObjects()) {
     m_object_cache_ap = llvm::make_unique<ObjectDumper>();
     m_execution_engine_ap->setObjectCache(m_object_cache_ap.get());
+  } else if (!object_cache_key.empty()) {
+    m_object_cache_ap = llvm::make_unique<PersistentObjectCache>(
+        cache_path.GetPath(), object_cache_key);
+    m_execution_engine_ap->setObjectCache(m_object_cache_ap.get());
   }
 
   // Make sure we see all sections, including ones that don't have
@@ -13,6 +13,7 @@
 #include "lldb/Core/Scalar.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Expression/DiagnosticManager.h"
+#include "lldb/Expression/IRBytecode.h"
 #include "lldb/Expression/IRExecutionUnit.h"
 #include "lldb/Expression/IRMemoryMap.h"
 #include "lldb/Utility/ConstString.h"
@@ -641,6 +642,403 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
   return true;
 }
 
+//----------------------------------------------------------------------
+// Lowers a function the interpreter can handle into IRBytecode.  Lowering
+// fails for anything the bytecode has no equivalent for (function calls,
+// values wider than 64 bits, aggregates), and the function is then walked
+// by the loop in IRInterpreter::Interpret instead.
+//----------------------------------------------------------------------
+class BytecodeLowering {
+public:
+  BytecodeLowering(DataLayout &target_data, InterpreterStackFrame &frame)
+      : m_target_data(target_data), m_frame(frame) {}
+
+  std::unique_ptr<lldb_private::IRBytecode> Lower(const Function &function) {
+    m_bytecode.reset(new lldb_private::IRBytecode(
+        m_frame.m_byte_order, static_cast<uint32_t>(function.arg_size())));
+
+    uint32_t arg_index = 0;
+    for (const Argument &arg : function.args())
+      m_registers[&arg] = m_bytecode->GetArgumentRegister(arg_index++);
+
+    for (const BasicBlock &bb : function) {
+      for (const Instruction &inst : bb) {
+        if (!inst.getType()->isVoidTy())
+          m_registers[&inst] = m_bytecode->AddRegister();
+      }
+    }
+
+    for (const BasicBlock &bb : function) {
+      m_block_starts[&bb] = m_bytecode->GetNumInstructions();
+      for (const Instruction &inst : bb) {
+        if (!LowerInstruction(inst)) {
+          Fail(&inst);
+          return nullptr;
+        }
+      }
+    }
+
+    for (const auto &jump : m_jumps) {
+      auto start = m_block_starts.find(jump.second);
+      if (start == m_block_starts.end())
+        return nullptr;
+      m_bytecode->GetInstruction(jump.first).imm = start->second;
+    }
+
+    m_bytecode->SetEntrySteps(function.front().size());
+    return std::move(m_bytecode);
+  }
+
+private:
+  bool GetWidth(Type *type, uint8_t &width) {
+    uint64_t bits;
+    if (type->isIntegerTy())
+      bits = type->getIntegerBitWidth();
+    else if (type->isPointerTy())
+      bits = m_target_data.getPointerSizeInBits();
+    else if (type->isFloatingPointTy())
+      bits = m_target_data.getTypeStoreSize(type) * 8;
+    else
+      return false;
+    if (bits == 0 || bits > 64)
+      return false;
+    width = static_cast<uint8_t>(bits);
+    return true;
+  }
+
+  bool GetRegister(const Value *value, uint32_t &reg) {
+    auto pos = m_registers.find(value);
+    if (pos != m_registers.end()) {
+      reg = pos->second;
+      return true;
+    }
+
+    // Constants are resolved once, into a register of their own.
+    const Constant *constant = dyn_cast<Constant>(value);
+    uint8_t width;
+    APInt resolved_value;
+    if (!constant || !GetWidth(constant->getType(), width) ||
+        !m_frame.ResolveConstantValue(resolved_value, constant))
+      return false;
+
+    reg = m_bytecode->AddRegister(
+        resolved_value.zextOrTrunc(width).getZExtValue());
+    m_registers[value] = reg;
+    return true;
+  }
+
+  uint32_t GetConstantRegister(uint64_t value) {
+    return m_bytecode->AddRegister(value);
+  }
+
+  bool Emit(lldb_private::IRBytecode::Opcode op, const Instruction &inst,
+            const Value *a, const Value *b = nullptr, uint8_t width = 0) {
+    lldb_private::IRBytecode::Instruction code = {};
+    code.op = op;
+    if (!GetRegister(&inst, code.dst) || !GetRegister(a, code.a) ||
+        (b && !GetRegister(b, code.b)))
+      return false;
+    if (!width && !GetWidth(inst.getType(), width))
+      return false;
+    code.width = width;
+    m_bytecode->AddInstruction(code);
+    return true;
+  }
+
+  // Copy the incoming values of the PHI nodes in \a to along the edge from
+  // \a from, then jump to \a to.  PHI nodes take their values in parallel,
+  // so if there are several they go through temporaries first.
+  bool EmitEdge(const BasicBlock *from, const BasicBlock *to) {
+    std::vector<std::pair<uint32_t, uint32_t>> copies;
+    std::vector<uint8_t> widths;
+    for (const Instruction &inst : *to) {
+      const PHINode *phi = dyn_cast<PHINode>(&inst);
+      if (!phi)
+        break;
+      int index = phi->getBasicBlockIndex(from);
+      uint32_t src, dst;
+      uint8_t width;
+      if (index < 0 || !GetRegister(phi->getIncomingValue(index), src) ||
+          !GetRegister(phi, dst) || !GetWidth(phi->getType(), width))
+        return false;
+      copies.push_back({dst, src});
+      widths.push_back(width);
+    }
+
+    lldb_private::IRBytecode::Instruction code = {};
+    code.op = lldb_private::IRBytecode::eOpMove;
+    if (copies.size() > 1) {
+      for (size_t i = 0; i < copies.size(); ++i) {
+        code.width = widths[i];
+        code.a = copies[i].second;
+        code.dst = copies[i].second = m_bytecode->AddRegister();
+        m_bytecode->AddInstruction(code);
+      }
+    }
+    for (size_t i = 0; i < copies.size(); ++i) {
+      code.width = widths[i];
+      code.a = copies[i].second;
+      code.dst = copies[i].first;
+      m_bytecode->AddInstruction(code);
+    }
+
+    code = {};
+    code.op = lldb_private::IRBytecode::eOpJump;
+    code.size = to->size();
+    m_jumps.push_back({m_bytecode->AddInstruction(code), to});
+    return true;
+  }
+
+  bool EmitGetElementPtr(const GetElementPtrInst &gep) {
+    lldb_private::IRBytecode::Instruction code = {};
+    code.width = m_target_data.getPointerSizeInBits();
+    if (!GetRegister(&gep, code.dst) ||
+        !GetRegister(gep.getPointerOperand(), code.a))
+      return false;
+    const uint32_t dst = code.dst;
+    code.op = lldb_private::IRBytecode::eOpMove;
+    m_bytecode->AddInstruction(code);
+
+    // Constant indices are folded into one offset; variable ones are scaled
+    // by the size of the type they step over.
+    int64_t offset = 0;
+    Type *type = gep.getSourceElementType();
+    bool first = true;
+    for (const Use &use : make_range(gep.idx_begin(), gep.idx_end())) {
+      const Value *index = use.get();
+      uint64_t stride;
+      if (first) {
+        stride = m_target_data.getTypeAllocSize(type);
+        first = false;
+      } else if (StructType *struct_type = dyn_cast<StructType>(type)) {
+        const ConstantInt *field = dyn_cast<ConstantInt>(index);
+        if (!field)
+          return false;
+        const uint64_t field_index = field->getZExtValue();
+        offset += m_target_data.getStructLayout(struct_type)
+                      ->getElementOffset(field_index);
+        type = struct_type->getElementType(field_index);
+        continue;
+      } else if (ArrayType *array_type = dyn_cast<ArrayType>(type)) {
+        type = array_type->getElementType();
+        stride = m_target_data.getTypeAllocSize(type);
+      } else {
+        return false;
+      }
+
+      if (const ConstantInt *constant_index = dyn_cast<ConstantInt>(index)) {
+        offset += constant_index->getSExtValue() * stride;
+        continue;
+      }
+
+      uint8_t index_width;
+      if (!GetRegister(index, code.b) ||
+          !GetWidth(index->getType(), index_width))
+        return false;
+      code.op = lldb_private::IRBytecode::eOpIndex;
+      code.a = dst;
+      code.src_width = index_width;
+      code.imm = stride;
+      m_bytecode->AddInstruction(code);
+    }
+
+    if (offset) {
+      code.op = lldb_private::IRBytecode::eOpAdd;
+      code.a = dst;
+      code.b = GetConstantRegister(static_cast<uint64_t>(offset));
+      m_bytecode->AddInstruction(code);
+    }
+    return true;
+  }
+
+  bool EmitMemoryAccess(const Instruction &inst) {
+    lldb_private::IRBytecode::Instruction code = {};
+    Type *type;
+    if (const LoadInst *load_inst = dyn_cast<LoadInst>(&inst)) {
+      code.op = lldb_private::IRBytecode::eOpLoad;
+      type = load_inst->getType();
+      if (!GetRegister(load_inst, code.dst) ||
+          !GetRegister(load_inst->getPointerOperand(), code.a))
+        return false;
+    } else {
+      const StoreInst *store_inst = cast<StoreInst>(&inst);
+      code.op = lldb_private::IRBytecode::eOpStore;
+      type = store_inst->getValueOperand()->getType();
+      if (!GetRegister(store_inst->getValueOperand(), code.a) ||
+          !GetRegister(store_inst->getPointerOperand(), code.b))
+        return false;
+    }
+    code.size = m_target_data.getTypeStoreSize(type);
+    if (!GetWidth(type, code.width) || code.size > 8)
+      return false;
+    m_bytecode->AddInstruction(code);
+    return true;
+  }
+
+  bool LowerInstruction(const Instruction &inst) {
+    using lldb_private::IRBytecode;
+
+    switch (inst.getOpcode()) {
+    default:
+      return false;
+    case Instruction::Add:
+      return Emit(IRBytecode::eOpAdd, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::Sub:
+      return Emit(IRBytecode::eOpSub, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::Mul:
+      return Emit(IRBytecode::eOpMul, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::SDiv:
+      return Emit(IRBytecode::eOpSDiv, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::UDiv:
+      return Emit(IRBytecode::eOpUDiv, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::SRem:
+      return Emit(IRBytecode::eOpSRem, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::URem:
+      return Emit(IRBytecode::eOpURem, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::Shl:
+      return Emit(IRBytecode::eOpShl, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::LShr:
+      return Emit(IRBytecode::eOpLShr, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::AShr:
+      return Emit(IRBytecode::eOpAShr, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::And:
+      return Emit(IRBytecode::eOpAnd, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::Or:
+      return Emit(IRBytecode::eOpOr, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::Xor:
+      return Emit(IRBytecode::eOpXor, inst, inst.getOperand(0),
+                  inst.getOperand(1));
+    case Instruction::ICmp: {
+      IRBytecode::Opcode op;
+      switch (cast<ICmpInst>(inst).getPredicate()) {
+      default:
+        return false;
+      case CmpInst::ICMP_EQ:
+        op = IRBytecode::eOpCmpEQ;
+        break;
+      case CmpInst::ICMP_NE:
+        op = IRBytecode::eOpCmpNE;
+        break;
+      case CmpInst::ICMP_UGT:
+        op = IRBytecode::eOpCmpUGT;
+        break;
+      case CmpInst::ICMP_UGE:
+        op = IRBytecode::eOpCmpUGE;
+        break;
+      case CmpInst::ICMP_ULT:
+        op = IRBytecode::eOpCmpULT;
+        break;
+      case CmpInst::ICMP_ULE:
+        op = IRBytecode::eOpCmpULE;
+        break;
+      case CmpInst::ICMP_SGT:
+        op = IRBytecode::eOpCmpSGT;
+        break;
+      case CmpInst::ICMP_SGE:
+        op = IRBytecode::eOpCmpSGE;
+        break;
+      case CmpInst::ICMP_SLT:
+        op = IRBytecode::eOpCmpSLT;
+        break;
+      case CmpInst::ICMP_SLE:
+        op = IRBytecode::eOpCmpSLE;
+        break;
+      }
+      // Comparisons work at the width of their operands.
+      uint8_t width;
+      if (!GetWidth(inst.getOperand(0)->getType(), width))
+        return false;
+      return Emit(op, inst, inst.getOperand(0), inst.getOperand(1), width);
+    }
+    case Instruction::BitCast:
+    case Instruction::ZExt:
+    case Instruction::Trunc:
+    case Instruction::IntToPtr:
+    case Instruction::PtrToInt:
+      return Emit(IRBytecode::eOpMove, inst, inst.getOperand(0));
+    case Instruction::SExt: {
+      if (!Emit(IRBytecode::eOpSExt, inst, inst.getOperand(0)))
+        return false;
+      IRBytecode::Instruction &code =
+          m_bytecode->GetInstruction(m_bytecode->GetNumInstructions() - 1);
+      return GetWidth(inst.getOperand(0)->getType(), code.src_width);
+    }
+    case Instruction::GetElementPtr:
+      return EmitGetElementPtr(cast<GetElementPtrInst>(inst));
+    case Instruction::Alloca: {
+      const AllocaInst &alloca_inst = cast<AllocaInst>(inst);
+      if (alloca_inst.isArrayAllocation())
+        return false;
+      Type *type = alloca_inst.getAllocatedType();
+      IRBytecode::Instruction code = {};
+      code.op = IRBytecode::eOpAlloca;
+      code.imm = m_target_data.getTypeAllocSize(type);
+      code.size = m_target_data.getPrefTypeAlignment(type);
+      if (!code.size || !GetRegister(&inst, code.dst))
+        return false;
+      m_bytecode->AddInstruction(code);
+      return true;
+    }
+    case Instruction::Load:
+    case Instruction::Store:
+      return EmitMemoryAccess(inst);
+    case Instruction::PHI:
+      // Assigned on the edges into the block.
+      return true;
+    case Instruction::Call:
+      return CanIgnoreCall(cast<CallInst>(&inst));
+    case Instruction::Br: {
+      const BranchInst &br_inst = cast<BranchInst>(inst);
+      if (!br_inst.isConditional())
+        return EmitEdge(inst.getParent(), br_inst.getSuccessor(0));
+
+      IRBytecode::Instruction code = {};
+      code.op = IRBytecode::eOpBranch;
+      if (!GetRegister(br_inst.getCondition(), code.a))
+        return false;
+      const size_t branch = m_bytecode->AddInstruction(code);
+      m_bytecode->GetInstruction(branch).imm = branch + 1;
+      if (!EmitEdge(inst.getParent(), br_inst.getSuccessor(0)))
+        return false;
+      m_bytecode->GetInstruction(branch).b = m_bytecode->GetNumInstructions();
+      return EmitEdge(inst.getParent(), br_inst.getSuccessor(1));
+    }
+    case Instruction::Ret: {
+      IRBytecode::Instruction code = {};
+      code.op = IRBytecode::eOpReturn;
+      m_bytecode->AddInstruction(code);
+      return true;
+    }
+    }
+  }
+
+  void Fail(const Instruction *inst) {
+    lldb_private::Log *log(
+        lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+    if (log)
+      log->Printf("Couldn't lower %s to bytecode", PrintValue(inst).c_str());
+  }
+
+  DataLayout &m_target_data;
+  InterpreterStackFrame &m_frame;
+  std::unique_ptr<lldb_private::IRBytecode> m_bytecode;
+  std::map<const Value *, uint32_t> m_registers;
+  std::map<const BasicBlock *, size_t> m_block_starts;
+  std::vector<std::pair<size_t, const BasicBlock *>> m_jumps;
+};
+
 bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
                               llvm::ArrayRef<lldb::addr_t> args,
                               lldb_private::IRExecutionUnit &execution_unit,
@@ -672,6 +1070,22 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
     error.SetErrorString("Couldn't allocate stack frame");
   }
 
+  lldb_private::Target *target = exe_ctx.GetTargetPtr();
+  if (!target || target->GetUseInterpreterBytecode()) {
+    lldb_private::IRBytecode *bytecode = execution_unit.GetInterpreterBytecode(
+        [&]() { return BytecodeLowering(data_layout, frame).Lower(function); });
+
+    if (bytecode) {
+      if (log) {
+        lldb_private::StreamString ss;
+        bytecode->Dump(ss);
+        log->Printf("Interpreting bytecode:\n%s", ss.GetData());
+      }
+      return bytecode->Run(args, execution_unit, stack_frame_bottom,
+                           stack_frame_top, error);
+    }
+  }
+
   int arg_index = 0;
 
   for (llvm::Function::arg_iterator ai = function.arg_begin(),
@@ -225,6 +225,58 @@ bool IRMemoryMap::AllocationsIntersect(lldb::addr_t addr1, size_t size1,
   return (addr2 < (addr1 + size1)) && (addr1 < (addr2 + size2));
 }
 
+void IRMemoryMap::BeginBatch(lldb::addr_t process_address, bool fetch,
+                             Status &error) {
+  error.Clear();
+
+  lldbassert(m_batch_start == LLDB_INVALID_ADDRESS &&
+             "only one allocation can be batched at a time");
+
+  AllocationMap::iterator iter = FindAllocation(process_address, 1);
+  if (iter == m_allocations.end())
+    return;
+
+  Allocation &allocation = iter->second;
+  lldb::ProcessSP process_sp = m_process_wp.lock();
+  if (allocation.m_policy != eAllocationPolicyMirror || !process_sp ||
+      !allocation.m_data.GetByteSize())
+    return;
+
+  if (fetch) {
+    ++m_num_process_reads;
+    process_sp->ReadMemory(allocation.m_process_start,
+                           allocation.m_data.GetBytes(),
+                           allocation.m_data.GetByteSize(), error);
+    if (!error.Success())
+      return;
+  }
+
+  m_batch_start = allocation.m_process_start;
+  m_batch_dirty_begin = m_batch_dirty_end = 0;
+}
+
+void IRMemoryMap::EndBatch(Status &error) {
+  error.Clear();
+
+  if (m_batch_start == LLDB_INVALID_ADDRESS)
+    return;
+
+  AllocationMap::iterator iter = m_allocations.find(m_batch_start);
+  m_batch_start = LLDB_INVALID_ADDRESS;
+  if (iter == m_allocations.end() || m_batch_dirty_begin == m_batch_dirty_end)
+    return;
+
+  Allocation &allocation = iter->second;
+  lldb::ProcessSP process_sp = m_process_wp.lock();
+  if (!process_sp)
+    return;
+
+  ++m_num_process_writes;
+  process_sp->WriteMemory(allocation.m_process_start + m_batch_dirty_begin,
+                          allocation.m_data.GetBytes() + m_batch_dirty_begin,
+                          m_batch_dirty_end - m_batch_dirty_begin, error);
+}
+
 lldb::ByteOrder IRMemoryMap::GetByteOrder() {
   lldb::ProcessSP process_sp = m_process_wp.lock();
 
@@ -487,6 +539,9 @@ void IRMemoryMap::Free(lldb::addr_t process_address, Status &error) {
                 iter->second.m_process_start + iter->second.m_size);
   }
 
+  if (IsBatched(allocation))
+    m_batch_start = LLDB_INVALID_ADDRESS;
+
   m_allocations.erase(iter);
 }
 
@@ -523,6 +578,7 @@ void IRMemoryMap::WriteMemory(lldb::addr_t process_address,
     lldb::ProcessSP process_sp = m_process_wp.lock();
 
     if (process_sp) {
+      ++m_num_process_writes;
       process_sp->WriteMemory(process_address, bytes, size, error);
       return;
     }
@@ -559,8 +615,20 @@ void IRMemoryMap::WriteMemory(lldb::addr_t process_address,
       return;
     }
     ::memcpy(allocation.m_data.GetBytes() + offset, bytes, size);
+    if (IsBatched(allocation)) {
+      // EndBatch will write this out.
+      if (m_batch_dirty_begin == m_batch_dirty_end) {
+        m_batch_dirty_begin = offset;
+        m_batch_dirty_end = offset + size;
+      } else {
+        m_batch_dirty_begin = std::min<size_t>(m_batch_dirty_begin, offset);
+        m_batch_dirty_end = std::max<size_t>(m_batch_dirty_end, offset + size);
+      }
+      break;
+    }
     process_sp = m_process_wp.lock();
     if (process_sp) {
+      ++m_num_process_writes;
       process_sp->WriteMemory(process_address, bytes, size, error);
       if (!error.Success())
         return;
@@ -569,6 +637,7 @@ void IRMemoryMap::WriteMemory(lldb::addr_t process_address,
   case eAllocationPolicyProcessOnly:
     process_sp = m_process_wp.lock();
     if (process_sp) {
+      ++m_num_process_writes;
       process_sp->WriteMemory(process_address, bytes, size, error);
       if (!error.Success())
         return;
@@ -632,6 +701,7 @@ void IRMemoryMap::ReadMemory(uint8_t *bytes, lldb::addr_t process_address,
     lldb::ProcessSP process_sp = m_process_wp.lock();
 
     if (process_sp) {
+      ++m_num_process_reads;
       process_sp->ReadMemory(process_address, bytes, size, error);
       return;
     }
@@ -683,7 +753,8 @@ void IRMemoryMap::ReadMemory(uint8_t *bytes, lldb::addr_t process_address,
     break;
   case eAllocationPolicyMirror:
     process_sp = m_process_wp.lock();
-    if (process_sp) {
+    if (process_sp && !IsBatched(allocation)) {
+      ++m_num_process_reads;
       process_sp->ReadMemory(process_address, bytes, size, error);
       if (!error.Success())
         return;
@@ -699,6 +770,7 @@ void IRMemoryMap::ReadMemory(uint8_t *bytes, lldb::addr_t process_address,
   case eAllocationPolicyProcessOnly:
     process_sp = m_process_wp.lock();
     if (process_sp) {
+      ++m_num_process_reads;
       process_sp->ReadMemory(process_address, bytes, size, error);
       if (!error.Success())
         return;
@@ -816,11 +888,15 @@ void IRMemoryMap::GetMemoryData(DataExtractor &extractor,
         return;
       }
       if (process_sp) {
-        process_sp->ReadMemory(allocation.m_process_start,
-                               allocation.m_data.GetBytes(),
-                               allocation.m_data.GetByteSize(), error);
-        if (!error.Success())
-          return;
+        // A batched allocation's host copy is already the latest data.
+        if (!IsBatched(allocation)) {
+          ++m_num_process_reads;
+          process_sp->ReadMemory(allocation.m_process_start,
+                                 allocation.m_data.GetBytes(),
+                                 allocation.m_data.GetByteSize(), error);
+          if (!error.Success())
+            return;
+        }
         uint64_t offset = process_address - allocation.m_process_start;
         extractor = DataExtractor(allocation.m_data.GetBytes() + offset, size,
                                   GetByteOrder(), GetAddressByteSize());
@@ -1460,19 +1460,38 @@ Materializer::Materialize(lldb::StackFrameSP &frame_sp, IRMemoryMap &map,
     error.SetErrorString("Couldn't materialize: target doesn't exist");
   }
 
+  // Fill in the whole struct on the host, then write it out at once.
+  const uint32_t num_reads = map.GetNumProcessReads();
+  const uint32_t num_writes = map.GetNumProcessWrites();
+  lldb::TargetSP target_sp = map.GetTarget();
+  Status batch_error;
+  if (target_sp && target_sp->GetBatchMaterialization())
+    map.BeginBatch(process_address, false, batch_error);
+
   for (EntityUP &entity_up : m_entities) {
     entity_up->Materialize(frame_sp, map, process_address, error);
 
-    if (!error.Success())
+    if (!error.Success()) {
+      map.EndBatch(batch_error);
       return DematerializerSP();
+    }
+  }
+
+  map.EndBatch(batch_error);
+  if (!batch_error.Success()) {
+    error.SetErrorStringWithFormat("Couldn't materialize: %s",
+                                   batch_error.AsCString());
+    return DematerializerSP();
   }
 
   if (Log *log =
           lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS)) {
     log->Printf(
         "Materializer::Materialize (frame_sp = %p, process_address = 0x%" PRIx64
-        ") materialized:",
-        static_cast<void *>(frame_sp.get()), process_address);
+        ") materialized with %u process reads and %u process writes:",
+        static_cast<void *>(frame_sp.get()), process_address,
+        map.GetNumProcessReads() - num_reads,
+        map.GetNumProcessWrites() - num_writes);
     for (EntityUP &entity_up : m_entities)
       entity_up->DumpToLog(map, process_address, log);
   }
@@ -1502,8 +1521,17 @@ void Materializer::Dematerializer::Dematerialize(Status &error,
     error.SetErrorToGenericError();
     error.SetErrorString("Couldn't dematerialize: target is gone");
   } else {
-    if (Log *log =
-            lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS)) {
+    // Read the whole struct back at once.  If that fails, the entities
+    // will report the errors reading their parts of it.
+    const uint32_t num_reads = m_map->GetNumProcessReads();
+    const uint32_t num_writes = m_map->GetNumProcessWrites();
+    lldb::TargetSP target_sp = m_map->GetTarget();
+    Status batch_error;
+    if (target_sp && target_sp->GetBatchMaterialization())
+      m_map->BeginBatch(m_process_address, true, batch_error);
+
+    Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS);
+    if (log) {
       log->Printf("Materializer::Dematerialize (frame_sp = %p, process_address "
                   "= 0x%" PRIx64 ") about to dematerialize:",
                   static_cast<void *>(frame_sp.get()), m_process_address);
@@ -1519,6 +1547,17 @@ void Materializer::Dematerializer::Dematerialize(Status &error,
         break;
     }
 
+    m_map->EndBatch(batch_error);
+    if (!batch_error.Success() && error.Success())
+      error.SetErrorStringWithFormat("Couldn't dematerialize: %s",
+                                     batch_error.AsCString());
+
+    if (log)
+      log->Printf("Materializer::Dematerialize made %u process reads and %u "
+                  "process writes",
+                  m_map->GetNumProcessReads() - num_reads,
+                  m_map->GetNumProcessWrites() - num_writes);
+
     // Okay now if there's an error and it is not empty, then report that,
     // otherwise report the regular error...
   }
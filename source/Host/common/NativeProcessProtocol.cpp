@@ -8,11 +8,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Host/common/NativeProcessProtocol.h"
+#include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/State.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/common/NativeRegisterContext.h"
 #include "lldb/Host/common/NativeThreadProtocol.h"
 #include "lldb/Host/common/SoftwareBreakpoint.h"
+#include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/lldb-enumerations.h"
@@ -55,6 +58,27 @@ NativeProcessProtocol::GetMemoryRegionInfo(lldb::addr_t load_addr,
   return Status("not implemented");
 }
 
+lldb_private::Status NativeProcessProtocol::GetMemoryRegions(
+    std::vector<MemoryRegionInfo> &regions) {
+  regions.clear();
+  lldb::addr_t range_end = 0;
+  do {
+    MemoryRegionInfo region_info;
+    Status error = GetMemoryRegionInfo(range_end, region_info);
+    if (error.Fail()) {
+      regions.clear();
+      return error;
+    }
+    // Stop rather than loop forever on an empty range.
+    if (region_info.GetRange().GetRangeEnd() <= range_end)
+      break;
+    range_end = region_info.GetRange().GetRangeEnd();
+    if (region_info.GetMapped() == MemoryRegionInfo::eYes)
+      regions.push_back(region_info);
+  } while (range_end != LLDB_INVALID_ADDRESS);
+  return Status();
+}
+
 llvm::Optional<WaitStatus> NativeProcessProtocol::GetExitStatus() {
   if (m_state == lldb::eStateExited)
     return m_exit_status;
@@ -376,8 +400,163 @@ Status NativeProcessProtocol::RemoveBreakpoint(lldb::addr_t addr,
                                                bool hardware) {
   if (hardware)
     return RemoveHardwareBreakpoint(addr);
+
+  Status error = m_breakpoint_list.DecRef(addr);
+  // The tracepoints go with the last reference to the breakpoint.
+  NativeBreakpointSP breakpoint_sp;
+  if (error.Success() &&
+      m_breakpoint_list.GetBreakpoint(addr, breakpoint_sp).Fail())
+    m_tracepoints.erase(addr);
+  return error;
+}
+
+Status NativeProcessProtocol::SetBreakpointConditions(
+    lldb::addr_t addr, std::vector<AgentExpression> conditions) {
+  NativeBreakpointSP breakpoint_sp;
+  Status error = m_breakpoint_list.GetBreakpoint(addr, breakpoint_sp);
+  if (error.Fail())
+    return error;
+  if (!breakpoint_sp->IsSoftwareBreakpoint())
+    return Status("conditions are only supported on software breakpoints");
+
+  breakpoint_sp->SetConditions(std::move(conditions));
+  return Status();
+}
+
+Status NativeProcessProtocol::SetBreakpointTracepoints(
+    lldb::addr_t addr, std::vector<TracepointSpec> specs) {
+  if (!SupportsBreakpointConditions())
+    return Status("tracepoints are not supported");
+  if (specs.empty())
+    m_tracepoints.erase(addr);
   else
-    return m_breakpoint_list.DecRef(addr);
+    m_tracepoints[addr] = std::move(specs);
+  return Status();
+}
+
+namespace {
+// Reads registers and memory of a stopped thread for breakpoint conditions
+// and tracepoints.  Register numbers are the register context's own
+// indexes, which are the numbers the client learned from qRegisterInfo.
+class ThreadConditionContext : public TracepointContext {
+public:
+  ThreadConditionContext(NativeProcessProtocol &process,
+                         NativeThreadProtocol &thread)
+      : m_process(process), m_reg_ctx(thread.GetRegisterContext()) {}
+
+  bool ReadRegister(uint32_t reg_num, uint64_t &value) override {
+    const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoAtIndex(reg_num);
+    if (!reg_info)
+      return false;
+    RegisterValue reg_value;
+    if (m_reg_ctx.ReadRegister(reg_info, reg_value).Fail())
+      return false;
+    bool success = false;
+    value = reg_value.GetAsUInt64(0, &success);
+    return success;
+  }
+
+  bool ReadUnsigned(lldb::addr_t addr, size_t byte_size,
+                    uint64_t &value) override {
+    uint8_t buf[8];
+    size_t bytes_read = 0;
+    if (byte_size > sizeof(buf) ||
+        m_process.ReadMemoryWithoutTrap(addr, buf, byte_size, bytes_read)
+            .Fail() ||
+        bytes_read != byte_size)
+      return false;
+    const ArchSpec &arch = m_process.GetArchitecture();
+    DataExtractor data(buf, byte_size, arch.GetByteOrder(),
+                       arch.GetAddressByteSize());
+    lldb::offset_t offset = 0;
+    value = data.GetMaxU64(&offset, byte_size);
+    return true;
+  }
+
+  bool ReadRegisterBytes(uint32_t reg_num,
+                         std::vector<uint8_t> &bytes) override {
+    const RegisterInfo *reg_info = m_reg_ctx.GetRegisterInfoAtIndex(reg_num);
+    if (!reg_info)
+      return false;
+    RegisterValue reg_value;
+    if (m_reg_ctx.ReadRegister(reg_info, reg_value).Fail() ||
+        reg_value.GetByteSize() == 0)
+      return false;
+    const uint8_t *src = static_cast<const uint8_t *>(reg_value.GetBytes());
+    bytes.assign(src, src + reg_value.GetByteSize());
+    return true;
+  }
+
+  bool ReadMemory(lldb::addr_t addr, size_t size,
+                  std::vector<uint8_t> &bytes) override {
+    bytes.resize(size);
+    size_t bytes_read = 0;
+    if (m_process.ReadMemoryWithoutTrap(addr, bytes.data(), size, bytes_read)
+            .Fail() ||
+        bytes_read != size)
+      return false;
+    return true;
+  }
+
+  lldb::ByteOrder GetByteOrder() override {
+    return m_process.GetArchitecture().GetByteOrder();
+  }
+
+private:
+  NativeProcessProtocol &m_process;
+  NativeRegisterContext &m_reg_ctx;
+};
+} // namespace
+
+bool NativeProcessProtocol::BreakpointConditionsSayStop(
+    NativeThreadProtocol &thread, lldb::addr_t addr) {
+  if (!SupportsBreakpointConditions())
+    return true;
+
+  NativeBreakpointSP breakpoint_sp;
+  if (m_breakpoint_list.GetBreakpoint(addr, breakpoint_sp).Fail() ||
+      !breakpoint_sp->IsSoftwareBreakpoint())
+    return true;
+
+  const std::vector<AgentExpression> &conditions =
+      breakpoint_sp->GetConditions();
+  if (conditions.empty())
+    return true;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  ThreadConditionContext context(*this, thread);
+  for (const AgentExpression &condition : conditions) {
+    uint64_t result = 0;
+    Status error = condition.Evaluate(context, result);
+    if (error.Fail()) {
+      // Let the client evaluate the condition and report the problem.
+      LLDB_LOG(log, "tid {0} breakpoint {1:x}: condition failed: {2}",
+               thread.GetID(), addr, error);
+      return true;
+    }
+    if (result != 0)
+      return true;
+  }
+  return false;
+}
+
+void NativeProcessProtocol::CollectTracepoints(NativeThreadProtocol &thread,
+                                               lldb::addr_t addr) {
+  auto pos = m_tracepoints.find(addr);
+  if (pos == m_tracepoints.end())
+    return;
+
+  ThreadConditionContext context(*this, thread);
+  for (const TracepointSpec &spec : pos->second) {
+    if (!spec.ShouldCollect(context))
+      continue;
+    TracepointRecord record;
+    record.id = spec.id;
+    record.tid = thread.GetID();
+    record.pc = addr;
+    spec.Collect(context, record);
+    m_tracepoint_buffer.Append(record);
+  }
 }
 
 Status NativeProcessProtocol::EnableBreakpoint(lldb::addr_t addr) {
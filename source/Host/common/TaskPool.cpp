@@ -10,94 +10,286 @@
 #include "lldb/Host/TaskPool.h"
 #include "lldb/Host/ThreadLauncher.h"
 
-#include <cstdint> // for uint32_t
-#include <queue>   // for queue
-#include <thread>  // for thread
+#include <algorithm>          // for find_if, max, min
+#include <condition_variable> // for condition_variable
+#include <cstdint>            // for uint32_t, uintptr_t
+#include <deque>              // for deque
+#include <thread>             // for thread
+#include <vector>             // for vector
 
 namespace lldb_private {
 
+struct TaskGroupState : std::enable_shared_from_this<TaskGroupState> {
+  TaskGroupState(TaskPriority priority, CancellationToken token,
+                 std::shared_ptr<TaskGroupState> parent)
+      : priority(priority), token(std::move(token)), parent(std::move(parent)),
+        pending(0), num_added(0) {}
+
+  // Whether this is \a group or a group created by one of its tasks, or by
+  // one of theirs.
+  bool IsNestedIn(const TaskGroupState &group) const {
+    for (const TaskGroupState *state = this; state;
+         state = state->parent.get())
+      if (state == &group)
+        return true;
+    return false;
+  }
+
+  const TaskPriority priority;
+  const CancellationToken token;
+  // The group of the task that created this one, if any.
+  const std::shared_ptr<TaskGroupState> parent;
+  std::atomic<size_t> pending;
+  // Counts the tasks a thread waiting on this group could take that were
+  // ever added, so that it can tell whether one came in since it last
+  // looked.  Waiting threads sleep on \a condition until it changes or
+  // the group is done.
+  std::atomic<uint64_t> num_added;
+  std::condition_variable condition;
+};
+
 namespace {
+struct Task {
+  std::function<void()> fn;
+  std::shared_ptr<TaskGroupState> group; // Null for TaskPool::AddTask
+};
+
+const size_t g_num_priorities = 3;
+
+struct TaskQueue {
+  std::mutex mutex;
+  std::deque<Task> lanes[g_num_priorities];
+};
+
 class TaskPoolImpl {
 public:
   static TaskPoolImpl &GetInstance();
 
-  void AddTask(std::function<void()> &&task_fn);
+  void AddTask(Task &&task, TaskPriority priority);
+
+  // Run queued tasks of \a group and of the groups nested in it until it has
+  // none left queued or running.
+  void Wait(TaskGroupState &group);
 
 private:
   TaskPoolImpl();
 
-  static lldb::thread_result_t WorkerPtr(void *pool);
+  static lldb::thread_result_t WorkerPtr(void *index);
 
-  static void Worker(TaskPoolImpl *pool);
+  void Worker(size_t index);
 
-  std::queue<std::function<void()>> m_tasks;
-  std::mutex m_tasks_mutex;
+  // Take the next task to run.  A thread waiting on a group only takes the
+  // tasks of that group and of the groups nested in it, and none in a lower
+  // priority lane: anything else could take much longer than what it is
+  // waiting for, or wait on something it holds.
+  bool PopTask(Task &task, const TaskGroupState *waiting_group = nullptr);
+
+  void RunTask(Task &task);
+
+  // m_queues[0] takes the tasks added by threads that aren't workers, the
+  // others belong to one worker each.
+  std::vector<std::unique_ptr<TaskQueue>> m_queues;
+  std::atomic<size_t> m_num_queued;
+  // Guards m_thread_count. Idle workers sleep on m_condition until there
+  // are tasks, and waiting threads on their group's condition.
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
   uint32_t m_thread_count;
 };
 
+// The index in m_queues of the worker running on this thread.
+thread_local size_t g_worker_index = 0;
+
+// The group of the task running on this thread, which the groups it
+// creates are nested in.
+thread_local TaskGroupState *g_current_group = nullptr;
+
 } // end of anonymous namespace
 
 TaskPoolImpl &TaskPoolImpl::GetInstance() {
-  static TaskPoolImpl g_task_pool_impl;
-  return g_task_pool_impl;
+  // Never destroyed: the workers wait on it for as long as the process runs.
+  static TaskPoolImpl *g_task_pool_impl = new TaskPoolImpl();
+  return *g_task_pool_impl;
 }
 
 void TaskPool::AddTaskImpl(std::function<void()> &&task_fn) {
-  TaskPoolImpl::GetInstance().AddTask(std::move(task_fn));
+  Task task;
+  task.fn = std::move(task_fn);
+  TaskPoolImpl::GetInstance().AddTask(std::move(task), TaskPriority::Normal);
 }
 
-TaskPoolImpl::TaskPoolImpl() : m_thread_count(0) {}
+TaskPoolImpl::TaskPoolImpl()
+    : m_num_queued(0), m_thread_count(0) {
+  for (size_t i = 0; i <= GetHardwareConcurrencyHint(); ++i)
+    m_queues.emplace_back(new TaskQueue());
+}
 
 unsigned GetHardwareConcurrencyHint() {
   // std::thread::hardware_concurrency may return 0 if the value is not well
   // defined or not computable.
-  static const unsigned g_hardware_concurrency = 
+  static const unsigned g_hardware_concurrency =
     std::max(1u, std::thread::hardware_concurrency());
   return g_hardware_concurrency;
 }
 
-void TaskPoolImpl::AddTask(std::function<void()> &&task_fn) {
+void TaskPoolImpl::AddTask(Task &&task, TaskPriority priority) {
   const size_t min_stack_size = 8 * 1024 * 1024;
 
-  std::unique_lock<std::mutex> lock(m_tasks_mutex);
-  m_tasks.emplace(std::move(task_fn));
-  if (m_thread_count < GetHardwareConcurrencyHint()) {
+  TaskGroupState *const group = task.group.get();
+  TaskQueue &queue = *m_queues[g_worker_index];
+  {
+    std::lock_guard<std::mutex> guard(queue.mutex);
+    queue.lanes[static_cast<size_t>(priority)].push_back(std::move(task));
+  }
+  ++m_num_queued;
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // Only wake the threads waiting on a group that PopTask lets take this
+  // task, rather than have every waiting thread look through the queues.
+  for (TaskGroupState *state = group; state; state = state->parent.get()) {
+    if (priority > state->priority)
+      continue;
+    ++state->num_added;
+    state->condition.notify_all();
+  }
+  if (m_thread_count < m_queues.size() - 1) {
     m_thread_count++;
-    // Note that this detach call needs to happen with the m_tasks_mutex held.
-    // This prevents the thread from exiting prematurely and triggering a linux
+    // Note that this detach call needs to happen with the m_mutex held. This
+    // prevents the thread from exiting prematurely and triggering a linux
     // libc bug (https://sourceware.org/bugzilla/show_bug.cgi?id=19951).
-    lldb_private::ThreadLauncher::LaunchThread("task-pool.worker", WorkerPtr,
-                                               this, nullptr, min_stack_size)
+    lldb_private::ThreadLauncher::LaunchThread(
+        "task-pool.worker", WorkerPtr,
+        reinterpret_cast<void *>(static_cast<uintptr_t>(m_thread_count)),
+        nullptr, min_stack_size)
         .Release();
   }
+  m_condition.notify_one();
 }
 
-lldb::thread_result_t TaskPoolImpl::WorkerPtr(void *pool) {
-  Worker((TaskPoolImpl *)pool);
+lldb::thread_result_t TaskPoolImpl::WorkerPtr(void *index) {
+  GetInstance().Worker(reinterpret_cast<uintptr_t>(index));
   return 0;
 }
 
-void TaskPoolImpl::Worker(TaskPoolImpl *pool) {
+void TaskPoolImpl::Worker(size_t index) {
+  g_worker_index = index;
   while (true) {
-    std::unique_lock<std::mutex> lock(pool->m_tasks_mutex);
-    if (pool->m_tasks.empty()) {
-      pool->m_thread_count--;
-      break;
+    Task task;
+    if (PopTask(task)) {
+      RunTask(task);
+      continue;
     }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return m_num_queued > 0; });
+  }
+}
 
-    std::function<void()> f = std::move(pool->m_tasks.front());
-    pool->m_tasks.pop();
-    lock.unlock();
+void TaskPoolImpl::Wait(TaskGroupState &group) {
+  while (group.pending > 0) {
+    const uint64_t num_added = group.num_added;
+    Task task;
+    if (PopTask(task, &group)) {
+      RunTask(task);
+      continue;
+    }
+    // Everything left in the group is running on other threads.
+    std::unique_lock<std::mutex> lock(m_mutex);
+    group.condition.wait(lock, [&] {
+      return group.pending == 0 || group.num_added != num_added;
+    });
+  }
+}
+
+bool TaskPoolImpl::PopTask(Task &task, const TaskGroupState *waiting_group) {
+  if (m_num_queued == 0)
+    return false;
+
+  auto can_take = [waiting_group](const Task &task) {
+    return !waiting_group ||
+           (task.group && task.group->IsNestedIn(*waiting_group));
+  };
+
+  const size_t self = g_worker_index;
+  const size_t num_queues = m_queues.size();
+  const size_t num_lanes =
+      waiting_group ? static_cast<size_t>(waiting_group->priority) + 1
+                    : g_num_priorities;
+  for (size_t lane = 0; lane < num_lanes; ++lane) {
+    // A worker takes the newest of its own tasks, which are the most likely
+    // to still be in its cache, and the oldest of everybody else's.
+    for (size_t i = 0; i < num_queues; ++i) {
+      TaskQueue &queue = *m_queues[(self + i) % num_queues];
+      std::lock_guard<std::mutex> guard(queue.mutex);
+      std::deque<Task> &tasks = queue.lanes[lane];
+      if (i == 0 && self != 0) {
+        auto pos = std::find_if(tasks.rbegin(), tasks.rend(), can_take);
+        if (pos == tasks.rend())
+          continue;
+        task = std::move(*pos);
+        tasks.erase(std::next(pos).base());
+      } else {
+        auto pos = std::find_if(tasks.begin(), tasks.end(), can_take);
+        if (pos == tasks.end())
+          continue;
+        task = std::move(*pos);
+        tasks.erase(pos);
+      }
+      --m_num_queued;
+      return true;
+    }
+  }
+  return false;
+}
 
-    f();
+void TaskPoolImpl::RunTask(Task &task) {
+  std::shared_ptr<TaskGroupState> group = std::move(task.group);
+  if (!group || !group->token.IsCancelled()) {
+    TaskGroupState *const outer_group = g_current_group;
+    g_current_group = group.get();
+    task.fn();
+    g_current_group = outer_group;
   }
+  // Let go of what the task captured before its group can be seen as done.
+  task.fn = nullptr;
+  if (group && --group->pending == 0) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    group->condition.notify_all();
+  }
+}
+
+TaskGroup::TaskGroup(TaskPriority priority, CancellationToken token)
+    : m_state(std::make_shared<TaskGroupState>(
+          priority, std::move(token),
+          g_current_group ? g_current_group->shared_from_this()
+                          : std::shared_ptr<TaskGroupState>())) {}
+
+TaskGroup::~TaskGroup() { Wait(); }
+
+void TaskGroup::Add(std::function<void()> &&task_fn) {
+  if (m_state->token.IsCancelled())
+    return;
+  ++m_state->pending;
+  Task task;
+  task.fn = std::move(task_fn);
+  task.group = m_state;
+  TaskPoolImpl::GetInstance().AddTask(std::move(task), m_state->priority);
+}
+
+void TaskGroup::Wait() { TaskPoolImpl::GetInstance().Wait(*m_state); }
+
+const CancellationToken &TaskGroup::GetCancellationToken() const {
+  return m_state->token;
 }
 
 void TaskMapOverInt(size_t begin, size_t end,
-                    const llvm::function_ref<void(size_t)> &func) {
-  const size_t num_workers = std::min<size_t>(end, GetHardwareConcurrencyHint());
+                    const llvm::function_ref<void(size_t)> &func,
+                    TaskPriority priority) {
+  if (end <= begin)
+    return;
+  const size_t num_workers =
+      std::min<size_t>(end - begin, GetHardwareConcurrencyHint());
   std::atomic<size_t> idx{begin};
-  
+
   auto wrapper = [&idx, end, &func]() {
     while (true) {
       size_t i = idx.fetch_add(1);
@@ -107,13 +299,13 @@ void TaskMapOverInt(size_t begin, size_t end,
     }
   };
 
-  std::vector<std::future<void>> futures;
-  futures.reserve(num_workers);
-  for (size_t i = 0; i < num_workers; i++)
-    futures.push_back(TaskPool::AddTask(wrapper));
-  for (size_t i = 0; i < num_workers; i++)
-    futures[i].wait();
+  // The calling thread does its share, so this finishes even when every
+  // worker is busy.
+  TaskGroup group(priority);
+  for (size_t i = 1; i < num_workers; i++)
+    group.Add(wrapper);
+  wrapper();
+  group.Wait();
 }
 
 } // namespace lldb_private
-
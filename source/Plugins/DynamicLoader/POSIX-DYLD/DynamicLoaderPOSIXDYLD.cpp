@@ -80,7 +80,8 @@ DynamicLoaderPOSIXDYLD::DynamicLoaderPOSIXDYLD(Process *process)
       m_load_offset(LLDB_INVALID_ADDRESS), m_entry_point(LLDB_INVALID_ADDRESS),
       m_auxv(), m_dyld_bid(LLDB_INVALID_BREAK_ID),
       m_vdso_base(LLDB_INVALID_ADDRESS),
-      m_interpreter_base(LLDB_INVALID_ADDRESS) {}
+      m_interpreter_base(LLDB_INVALID_ADDRESS),
+      m_load_modules_on_demand(false) {}
 
 DynamicLoaderPOSIXDYLD::~DynamicLoaderPOSIXDYLD() {
   if (m_dyld_bid != LLDB_INVALID_BREAK_ID) {
@@ -428,7 +429,12 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   if (m_rendezvous.ModulesDidLoad()) {
     ModuleList new_modules;
 
+    std::vector<FileSpec> module_names;
     E = m_rendezvous.loaded_end();
+    for (I = m_rendezvous.loaded_begin(); I != E; ++I)
+      module_names.push_back(I->file_spec);
+    std::vector<ModuleSP> prepared_modules = PrepareModules(module_names);
+
     for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
       ModuleSP module_sp =
           LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -575,11 +581,22 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   ModuleSP executable = GetTargetExecutable();
   m_loaded_modules[executable] = m_rendezvous.GetLinkMapAddress();
 
+  if (m_load_modules_on_demand) {
+    for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I)
+      m_deferred_modules.emplace(I->base_addr, *I);
+    if (log)
+      log->Printf("DynamicLoaderPOSIXDYLD::%s deferred loading %" PRIu64
+                  " modules",
+                  __FUNCTION__, (uint64_t)m_deferred_modules.size());
+    return;
+  }
+
   std::vector<FileSpec> module_names;
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I)
     module_names.push_back(I->file_spec);
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
+  std::vector<ModuleSP> prepared_modules = PrepareModules(module_names);
 
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
@@ -600,6 +617,66 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->GetTarget().ModulesDidLoad(module_list);
 }
 
+ModuleSP DynamicLoaderPOSIXDYLD::LoadModuleContainingAddress(addr_t load_addr) {
+  if (m_deferred_modules.empty())
+    return ModuleSP();
+
+  // The link map doesn't say how large a library is, so find the library
+  // through the name of the file mapped at the address.
+  MemoryRegionInfo region_info;
+  Status error = m_process->GetMemoryRegionInfo(load_addr, region_info);
+  if (error.Fail() || !region_info.GetName())
+    return ModuleSP();
+  ConstString name = region_info.GetName();
+
+  auto pos = m_deferred_modules.end();
+  for (auto it = m_deferred_modules.begin(); it != m_deferred_modules.end();
+       ++it) {
+    if (ConstString(it->second.file_spec.GetPath()) == name) {
+      pos = it;
+      break;
+    }
+  }
+
+  // The link map may name the library through a symbolic link.  A library
+  // whose first segment is at its load bias maps the same file there.
+  if (pos == m_deferred_modules.end()) {
+    auto below = m_deferred_modules.upper_bound(load_addr);
+    if (below != m_deferred_modules.begin()) {
+      --below;
+      MemoryRegionInfo base_region_info;
+      if (m_process->GetMemoryRegionInfo(below->first, base_region_info)
+              .Success() &&
+          base_region_info.GetName() == name)
+        pos = below;
+    }
+  }
+  if (pos == m_deferred_modules.end())
+    return ModuleSP();
+
+  const DYLDRendezvous::SOEntry entry = pos->second;
+  m_deferred_modules.erase(pos);
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_DYNAMIC_LOADER));
+  ModuleSP module_sp = LoadModuleAtAddress(entry.file_spec, entry.link_addr,
+                                           entry.base_addr, true);
+  if (!module_sp) {
+    if (log)
+      log->Printf(
+          "DynamicLoaderPOSIXDYLD::%s failed loading module %s at 0x%" PRIx64,
+          __FUNCTION__, entry.file_spec.GetCString(), entry.base_addr);
+    return ModuleSP();
+  }
+  if (log)
+    log->Printf("DynamicLoaderPOSIXDYLD::%s loaded module %s for 0x%" PRIx64,
+                __FUNCTION__, entry.file_spec.GetCString(), load_addr);
+
+  ModuleList module_list;
+  module_list.Append(module_sp);
+  m_process->GetTarget().ModulesDidLoad(module_list);
+  return module_sp;
+}
+
 addr_t DynamicLoaderPOSIXDYLD::ComputeLoadOffset() {
   addr_t virt_entry;
 
@@ -58,6 +58,16 @@ public:
                                   const lldb::ThreadSP thread,
                                   lldb::addr_t tls_file_addr) override;
 
+  lldb::ModuleSP LoadModuleContainingAddress(lldb::addr_t load_addr) override;
+
+  /// Only record the shared libraries in the link map when attaching, and
+  /// load each one when LoadModuleContainingAddress() asks for an address
+  /// in it.  Breakpoints aren't set in libraries that aren't loaded, so
+  /// this is only for processes that don't run, like core files.
+  void SetLoadModulesOnDemand(bool on_demand) {
+    m_load_modules_on_demand = on_demand;
+  }
+
   //------------------------------------------------------------------
   // PluginInterface protocol
   //------------------------------------------------------------------
@@ -93,6 +103,12 @@ protected:
   std::map<lldb::ModuleWP, lldb::addr_t, std::owner_less<lldb::ModuleWP>>
       m_loaded_modules;
 
+  /// Whether LoadAllCurrentModules() defers loading the shared libraries.
+  bool m_load_modules_on_demand;
+
+  /// Shared libraries that haven't been loaded yet, by base address.
+  std::map<lldb::addr_t, DYLDRendezvous::SOEntry> m_deferred_modules;
+
   /// If possible sets a breakpoint on a function called by the runtime
   /// linker each time a module is loaded or unloaded.
   bool SetRendezvousBreakpoint();
@@ -31,24 +31,59 @@ using namespace lldb_private;
 using namespace lldb_private::formatters;
 using namespace lldb_private::formatters::swift;
 
-size_t SwiftArrayNativeBufferHandler::GetCount() { return m_size; }
+// Big enough that paging through a large array takes few round trips, small
+// enough that printing the first few elements of one doesn't read megabytes.
+static const size_t g_array_chunk_byte_size = 16 * 1024;
+
+SwiftArrayElementReader::SwiftArrayElementReader(
+    const ExecutionContextRef &exe_ctx_ref, CompilerType elem_type,
+    size_t element_size, size_t element_stride)
+    : m_exe_ctx_ref(exe_ctx_ref), m_elem_type(elem_type),
+      m_element_size(element_size), m_element_stride(element_stride),
+      m_chunk_sp(), m_chunk_first_idx(0), m_chunk_num_elements(0) {}
+
+void SwiftArrayElementReader::Clear() {
+  m_chunk_sp.reset();
+  m_chunk_first_idx = 0;
+  m_chunk_num_elements = 0;
+}
 
-size_t SwiftArrayNativeBufferHandler::GetCapacity() { return m_capacity; }
+bool SwiftArrayElementReader::ReadChunk(lldb::addr_t first_elem_ptr,
+                                        size_t idx, size_t end_idx) {
+  Clear();
+  ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
+  if (!process_sp || idx >= end_idx)
+    return false;
 
-lldb_private::CompilerType SwiftArrayNativeBufferHandler::GetElementType() {
-  return m_elem_type;
-}
+  size_t num_elements = std::max<size_t>(
+      1, g_array_chunk_byte_size / m_element_stride);
+  num_elements = std::min(num_elements, end_idx - idx);
+  // The last element doesn't need its tail padding.
+  const size_t byte_size = (num_elements - 1) * m_element_stride +
+                           m_element_size;
 
-ValueObjectSP SwiftArrayNativeBufferHandler::GetElementAtIndex(size_t idx) {
-  if (idx >= m_size)
-    return ValueObjectSP();
+  DataBufferSP buffer_sp(new DataBufferHeap(byte_size, 0));
+  Status error;
+  if (process_sp->ReadMemory(first_elem_ptr + idx * m_element_stride,
+                             buffer_sp->GetBytes(), byte_size,
+                             error) != byte_size ||
+      error.Fail())
+    return false;
 
-  lldb::addr_t child_location = m_first_elem_ptr + idx * m_element_stride;
+  m_chunk_sp = buffer_sp;
+  m_chunk_first_idx = idx;
+  m_chunk_num_elements = num_elements;
+  return true;
+}
 
+ValueObjectSP
+SwiftArrayElementReader::ReadSingleElement(lldb::addr_t first_elem_ptr,
+                                           size_t idx, llvm::StringRef name) {
   ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
   if (!process_sp)
     return ValueObjectSP();
 
+  lldb::addr_t child_location = first_elem_ptr + idx * m_element_stride;
   DataBufferSP buffer(new DataBufferHeap(m_element_size, 0));
   Status error;
   if (process_sp->ReadMemory(child_location, buffer->GetBytes(), m_element_size,
@@ -57,10 +92,62 @@ ValueObjectSP SwiftArrayNativeBufferHandler::GetElementAtIndex(size_t idx) {
     return ValueObjectSP();
   DataExtractor data(buffer, process_sp->GetByteOrder(),
                      process_sp->GetAddressByteSize());
+  return ValueObject::CreateValueObjectFromData(name, data, m_exe_ctx_ref,
+                                                m_elem_type);
+}
+
+ValueObjectSP SwiftArrayElementReader::GetElementAtIndex(
+    lldb::addr_t first_elem_ptr, size_t idx, size_t end_idx,
+    llvm::StringRef name) {
+  // Zero-sized or oddly laid out elements aren't worth chunking.
+  if (m_element_size == 0 || m_element_stride < m_element_size)
+    return ReadSingleElement(first_elem_ptr, idx, name);
+
+  if (!m_chunk_sp || idx < m_chunk_first_idx ||
+      idx >= m_chunk_first_idx + m_chunk_num_elements) {
+    if (!ReadChunk(first_elem_ptr, idx, end_idx))
+      return ReadSingleElement(first_elem_ptr, idx, name);
+  }
+
+  ExecutionContext exe_ctx(m_exe_ctx_ref);
+  ProcessSP process_sp(exe_ctx.GetProcessSP());
+  if (!process_sp)
+    return ValueObjectSP();
+
+  // The child keeps the chunk alive; the data is not copied.
+  DataExtractor chunk(m_chunk_sp, process_sp->GetByteOrder(),
+                      process_sp->GetAddressByteSize());
+  DataExtractor data(chunk, (idx - m_chunk_first_idx) * m_element_stride,
+                     m_element_size);
+  ValueObjectSP child_sp = ValueObjectConstResult::Create(
+      exe_ctx.GetBestExecutionContextScope(), m_elem_type, ConstString(name),
+      data, LLDB_INVALID_ADDRESS);
+  if (!child_sp)
+    return child_sp;
+  child_sp->SetAddressTypeOfChildren(eAddressTypeLoad);
+  // We already know the size of every element, don't make each child ask the
+  // type system again.
+  static_cast<ValueObjectConstResult *>(child_sp.get())
+      ->SetByteSize(m_element_size);
+  return child_sp;
+}
+
+size_t SwiftArrayNativeBufferHandler::GetCount() { return m_size; }
+
+size_t SwiftArrayNativeBufferHandler::GetCapacity() { return m_capacity; }
+
+lldb_private::CompilerType SwiftArrayNativeBufferHandler::GetElementType() {
+  return m_elem_type;
+}
+
+ValueObjectSP SwiftArrayNativeBufferHandler::GetElementAtIndex(size_t idx) {
+  if (idx >= m_size)
+    return ValueObjectSP();
+
   StreamString name;
   name.Printf("[%zu]", idx);
-  return ValueObject::CreateValueObjectFromData(name.GetData(), data,
-                                                m_exe_ctx_ref, m_elem_type);
+  return m_reader.GetElementAtIndex(m_first_elem_ptr, idx, m_size,
+                                    name.GetString());
 }
 
 SwiftArrayNativeBufferHandler::SwiftArrayNativeBufferHandler(
@@ -70,7 +157,8 @@ SwiftArrayNativeBufferHandler::SwiftArrayNativeBufferHandler(
       m_first_elem_ptr(LLDB_INVALID_ADDRESS), m_elem_type(elem_type),
       m_element_size(elem_type.GetByteSize(nullptr)),
       m_element_stride(elem_type.GetByteStride()),
-      m_exe_ctx_ref(valobj.GetExecutionContextRef()) {
+      m_exe_ctx_ref(valobj.GetExecutionContextRef()),
+      m_reader(m_exe_ctx_ref, m_elem_type, m_element_size, m_element_stride) {
   if (native_ptr == LLDB_INVALID_ADDRESS)
     return;
   if (native_ptr == 0) {
@@ -167,25 +255,10 @@ SwiftArraySliceBufferHandler::GetElementAtIndex(size_t idx) {
 
   const uint64_t effective_idx = idx + m_start_index;
 
-  lldb::addr_t child_location =
-      m_first_elem_ptr + effective_idx * m_element_stride;
-
-  ProcessSP process_sp(m_exe_ctx_ref.GetProcessSP());
-  if (!process_sp)
-    return ValueObjectSP();
-
-  DataBufferSP buffer(new DataBufferHeap(m_element_size, 0));
-  Status error;
-  if (process_sp->ReadMemory(child_location, buffer->GetBytes(), m_element_size,
-                             error) != m_element_size ||
-      error.Fail())
-    return ValueObjectSP();
-  DataExtractor data(buffer, process_sp->GetByteOrder(),
-                     process_sp->GetAddressByteSize());
   StreamString name;
   name.Printf("[%" PRIu64 "]", effective_idx);
-  return ValueObject::CreateValueObjectFromData(name.GetData(), data,
-                                                m_exe_ctx_ref, m_elem_type);
+  return m_reader.GetElementAtIndex(m_first_elem_ptr, effective_idx,
+                                    m_start_index + m_size, name.GetString());
 }
 
 // this gets passed the "buffer" element?
@@ -195,7 +268,8 @@ SwiftArraySliceBufferHandler::SwiftArraySliceBufferHandler(
       m_element_size(elem_type.GetByteSize(nullptr)),
       m_element_stride(elem_type.GetByteStride()),
       m_exe_ctx_ref(valobj.GetExecutionContextRef()), m_native_buffer(false),
-      m_start_index(0) {
+      m_start_index(0),
+      m_reader(m_exe_ctx_ref, m_elem_type, m_element_size, m_element_stride) {
   static ConstString g_start("subscriptBaseAddress");
   static ConstString g_value("_value");
   static ConstString g__rawValue("_rawValue");
@@ -51,6 +51,39 @@ protected:
   static bool DoesTypeEntailIndirectBuffer(const CompilerType &element_type);
 };
 
+// Vends the elements of a contiguous array storage. Rather than doing one
+// memory read per element, the storage is read in large chunks and the
+// children point straight into the chunk they came from, so paging through an
+// array of millions of integers costs a handful of reads and no copies.
+class SwiftArrayElementReader {
+public:
+  SwiftArrayElementReader(const ExecutionContextRef &exe_ctx_ref,
+                          CompilerType elem_type, size_t element_size,
+                          size_t element_stride);
+
+  // Returns the element at physical index idx of the storage starting at
+  // first_elem_ptr, reading ahead no further than element end_idx.
+  lldb::ValueObjectSP GetElementAtIndex(lldb::addr_t first_elem_ptr,
+                                        size_t idx, size_t end_idx,
+                                        llvm::StringRef name);
+
+  void Clear();
+
+private:
+  bool ReadChunk(lldb::addr_t first_elem_ptr, size_t idx, size_t end_idx);
+
+  lldb::ValueObjectSP ReadSingleElement(lldb::addr_t first_elem_ptr,
+                                        size_t idx, llvm::StringRef name);
+
+  lldb_private::ExecutionContextRef m_exe_ctx_ref;
+  lldb_private::CompilerType m_elem_type;
+  size_t m_element_size;
+  size_t m_element_stride;
+  lldb::DataBufferSP m_chunk_sp;
+  size_t m_chunk_first_idx;
+  size_t m_chunk_num_elements;
+};
+
 class SwiftArrayEmptyBufferHandler : public SwiftArrayBufferHandler {
 public:
   virtual size_t GetCount() { return 0; }
@@ -105,6 +138,7 @@ private:
   size_t m_element_size;
   size_t m_element_stride;
   lldb_private::ExecutionContextRef m_exe_ctx_ref;
+  SwiftArrayElementReader m_reader;
 };
 
 class SwiftArrayBridgedBufferHandler : public SwiftArrayBufferHandler {
@@ -158,6 +192,7 @@ private:
   lldb_private::ExecutionContextRef m_exe_ctx_ref;
   bool m_native_buffer;
   uint64_t m_start_index;
+  SwiftArrayElementReader m_reader;
 };
 
 class SwiftSyntheticFrontEndBufferHandler : public SwiftArrayBufferHandler {
@@ -28,6 +28,7 @@
 #include "swift/Remote/RemoteAddress.h"
 #include "swift/RemoteAST/RemoteAST.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MathExtras.h"
 
 #include <algorithm>
 
@@ -76,12 +77,27 @@ public:
 
   virtual bool IsValid() override;
 
+  virtual BucketCacheSP GetBucketCache() override { return m_bucketCache; }
+
+  virtual void SetBucketCache(BucketCacheSP cache_sp) override {
+    m_bucketCache = cache_sp;
+  }
+
   virtual ~NativeHashedStorageHandler() override {}
 
 protected:
   typedef uint64_t Index;
   typedef uint64_t Bucket;
 
+  // A run of consecutive buckets of the key or value storage that was read
+  // with a single memory read.
+  struct BucketWindow {
+    Bucket m_first = 0;
+    Bucket m_end = 0;
+    DataBufferSP m_data_sp;
+  };
+
+  bool ReadBitmap(std::vector<uint8_t> &bitmap);
   bool UpdateBuckets();
   bool FailBuckets();
 
@@ -101,35 +117,23 @@ protected:
       : LLDB_INVALID_ADDRESS;
   }
 
-  // these are sharp tools that assume that the Bucket contains valid
-  // data and the destination buffer has enough room to store the data
-  // to - use with caution
-  bool GetDataForKeyInBucket(Bucket b, void *data_ptr) {
-    if (!data_ptr)
-      return false;
-
-    lldb::addr_t addr = GetLocationOfKeyInBucket(b);
-    Status error;
-    m_process->ReadMemory(addr, data_ptr, m_key_stride, error);
-    if (error.Fail())
-      return false;
-
-    return true;
+  // these are sharp tools that assume that the Index is valid and that the
+  // buckets have been computed
+  bool GetDataForKeyAtIndex(Index idx, void *data_ptr) {
+    return GetDataInBucket(m_keys_ptr, m_key_stride, m_keyWindow, idx,
+                           data_ptr);
   }
 
-  bool GetDataForValueInBucket(Bucket b, void *data_ptr) {
-    if (!data_ptr || !m_value_stride)
+  bool GetDataForValueAtIndex(Index idx, void *data_ptr) {
+    if (!m_value_stride)
       return false;
-
-    lldb::addr_t addr = GetLocationOfValueInBucket(b);
-    Status error;
-    m_process->ReadMemory(addr, data_ptr, m_value_stride, error);
-    if (error.Fail())
-      return false;
-
-    return true;
+    return GetDataInBucket(m_values_ptr, m_value_stride, m_valueWindow, idx,
+                           data_ptr);
   }
 
+  bool GetDataInBucket(lldb::addr_t base, uint64_t stride,
+                       BucketWindow &window, Index idx, void *data_ptr);
+
 private:
   ValueObject *m_storage;
   Process *m_process;
@@ -146,6 +150,9 @@ private:
   // Cached mapping from index to occupied bucket.
   std::vector<Bucket> m_occupiedBuckets;
   bool m_failedToGetBuckets;
+  BucketCacheSP m_bucketCache;
+  BucketWindow m_keyWindow;
+  BucketWindow m_valueWindow;
 };
 
 class CocoaHashedStorageHandler: public HashedStorageHandler {
@@ -425,7 +432,10 @@ NativeHashedStorageHandler::NativeHashedStorageHandler(
     m_value_stride(0),
     m_key_stride_padded(m_key_stride),
     m_occupiedBuckets(),
-    m_failedToGetBuckets(false) {
+    m_failedToGetBuckets(false),
+    m_bucketCache(),
+    m_keyWindow(),
+    m_valueWindow() {
   static ConstString g__count("_count");
   static ConstString g__scale("_scale");
   static ConstString g__rawElements("_rawElements");
@@ -561,39 +571,107 @@ NativeHashedStorageHandler::FailBuckets() {
   return false;
 }
 
+bool
+NativeHashedStorageHandler::ReadBitmap(std::vector<uint8_t> &bitmap) {
+  const size_t byte_size = GetWordCount() * m_ptr_size;
+  bitmap.resize(byte_size);
+  Status error;
+  if (m_process->ReadMemory(m_metadata_ptr, bitmap.data(), byte_size,
+                            error) != byte_size ||
+      error.Fail())
+    return false;
+  return true;
+}
+
 bool
 NativeHashedStorageHandler::UpdateBuckets() {
   if (m_failedToGetBuckets)
     return false;
   if (!m_occupiedBuckets.empty())
     return true;
+  // Read the whole bitmap at once rather than word by word.
+  std::vector<uint8_t> bitmap;
+  if (!ReadBitmap(bitmap))
+    return FailBuckets();
+  if (m_bucketCache && m_bucketCache->m_metadata_ptr == m_metadata_ptr &&
+      m_bucketCache->m_count == m_count && m_bucketCache->m_bitmap == bitmap) {
+    m_occupiedBuckets = m_bucketCache->m_buckets;
+    return true;
+  }
   // Scan bitmap for occupied buckets.
   m_occupiedBuckets.reserve(m_count);
   size_t bucketCount = GetBucketCount();
   size_t wordWidth = GetWordWidth();
   size_t wordCount = GetWordCount();
+  DataExtractor words(bitmap.data(), bitmap.size(), m_process->GetByteOrder(),
+                      m_ptr_size);
+  lldb::offset_t offset = 0;
   for (size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
-    Status error;
-    auto word = GetMetadataWord(wordIndex, error);
-    if (error.Fail()) {
-      return FailBuckets();
-    }
-    if (wordCount == 1) {
+    uint64_t word = words.GetMaxU64(&offset, m_ptr_size);
+    if (wordCount == 1 && bucketCount < wordWidth) {
       // Mask off out-of-bounds bits from first partial word.
-      word &= (1 << bucketCount) - 1;
+      word &= (1ULL << bucketCount) - 1;
     }
-    for (size_t bit = 0; bit < wordWidth; bit++) {
-      if ((word & (1ULL << bit)) != 0) {
-        if (m_occupiedBuckets.size() == m_count) {
-          return FailBuckets();
-        }
-        m_occupiedBuckets.push_back(wordIndex * wordWidth + bit);
+    while (word != 0) {
+      if (m_occupiedBuckets.size() == m_count) {
+        return FailBuckets();
       }
+      m_occupiedBuckets.push_back(wordIndex * wordWidth +
+                                  llvm::countTrailingZeros(word));
+      // Clear the lowest set bit.
+      word &= word - 1;
     }
   }
   if (m_occupiedBuckets.size() != m_count) {
     return FailBuckets();
   }
+  m_bucketCache = std::make_shared<BucketCache>();
+  m_bucketCache->m_metadata_ptr = m_metadata_ptr;
+  m_bucketCache->m_count = m_count;
+  m_bucketCache->m_bitmap.swap(bitmap);
+  m_bucketCache->m_buckets = m_occupiedBuckets;
+  return true;
+}
+
+// Big enough that walking a large dictionary takes few round trips, small
+// enough that looking at its first few entries stays cheap.
+static const uint64_t g_bucket_window_byte_size = 16 * 1024;
+
+bool
+NativeHashedStorageHandler::GetDataInBucket(
+  lldb::addr_t base, uint64_t stride, BucketWindow &window, Index idx,
+  void *data_ptr) {
+  if (!data_ptr)
+    return false;
+  if (stride == 0)
+    return true;
+  Bucket bucket = m_occupiedBuckets[idx];
+  if (!window.m_data_sp || bucket < window.m_first || bucket >= window.m_end) {
+    // Extend the window over the following occupied buckets, as long as they
+    // are close enough to be worth reading along with this one.
+    Bucket last = bucket;
+    for (Index i = idx + 1; i < m_occupiedBuckets.size(); ++i) {
+      if ((m_occupiedBuckets[i] - bucket + 1) * stride >
+          g_bucket_window_byte_size)
+        break;
+      last = m_occupiedBuckets[i];
+    }
+    const uint64_t byte_size = (last - bucket + 1) * stride;
+    DataBufferSP data_sp(new DataBufferHeap(byte_size, 0));
+    Status error;
+    if (m_process->ReadMemory(base + bucket * stride, data_sp->GetBytes(),
+                              byte_size, error) != byte_size ||
+        error.Fail()) {
+      window = BucketWindow();
+      return false;
+    }
+    window.m_first = bucket;
+    window.m_end = last + 1;
+    window.m_data_sp = data_sp;
+  }
+  memcpy(data_ptr,
+         window.m_data_sp->GetBytes() + (bucket - window.m_first) * stride,
+         stride);
   return true;
 }
 
@@ -605,16 +683,15 @@ NativeHashedStorageHandler::GetElementAtIndex(size_t idx) {
     return nullptr;
   if (idx >= m_occupiedBuckets.size())
     return nullptr;
-  Bucket bucket = m_occupiedBuckets[idx];
   DataBufferSP full_buffer_sp(
     new DataBufferHeap(m_key_stride_padded + m_value_stride, 0));
   uint8_t *key_buffer_ptr = full_buffer_sp->GetBytes();
   uint8_t *value_buffer_ptr =
     m_value_stride ? (key_buffer_ptr + m_key_stride_padded) : nullptr;
-  if (!GetDataForKeyInBucket(bucket, key_buffer_ptr))
+  if (!GetDataForKeyAtIndex(idx, key_buffer_ptr))
     return nullptr;
   if (value_buffer_ptr != nullptr &&
-      !GetDataForValueInBucket(bucket, value_buffer_ptr))
+      !GetDataForValueAtIndex(idx, value_buffer_ptr))
     return nullptr;
   DataExtractor full_data;
   full_data.SetData(full_buffer_sp);
@@ -731,7 +808,12 @@ HashedSyntheticChildrenFrontEnd::GetChildAtIndex(size_t idx) {
 
 bool
 HashedSyntheticChildrenFrontEnd::Update() {
+  HashedStorageHandler::BucketCacheSP bucket_cache_sp;
+  if (m_buffer)
+    bucket_cache_sp = m_buffer->GetBucketCache();
   m_buffer = m_config.CreateHandler(m_backend);
+  if (m_buffer && bucket_cache_sp)
+    m_buffer->SetBucketCache(bucket_cache_sp);
   return false;
 }
 
@@ -23,6 +23,8 @@
 #include "lldb/Target/Target.h"
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace lldb_private {
 namespace formatters {
@@ -117,6 +119,18 @@ protected:
 // different FrontEnds
 class HashedStorageHandler {
 public:
+  // The occupied buckets of a native storage, in index order, together with
+  // the raw bitmap they were computed from. A handler recreated for the same
+  // storage after the process stops again reuses the buckets as long as the
+  // bitmap didn't change.
+  struct BucketCache {
+    lldb::addr_t m_metadata_ptr = LLDB_INVALID_ADDRESS;
+    uint64_t m_count = 0;
+    std::vector<uint8_t> m_bitmap;
+    std::vector<uint64_t> m_buckets;
+  };
+  typedef std::shared_ptr<BucketCache> BucketCacheSP;
+
   virtual size_t GetCount() = 0;
 
   virtual CompilerType GetElementType() = 0;
@@ -125,6 +139,10 @@ public:
 
   virtual bool IsValid() = 0;
 
+  virtual BucketCacheSP GetBucketCache() { return BucketCacheSP(); }
+
+  virtual void SetBucketCache(BucketCacheSP cache_sp) {}
+
   virtual ~HashedStorageHandler() {}
 };
 
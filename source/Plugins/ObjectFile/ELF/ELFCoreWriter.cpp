@@ -0,0 +1,507 @@
+//===-- ELFCoreWriter.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ELFCoreWriter.h"
+
+#include "lldb/Host/File.h"
+#include "lldb/Host/TaskPool.h"
+#include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Utility/DataBuffer.h"
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/StreamString.h"
+
+#include "llvm/BinaryFormat/ELF.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <chrono>
+#include <future>
+#include <string.h>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// Note types of Linux cores, see linux/elf.h.
+enum : uint32_t {
+  NT_LINUX_PRSTATUS = 1,
+  NT_LINUX_PRPSINFO = 3,
+  NT_LINUX_AUXV = 6,
+  NT_LINUX_FILE = 0x46494c45
+};
+
+// The granularity of zero page detection and NT_FILE offsets, and the
+// alignment of the memory contents in the file.
+const uint64_t kPageSize = 4096;
+
+// Memory is read and written in chunks of this size, and this many chunks
+// can be waiting to be written while the next one is read.
+const size_t kChunkSize = 4 * 1024 * 1024;
+const size_t kNumChunks = 4;
+
+const size_t kELFHeaderSize = 64;
+const size_t kProgramHeaderSize = 56;
+const size_t kSectionHeaderSize = 64;
+
+// The general purpose registers in the order of the pr_reg member of
+// struct elf_prstatus, using the names of LLDB's register contexts.
+const char *const g_x86_64_gpr_names[] = {
+    "r15", "r14", "r13", "r12", "rbp", "rbx", "r11", "r10", "r9",
+    "r8",  "rax", "rcx", "rdx", "rsi", "rdi", "orig_rax", "rip", "cs",
+    "rflags", "rsp", "ss", "fs_base", "gs_base", "ds", "es", "fs", "gs"};
+
+const char *const g_arm64_gpr_names[] = {
+    "x0",  "x1",  "x2",  "x3",  "x4",  "x5",  "x6",  "x7",  "x8",
+    "x9",  "x10", "x11", "x12", "x13", "x14", "x15", "x16", "x17",
+    "x18", "x19", "x20", "x21", "x22", "x23", "x24", "x25", "x26",
+    "x27", "x28", "fp",  "lr",  "sp",  "pc",  "cpsr"};
+
+struct CoreSegment {
+  addr_t vaddr;
+  addr_t mem_size;
+  // Zero for regions that can't be read.
+  addr_t file_size;
+  uint64_t file_offset;
+  uint32_t flags;
+};
+
+struct MappedFile {
+  addr_t start;
+  addr_t end;
+  uint64_t file_offset;
+  std::string path;
+};
+
+} // namespace
+
+static void PadTo4(StreamString &stream) {
+  while (stream.GetSize() % 4)
+    stream.PutHex8(0);
+}
+
+static void AppendNote(StreamString &notes, uint32_t type,
+                       llvm::StringRef desc) {
+  static const char name[] = "CORE";
+  notes.PutHex32(sizeof(name));
+  notes.PutHex32(desc.size());
+  notes.PutHex32(type);
+  notes.Write(name, sizeof(name));
+  PadTo4(notes);
+  notes.Write(desc.data(), desc.size());
+  PadTo4(notes);
+}
+
+static void PutFixedString(StreamString &stream, llvm::StringRef str,
+                           size_t size) {
+  str = str.take_front(size - 1);
+  stream.Write(str.data(), str.size());
+  for (size_t i = str.size(); i < size; ++i)
+    stream.PutHex8(0);
+}
+
+static void AppendPrStatus(StreamString &notes, Thread &thread,
+                           lldb::pid_t ppid,
+                           llvm::ArrayRef<const char *> gpr_names,
+                           const ArchSpec &arch) {
+  int signo = 0;
+  StopInfoSP stop_info_sp = thread.GetStopInfo();
+  if (stop_info_sp && stop_info_sp->GetStopReason() == eStopReasonSignal)
+    signo = stop_info_sp->GetValue();
+
+  StreamString desc(Stream::eBinary, arch.GetAddressByteSize(),
+                    arch.GetByteOrder());
+  desc.PutHex32(signo); // si_signo
+  desc.PutHex32(0);     // si_code
+  desc.PutHex32(0);     // si_errno
+  desc.PutHex16(signo); // pr_cursig
+  desc.PutHex16(0);
+  desc.PutHex64(0); // pr_sigpend
+  desc.PutHex64(0); // pr_sighold
+  desc.PutHex32(thread.GetProtocolID()); // pr_pid
+  desc.PutHex32(ppid);                   // pr_ppid
+  desc.PutHex32(0);                      // pr_pgrp
+  desc.PutHex32(0);                      // pr_sid
+  for (int i = 0; i < 8; ++i)
+    desc.PutHex64(0); // pr_utime, pr_stime, pr_cutime, pr_cstime
+
+  RegisterContextSP reg_ctx_sp = thread.GetRegisterContext();
+  for (const char *name : gpr_names) {
+    uint64_t value = 0;
+    if (reg_ctx_sp) {
+      if (const RegisterInfo *reg_info =
+              reg_ctx_sp->GetRegisterInfoByName(name))
+        value = reg_ctx_sp->ReadRegisterAsUnsigned(reg_info, 0);
+    }
+    desc.PutHex64(value);
+  }
+  desc.PutHex32(0); // pr_fpvalid
+  desc.PutHex32(0);
+  AppendNote(notes, NT_LINUX_PRSTATUS, desc.GetString());
+}
+
+static void AppendPrPsInfo(StreamString &notes, Process &process,
+                           const ProcessInstanceInfo &info,
+                           const ArchSpec &arch) {
+  std::string args;
+  info.GetArguments().GetCommandString(args);
+  std::string fname = info.GetExecutableFile().GetFilename().AsCString("");
+  if (fname.empty())
+    if (ModuleSP exe_module_sp = process.GetTarget().GetExecutableModule())
+      fname = exe_module_sp->GetFileSpec().GetFilename().AsCString("");
+
+  StreamString desc(Stream::eBinary, arch.GetAddressByteSize(),
+                    arch.GetByteOrder());
+  desc.PutHex8(0);   // pr_state
+  desc.PutHex8('T'); // pr_sname, the process is stopped
+  desc.PutHex8(0);   // pr_zomb
+  desc.PutHex8(0);   // pr_nice
+  desc.PutHex32(0);
+  desc.PutHex64(0); // pr_flag
+  desc.PutHex32(info.GetUserID());
+  desc.PutHex32(info.GetGroupID());
+  desc.PutHex32(process.GetID());
+  desc.PutHex32(info.GetParentProcessID());
+  desc.PutHex32(0); // pr_pgrp
+  desc.PutHex32(0); // pr_sid
+  PutFixedString(desc, fname, 16);
+  PutFixedString(desc, args, 80);
+  AppendNote(notes, NT_LINUX_PRPSINFO, desc.GetString());
+}
+
+static void AppendFileNote(StreamString &notes,
+                           const std::vector<MappedFile> &files,
+                           const ArchSpec &arch) {
+  StreamString desc(Stream::eBinary, arch.GetAddressByteSize(),
+                    arch.GetByteOrder());
+  desc.PutHex64(files.size());
+  desc.PutHex64(kPageSize);
+  for (const MappedFile &file : files) {
+    desc.PutHex64(file.start);
+    desc.PutHex64(file.end);
+    desc.PutHex64(file.file_offset / kPageSize);
+  }
+  for (const MappedFile &file : files)
+    desc.Write(file.path.c_str(), file.path.size() + 1);
+  AppendNote(notes, NT_LINUX_FILE, desc.GetString());
+}
+
+static bool IsZero(const uint8_t *data, size_t size) {
+  return size == 0 || (data[0] == 0 && memcmp(data, data + 1, size - 1) == 0);
+}
+
+// Read \a data.size() bytes at \a addr.  Pages that can't be read are left
+// zero, so they become holes in the file like pages that are all zeros.
+static void ReadChunk(Process &process, addr_t addr,
+                      std::vector<uint8_t> &data) {
+  // Reading past the memory cache keeps a whole process image from passing
+  // through it.
+  Status error;
+  size_t bytes_read =
+      process.ReadMemoryFromInferior(addr, data.data(), data.size(), error);
+  if (bytes_read == data.size())
+    return;
+
+  // Some of the chunk isn't readable: retry the rest a page at a time.
+  for (size_t offset = llvm::alignDown(bytes_read, kPageSize);
+       offset < data.size(); offset += kPageSize) {
+    const size_t size = std::min<size_t>(kPageSize, data.size() - offset);
+    bytes_read = process.ReadMemoryFromInferior(addr + offset,
+                                                data.data() + offset, size,
+                                                error);
+    memset(data.data() + offset + bytes_read, 0, size - bytes_read);
+  }
+}
+
+// Write the pages of \a data that aren't all zeros at \a file_offset.
+static Status WriteChunk(File &core_file, const std::vector<uint8_t> &data,
+                         uint64_t file_offset) {
+  size_t pos = 0;
+  while (pos < data.size()) {
+    size_t end = pos;
+    while (end < data.size() &&
+           !IsZero(data.data() + end,
+                   std::min<size_t>(kPageSize, data.size() - end)))
+      end = std::min<size_t>(end + kPageSize, data.size());
+
+    if (end > pos) {
+      size_t num_bytes = end - pos;
+      off_t offset = file_offset + pos;
+      Status error = core_file.Write(data.data() + pos, num_bytes, offset);
+      if (error.Fail())
+        return error;
+      if (num_bytes != end - pos)
+        return Status("short write to the core file");
+    }
+    pos = std::min<size_t>(end + kPageSize, data.size());
+  }
+  return Status();
+}
+
+// Copy the readable memory of \a segments to the core file.  Reads from the
+// process are sequential anyway, so the next chunk is read while earlier
+// ones are scanned for zero pages and written.
+static Status WriteSegments(Process &process, File &core_file,
+                            const std::vector<CoreSegment> &segments) {
+  struct Chunk {
+    std::vector<uint8_t> data;
+    std::future<Status> written;
+  };
+  std::vector<Chunk> chunks(kNumChunks);
+  size_t chunk_idx = 0;
+
+  Status error;
+  for (const CoreSegment &segment : segments) {
+    for (addr_t offset = 0; offset < segment.file_size && error.Success();
+         offset += kChunkSize) {
+      Chunk &chunk = chunks[chunk_idx++ % chunks.size()];
+      if (chunk.written.valid()) {
+        error = chunk.written.get();
+        if (error.Fail())
+          break;
+      }
+      chunk.data.resize(
+          std::min<addr_t>(kChunkSize, segment.file_size - offset));
+      ReadChunk(process, segment.vaddr + offset, chunk.data);
+
+      const std::vector<uint8_t> *data = &chunk.data;
+      const uint64_t file_offset = segment.file_offset + offset;
+      chunk.written = TaskPool::AddTask([&core_file, data, file_offset]() {
+        return WriteChunk(core_file, *data, file_offset);
+      });
+    }
+    if (error.Fail())
+      break;
+  }
+
+  // The tasks refer to the chunks, so wait for all of them.
+  for (Chunk &chunk : chunks) {
+    if (chunk.written.valid()) {
+      Status chunk_error = chunk.written.get();
+      if (error.Success())
+        error = chunk_error;
+    }
+  }
+  return error;
+}
+
+// Collect the file mappings for the NT_FILE note.  The offset of a mapping
+// into its file can't be told from the addresses: the loader leaves
+// alignment gaps between segments, and the data segment sits at a virtual
+// distance from the text that isn't its file offset.  Mappings whose
+// offset the process plugin doesn't report are written with offset 0.
+static std::vector<MappedFile>
+GetMappedFiles(const std::vector<MemoryRegionInfoSP> &regions) {
+  std::vector<MappedFile> files;
+  for (const MemoryRegionInfoSP &region : regions) {
+    llvm::StringRef path = region->GetName().GetStringRef();
+    if (!path.startswith("/"))
+      continue;
+    MappedFile file;
+    file.start = region->GetRange().GetRangeBase();
+    file.end = region->GetRange().GetRangeEnd();
+    file.file_offset = region->GetFileOffset() != LLDB_INVALID_OFFSET
+                           ? region->GetFileOffset()
+                           : 0;
+    file.path = path;
+    files.push_back(file);
+  }
+  return files;
+}
+
+bool lldb_private::SaveELFCore(const lldb::ProcessSP &process_sp,
+                               const lldb_private::FileSpec &outfile,
+                               lldb_private::Status &error) {
+  if (!process_sp)
+    return false;
+
+  Target &target = process_sp->GetTarget();
+  const ArchSpec arch = target.GetArchitecture();
+  if (arch.GetTriple().getOS() != llvm::Triple::Linux)
+    return false;
+
+  uint16_t machine;
+  llvm::ArrayRef<const char *> gpr_names;
+  switch (arch.GetMachine()) {
+  case llvm::Triple::x86_64:
+    machine = llvm::ELF::EM_X86_64;
+    gpr_names = g_x86_64_gpr_names;
+    break;
+  case llvm::Triple::aarch64:
+    machine = llvm::ELF::EM_AARCH64;
+    gpr_names = g_arm64_gpr_names;
+    break;
+  default:
+    error.SetErrorStringWithFormat("unsupported core architecture: %s",
+                                   arch.GetTriple().str().c_str());
+    return true;
+  }
+  const ByteOrder byte_order = arch.GetByteOrder();
+
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+  const auto start_time = std::chrono::steady_clock::now();
+
+  std::vector<MemoryRegionInfoSP> regions;
+  Status region_error = process_sp->GetMemoryRegions(regions);
+  if (region_error.Fail() || regions.empty()) {
+    error.SetErrorString("process doesn't support getting memory region info");
+    return true;
+  }
+
+  ProcessInstanceInfo process_info;
+  process_sp->GetProcessInfo(process_info);
+
+  // Notes.
+  StreamString notes(Stream::eBinary, arch.GetAddressByteSize(), byte_order);
+  AppendPrPsInfo(notes, *process_sp, process_info, arch);
+  ThreadList &thread_list = process_sp->GetThreadList();
+  const uint32_t num_threads = thread_list.GetSize();
+  for (uint32_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    if (ThreadSP thread_sp = thread_list.GetThreadAtIndex(thread_idx))
+      AppendPrStatus(notes, *thread_sp, process_info.GetParentProcessID(),
+                     gpr_names, arch);
+  }
+  if (DataBufferSP auxv_sp = process_sp->GetAuxvData())
+    AppendNote(notes, NT_LINUX_AUXV,
+               llvm::StringRef(reinterpret_cast<const char *>(
+                                   auxv_sp->GetBytes()),
+                               auxv_sp->GetByteSize()));
+  std::vector<MappedFile> files = GetMappedFiles(regions);
+  if (!files.empty())
+    AppendFileNote(notes, files, arch);
+
+  // Layout: the ELF header, the program headers, a section header if there
+  // are too many program headers to count in the ELF header, the notes, and
+  // the memory contents starting on a page boundary.
+  const size_t num_phdrs = regions.size() + 1;
+  const bool extended_phnum = num_phdrs >= llvm::ELF::PN_XNUM;
+  const uint64_t phdrs_offset = kELFHeaderSize;
+  const uint64_t shdr_offset = phdrs_offset + num_phdrs * kProgramHeaderSize;
+  const uint64_t notes_offset =
+      shdr_offset + (extended_phnum ? kSectionHeaderSize : 0);
+  uint64_t file_offset = llvm::alignTo(notes_offset + notes.GetSize(),
+                                       kPageSize);
+
+  std::vector<CoreSegment> segments;
+  uint64_t num_memory_bytes = 0;
+  for (const MemoryRegionInfoSP &region : regions) {
+    CoreSegment segment;
+    segment.vaddr = region->GetRange().GetRangeBase();
+    segment.mem_size = region->GetRange().GetByteSize();
+    const bool readable = region->GetReadable() == MemoryRegionInfo::eYes;
+    segment.file_size = readable ? segment.mem_size : 0;
+    segment.file_offset = file_offset;
+    segment.flags = 0;
+    if (readable)
+      segment.flags |= llvm::ELF::PF_R;
+    if (region->GetWritable() == MemoryRegionInfo::eYes)
+      segment.flags |= llvm::ELF::PF_W;
+    if (region->GetExecutable() == MemoryRegionInfo::eYes)
+      segment.flags |= llvm::ELF::PF_X;
+    file_offset += llvm::alignTo(segment.file_size, kPageSize);
+    num_memory_bytes += segment.file_size;
+    segments.push_back(segment);
+  }
+
+  StreamString headers(Stream::eBinary, arch.GetAddressByteSize(),
+                       byte_order);
+  const uint8_t data_encoding = byte_order == eByteOrderBig
+                                    ? llvm::ELF::ELFDATA2MSB
+                                    : llvm::ELF::ELFDATA2LSB;
+  const uint8_t ident[llvm::ELF::EI_NIDENT] = {
+      0x7f, 'E', 'L', 'F', llvm::ELF::ELFCLASS64, data_encoding,
+      llvm::ELF::EV_CURRENT, llvm::ELF::ELFOSABI_NONE};
+  headers.Write(ident, sizeof(ident));
+  headers.PutHex16(llvm::ELF::ET_CORE);
+  headers.PutHex16(machine);
+  headers.PutHex32(llvm::ELF::EV_CURRENT);
+  headers.PutHex64(0); // e_entry
+  headers.PutHex64(phdrs_offset);
+  headers.PutHex64(extended_phnum ? shdr_offset : 0);
+  headers.PutHex32(0); // e_flags
+  headers.PutHex16(kELFHeaderSize);
+  headers.PutHex16(kProgramHeaderSize);
+  headers.PutHex16(extended_phnum ? llvm::ELF::PN_XNUM : num_phdrs);
+  headers.PutHex16(extended_phnum ? kSectionHeaderSize : 0);
+  headers.PutHex16(extended_phnum ? 1 : 0); // e_shnum
+  headers.PutHex16(0);                      // e_shstrndx
+
+  headers.PutHex32(llvm::ELF::PT_NOTE);
+  headers.PutHex32(0);
+  headers.PutHex64(notes_offset);
+  headers.PutHex64(0);
+  headers.PutHex64(0);
+  headers.PutHex64(notes.GetSize());
+  headers.PutHex64(0);
+  headers.PutHex64(4);
+  for (const CoreSegment &segment : segments) {
+    headers.PutHex32(llvm::ELF::PT_LOAD);
+    headers.PutHex32(segment.flags);
+    headers.PutHex64(segment.file_offset);
+    headers.PutHex64(segment.vaddr);
+    headers.PutHex64(0); // p_paddr
+    headers.PutHex64(segment.file_size);
+    headers.PutHex64(segment.mem_size);
+    headers.PutHex64(kPageSize);
+  }
+
+  if (extended_phnum) {
+    // Section header 0 holds the real number of program headers.
+    headers.PutHex32(0); // sh_name
+    headers.PutHex32(llvm::ELF::SHT_NULL);
+    headers.PutHex64(0); // sh_flags
+    headers.PutHex64(0); // sh_addr
+    headers.PutHex64(0); // sh_offset
+    headers.PutHex64(0); // sh_size
+    headers.PutHex32(0); // sh_link
+    headers.PutHex32(num_phdrs);
+    headers.PutHex64(0); // sh_addralign
+    headers.PutHex64(0); // sh_entsize
+  }
+  headers.Write(notes.GetData(), notes.GetSize());
+
+  File core_file;
+  std::string core_file_path(outfile.GetPath());
+  error = core_file.Open(core_file_path.c_str(),
+                         File::eOpenOptionWrite | File::eOpenOptionTruncate |
+                             File::eOpenOptionCanCreate);
+  if (error.Fail())
+    return true;
+
+  size_t num_bytes = headers.GetSize();
+  off_t offset = 0;
+  error = core_file.Write(headers.GetData(), num_bytes, offset);
+  if (error.Success())
+    error = WriteSegments(*process_sp, core_file, segments);
+  // Zero pages at the end of the last segment aren't written, so the size
+  // has to be set explicitly.
+  if (error.Success()) {
+    if (std::error_code ec = llvm::sys::fs::resize_file(
+            core_file.GetDescriptor(), file_offset))
+      error.SetErrorStringWithFormat("unable to set the size of '%s': %s",
+                                     core_file_path.c_str(),
+                                     ec.message().c_str());
+  }
+
+  if (log) {
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start_time;
+    log->Printf("SaveELFCore: wrote %zu threads and %zu regions with %" PRIu64
+                " bytes of memory to '%s' in %.3f s: %s",
+                static_cast<size_t>(num_threads), segments.size(),
+                num_memory_bytes, core_file_path.c_str(), elapsed.count(),
+                error.Success() ? "success" : error.AsCString());
+  }
+  return true;
+}
@@ -0,0 +1,36 @@
+//===-- ELFCoreWriter.h -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ELFCoreWriter_h_
+#define liblldb_ELFCoreWriter_h_
+
+#include "lldb/Target/Process.h"
+
+namespace lldb_private {
+
+//------------------------------------------------------------------
+/// Write a Linux ELF core file of \a process_sp to \a outfile.
+///
+/// The core has a PT_NOTE segment with the NT_PRSTATUS of every thread,
+/// NT_PRPSINFO, NT_AUXV and NT_FILE notes, and a PT_LOAD segment for every
+/// memory region.  Regions that can't be read are recorded without file
+/// contents, and pages that are all zeros are left as holes in the file.
+///
+/// @return
+///     False if the process isn't a Linux process this writer supports,
+///     so another plug-in can try.  Otherwise true, with \a error telling
+///     whether the core was written.
+//------------------------------------------------------------------
+bool SaveELFCore(const lldb::ProcessSP &process_sp,
+                 const lldb_private::FileSpec &outfile,
+                 lldb_private::Status &error);
+
+} // namespace lldb_private
+
+#endif
@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "ObjectFileELF.h"
+#include "ELFCoreWriter.h"
 
 #include <algorithm>
 #include <cassert>
@@ -383,7 +384,8 @@ const uint32_t ObjectFileELF::g_core_uuid_magic(0xE210C);
 void ObjectFileELF::Initialize() {
   PluginManager::RegisterPlugin(GetPluginNameStatic(),
                                 GetPluginDescriptionStatic(), CreateInstance,
-                                CreateMemoryInstance, GetModuleSpecifications);
+                                CreateMemoryInstance, GetModuleSpecifications,
+                                SaveCore);
 }
 
 void ObjectFileELF::Terminate() {
@@ -754,6 +756,12 @@ size_t ObjectFileELF::GetModuleSpecifications(
   return specs.GetSize() - initial_count;
 }
 
+bool ObjectFileELF::SaveCore(const lldb::ProcessSP &process_sp,
+                             const lldb_private::FileSpec &outfile,
+                             lldb_private::Status &error) {
+  return SaveELFCore(process_sp, outfile, error);
+}
+
 //------------------------------------------------------------------
 // PluginInterface protocol
 //------------------------------------------------------------------
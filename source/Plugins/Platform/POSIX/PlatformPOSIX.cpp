@@ -35,6 +35,7 @@
 #include "lldb/Target/Thread.h"
 #include "lldb/Utility/CleanUp.h"
 #include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/FileSpec.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/StreamString.h"
@@ -944,40 +945,66 @@ PlatformPOSIX::MakeLoadImageUtilityFunction(ExecutionContext &exe_ctx,
   struct __lldb_dlopen_result {
     void *image_ptr;
     const char *error_str;
+    char error_buf[1024];
   };
   
   extern void *memcpy(void *, const void *, size_t size);
   extern size_t strlen(const char *);
   
+  // dlerror frees its message on the next call, so keep a copy of it with
+  // the result it belongs to:
+  void __lldb_save_dlerror(__lldb_dlopen_result *result_ptr) {
+    const char *error_str = dlerror();
+    if (!error_str) {
+      result_ptr->error_str = nullptr;
+      return;
+    }
+    size_t error_len = strlen(error_str);
+    if (error_len >= sizeof(result_ptr->error_buf))
+      error_len = sizeof(result_ptr->error_buf) - 1;
+    memcpy((void *) result_ptr->error_buf, (void *) error_str, error_len);
+    result_ptr->error_buf[error_len] = '\0';
+    result_ptr->error_str = result_ptr->error_buf;
+  }
+
 
-  void * __lldb_dlopen_wrapper (const char *name, 
+  void * __lldb_dlopen_wrapper (const char *names,
                                 const char *path_strings,
                                 char *buffer,
                                 __lldb_dlopen_result *result_ptr)
   {
-    // This is the case where the name is the full path:
-    if (!path_strings) {
-      result_ptr->image_ptr = dlopen(name, 2);
-      if (result_ptr->image_ptr)
-        result_ptr->error_str = nullptr;
-      return nullptr;
-    }
-    
-    // This is the case where we have a list of paths:
-    size_t name_len = strlen(name);
-    while (path_strings && path_strings[0] != '\0') {
-      size_t path_len = strlen(path_strings);
-      memcpy((void *) buffer, (void *) path_strings, path_len);
-      buffer[path_len] = '/';
-      char *target_ptr = buffer+path_len+1; 
-      memcpy((void *) target_ptr, (void *) name, name_len + 1);
-      result_ptr->image_ptr = dlopen(buffer, 2);
-      if (result_ptr->image_ptr) {
-        result_ptr->error_str = nullptr;
-        break;
+    // The names are laid out null terminated and end to end, with an empty
+    // string terminating the list, and there is a result for each of them:
+    for (; names[0] != '\0'; names += strlen(names) + 1, ++result_ptr) {
+      const char *name = names;
+
+      // This is the case where the name is the full path:
+      if (!path_strings) {
+        result_ptr->image_ptr = dlopen(name, 2);
+        if (result_ptr->image_ptr)
+          result_ptr->error_str = nullptr;
+        else
+          __lldb_save_dlerror(result_ptr);
+        continue;
+      }
+
+      // This is the case where we have a list of paths:
+      size_t name_len = strlen(name);
+      const char *path = path_strings;
+      while (path[0] != '\0') {
+        size_t path_len = strlen(path);
+        memcpy((void *) buffer, (void *) path, path_len);
+        buffer[path_len] = '/';
+        char *target_ptr = buffer+path_len+1; 
+        memcpy((void *) target_ptr, (void *) name, name_len + 1);
+        result_ptr->image_ptr = dlopen(buffer, 2);
+        if (result_ptr->image_ptr) {
+          result_ptr->error_str = nullptr;
+          break;
+        }
+        __lldb_save_dlerror(result_ptr);
+        path = path + path_len + 1;
       }
-      result_ptr->error_str = dlerror();
-      path_strings = path_strings + path_len + 1;
     }
     return nullptr;
   }
@@ -1020,9 +1047,9 @@ PlatformPOSIX::MakeLoadImageUtilityFunction(ExecutionContext &exe_ctx,
   CompilerType clang_char_pointer_type
         = ast->GetBasicType(eBasicTypeChar).GetPointerType();
 
-  // We are passing four arguments, the basename, the list of places to look,
-  // a buffer big enough for all the path + name combos, and
-  // a pointer to the storage we've made for the result:
+  // We are passing four arguments, the list of names, the list of places to
+  // look, a buffer big enough for all the path + name combos, and
+  // a pointer to the storage we've made for the results:
   value.SetValueType(Value::eValueTypeScalar);
   value.SetCompilerType(clang_void_pointer_type);
   arguments.PushValue(value);
@@ -1054,16 +1081,61 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
                                     const std::vector<std::string> *paths,
                                     lldb_private::Status &error,
                                     lldb_private::FileSpec *loaded_image) {
+  std::vector<Status> errors;
+  std::vector<uint32_t> tokens =
+      LoadImagesWithWrapper(process, {remote_file}, paths, errors,
+                            loaded_image);
+  error = errors.front();
+  return tokens.front();
+}
+
+std::vector<uint32_t> PlatformPOSIX::DoLoadImages(
+    lldb_private::Process *process,
+    const std::vector<lldb_private::FileSpec> &remote_files,
+    const std::vector<std::string> *paths,
+    std::vector<lldb_private::Status> &errors) {
+  return LoadImagesWithWrapper(process, remote_files, paths, errors, nullptr);
+}
+
+std::vector<uint32_t> PlatformPOSIX::LoadImagesWithWrapper(
+    lldb_private::Process *process,
+    const std::vector<lldb_private::FileSpec> &remote_files,
+    const std::vector<std::string> *paths,
+    std::vector<lldb_private::Status> &errors,
+    lldb_private::FileSpec *loaded_image) {
   if (loaded_image)
     loaded_image->Clear();
 
-  std::string path;
-  path = remote_file.GetPath();
-  
+  const size_t num_files = remote_files.size();
+  std::vector<uint32_t> tokens(num_files, LLDB_INVALID_IMAGE_TOKEN);
+  errors.assign(num_files, Status());
+  if (num_files == 0)
+    return tokens;
+
+  // Until the wrapper has run, whatever goes wrong goes wrong for all of
+  // the images.
+  Status error;
+  auto fail = [&]() -> std::vector<uint32_t> {
+    errors.assign(num_files, error);
+    return tokens;
+  };
+
+  // The names are laid out null terminated and end to end, with an empty
+  // string terminating the buffer.
+  std::string names;
+  size_t max_name_size = 0;
+  for (const FileSpec &remote_file : remote_files) {
+    std::string path = remote_file.GetPath();
+    max_name_size = std::max(max_name_size, path.size());
+    names.append(path);
+    names.push_back('\0');
+  }
+  names.push_back('\0');
+
   ThreadSP thread_sp = process->GetThreadList().GetExpressionExecutionThread();
   if (!thread_sp) {
     error.SetErrorString("dlopen error: no thread available to call dlopen.");
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
   
   DiagnosticManager diagnostics;
@@ -1084,50 +1156,52 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
       });
   // If we couldn't make it, the error will be in error, so we can exit here.
   if (!dlopen_utility_func)
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
     
   do_dlopen_function = dlopen_utility_func->GetFunctionCaller();
   if (!do_dlopen_function) {
     error.SetErrorString("dlopen error: could not get function caller.");
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
   arguments = do_dlopen_function->GetArgumentValues();
   
-  // Now insert the path we are searching for and the result structure into the
-  // target.
+  // Now insert the names we are searching for and the result structures
+  // into the target.
   uint32_t permissions = ePermissionsReadable|ePermissionsWritable;
-  size_t path_len = path.size() + 1;
-  lldb::addr_t path_addr = process->AllocateMemory(path_len, 
-                                                   permissions,
-                                                   utility_error);
-  if (path_addr == LLDB_INVALID_ADDRESS) {
+  lldb::addr_t names_addr = process->AllocateMemory(names.size(),
+                                                    permissions,
+                                                    utility_error);
+  if (names_addr == LLDB_INVALID_ADDRESS) {
     error.SetErrorStringWithFormat("dlopen error: could not allocate memory"
                                     "for path: %s", utility_error.AsCString());
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
   
   // Make sure we deallocate the input string memory:
-  CleanUp path_cleanup([process, path_addr] { 
-      process->DeallocateMemory(path_addr); 
+  CleanUp names_cleanup([process, names_addr] {
+      process->DeallocateMemory(names_addr);
   });
   
-  process->WriteMemory(path_addr, path.c_str(), path_len, utility_error);
+  process->WriteMemory(names_addr, names.data(), names.size(), utility_error);
   if (utility_error.Fail()) {
     error.SetErrorStringWithFormat("dlopen error: could not write path string:"
                                     " %s", utility_error.AsCString());
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
   
-  // Make space for our return structure.  It is two pointers big: the token
-  // and the error string.
+  // Make space for our return structures.  Each holds two pointers, the
+  // token and the error string, and the buffer the error is copied into,
+  // which must be as big as error_buf in __lldb_dlopen_result.
   const uint32_t addr_size = process->GetAddressByteSize();
-  lldb::addr_t return_addr = process->CallocateMemory(2*addr_size,
+  const size_t error_buf_size = 1024;
+  const size_t result_size = 2 * addr_size + error_buf_size;
+  lldb::addr_t return_addr = process->CallocateMemory(num_files * result_size,
                                                       permissions,
                                                       utility_error);
   if (utility_error.Fail()) {
     error.SetErrorStringWithFormat("dlopen error: could not allocate memory"
                                     "for path: %s", utility_error.AsCString());
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
   
   // Make sure we deallocate the result structure memory
@@ -1141,8 +1215,8 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
   llvm::Optional<CleanUp> path_array_cleanup;
 
   // This is the address to a buffer large enough to hold the largest path
-  // conjoined with the library name we're passing in.  This is a convenience 
-  // to avoid having to call malloc in the dlopen function.
+  // conjoined with the longest library name we're passing in.  This is a
+  // convenience to avoid having to call malloc in the dlopen function.
   lldb::addr_t buffer_addr = 0x0;
   llvm::Optional<CleanUp> buffer_cleanup;
   
@@ -1174,7 +1248,7 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
       error.SetErrorStringWithFormat("dlopen error: could not allocate memory"
                                       "for path array: %s", 
                                       utility_error.AsCString());
-      return LLDB_INVALID_IMAGE_TOKEN;
+      return fail();
     }
     
     // Make sure we deallocate the paths array.
@@ -1188,11 +1262,11 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
     if (utility_error.Fail()) {
       error.SetErrorStringWithFormat("dlopen error: could not write path array:"
                                      " %s", utility_error.AsCString());
-      return LLDB_INVALID_IMAGE_TOKEN;
+      return fail();
     }
     // Now make spaces in the target for the buffer.  We need to add one for
     // the '/' that the utility function will insert and one for the '\0':
-    buffer_size += path.size() + 2;
+    buffer_size += max_name_size + 2;
     
     buffer_addr = process->AllocateMemory(buffer_size, 
                                           permissions,
@@ -1201,7 +1275,7 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
       error.SetErrorStringWithFormat("dlopen error: could not allocate memory"
                                       "for buffer: %s", 
                                       utility_error.AsCString());
-      return LLDB_INVALID_IMAGE_TOKEN;
+      return fail();
     }
   
     // Make sure we deallocate the buffer memory:
@@ -1210,7 +1284,7 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
     });
   }
     
-  arguments.GetValueAtIndex(0)->GetScalar() = path_addr;
+  arguments.GetValueAtIndex(0)->GetScalar() = names_addr;
   arguments.GetValueAtIndex(1)->GetScalar() = path_array_addr;
   arguments.GetValueAtIndex(2)->GetScalar() = buffer_addr;
   arguments.GetValueAtIndex(3)->GetScalar() = return_addr;
@@ -1225,7 +1299,7 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
     error.SetErrorStringWithFormat("dlopen error: could not write function "
                                    "arguments: %s", 
                                    diagnostics.GetString().c_str());
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
   
   // Make sure we clean up the args structure.  We can't reuse it because the
@@ -1243,7 +1317,8 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
   options.SetUnwindOnError(true);
   options.SetTrapExceptions(false); // dlopen can't throw exceptions, so
                                     // don't do the work to trap them.
-  options.SetTimeout(std::chrono::seconds(2));
+  // Every image gets the time a single dlopen call used to get.
+  options.SetTimeout(std::chrono::seconds(2 * num_files));
   options.SetIsForUtilityExpr(true);
 
   Value return_value;
@@ -1261,53 +1336,56 @@ uint32_t PlatformPOSIX::DoLoadImage(lldb_private::Process *process,
     error.SetErrorStringWithFormat("dlopen error: failed executing "
                                    "dlopen wrapper function: %s", 
                                    diagnostics.GetString().c_str());
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
-  
-  // Read the dlopen token from the return area:
-  lldb::addr_t token = process->ReadPointerFromMemory(return_addr, 
-                                                      utility_error);
-  if (utility_error.Fail()) {
+
+  // Read all the results back in one go:
+  DataBufferHeap result_data(num_files * result_size, 0);
+  if (process->ReadMemory(return_addr, result_data.GetBytes(),
+                          result_data.GetByteSize(),
+                          utility_error) != result_data.GetByteSize()) {
     error.SetErrorStringWithFormat("dlopen error: could not read the return "
                                     "struct: %s", utility_error.AsCString());
-    return LLDB_INVALID_IMAGE_TOKEN;
+    return fail();
   }
-  
-  // The dlopen succeeded!
-  if (token != 0x0) {
-    if (loaded_image && buffer_addr != 0x0)
-    {
-      // Capture the image which was loaded.  We leave it in the buffer on
-      // exit from the dlopen function, so we can just read it from there:
-      std::string name_string;
-      process->ReadCStringFromMemory(buffer_addr, name_string, utility_error);
-      if (utility_error.Success())
-        loaded_image->SetFile(name_string, false, 
-                              llvm::sys::path::Style::posix);
+  DataExtractor result_extractor(result_data.GetBytes(),
+                                 result_data.GetByteSize(),
+                                 process->GetByteOrder(), addr_size);
+
+  for (size_t i = 0; i < num_files; ++i) {
+    lldb::offset_t offset = i * result_size;
+    lldb::addr_t token = result_extractor.GetAddress(&offset);
+    lldb::addr_t error_addr = result_extractor.GetAddress(&offset);
+
+    // The dlopen succeeded!
+    if (token != 0x0) {
+      if (loaded_image && buffer_addr != 0x0) {
+        // Capture the image which was loaded.  We leave it in the buffer on
+        // exit from the dlopen function, so we can just read it from there:
+        std::string name_string;
+        process->ReadCStringFromMemory(buffer_addr, name_string,
+                                       utility_error);
+        if (utility_error.Success())
+          loaded_image->SetFile(name_string, false,
+                                llvm::sys::path::Style::posix);
+      }
+      tokens[i] = process->AddImageToken(token);
+      continue;
     }
-    return process->AddImageToken(token);
-  }
-    
-  // We got an error, lets read in the error string:
-  std::string dlopen_error_str;
-  lldb::addr_t error_addr 
-    = process->ReadPointerFromMemory(return_addr + addr_size, utility_error);
-  if (utility_error.Fail()) {
-    error.SetErrorStringWithFormat("dlopen error: could not read error string: "
-                                    "%s", utility_error.AsCString());
-    return LLDB_INVALID_IMAGE_TOKEN;
+
+    // We got an error.  The wrapper copied the message into this result's
+    // error_buf, which we've already read in:
+    const char *dlopen_error_str = nullptr;
+    if (error_addr != 0x0)
+      dlopen_error_str = result_extractor.GetCStr(&offset);
+    if (dlopen_error_str && dlopen_error_str[0] != '\0')
+      errors[i].SetErrorStringWithFormat("dlopen error: %s",
+                                         dlopen_error_str);
+    else
+      errors[i].SetErrorStringWithFormat("dlopen failed for unknown reasons.");
   }
-  
-  size_t num_chars = process->ReadCStringFromMemory(error_addr + addr_size, 
-                                                    dlopen_error_str, 
-                                                    utility_error);
-  if (utility_error.Success() && num_chars > 0)
-    error.SetErrorStringWithFormat("dlopen error: %s",
-                                   dlopen_error_str.c_str());
-  else
-    error.SetErrorStringWithFormat("dlopen failed for unknown reasons.");
 
-  return LLDB_INVALID_IMAGE_TOKEN;
+  return tokens;
 }
 
 Status PlatformPOSIX::UnloadImage(lldb_private::Process *process,
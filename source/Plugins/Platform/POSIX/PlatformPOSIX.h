@@ -169,6 +169,12 @@ public:
                        lldb_private::Status &error,
                        lldb_private::FileSpec *loaded_image) override;
 
+  std::vector<uint32_t>
+  DoLoadImages(lldb_private::Process *process,
+               const std::vector<lldb_private::FileSpec> &remote_files,
+               const std::vector<std::string> *paths,
+               std::vector<lldb_private::Status> &errors) override;
+
   lldb_private::Status UnloadImage(lldb_private::Process *process,
                                    uint32_t image_token) override;
 
@@ -210,6 +216,16 @@ protected:
   llvm::StringRef GetLibdlFunctionDeclarations(lldb_private::Process *process);
 
 private:
+  // Opens all of remote_files with one call to the dlopen wrapper.  If
+  // loaded_image is non-null, it is set to the path the last image was
+  // found at.
+  std::vector<uint32_t>
+  LoadImagesWithWrapper(lldb_private::Process *process,
+                        const std::vector<lldb_private::FileSpec> &remote_files,
+                        const std::vector<std::string> *paths,
+                        std::vector<lldb_private::Status> &errors,
+                        lldb_private::FileSpec *loaded_image);
+
   DISALLOW_COPY_AND_ASSIGN(PlatformPOSIX);
 };
 
@@ -16,6 +16,7 @@
 #include <unistd.h>
 
 // C++ Includes
+#include <algorithm>
 #include <fstream>
 #include <mutex>
 #include <sstream>
@@ -602,6 +603,10 @@ void NativeProcessLinux::MonitorSIGTRAP(const siginfo_t &info,
 
     // Exec clears any pending notifications.
     m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+    m_conditional_step_state = eConditionalStepNone;
+    m_conditional_step_tid = LLDB_INVALID_THREAD_ID;
+    m_conditional_step_resume_tids.clear();
+    m_tracepoints.clear();
 
     // Remove all but the main thread here.  Linux fork creates a new process
     // which only copies the main thread.
@@ -746,6 +751,16 @@ void NativeProcessLinux::MonitorTrace(NativeThreadLinux &thread) {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
   LLDB_LOG(log, "received trace event, pid = {0}", thread.GetID());
 
+  if (m_conditional_step_state == eConditionalStepStepping &&
+      thread.GetID() == m_conditional_step_tid) {
+    // The thread is past a breakpoint whose conditions were false. The
+    // client never asked for this step, so there is nothing to report.
+    thread.SetStoppedWithNoReason();
+    FinishConditionalBreakpointStep();
+    SignalIfAllThreadsStopped();
+    return;
+  }
+
   // This thread is currently stopped.
   thread.SetStoppedByTrace();
 
@@ -766,6 +781,14 @@ void NativeProcessLinux::MonitorBreakpoint(NativeThreadLinux &thread) {
   if (m_threads_stepping_with_breakpoint.find(thread.GetID()) !=
       m_threads_stepping_with_breakpoint.end())
     thread.SetStoppedByTrace();
+  else if (error.Success()) {
+    const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+    if (!BreakpointConditionsSayStop(thread, pc)) {
+      StepOverConditionalBreakpoint(thread);
+      return;
+    }
+    CollectTracepoints(thread, pc);
+  }
 
   StopRunningThreads(thread.GetID());
 }
@@ -838,6 +861,10 @@ void NativeProcessLinux::MonitorSignal(const siginfo_t &info,
 
         SetCurrentThreadID(thread.GetID());
         SignalIfAllThreadsStopped();
+      } else if (m_conditional_step_state == eConditionalStepStopping) {
+        // Stopped so another thread can step over a conditional breakpoint.
+        thread.SetStoppedWithNoReason();
+        StepOverConditionalBreakpointIfAllThreadsStopped();
       } else {
         // We can end up here if stop was initiated by LLGS but by this time a
         // thread stop has occurred - maybe initiated by another event.
@@ -1305,9 +1332,10 @@ ParseMemoryRegionInfoFromProcMapsLine(llvm::StringRef &maps_line,
   else
     return Status("unexpected /proc/{pid}/maps exec permission char");
 
-  line_extractor.GetChar();              // Read the private bit
-  line_extractor.SkipSpaces();           // Skip the separator
-  line_extractor.GetHexMaxU64(false, 0); // Read the offset
+  line_extractor.GetChar();    // Read the private bit
+  line_extractor.SkipSpaces(); // Skip the separator
+  const lldb::offset_t file_offset =
+      line_extractor.GetHexMaxU64(false, LLDB_INVALID_OFFSET);
   line_extractor.GetHexMaxU64(false, 0); // Read the major device number
   line_extractor.GetChar();              // Read the device id separator
   line_extractor.GetHexMaxU64(false, 0); // Read the major device number
@@ -1316,8 +1344,11 @@ ParseMemoryRegionInfoFromProcMapsLine(llvm::StringRef &maps_line,
 
   line_extractor.SkipSpaces();
   const char *name = line_extractor.Peek();
-  if (name)
+  if (name) {
     memory_region_info.SetName(name);
+    // The offset only means something for regions backed by a file.
+    memory_region_info.SetFileOffset(file_offset);
+  }
 
   return Status();
 }
@@ -1391,6 +1422,22 @@ Status NativeProcessLinux::GetMemoryRegionInfo(lldb::addr_t load_addr,
   return error;
 }
 
+Status
+NativeProcessLinux::GetMemoryRegions(std::vector<MemoryRegionInfo> &regions) {
+  regions.clear();
+  if (m_supports_mem_region == LazyBool::eLazyBoolNo)
+    return Status("unsupported");
+
+  Status error = PopulateMemoryRegionCache();
+  if (error.Fail())
+    return error;
+
+  regions.reserve(m_mem_region_cache.size());
+  for (const auto &entry : m_mem_region_cache)
+    regions.push_back(entry.first);
+  return Status();
+}
+
 Status NativeProcessLinux::PopulateMemoryRegionCache() {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
 
@@ -1776,6 +1823,8 @@ bool NativeProcessLinux::StopTrackingThread(lldb::tid_t thread_id) {
 
   if (found)
     StopTracingForThread(thread_id);
+  if (thread_id == m_conditional_step_tid)
+    FinishConditionalBreakpointStep();
   SignalIfAllThreadsStopped();
   return found;
 }
@@ -1988,8 +2037,12 @@ void NativeProcessLinux::StopRunningThreads(const lldb::tid_t triggering_tid) {
 }
 
 void NativeProcessLinux::SignalIfAllThreadsStopped() {
-  if (m_pending_notification_tid == LLDB_INVALID_THREAD_ID)
-    return; // No pending notification. Nothing to do.
+  if (m_pending_notification_tid == LLDB_INVALID_THREAD_ID) {
+    // No pending notification, but we may be stopping threads to step over a
+    // conditional breakpoint.
+    StepOverConditionalBreakpointIfAllThreadsStopped();
+    return;
+  }
 
   for (const auto &thread_sp : m_threads) {
     if (StateIsRunningState(thread_sp->GetState()))
@@ -2000,6 +2053,10 @@ void NativeProcessLinux::SignalIfAllThreadsStopped() {
   Log *log(
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
 
+  // A real stop overtook a conditional breakpoint step. Put the breakpoint
+  // back; the client resumes the threads the step had stopped.
+  FinishConditionalBreakpointStep();
+
   // Clear any temporary breakpoints we used to implement software single
   // stepping.
   for (const auto &thread_info : m_threads_stepping_with_breakpoint) {
@@ -2025,6 +2082,126 @@ void NativeProcessLinux::ThreadWasCreated(NativeThreadLinux &thread) {
     // We will need to wait for this new thread to stop as well before firing
     // the notification.
     thread.RequestStop();
+  } else if (m_conditional_step_state != eConditionalStepNone &&
+             StateIsRunningState(thread.GetState())) {
+    // The new thread must not run while a conditional breakpoint is lifted.
+    thread.RequestStop();
+    m_conditional_step_resume_tids.push_back(thread.GetID());
+  }
+}
+
+void NativeProcessLinux::StepOverConditionalBreakpoint(
+    NativeThreadLinux &thread) {
+  Log *log(
+      GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
+  const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID ||
+      m_conditional_step_state != eConditionalStepNone) {
+    // The process is already being stopped. Leave the thread parked on the
+    // breakpoint: once resumed it will hit it again and re-evaluate the
+    // conditions.
+    LLDB_LOG(log, "tid {0} parked at conditional breakpoint {1:x}",
+             thread.GetID(), pc);
+    thread.SetStoppedWithNoReason();
+    if (m_conditional_step_state != eConditionalStepNone &&
+        std::find(m_conditional_step_resume_tids.begin(),
+                  m_conditional_step_resume_tids.end(),
+                  thread.GetID()) == m_conditional_step_resume_tids.end())
+      m_conditional_step_resume_tids.push_back(thread.GetID());
+    SignalIfAllThreadsStopped();
+    return;
+  }
+
+  // The thread is going past the breakpoint now, so this is the hit to
+  // record; a parked thread records it when it comes back.
+  CollectTracepoints(thread, pc);
+  LLDB_LOG(log, "tid {0} conditions of breakpoint {1:x} are false, stepping "
+                "over it",
+           thread.GetID(), pc);
+
+  m_conditional_step_state = eConditionalStepStopping;
+  m_conditional_step_tid = thread.GetID();
+  m_conditional_step_addr = pc;
+  m_conditional_step_resume_tids.clear();
+  for (const auto &thread_sp : m_threads) {
+    if (StateIsRunningState(thread_sp->GetState())) {
+      static_cast<NativeThreadLinux *>(thread_sp.get())->RequestStop();
+      m_conditional_step_resume_tids.push_back(thread_sp->GetID());
+    }
+  }
+
+  StepOverConditionalBreakpointIfAllThreadsStopped();
+}
+
+void NativeProcessLinux::StepOverConditionalBreakpointIfAllThreadsStopped() {
+  if (m_conditional_step_state != eConditionalStepStopping)
+    return;
+
+  for (const auto &thread_sp : m_threads) {
+    if (StateIsRunningState(thread_sp->GetState()))
+      return; // Some threads are still running.
+  }
+
+  Log *log(
+      GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
+  const lldb::tid_t tid = m_conditional_step_tid;
+  NativeThreadLinux *thread = GetThreadByID(tid);
+  if (!thread) {
+    FinishConditionalBreakpointStep();
+    return;
+  }
+
+  Status error = DisableBreakpoint(m_conditional_step_addr);
+  if (error.Success()) {
+    m_conditional_step_state = eConditionalStepStepping;
+    error = ResumeThread(*thread, eStateStepping, LLDB_INVALID_SIGNAL_NUMBER);
+    if (error.Success())
+      return;
+  }
+
+  // We can't step over the breakpoint ourselves. Report the hit and let the
+  // client evaluate the conditions.
+  LLDB_LOG(log, "tid {0} failed to step over conditional breakpoint {1:x}: "
+                "{2}",
+           tid, m_conditional_step_addr, error);
+  thread->SetStoppedByBreakpoint();
+  StopRunningThreads(tid);
+}
+
+void NativeProcessLinux::FinishConditionalBreakpointStep() {
+  if (m_conditional_step_state == eConditionalStepNone)
+    return;
+
+  Log *log(
+      GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
+  if (m_conditional_step_state == eConditionalStepStepping) {
+    Status error = EnableBreakpoint(m_conditional_step_addr);
+    if (error.Fail())
+      LLDB_LOG(log, "failed to re-enable breakpoint {0:x}: {1}",
+               m_conditional_step_addr, error);
+  }
+
+  std::vector<lldb::tid_t> tids;
+  tids.swap(m_conditional_step_resume_tids);
+  tids.push_back(m_conditional_step_tid);
+  m_conditional_step_state = eConditionalStepNone;
+  m_conditional_step_tid = LLDB_INVALID_THREAD_ID;
+  m_conditional_step_addr = LLDB_INVALID_ADDRESS;
+
+  // If something else stopped the process meanwhile, the client gets to
+  // decide which threads run next.
+  if (m_pending_notification_tid != LLDB_INVALID_THREAD_ID)
+    return;
+
+  for (lldb::tid_t tid : tids) {
+    NativeThreadLinux *thread = GetThreadByID(tid);
+    if (!thread || !StateIsStoppedState(thread->GetState(), false))
+      continue;
+    Status error =
+        ResumeThread(*thread, eStateRunning, LLDB_INVALID_SIGNAL_NUMBER);
+    if (error.Fail())
+      LLDB_LOG(log, "failed to resume thread {0}: {1}", tid, error);
   }
 }
 
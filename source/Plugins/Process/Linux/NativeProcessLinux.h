@@ -68,6 +68,8 @@ public:
   Status GetMemoryRegionInfo(lldb::addr_t load_addr,
                              MemoryRegionInfo &range_info) override;
 
+  Status GetMemoryRegions(std::vector<MemoryRegionInfo> &regions) override;
+
   Status ReadMemory(lldb::addr_t addr, void *buf, size_t size,
                     size_t &bytes_read) override;
 
@@ -133,6 +135,12 @@ public:
 
   bool SupportHardwareSingleStepping() const;
 
+  // Stepping over a breakpoint whose conditions are false needs a hardware
+  // single step; see StepOverConditionalBreakpoint().
+  bool SupportsBreakpointConditions() const override {
+    return SupportHardwareSingleStepping();
+  }
+
 protected:
   // ---------------------------------------------------------------------
   // NativeProcessProtocol protected interface
@@ -155,6 +163,21 @@ private:
   // the relevan breakpoint
   std::map<lldb::tid_t, lldb::addr_t> m_threads_stepping_with_breakpoint;
 
+  // A thread hit a breakpoint whose conditions were all false and is being
+  // moved past it without telling the client.  All other threads are stopped
+  // first, then the breakpoint is lifted while the thread single steps, so no
+  // other thread can run through the unprotected address.
+  enum ConditionalStepState {
+    eConditionalStepNone,
+    eConditionalStepStopping,
+    eConditionalStepStepping
+  };
+  ConditionalStepState m_conditional_step_state = eConditionalStepNone;
+  lldb::tid_t m_conditional_step_tid = LLDB_INVALID_THREAD_ID;
+  lldb::addr_t m_conditional_step_addr = LLDB_INVALID_ADDRESS;
+  // Threads stopped for the step that must be resumed once it is done.
+  std::vector<lldb::tid_t> m_conditional_step_resume_tids;
+
   // ---------------------------------------------------------------------
   // Private Instance Methods
   // ---------------------------------------------------------------------
@@ -217,6 +240,19 @@ private:
   // Notify the delegate if all threads have stopped.
   void SignalIfAllThreadsStopped();
 
+  // Step \p thread, which is stopped at a breakpoint whose conditions are
+  // all false, past the breakpoint and resume the process without
+  // reporting a stop.
+  void StepOverConditionalBreakpoint(NativeThreadLinux &thread);
+
+  // Once every other thread has stopped, lift the breakpoint and single
+  // step the thread stepping over it.
+  void StepOverConditionalBreakpointIfAllThreadsStopped();
+
+  // Put the breakpoint back after the single step and resume the threads
+  // stopped for it, unless a real stop is now pending.
+  void FinishConditionalBreakpointStep();
+
   // Resume the given thread, optionally passing it the given signal. The type
   // of resume
   // operation (continue, single-step) depends on the state parameter.
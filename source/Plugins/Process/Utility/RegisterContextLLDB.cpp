@@ -138,7 +138,7 @@ void RegisterContextLLDB::InitializeZerothFrame() {
 
   // Initialize m_current_pc, an Address object, based on current_pc, an
   // addr_t.
-  m_current_pc.SetLoadAddress(current_pc, &process->GetTarget());
+  SetCurrentPC(*process, current_pc, false);
 
   // If we don't have a Module for some reason, we're not going to find
   // symbol/function information - just stick in some reasonable defaults and
@@ -264,6 +264,22 @@ void RegisterContextLLDB::InitializeZerothFrame() {
                m_full_unwind_plan_sp->GetSourceName().GetCString());
 }
 
+void RegisterContextLLDB::SetCurrentPC(Process &process, addr_t pc,
+                                       bool allow_section_end) {
+  Target &target = process.GetTarget();
+  m_current_pc.SetLoadAddress(pc, &target, allow_section_end);
+  if (m_current_pc.GetModule())
+    return;
+
+  // Dynamic loaders that load modules on demand, as for core files with
+  // plugin.process.elf-core.load-modules-on-demand set, load it now.
+  DynamicLoader *dyld = process.GetDynamicLoader();
+  if (dyld && dyld->LoadModuleContainingAddress(pc)) {
+    UnwindLogMsg("loaded the module containing pc 0x%" PRIx64, pc);
+    m_current_pc.SetLoadAddress(pc, &target, allow_section_end);
+  }
+}
+
 // Initialize a RegisterContextLLDB for the non-zeroth frame -- rely on the
 // RegisterContextLLDB "below" it to provide things like its current pc value.
 
@@ -328,7 +344,7 @@ void RegisterContextLLDB::InitializeNonZerothFrame() {
   }
 
   const bool allow_section_end = true;
-  m_current_pc.SetLoadAddress(pc, &process->GetTarget(), allow_section_end);
+  SetCurrentPC(*process, pc, allow_section_end);
 
   // If we don't have a Module for some reason, we're not going to find
   // symbol/function information - just stick in some reasonable defaults and
@@ -99,6 +99,10 @@ private:
 
   void InitializeNonZerothFrame();
 
+  // Set m_current_pc to the load address pc, asking the dynamic loader to
+  // load the module that contains pc if no loaded module does.
+  void SetCurrentPC(Process &process, lldb::addr_t pc, bool allow_section_end);
+
   SharedPtr GetNextFrame() const;
 
   SharedPtr GetPrevFrame() const;
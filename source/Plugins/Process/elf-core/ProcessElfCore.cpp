@@ -19,12 +19,14 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Core/State.h"
+#include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Target/DynamicLoader.h"
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/UnixSignals.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/Log.h"
 
 #include "llvm/BinaryFormat/ELF.h"
@@ -38,6 +40,48 @@
 
 using namespace lldb_private;
 
+namespace {
+
+static constexpr PropertyDefinition g_properties[] = {
+    {"load-modules-on-demand", OptionValue::eTypeBoolean, true, false, NULL,
+     {},
+     "Load the shared libraries of a core file only when a stack frame is "
+     "in one of them. Breakpoints and symbol lookups only see the libraries "
+     "that are loaded."}};
+
+enum { ePropertyLoadModulesOnDemand };
+
+class PluginProperties : public Properties {
+public:
+  static ConstString GetSettingName() {
+    return ProcessElfCore::GetPluginNameStatic();
+  }
+
+  PluginProperties() : Properties() {
+    m_collection_sp.reset(new OptionValueProperties(GetSettingName()));
+    m_collection_sp->Initialize(g_properties);
+  }
+
+  virtual ~PluginProperties() {}
+
+  bool GetLoadModulesOnDemand() const {
+    const uint32_t idx = ePropertyLoadModulesOnDemand;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        NULL, idx, g_properties[idx].default_uint_value != 0);
+  }
+};
+
+typedef std::shared_ptr<PluginProperties> ProcessElfCorePropertiesSP;
+
+static const ProcessElfCorePropertiesSP &GetGlobalPluginProperties() {
+  static ProcessElfCorePropertiesSP g_settings_sp;
+  if (!g_settings_sp)
+    g_settings_sp.reset(new PluginProperties());
+  return g_settings_sp;
+}
+
+} // anonymous namespace end
+
 ConstString ProcessElfCore::GetPluginNameStatic() {
   static ConstString g_name("elf-core");
   return g_name;
@@ -262,9 +306,13 @@ Status ProcessElfCore::DoLoadCore() {
 }
 
 lldb_private::DynamicLoader *ProcessElfCore::GetDynamicLoader() {
-  if (m_dyld_ap.get() == NULL)
+  if (m_dyld_ap.get() == NULL) {
     m_dyld_ap.reset(DynamicLoader::FindPlugin(
         this, DynamicLoaderPOSIXDYLD::GetPluginNameStatic().GetCString()));
+    if (m_dyld_ap && GetGlobalPluginProperties()->GetLoadModulesOnDemand())
+      static_cast<DynamicLoaderPOSIXDYLD *>(m_dyld_ap.get())
+          ->SetLoadModulesOnDemand(true);
+  }
   return m_dyld_ap.get();
 }
 
@@ -322,6 +370,13 @@ Status ProcessElfCore::GetMemoryRegionInfo(lldb::addr_t load_addr,
                                     ? MemoryRegionInfo::eYes
                                     : MemoryRegionInfo::eNo);
       region_info.SetMapped(MemoryRegionInfo::eYes);
+      // Name the region after the file mapped there, if there is one.
+      for (const NT_FILE_Entry &entry : m_nt_file_entries) {
+        if (entry.start <= load_addr && load_addr < entry.end) {
+          region_info.SetName(entry.path.GetCString());
+          break;
+        }
+      }
     } else if (load_addr < permission_entry->GetRangeBase()) {
       region_info.GetRange().SetRangeBase(load_addr);
       region_info.GetRange().SetRangeEnd(permission_entry->GetRangeBase());
@@ -398,6 +453,35 @@ size_t ProcessElfCore::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
   return bytes_copied + zero_fill_size;
 }
 
+bool ProcessElfCore::GetSharedMemoryData(lldb::addr_t addr, size_t size,
+                                         DataExtractor &data) {
+  ObjectFile *core_objfile = m_core_module_sp->GetObjectFile();
+  if (core_objfile == NULL || size == 0)
+    return false;
+
+  const VMRangeToFileOffset::Entry *address_range =
+      m_core_aranges.FindEntryThatContains(addr);
+  if (address_range == NULL)
+    return false;
+
+  // Only ranges that are entirely in the file can be shared, the rest of
+  // a segment reads as zeros.
+  const lldb::addr_t offset = addr - address_range->GetRangeBase();
+  const lldb::addr_t file_start = address_range->data.GetRangeBase();
+  const lldb::addr_t file_end = address_range->data.GetRangeEnd();
+  if (file_end < file_start + offset || file_end - (file_start + offset) < size)
+    return false;
+
+  // GetData() shares the buffer the core file is mapped into.
+  DataExtractor core_data;
+  if (core_objfile->GetData(file_start + offset, size, core_data) != size)
+    return false;
+  DataBufferSP data_sp = core_data.GetSharedDataBuffer();
+  if (!data_sp)
+    return false;
+  return data.SetData(data_sp, core_data.GetSharedDataOffset(), size) == size;
+}
+
 void ProcessElfCore::Clear() {
   m_thread_list.Clear();
 
@@ -409,10 +493,22 @@ void ProcessElfCore::Initialize() {
 
   llvm::call_once(g_once_flag, []() {
     PluginManager::RegisterPlugin(GetPluginNameStatic(),
-                                  GetPluginDescriptionStatic(), CreateInstance);
+                                  GetPluginDescriptionStatic(), CreateInstance,
+                                  DebuggerInitialize);
   });
 }
 
+void ProcessElfCore::DebuggerInitialize(Debugger &debugger) {
+  if (!PluginManager::GetSettingForProcessPlugin(
+          debugger, PluginProperties::GetSettingName())) {
+    const bool is_global_setting = true;
+    PluginManager::CreateSettingForProcessPlugin(
+        debugger, GetGlobalPluginProperties()->GetValueProperties(),
+        ConstString("Properties for the elf-core process plug-in."),
+        is_global_setting);
+  }
+}
+
 lldb::addr_t ProcessElfCore::GetImageInfoAddress() {
   ObjectFile *obj_file = GetTarget().GetExecutableModule()->GetObjectFile();
   Address addr = obj_file->GetImageInfoAddress(&GetTarget());
@@ -46,6 +46,8 @@ public:
 
   static void Terminate();
 
+  static void DebuggerInitialize(lldb_private::Debugger &debugger);
+
   static lldb_private::ConstString GetPluginNameStatic();
 
   static const char *GetPluginDescriptionStatic();
@@ -109,6 +111,9 @@ public:
   size_t DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
                       lldb_private::Status &error) override;
 
+  bool GetSharedMemoryData(lldb::addr_t addr, size_t size,
+                           lldb_private::DataExtractor &data) override;
+
   lldb_private::Status
   GetMemoryRegionInfo(lldb::addr_t load_addr,
                       lldb_private::MemoryRegionInfo &region_info) override;
@@ -52,7 +52,10 @@ ThreadElfCore::ThreadElfCore(Process &process, const ThreadData &td)
 ThreadElfCore::~ThreadElfCore() { DestroyThread(); }
 
 void ThreadElfCore::RefreshStateAfterStop() {
-  GetRegisterContext()->InvalidateIfNeeded(false);
+  // The registers in a core never change, so don't decode the registers of
+  // every thread when the core is loaded.  They are decoded when asked for.
+  if (m_reg_context_sp)
+    m_reg_context_sp->InvalidateIfNeeded(false);
 }
 
 RegisterContextSP ThreadElfCore::GetRegisterContext() {
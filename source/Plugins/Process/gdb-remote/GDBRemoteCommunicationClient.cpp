@@ -14,6 +14,7 @@
 #include <sys/stat.h>
 
 // C++ Includes
+#include <algorithm>
 #include <numeric>
 #include <sstream>
 
@@ -88,6 +89,8 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_conditional_breakpoints(eLazyBoolCalculate),
+      m_supports_tracepoints(eLazyBoolCalculate),
       m_supports_error_string_reply(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
@@ -97,6 +100,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_QEnvironmentHexEncoded(true), m_supports_qSymbol(true),
       m_qSymbol_requests_done(false), m_supports_qModuleInfo(true),
       m_supports_jThreadsInfo(true), m_supports_jModulesInfo(true),
+      m_supports_jMemoryRegions(true),
       m_curr_pid(LLDB_INVALID_PROCESS_ID), m_curr_tid(LLDB_INVALID_THREAD_ID),
       m_curr_tid_run(LLDB_INVALID_THREAD_ID),
       m_num_supported_hardware_watchpoints(0), m_host_arch(), m_process_arch(),
@@ -159,6 +163,25 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported() {
+  if (m_supports_conditional_breakpoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_conditional_breakpoints == eLazyBoolYes;
+}
+
+bool GDBRemoteCommunicationClient::GetTracepointsSupported() {
+  if (m_supports_tracepoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_tracepoints == eLazyBoolYes;
+}
+
+void GDBRemoteCommunicationClient::ResetProcessDependentFeatures() {
+  m_supports_conditional_breakpoints = eLazyBoolCalculate;
+  m_supports_tracepoints = eLazyBoolCalculate;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -334,12 +357,14 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supported_async_json_packets_is_valid = false;
     m_supported_async_json_packets_sp.reset();
     m_supports_jModulesInfo = true;
+    m_supports_jMemoryRegions = true;
   }
 
   // These flags should be reset when we first connect to a GDB server and when
   // our inferior process execs
   m_qProcessInfo_is_valid = eLazyBoolCalculate;
   m_process_arch.Clear();
+  ResetProcessDependentFeatures();
 }
 
 void GDBRemoteCommunicationClient::GetRemoteQSupported() {
@@ -441,6 +466,16 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "ConditionalBreakpoints+"))
+      m_supports_conditional_breakpoints = eLazyBoolYes;
+    else
+      m_supports_conditional_breakpoints = eLazyBoolNo;
+
+    if (::strstr(response_cstr, "Tracepoints+"))
+      m_supports_tracepoints = eLazyBoolYes;
+    else
+      m_supports_tracepoints = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -1503,6 +1538,10 @@ Status GDBRemoteCommunicationClient::GetMemoryRegionInfo(
           std::string name;
           name_extractor.GetHexByteString(name);
           region_info.SetName(name.c_str());
+        } else if (name.equals("offset")) {
+          lldb::offset_t file_offset;
+          if (!value.getAsInteger(16, file_offset))
+            region_info.SetFileOffset(file_offset);
         } else if (name.equals("error")) {
           StringExtractorGDBRemote error_extractor(value);
           std::string error_string;
@@ -1560,6 +1599,77 @@ Status GDBRemoteCommunicationClient::GetMemoryRegionInfo(
   return error;
 }
 
+Status GDBRemoteCommunicationClient::GetMemoryRegions(
+    std::vector<MemoryRegionInfo> &regions) {
+  regions.clear();
+  if (!m_supports_jMemoryRegions)
+    return Status("jMemoryRegions is not supported");
+
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse("jMemoryRegions", response, false) !=
+      PacketResult::Success)
+    return Status("sending jMemoryRegions failed");
+  if (response.IsUnsupportedResponse()) {
+    m_supports_jMemoryRegions = false;
+    return Status("jMemoryRegions is not supported");
+  }
+  if (response.IsErrorResponse())
+    return response.GetStatus();
+
+  StructuredData::ObjectSP response_object_sp =
+      StructuredData::ParseJSON(response.GetStringRef());
+  StructuredData::Array *response_array =
+      response_object_sp ? response_object_sp->GetAsArray() : nullptr;
+  if (!response_array)
+    return Status("invalid jMemoryRegions response");
+
+  Status error;
+  response_array->ForEach([&](StructuredData::Object *object) -> bool {
+    StructuredData::Dictionary *dict = object->GetAsDictionary();
+    uint64_t start, size;
+    if (!dict || !dict->GetValueForKeyAsInteger("start", start) ||
+        !dict->GetValueForKeyAsInteger("size", size) || size == 0) {
+      error.SetErrorString("invalid region in jMemoryRegions response");
+      return false;
+    }
+    llvm::StringRef permissions;
+    dict->GetValueForKeyAsString("permissions", permissions);
+
+    MemoryRegionInfo region_info;
+    region_info.GetRange().SetRangeBase(start);
+    region_info.GetRange().SetByteSize(size);
+    auto has_permission = [&](char c) {
+      return permissions.find(c) != llvm::StringRef::npos
+                 ? MemoryRegionInfo::eYes
+                 : MemoryRegionInfo::eNo;
+    };
+    region_info.SetReadable(has_permission('r'));
+    region_info.SetWritable(has_permission('w'));
+    region_info.SetExecutable(has_permission('x'));
+    region_info.SetMapped(MemoryRegionInfo::eYes);
+    llvm::StringRef name;
+    if (dict->GetValueForKeyAsString("name", name))
+      region_info.SetName(name.str().c_str());
+    uint64_t file_offset;
+    if (dict->GetValueForKeyAsInteger("offset", file_offset))
+      region_info.SetFileOffset(file_offset);
+    regions.push_back(region_info);
+    return true;
+  });
+  if (error.Fail()) {
+    regions.clear();
+    return error;
+  }
+
+  // The regions should come sorted, but lookups depend on it.
+  std::sort(regions.begin(), regions.end(),
+            [](const MemoryRegionInfo &lhs, const MemoryRegionInfo &rhs) {
+              return lhs.GetRange().GetRangeBase() <
+                     rhs.GetRange().GetRangeBase();
+            });
+  return error;
+}
+
 Status GDBRemoteCommunicationClient::GetQXferMemoryMapRegionInfo(
     lldb::addr_t addr, MemoryRegionInfo &region) {
   Status error = LoadQXferMemoryMap();
@@ -2655,29 +2765,35 @@ bool GDBRemoteCommunicationClient::GetThreadStopInfo(
 }
 
 uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
-    GDBStoppointType type, bool insert, addr_t addr, uint32_t length) {
+    GDBStoppointType type, bool insert, addr_t addr, uint32_t length,
+    llvm::ArrayRef<AgentExpression> conditions) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
   if (log)
-    log->Printf("GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64,
-                __FUNCTION__, insert ? "add" : "remove", addr);
+    log->Printf("GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64
+                " with %zu conditions",
+                __FUNCTION__, insert ? "add" : "remove", addr,
+                conditions.size());
 
   // Check if the stub is known not to support this breakpoint type
   if (!SupportsGDBStoppointPacket(type))
     return UINT8_MAX;
   // Construct the breakpoint packet
-  char packet[64];
-  const int packet_len =
-      ::snprintf(packet, sizeof(packet), "%c%i,%" PRIx64 ",%x",
-                 insert ? 'Z' : 'z', type, addr, length);
-  // Check we haven't overwritten the end of the packet buffer
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
+  StreamString packet;
+  packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr, length);
+  // Append the condition list: ";X<len>,<hex bytecode>" per condition.
+  if (insert) {
+    for (const AgentExpression &condition : conditions) {
+      llvm::ArrayRef<uint8_t> bytes = condition.GetBytes();
+      packet.Printf(";X%zx,", bytes.size());
+      packet.PutBytesAsRawHex8(bytes.data(), bytes.size());
+    }
+  }
   StringExtractorGDBRemote response;
   // Make sure the response is either "OK", "EXX" where XX are two hex digits,
   // or "" (unsupported)
   response.SetResponseValidatorToOKErrorNotSupported();
   // Try to send the breakpoint packet, and check that it was correctly sent
-  if (SendPacketAndWaitForResponse(packet, response, true) ==
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) ==
       PacketResult::Success) {
     // Receive and OK packet when the breakpoint successfully placed
     if (response.IsOKResponse())
@@ -2715,6 +2831,103 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   return UINT8_MAX;
 }
 
+static void PutAgentExpression(StreamString &packet,
+                               const AgentExpression &expr) {
+  llvm::ArrayRef<uint8_t> bytes = expr.GetBytes();
+  packet.Printf("%zx,", bytes.size());
+  packet.PutBytesAsRawHex8(bytes.data(), bytes.size());
+}
+
+uint8_t GDBRemoteCommunicationClient::SendTracepointPacket(
+    addr_t addr, llvm::ArrayRef<TracepointSpec> specs) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  if (log)
+    log->Printf("GDBRemoteCommunicationClient::%s() %zu tracepoints at addr "
+                "= 0x%" PRIx64,
+                __FUNCTION__, specs.size(), addr);
+
+  if (!GetTracepointsSupported())
+    return UINT8_MAX;
+
+  // "QTracepoint:<addr>", then ";T<id>" per tracepoint, followed by its
+  // optional condition ";C<len>,<hex>" and its actions.
+  StreamString packet;
+  packet.Printf("QTracepoint:%" PRIx64, addr);
+  for (const TracepointSpec &spec : specs) {
+    packet.Printf(";T%" PRIx64, spec.id);
+    if (!spec.condition.IsEmpty()) {
+      packet.PutCString(";C");
+      PutAgentExpression(packet, spec.condition);
+    }
+    for (const TracepointAction &action : spec.actions) {
+      packet.PutChar(';');
+      packet.PutChar(action.kind);
+      if (action.kind == TracepointAction::eKindRegister) {
+        packet.Printf("%x", action.reg_num);
+        continue;
+      }
+      packet.Printf("%x,", action.size);
+      PutAgentExpression(packet, action.expr);
+    }
+  }
+
+  StringExtractorGDBRemote response;
+  response.SetResponseValidatorToOKErrorNotSupported();
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) !=
+      PacketResult::Success)
+    return UINT8_MAX;
+  if (response.IsOKResponse())
+    return 0;
+  if (response.IsErrorResponse())
+    return response.GetError();
+  if (response.IsUnsupportedResponse())
+    m_supports_tracepoints = eLazyBoolNo;
+  return UINT8_MAX;
+}
+
+Status GDBRemoteCommunicationClient::SendTracepointBufferPacket(
+    size_t max_bytes, std::vector<uint8_t> &data, uint64_t &num_dropped) {
+  Status error;
+  if (!GetTracepointsSupported()) {
+    error.SetErrorString("the stub doesn't support tracepoints");
+    return error;
+  }
+
+  StreamString packet;
+  packet.Printf("qTracepointBuffer:%zx", max_bytes);
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) !=
+      PacketResult::Success) {
+    error.SetErrorString("failed to send qTracepointBuffer packet");
+    return error;
+  }
+  if (!response.IsNormalResponse()) {
+    error = response.GetStatus();
+    if (error.Success())
+      error.SetErrorString("unexpected qTracepointBuffer response");
+    return error;
+  }
+
+  // "dropped:<count>;data:<hex records>;"
+  llvm::StringRef name;
+  llvm::StringRef value;
+  while (response.GetNameColonValue(name, value)) {
+    if (name == "dropped") {
+      uint64_t dropped = 0;
+      if (!value.getAsInteger(16, dropped))
+        num_dropped += dropped;
+    } else if (name == "data") {
+      StringExtractor hex(value);
+      const size_t offset = data.size();
+      data.resize(offset + value.size() / 2);
+      const size_t num_bytes = hex.GetHexBytesAvail(
+          llvm::MutableArrayRef<uint8_t>(data).drop_front(offset));
+      data.resize(offset + num_bytes);
+    }
+  }
+  return error;
+}
+
 size_t GDBRemoteCommunicationClient::GetCurrentThreadIDs(
     std::vector<lldb::tid_t> &thread_ids, bool &sequence_mutex_unavailable) {
   thread_ids.clear();
@@ -21,9 +21,11 @@
 #include <vector>
 
 #include "lldb/Target/Process.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/StreamGDBRemote.h"
 #include "lldb/Utility/StructuredData.h"
+#include "lldb/Utility/Tracepoint.h"
 
 #include "llvm/ADT/Optional.h"
 
@@ -234,6 +236,10 @@ public:
 
   Status GetMemoryRegionInfo(lldb::addr_t addr, MemoryRegionInfo &range_info);
 
+  // Get every mapped region with one jMemoryRegions packet.  Fails if the
+  // stub doesn't support it.
+  Status GetMemoryRegions(std::vector<MemoryRegionInfo> &regions);
+
   Status GetWatchpointSupportInfo(uint32_t &num);
 
   Status GetWatchpointSupportInfo(uint32_t &num, bool &after,
@@ -318,7 +324,22 @@ public:
       GDBStoppointType type, // Type of breakpoint or watchpoint
       bool insert,           // Insert or remove?
       lldb::addr_t addr,     // Address of breakpoint or watchpoint
-      uint32_t length);      // Byte Size of breakpoint or watchpoint
+      uint32_t length,       // Byte Size of breakpoint or watchpoint
+      llvm::ArrayRef<AgentExpression> conditions =
+          {}); // Conditions for the stub to evaluate, see
+               // GetConditionalBreakpointsSupported()
+
+  // Replace the tracepoints the stub collects at the software breakpoint
+  // at \a addr; an empty list removes them.  Returns 0 on success, see
+  // SendGDBStoppointTypePacket().
+  uint8_t SendTracepointPacket(lldb::addr_t addr,
+                               llvm::ArrayRef<TracepointSpec> specs);
+
+  // Take up to \a max_bytes of encoded tracepoint records (see
+  // TracepointBuffer) out of the stub's buffer and append them to \a data.
+  Status SendTracepointBufferPacket(size_t max_bytes,
+                                    std::vector<uint8_t> &data,
+                                    uint64_t &num_dropped);
 
   bool SetNonStopMode(const bool enable);
 
@@ -351,6 +372,18 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  // True if the stub accepts agent expression conditions with Z0 packets
+  // and only reports a hit when one of them is true.
+  bool GetConditionalBreakpointsSupported();
+
+  // True if the stub can collect tracepoints at software breakpoints into
+  // a buffer, see SendTracepointPacket().
+  bool GetTracepointsSupported();
+
+  // The two above depend on the debugged process, so the stub doesn't
+  // advertise them before there is one. Ask again once there is.
+  void ResetProcessDependentFeatures();
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -552,6 +585,8 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_conditional_breakpoints;
+  LazyBool m_supports_tracepoints;
   LazyBool m_supports_error_string_reply;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
@@ -561,7 +596,7 @@ protected:
       m_supports_QEnvironment : 1, m_supports_QEnvironmentHexEncoded : 1,
       m_supports_qSymbol : 1, m_qSymbol_requests_done : 1,
       m_supports_qModuleInfo : 1, m_supports_jThreadsInfo : 1,
-      m_supports_jModulesInfo : 1;
+      m_supports_jModulesInfo : 1, m_supports_jMemoryRegions : 1;
 
   lldb::pid_t m_curr_pid;
   lldb::tid_t m_curr_tid; // Current gdb remote protocol thread index for all
@@ -837,6 +837,7 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
   response.PutCString(";QPassSignals+");
   response.PutCString(";qXfer:auxv:read+");
 #endif
+  AppendSupportedFeatures(response);
 
   return SendPacketNoLock(response.GetString());
 }
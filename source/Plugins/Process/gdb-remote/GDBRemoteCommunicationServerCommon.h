@@ -25,6 +25,9 @@
 class StringExtractorGDBRemote;
 
 namespace lldb_private {
+
+class StreamGDBRemote;
+
 namespace process_gdb_remote {
 
 class ProcessGDBRemote;
@@ -96,6 +99,9 @@ protected:
 
   PacketResult Handle_qSupported(StringExtractorGDBRemote &packet);
 
+  // Lets subclasses add the qSupported features only they know about.
+  virtual void AppendSupportedFeatures(StreamGDBRemote &response) {}
+
   PacketResult Handle_QThreadSuffixSupported(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_QListThreadsInStopReply(StringExtractorGDBRemote &packet);
@@ -35,6 +35,7 @@
 #include "lldb/Host/common/NativeThreadProtocol.h"
 #include "lldb/Target/FileAction.h"
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/Args.h"
 #include "lldb/Utility/DataBuffer.h"
 #include "lldb/Utility/Endian.h"
@@ -122,6 +123,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qMemoryRegionInfoSupported,
       &GDBRemoteCommunicationServerLLGS::Handle_qMemoryRegionInfoSupported);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_jMemoryRegions,
+      &GDBRemoteCommunicationServerLLGS::Handle_jMemoryRegions);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qProcessInfo,
       &GDBRemoteCommunicationServerLLGS::Handle_qProcessInfo);
@@ -179,6 +183,12 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_QPassSignals,
       &GDBRemoteCommunicationServerLLGS::Handle_QPassSignals);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_QTracepoint,
+      &GDBRemoteCommunicationServerLLGS::Handle_QTracepoint);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_qTracepointBuffer,
+      &GDBRemoteCommunicationServerLLGS::Handle_qTracepointBuffer);
 
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_jTraceStart,
@@ -2458,12 +2468,73 @@ GDBRemoteCommunicationServerLLGS::Handle_qMemoryRegionInfo(
       response.PutCString("name:");
       response.PutCStringAsRawHex8(name.AsCString());
       response.PutChar(';');
+      if (region_info.GetFileOffset() != LLDB_INVALID_OFFSET)
+        response.Printf("offset:%" PRIx64 ";", region_info.GetFileOffset());
     }
   }
 
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_jMemoryRegions(
+    StringExtractorGDBRemote &) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  // Ensure we have a process.
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOG(log, "failed, no process available");
+    return SendErrorResponse(0x15);
+  }
+
+  std::vector<MemoryRegionInfo> regions;
+  const Status error = m_debugged_process_up->GetMemoryRegions(regions);
+  if (error.Fail()) {
+    LLDB_LOG(log, "failed to get the memory regions of pid {0}: {1}",
+             m_debugged_process_up->GetID(), error);
+    return SendErrorResponse(0x16);
+  }
+
+  JSONArray regions_array;
+  for (const MemoryRegionInfo &region_info : regions) {
+    JSONObject::SP region_sp = std::make_shared<JSONObject>();
+    region_sp->SetObject(
+        "start",
+        std::make_shared<JSONNumber>(region_info.GetRange().GetRangeBase()));
+    region_sp->SetObject(
+        "size",
+        std::make_shared<JSONNumber>(region_info.GetRange().GetByteSize()));
+
+    std::string permissions;
+    if (region_info.GetReadable())
+      permissions += 'r';
+    if (region_info.GetWritable())
+      permissions += 'w';
+    if (region_info.GetExecutable())
+      permissions += 'x';
+    region_sp->SetObject("permissions",
+                         std::make_shared<JSONString>(permissions));
+
+    if (ConstString name = region_info.GetName()) {
+      region_sp->SetObject("name",
+                           std::make_shared<JSONString>(name.GetCString()));
+      if (region_info.GetFileOffset() != LLDB_INVALID_OFFSET)
+        region_sp->SetObject("offset", std::make_shared<JSONNumber>(
+                                           region_info.GetFileOffset()));
+    }
+    regions_array.AppendObject(region_sp);
+  }
+  LLDB_LOG(log, "sending {0} memory regions of pid {1}", regions.size(),
+           m_debugged_process_up->GetID());
+
+  StreamString response;
+  regions_array.Write(response);
+  StreamGDBRemote escaped_response;
+  escaped_response.PutEscapedBytes(response.GetData(), response.GetSize());
+  return SendPacketNoLock(escaped_response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
   // Ensure we have a process.
@@ -2535,10 +2606,36 @@ GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
     return SendIllFormedResponse(
         packet, "Malformed Z packet, failed to parse size argument");
 
+  // Parse out the optional condition list: ";X<len>,<bytecode>" for each
+  // agent expression.  Anything after it (e.g. ";cmds:") is ignored.
+  std::vector<AgentExpression> conditions;
+  while (packet.GetBytesLeft() > 1 && packet.PeekChar() == ';') {
+    packet.GetChar();
+    if (packet.PeekChar() != 'X')
+      break;
+    packet.GetChar();
+    const uint32_t expr_len = packet.GetHexMaxU32(false, 0);
+    if (expr_len == 0 || packet.GetChar() != ',' ||
+        packet.GetBytesLeft() < expr_len * 2)
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition");
+    std::vector<uint8_t> bytes(expr_len);
+    if (packet.GetHexBytes(bytes, 0) != expr_len)
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, failed to parse condition bytecode");
+    conditions.emplace_back(bytes);
+  }
+
   if (want_breakpoint) {
     // Try to set the breakpoint.
-    const Status error =
+    Status error =
         m_debugged_process_up->SetBreakpoint(addr, size, want_hardware);
+    // Conditions can only be evaluated for software breakpoints; a hardware
+    // breakpoint always reports its hits and the client checks them.
+    if (error.Success() && !want_hardware &&
+        m_debugged_process_up->SupportsBreakpointConditions())
+      error = m_debugged_process_up->SetBreakpointConditions(
+          addr, std::move(conditions));
     if (error.Success())
       return SendOKResponse();
     Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
@@ -2696,6 +2793,19 @@ GDBRemoteCommunicationServerLLGS::Handle_s(StringExtractorGDBRemote &packet) {
   return PacketResult::Success;
 }
 
+void GDBRemoteCommunicationServerLLGS::AppendSupportedFeatures(
+    StreamGDBRemote &response) {
+  // Whether conditions can be evaluated in the stub depends on the debugged
+  // process, so they are only advertised once there is one.  The client asks
+  // again after launching or attaching.  Tracepoints use the same stepping
+  // over the breakpoint to carry on after collecting.
+  if (m_debugged_process_up &&
+      m_debugged_process_up->SupportsBreakpointConditions()) {
+    response.PutCString(";ConditionalBreakpoints+");
+    response.PutCString(";Tracepoints+");
+  }
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_qXfer_auxv_read(
     StringExtractorGDBRemote &packet) {
@@ -3110,6 +3220,125 @@ GDBRemoteCommunicationServerLLGS::Handle_QPassSignals(
   return SendOKResponse();
 }
 
+// Parse "<len>,<bytecode>" into \a expr.
+static bool GetAgentExpression(StringExtractorGDBRemote &packet,
+                               AgentExpression &expr) {
+  const uint32_t expr_len = packet.GetHexMaxU32(false, 0);
+  if (expr_len == 0 || packet.GetChar() != ',' ||
+      packet.GetBytesLeft() < expr_len * 2)
+    return false;
+  std::vector<uint8_t> bytes(expr_len);
+  if (packet.GetHexBytes(bytes, 0) != expr_len)
+    return false;
+  expr = AgentExpression(bytes);
+  return true;
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_QTracepoint(
+    StringExtractorGDBRemote &packet) {
+  // Fail if we don't have a current process.
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID))
+    return SendErrorResponse(0x15);
+
+  packet.SetFilePos(strlen("QTracepoint:"));
+  if (packet.GetBytesLeft() < 1)
+    return SendIllFormedResponse(
+        packet, "Too short QTracepoint packet, missing address");
+  const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+  if (addr == LLDB_INVALID_ADDRESS)
+    return SendIllFormedResponse(
+        packet, "Malformed QTracepoint packet, bad address");
+
+  // ";T<id>" starts each tracepoint, followed by its optional condition
+  // ";C<len>,<bytecode>" and its actions ";R<regnum>",
+  // ";X<size>,<len>,<bytecode>" and ";M<size>,<len>,<bytecode>".
+  std::vector<TracepointSpec> specs;
+  while (packet.GetBytesLeft() > 0) {
+    if (packet.GetChar() != ';')
+      return SendIllFormedResponse(
+          packet, "Malformed QTracepoint packet, expecting semicolon");
+    const char item = packet.GetChar();
+    if (item == 'T') {
+      specs.emplace_back();
+      specs.back().id = packet.GetHexMaxU64(false, 0);
+      continue;
+    }
+    if (specs.empty())
+      return SendIllFormedResponse(
+          packet, "Malformed QTracepoint packet, item before tracepoint");
+    TracepointSpec &spec = specs.back();
+    if (item == 'C') {
+      if (!GetAgentExpression(packet, spec.condition))
+        return SendIllFormedResponse(
+            packet, "Malformed QTracepoint packet, failed to parse condition");
+      continue;
+    }
+
+    TracepointAction action;
+    switch (item) {
+    case TracepointAction::eKindRegister:
+      action.kind = TracepointAction::eKindRegister;
+      action.reg_num = packet.GetHexMaxU32(false, UINT32_MAX);
+      if (action.reg_num == UINT32_MAX)
+        return SendIllFormedResponse(
+            packet, "Malformed QTracepoint packet, bad register number");
+      break;
+
+    case TracepointAction::eKindValue:
+    case TracepointAction::eKindMemory:
+      action.kind = static_cast<TracepointAction::Kind>(item);
+      action.size = packet.GetHexMaxU32(false, 0);
+      if (action.size == 0 || packet.GetChar() != ',' ||
+          !GetAgentExpression(packet, action.expr))
+        return SendIllFormedResponse(
+            packet, "Malformed QTracepoint packet, failed to parse action");
+      break;
+
+    default:
+      return SendIllFormedResponse(
+          packet, "Malformed QTracepoint packet, unknown item");
+    }
+    spec.actions.push_back(std::move(action));
+  }
+
+  Status error = m_debugged_process_up->SetBreakpointTracepoints(
+      addr, std::move(specs));
+  if (error.Fail()) {
+    Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+    LLDB_LOG(log, "pid {0} failed to set tracepoints: {1}",
+             m_debugged_process_up->GetID(), error);
+    return SendErrorResponse(0x09);
+  }
+  return SendOKResponse();
+}
+
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qTracepointBuffer(
+    StringExtractorGDBRemote &packet) {
+  // Fail if we don't have a current process.
+  if (!m_debugged_process_up ||
+      (m_debugged_process_up->GetID() == LLDB_INVALID_PROCESS_ID))
+    return SendErrorResponse(0x15);
+
+  packet.SetFilePos(strlen("qTracepointBuffer:"));
+  const uint64_t max_bytes = packet.GetHexMaxU64(false, 0);
+  if (max_bytes == 0)
+    return SendIllFormedResponse(
+        packet, "Malformed qTracepointBuffer packet, bad size");
+
+  TracepointBuffer &buffer = m_debugged_process_up->GetTracepointBuffer();
+  std::vector<uint8_t> data;
+  buffer.Drain(max_bytes, data);
+
+  StreamGDBRemote response;
+  response.Printf("dropped:%" PRIx64 ";data:", buffer.TakeNumDropped());
+  response.PutBytesAsRawHex8(data.data(), data.size());
+  response.PutChar(';');
+  return SendPacketNoLock(response.GetString());
+}
+
 void GDBRemoteCommunicationServerLLGS::MaybeCloseInferiorTerminalConnection() {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
 
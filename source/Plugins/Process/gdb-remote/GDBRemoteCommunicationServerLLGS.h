@@ -157,6 +157,8 @@ protected:
 
   PacketResult Handle_qMemoryRegionInfo(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_jMemoryRegions(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_Z(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_z(StringExtractorGDBRemote &packet);
@@ -191,6 +193,10 @@ protected:
 
   PacketResult Handle_QPassSignals(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_QTracepoint(StringExtractorGDBRemote &packet);
+
+  PacketResult Handle_qTracepointBuffer(StringExtractorGDBRemote &packet);
+
   void SetCurrentThreadID(lldb::tid_t tid);
 
   lldb::tid_t GetCurrentThreadID() const;
@@ -204,6 +210,8 @@ protected:
   FileSpec FindModuleFile(const std::string &module_path,
                           const ArchSpec &arch) override;
 
+  void AppendSupportedFeatures(StreamGDBRemote &response) override;
+
 private:
   void HandleInferiorState_Exited(NativeProcessProtocol *process);
 
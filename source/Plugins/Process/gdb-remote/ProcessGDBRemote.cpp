@@ -258,8 +258,9 @@ ProcessGDBRemote::ProcessGDBRemote(lldb::TargetSP target_sp,
       m_addr_to_mmap_size(), m_thread_create_bp_sp(),
       m_waiting_for_attach(false), m_destroy_tried_resuming(false),
       m_command_sp(), m_breakpoint_pc_offset(0),
-      m_initial_tid(LLDB_INVALID_THREAD_ID), m_allow_flash_writes(false),
-      m_erased_flash_ranges() {
+      m_initial_tid(LLDB_INVALID_THREAD_ID), m_memory_regions_stop_id(0),
+      m_memory_regions_valid(false), m_memory_regions_failed(false),
+      m_allow_flash_writes(false), m_erased_flash_ranges() {
   m_async_broadcaster.SetEventName(eBroadcastBitAsyncThreadShouldExit,
                                    "async thread should exit");
   m_async_broadcaster.SetEventName(eBroadcastBitAsyncContinue,
@@ -1046,6 +1047,7 @@ void ProcessGDBRemote::DidLaunchOrAttach(ArchSpec &process_arch) {
     log->Printf("ProcessGDBRemote::%s()", __FUNCTION__);
   if (GetID() != LLDB_INVALID_PROCESS_ID) {
     BuildDynamicRegisterInfo(false);
+    m_gdb_comm.ResetProcessDependentFeatures();
 
     // See if the GDB server supports the qHostInfo information
 
@@ -2978,6 +2980,8 @@ lldb::addr_t ProcessGDBRemote::DoAllocateMemory(size_t size,
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_EXPRESSIONS));
   addr_t allocated_addr = LLDB_INVALID_ADDRESS;
 
+  ClearMemoryRegionCache();
+
   if (m_gdb_comm.SupportsAllocDeallocMemory() != eLazyBoolNo) {
     allocated_addr = m_gdb_comm.AllocateMemory(size, permissions);
     if (allocated_addr != LLDB_INVALID_ADDRESS ||
@@ -3017,11 +3021,68 @@ lldb::addr_t ProcessGDBRemote::DoAllocateMemory(size_t size,
   return allocated_addr;
 }
 
+bool ProcessGDBRemote::UpdateMemoryRegionCache() {
+  // Any resume bumps the stop ID, and with it anything the inferior mapped
+  // or unmapped while it ran.
+  const uint32_t stop_id = GetStopID();
+  if (m_memory_regions_valid && m_memory_regions_stop_id == stop_id)
+    return !m_memory_regions_failed;
+
+  // An error reply is remembered for the stop like the regions are, so the
+  // lookups falling back to "qMemoryRegionInfo" don't each ask again first.
+  m_memory_regions_failed =
+      !m_gdb_comm.GetMemoryRegions(m_memory_regions).Success();
+  m_memory_regions_stop_id = stop_id;
+  m_memory_regions_valid = true;
+  return !m_memory_regions_failed;
+}
+
+void ProcessGDBRemote::ClearMemoryRegionCache() {
+  m_memory_regions_valid = false;
+  m_memory_regions.clear();
+}
+
 Status ProcessGDBRemote::GetMemoryRegionInfo(addr_t load_addr,
                                              MemoryRegionInfo &region_info) {
+  if (!UpdateMemoryRegionCache()) {
+    Status error(m_gdb_comm.GetMemoryRegionInfo(load_addr, region_info));
+    return error;
+  }
 
-  Status error(m_gdb_comm.GetMemoryRegionInfo(load_addr, region_info));
-  return error;
+  auto pos = std::upper_bound(
+      m_memory_regions.begin(), m_memory_regions.end(), load_addr,
+      [](addr_t addr, const MemoryRegionInfo &region) {
+        return addr < region.GetRange().GetRangeBase();
+      });
+  if (pos != m_memory_regions.begin() &&
+      std::prev(pos)->GetRange().Contains(load_addr)) {
+    region_info = *std::prev(pos);
+    return Status();
+  }
+
+  // Describe the unmapped gap up to the next region, like qMemoryRegionInfo.
+  region_info.Clear();
+  region_info.GetRange().SetRangeBase(load_addr);
+  if (pos != m_memory_regions.end())
+    region_info.GetRange().SetRangeEnd(pos->GetRange().GetRangeBase());
+  else
+    region_info.GetRange().SetRangeEnd(LLDB_INVALID_ADDRESS);
+  region_info.SetReadable(MemoryRegionInfo::eNo);
+  region_info.SetWritable(MemoryRegionInfo::eNo);
+  region_info.SetExecutable(MemoryRegionInfo::eNo);
+  region_info.SetMapped(MemoryRegionInfo::eNo);
+  return Status();
+}
+
+Status ProcessGDBRemote::GetMemoryRegions(
+    std::vector<lldb::MemoryRegionInfoSP> &region_list) {
+  if (!UpdateMemoryRegionCache())
+    return Process::GetMemoryRegions(region_list);
+
+  region_list.clear();
+  for (const MemoryRegionInfo &region : m_memory_regions)
+    region_list.push_back(std::make_shared<MemoryRegionInfo>(region));
+  return Status();
 }
 
 Status ProcessGDBRemote::GetWatchpointSupportInfo(uint32_t &num) {
@@ -3038,6 +3099,7 @@ Status ProcessGDBRemote::GetWatchpointSupportInfo(uint32_t &num, bool &after) {
 
 Status ProcessGDBRemote::DoDeallocateMemory(lldb::addr_t addr) {
   Status error;
+  ClearMemoryRegionCache();
   LazyBool supported = m_gdb_comm.SupportsAllocDeallocMemory();
 
   switch (supported) {
@@ -3085,6 +3147,145 @@ size_t ProcessGDBRemote::PutSTDIN(const char *src, size_t src_len,
   return 0;
 }
 
+bool ProcessGDBRemote::GetBreakpointSiteConditions(
+    BreakpointSite *bp_site, std::vector<AgentExpression> &conditions) {
+  conditions.clear();
+  if (!m_gdb_comm.GetConditionalBreakpointsSupported())
+    return false;
+  ThreadSP thread_sp = m_thread_list.GetThreadAtIndex(0, false);
+  if (!thread_sp)
+    return false;
+  return bp_site->GetAgentConditions(*thread_sp, eRegisterKindProcessPlugin,
+                                     conditions);
+}
+
+bool ProcessGDBRemote::UpdateBreakpointSiteTracepoints(
+    BreakpointSite *bp_site) {
+  const bool had_tracepoints = bp_site->GetStubCollectsTracepoints();
+  bp_site->SetStubCollectsTracepoints(false);
+  // The stub collects at the hit and then uses the conditions to decide
+  // not to stop, so it must be able to do both.
+  if (!m_gdb_comm.GetTracepointsSupported() ||
+      !m_gdb_comm.GetConditionalBreakpointsSupported())
+    return false;
+
+  const addr_t addr = bp_site->GetLoadAddress();
+  std::vector<TracepointSpec> specs;
+  ThreadSP thread_sp = m_thread_list.GetThreadAtIndex(0, false);
+  if (!thread_sp ||
+      !bp_site->GetTracepoints(*thread_sp, eRegisterKindProcessPlugin, specs))
+    specs.clear();
+  if (specs.empty()) {
+    // Make sure a stub that collected here before stops doing so.
+    if (had_tracepoints)
+      m_gdb_comm.SendTracepointPacket(addr, specs);
+    return false;
+  }
+
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+  const bool success = m_gdb_comm.SendTracepointPacket(addr, specs) == 0;
+  if (log)
+    log->Printf("ProcessGDBRemote::UpdateBreakpointSiteTracepoints (site_id = "
+                "%" PRIu64 ") address = 0x%" PRIx64 " with %zu tracepoints%s",
+                bp_site->GetID(), (uint64_t)addr, specs.size(),
+                success ? "" : " -- FAILED");
+  bp_site->SetStubCollectsTracepoints(success);
+  return success;
+}
+
+Status ProcessGDBRemote::DoGetTracepointRecords(
+    std::vector<TracepointRecord> &records, uint64_t &num_dropped) {
+  Status error;
+  if (!m_gdb_comm.GetTracepointsSupported())
+    return error;
+
+  // Each byte goes over the wire as two hex digits; leave room for the
+  // "dropped" field and the packet framing.
+  uint64_t max_packet_size = m_gdb_comm.GetRemoteMaxPacketSize();
+  if (max_packet_size == 0)
+    max_packet_size = 4096;
+  const size_t max_bytes =
+      std::max<uint64_t>(max_packet_size > 64 ? (max_packet_size - 64) / 2 : 0,
+                         256);
+  while (true) {
+    std::vector<uint8_t> data;
+    uint64_t packet_dropped = 0;
+    error = m_gdb_comm.SendTracepointBufferPacket(max_bytes, data,
+                                                  packet_dropped);
+    if (error.Fail())
+      break;
+    num_dropped += packet_dropped;
+    if (data.empty())
+      break;
+    if (!TracepointBuffer::Decode(data, records)) {
+      error.SetErrorString("malformed tracepoint records");
+      break;
+    }
+  }
+  return error;
+}
+
+Status
+ProcessGDBRemote::UpdateBreakpointSiteConditions(BreakpointSite *bp_site) {
+  Status error;
+  if (!bp_site->IsEnabled() ||
+      bp_site->GetType() != BreakpointSite::eExternal ||
+      !m_gdb_comm.GetConditionalBreakpointsSupported())
+    return error;
+
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+  const addr_t addr = bp_site->GetLoadAddress();
+  const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(bp_site);
+
+  // The stub's tracepoints decide which owners need a condition, so they
+  // go first.  Most owner changes leave the conditions as they were, and
+  // then there is nothing more to send.
+  UpdateBreakpointSiteTracepoints(bp_site);
+  std::vector<AgentExpression> conditions;
+  GetBreakpointSiteConditions(bp_site, conditions);
+  if (conditions == bp_site->GetStubConditions())
+    return error;
+
+  // Conditions can only be given when inserting, so re-insert the
+  // breakpoint.  lldb-server replaces the conditions of an existing
+  // breakpoint, but a stub that counts insertions needs the removal.
+  // Removing it also drops the stub's tracepoints, so they are handed over
+  // again in between.
+  if (log)
+    log->Printf("ProcessGDBRemote::UpdateBreakpointSiteConditions (site_id "
+                "= %" PRIu64 ") address = 0x%" PRIx64 " with %zu conditions",
+                bp_site->GetID(), (uint64_t)addr, conditions.size());
+  if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, false, addr,
+                                            bp_op_size) != 0) {
+    // The breakpoint is still there with its old conditions.
+    error.SetErrorStringWithFormat(
+        "failed to update the conditions of the breakpoint at 0x%" PRIx64,
+        addr);
+  } else {
+    if (bp_site->GetStubCollectsTracepoints())
+      UpdateBreakpointSiteTracepoints(bp_site);
+    if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                              bp_op_size, conditions) == 0) {
+      bp_site->SetStubConditions(std::move(conditions));
+      return error;
+    }
+    bp_site->SetEnabled(false);
+    bp_site->SetStubCollectsTracepoints(false);
+    bp_site->SetStubConditions({});
+    error.SetErrorStringWithFormat(
+        "failed to re-insert the breakpoint at 0x%" PRIx64
+        " with new conditions, it is disabled now",
+        addr);
+  }
+
+  // Nothing up the call chain reports this, and the breakpoint no longer
+  // stops where the user expects it to.
+  GetTarget().GetDebugger().GetErrorFile()->Printf(
+      "warning: breakpoint site %" PRIu64 ": %s\n", bp_site->GetID(),
+      error.AsCString());
+  return error;
+}
+
 Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   Status error;
   assert(bp_site != NULL);
@@ -3125,15 +3326,26 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   // breakpoints.
   if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) &&
       (!bp_site->HardwareRequired())) {
-    // Try to send off a software breakpoint packet ($Z0)
+    // Try to send off a software breakpoint packet ($Z0), along with the
+    // conditions of its owners if the stub can evaluate them itself.  The
+    // stub's tracepoints go first, since they decide whether tracepoint
+    // owners need to stop at all.
+    UpdateBreakpointSiteTracepoints(bp_site);
+    std::vector<AgentExpression> conditions;
+    GetBreakpointSiteConditions(bp_site, conditions);
     uint8_t error_no = m_gdb_comm.SendGDBStoppointTypePacket(
-        eBreakpointSoftware, true, addr, bp_op_size);
+        eBreakpointSoftware, true, addr, bp_op_size, conditions);
     if (error_no == 0) {
       // The breakpoint was placed successfully
       bp_site->SetEnabled(true);
       bp_site->SetType(BreakpointSite::eExternal);
+      bp_site->SetStubConditions(std::move(conditions));
       return error;
     }
+    if (bp_site->GetStubCollectsTracepoints()) {
+      m_gdb_comm.SendTracepointPacket(addr, {});
+      bp_site->SetStubCollectsTracepoints(false);
+    }
 
     // SendGDBStoppointTypePacket() will return an error if it was unable to
     // set this breakpoint. We need to differentiate between a error specific
@@ -3249,8 +3461,13 @@ Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
         error.SetErrorToGenericError();
     } break;
     }
-    if (error.Success())
+    if (error.Success()) {
+      // Removing the breakpoint removes the stub's tracepoints and
+      // conditions with it.
       bp_site->SetEnabled(false);
+      bp_site->SetStubCollectsTracepoints(false);
+      bp_site->SetStubConditions({});
+    }
   } else {
     if (log)
       log->Printf("ProcessGDBRemote::DisableBreakpointSite (site_id = %" PRIu64
@@ -3366,6 +3583,7 @@ Status ProcessGDBRemote::DisableWatchpoint(Watchpoint *wp, bool notify) {
 void ProcessGDBRemote::Clear() {
   m_thread_list_real.Clear();
   m_thread_list.Clear();
+  ClearMemoryRegionCache();
 }
 
 Status ProcessGDBRemote::DoSignal(int signo) {
@@ -25,6 +25,7 @@
 #include "lldb/Host/HostThread.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Thread.h"
+#include "lldb/Utility/AgentExpression.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/Status.h"
@@ -156,6 +157,9 @@ public:
   Status GetMemoryRegionInfo(lldb::addr_t load_addr,
                              MemoryRegionInfo &region_info) override;
 
+  Status
+  GetMemoryRegions(std::vector<lldb::MemoryRegionInfoSP> &region_list) override;
+
   Status DoDeallocateMemory(lldb::addr_t ptr) override;
 
   //------------------------------------------------------------------
@@ -170,6 +174,11 @@ public:
 
   Status DisableBreakpointSite(BreakpointSite *bp_site) override;
 
+  Status UpdateBreakpointSiteConditions(BreakpointSite *bp_site) override;
+
+  Status DoGetTracepointRecords(std::vector<TracepointRecord> &records,
+                                uint64_t &num_dropped) override;
+
   //----------------------------------------------------------------------
   // Process Watchpoints
   //----------------------------------------------------------------------
@@ -304,6 +313,14 @@ protected:
   int64_t m_breakpoint_pc_offset;
   lldb::tid_t m_initial_tid; // The initial thread ID, given by stub on attach
 
+  // The memory region map from "jMemoryRegions", valid while the process
+  // stays stopped at m_memory_regions_stop_id.  If the stub failed to send
+  // it, m_memory_regions_failed keeps it from being asked again until then.
+  std::vector<MemoryRegionInfo> m_memory_regions;
+  uint32_t m_memory_regions_stop_id;
+  bool m_memory_regions_valid;
+  bool m_memory_regions_failed;
+
   bool m_allow_flash_writes;
   using FlashRangeVector = lldb_private::RangeVector<lldb::addr_t, size_t>;
   using FlashRange = FlashRangeVector::Entry;
@@ -349,6 +366,23 @@ protected:
 
   void GetMaxMemorySize();
 
+  // Fetch the region map with "jMemoryRegions" unless the cached one is still
+  // current for this stop.  Returns false if the stub can't send it.
+  bool UpdateMemoryRegionCache();
+
+  void ClearMemoryRegionCache();
+
+  // Compile the conditions of the owners of \a bp_site for the stub to
+  // evaluate.  Returns false, with no conditions, if the stub can't evaluate
+  // them or any owner needs the host to decide whether to stop.
+  bool GetBreakpointSiteConditions(BreakpointSite *bp_site,
+                                   std::vector<AgentExpression> &conditions);
+
+  // Hand the tracepoints of the owners of \a bp_site to the stub, or take
+  // them away if they can't all be collected there.  Returns true, and
+  // marks the site, if the stub collects them.
+  bool UpdateBreakpointSiteTracepoints(BreakpointSite *bp_site);
+
   bool CalculateThreadStopInfo(ThreadGDBRemote *thread);
 
   size_t UpdateThreadPCsFromStopReplyThreadsValue(std::string &value);
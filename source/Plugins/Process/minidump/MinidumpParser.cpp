@@ -296,74 +296,69 @@ const MinidumpExceptionStream *MinidumpParser::GetExceptionStream() {
   return MinidumpExceptionStream::Parse(data);
 }
 
-llvm::Optional<minidump::Range>
-MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
-  llvm::ArrayRef<uint8_t> data = GetStream(MinidumpStreamType::MemoryList);
-  llvm::ArrayRef<uint8_t> data64 = GetStream(MinidumpStreamType::Memory64List);
-
-  if (data.empty() && data64.empty())
-    return llvm::None;
+void MinidumpParser::IndexMemory() {
+  m_memory_ranges.Clear();
+  m_memory_infos.Clear();
+  const uint64_t file_size = GetData().size();
 
+  llvm::ArrayRef<uint8_t> data = GetStream(MinidumpStreamType::MemoryList);
   if (!data.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor> memory_list =
         MinidumpMemoryDescriptor::ParseMemoryList(data);
-
-    if (memory_list.empty())
-      return llvm::None;
-
     for (const auto &memory_desc : memory_list) {
       const MinidumpLocationDescriptor &loc_desc = memory_desc.memory;
-      const lldb::addr_t range_start = memory_desc.start_of_memory_range;
-      const size_t range_size = loc_desc.data_size;
-
-      if (loc_desc.rva + loc_desc.data_size > GetData().size())
-        return llvm::None;
-
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(loc_desc.rva, range_size));
-      }
+      // Ranges whose contents are past the end of the file are left out.
+      if (uint64_t(loc_desc.rva) + loc_desc.data_size > file_size)
+        continue;
+      m_memory_ranges.Append(MemoryRangeIndex::Entry(
+          memory_desc.start_of_memory_range, loc_desc.data_size,
+          loc_desc.rva));
     }
   }
 
   // Some Minidumps have a Memory64ListStream that captures all the heap memory
-  // (full-memory Minidumps).  We can't exactly use the same loop as above,
-  // because the Minidump uses slightly different data structures to describe
-  // those
-
+  // (full-memory Minidumps).  Its ranges are stored one after the other
+  // starting at a base RVA, rather than each with its own location.
+  llvm::ArrayRef<uint8_t> data64 = GetStream(MinidumpStreamType::Memory64List);
   if (!data64.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor64> memory64_list;
     uint64_t base_rva;
     std::tie(memory64_list, base_rva) =
         MinidumpMemoryDescriptor64::ParseMemory64List(data64);
-
-    if (memory64_list.empty())
-      return llvm::None;
-
     for (const auto &memory_desc64 : memory64_list) {
-      const lldb::addr_t range_start = memory_desc64.start_of_memory_range;
-      const size_t range_size = memory_desc64.data_size;
-
-      if (base_rva + range_size > GetData().size())
-        return llvm::None;
-
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(base_rva, range_size));
-      }
+      const uint64_t range_size = memory_desc64.data_size;
+      if (base_rva + range_size > file_size)
+        break;
+      m_memory_ranges.Append(MemoryRangeIndex::Entry(
+          memory_desc64.start_of_memory_range, range_size, base_rva));
       base_rva += range_size;
     }
   }
+  m_memory_ranges.Sort();
+
+  llvm::ArrayRef<uint8_t> info_data =
+      GetStream(MinidumpStreamType::MemoryInfoList);
+  if (!info_data.empty()) {
+    for (const MinidumpMemoryInfo *entry :
+         MinidumpMemoryInfo::ParseMemoryInfoList(info_data))
+      m_memory_infos.Append(MemoryInfoIndex::Entry(
+          entry->base_address, entry->region_size, entry));
+  }
+  m_memory_infos.Sort();
+}
 
-  return llvm::None;
+llvm::Optional<minidump::Range>
+MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
+  const MemoryRangeIndex::Entry *entry =
+      m_memory_ranges.FindEntryThatContains(addr);
+  if (!entry)
+    return llvm::None;
+  return minidump::Range(entry->GetRangeBase(),
+                         GetData().slice(entry->data, entry->GetByteSize()));
 }
 
 llvm::ArrayRef<uint8_t> MinidumpParser::GetMemory(lldb::addr_t addr,
                                                   size_t size) {
-  // I don't have a sense of how frequently this is called or how many memory
-  // ranges a Minidump typically has, so I'm not sure if searching for the
-  // appropriate range linearly each time is stupid.  Perhaps we should build
-  // an index for faster lookups.
   llvm::Optional<minidump::Range> range = FindMemoryRange(addr);
   if (!range)
     return {};
@@ -384,60 +379,52 @@ llvm::ArrayRef<uint8_t> MinidumpParser::GetMemory(lldb::addr_t addr,
 llvm::Optional<MemoryRegionInfo>
 MinidumpParser::GetMemoryRegionInfo(lldb::addr_t load_addr) {
   MemoryRegionInfo info;
-  llvm::ArrayRef<uint8_t> data = GetStream(MinidumpStreamType::MemoryInfoList);
-  if (data.empty())
-    return llvm::None;
-
-  std::vector<const MinidumpMemoryInfo *> mem_info_list =
-      MinidumpMemoryInfo::ParseMemoryInfoList(data);
-  if (mem_info_list.empty())
+  if (m_memory_infos.IsEmpty())
     return llvm::None;
 
   const auto yes = MemoryRegionInfo::eYes;
   const auto no = MemoryRegionInfo::eNo;
 
-  const MinidumpMemoryInfo *next_entry = nullptr;
-  for (const auto &entry : mem_info_list) {
+  // In case there is no region containing load_addr this is the nearest
+  // region after load_addr, so we can return the distance to it.
+  const MemoryInfoIndex::Entry *index_entry =
+      m_memory_infos.FindEntryThatContainsOrFollows(load_addr);
+  if (index_entry && index_entry->Contains(load_addr)) {
+    const MinidumpMemoryInfo *entry = index_entry->data;
     const auto head = entry->base_address;
     const auto tail = head + entry->region_size;
 
-    if (head <= load_addr && load_addr < tail) {
-      info.GetRange().SetRangeBase(
-          (entry->state != uint32_t(MinidumpMemoryInfoState::MemFree))
-              ? head
-              : load_addr);
-      info.GetRange().SetRangeEnd(tail);
-
-      const uint32_t PageNoAccess =
-          static_cast<uint32_t>(MinidumpMemoryProtectionContants::PageNoAccess);
-      info.SetReadable((entry->protect & PageNoAccess) == 0 ? yes : no);
-
-      const uint32_t PageWritable =
-          static_cast<uint32_t>(MinidumpMemoryProtectionContants::PageWritable);
-      info.SetWritable((entry->protect & PageWritable) != 0 ? yes : no);
-
-      const uint32_t PageExecutable = static_cast<uint32_t>(
-          MinidumpMemoryProtectionContants::PageExecutable);
-      info.SetExecutable((entry->protect & PageExecutable) != 0 ? yes : no);
-
-      const uint32_t MemFree =
-          static_cast<uint32_t>(MinidumpMemoryInfoState::MemFree);
-      info.SetMapped((entry->state != MemFree) ? yes : no);
-
-      return info;
-    } else if (head > load_addr &&
-               (next_entry == nullptr || head < next_entry->base_address)) {
-      // In case there is no region containing load_addr keep track of the
-      // nearest region after load_addr so we can return the distance to it.
-      next_entry = entry;
-    }
+    info.GetRange().SetRangeBase(
+        (entry->state != uint32_t(MinidumpMemoryInfoState::MemFree))
+            ? head
+            : load_addr);
+    info.GetRange().SetRangeEnd(tail);
+
+    const uint32_t PageNoAccess =
+        static_cast<uint32_t>(MinidumpMemoryProtectionContants::PageNoAccess);
+    info.SetReadable((entry->protect & PageNoAccess) == 0 ? yes : no);
+
+    const uint32_t PageWritable =
+        static_cast<uint32_t>(MinidumpMemoryProtectionContants::PageWritable);
+    info.SetWritable((entry->protect & PageWritable) != 0 ? yes : no);
+
+    const uint32_t PageExecutable = static_cast<uint32_t>(
+        MinidumpMemoryProtectionContants::PageExecutable);
+    info.SetExecutable((entry->protect & PageExecutable) != 0 ? yes : no);
+
+    const uint32_t MemFree =
+        static_cast<uint32_t>(MinidumpMemoryInfoState::MemFree);
+    info.SetMapped((entry->state != MemFree) ? yes : no);
+
+    return info;
   }
 
   // No containing region found. Create an unmapped region that extends to the
   // next region or LLDB_INVALID_ADDRESS
   info.GetRange().SetRangeBase(load_addr);
-  info.GetRange().SetRangeEnd((next_entry != nullptr) ? next_entry->base_address
-                                                      : LLDB_INVALID_ADDRESS);
+  info.GetRange().SetRangeEnd((index_entry != nullptr)
+                                  ? index_entry->GetRangeBase()
+                                  : LLDB_INVALID_ADDRESS);
   info.SetReadable(no);
   info.SetWritable(no);
   info.SetExecutable(no);
@@ -552,5 +539,6 @@ Status MinidumpParser::Initialize() {
     return error;
   }
 
+  IndexMemory();
   return error;
 }
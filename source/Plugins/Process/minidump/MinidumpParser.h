@@ -14,6 +14,7 @@
 // Project includes
 #include "MinidumpTypes.h"
 
+#include "lldb/Core/RangeMap.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/DataBuffer.h"
 #include "lldb/Utility/Status.h"
@@ -95,9 +96,23 @@ public:
 private:
   MinidumpParser(const lldb::DataBufferSP &data_buf_sp);
 
+  // Index the MemoryList, Memory64List and MemoryInfoList streams, so memory
+  // reads don't have to scan them.  Full-memory minidumps have tens of
+  // thousands of ranges.
+  void IndexMemory();
+
 private:
+  // The file offset of each captured memory range, by virtual address.
+  typedef RangeDataVector<lldb::addr_t, lldb::addr_t, uint64_t>
+      MemoryRangeIndex;
+  typedef RangeDataVector<lldb::addr_t, lldb::addr_t,
+                          const MinidumpMemoryInfo *>
+      MemoryInfoIndex;
+
   lldb::DataBufferSP m_data_sp;
   llvm::DenseMap<uint32_t, MinidumpLocationDescriptor> m_directory_map;
+  MemoryRangeIndex m_memory_ranges;
+  MemoryInfoIndex m_memory_infos;
 };
 
 } // end namespace minidump
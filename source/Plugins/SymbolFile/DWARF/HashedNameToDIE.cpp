@@ -449,6 +449,7 @@ DWARFMappedHash::MemoryTable::GetHashDataForName(
 DWARFMappedHash::MemoryTable::Result
 DWARFMappedHash::MemoryTable::AppendHashDataForRegularExpression(
     const lldb_private::RegularExpression &regex,
+    llvm::ArrayRef<std::string> literals,
     lldb::offset_t *hash_data_offset_ptr, Pair &pair) const {
   pair.key = m_data.GetU32(hash_data_offset_ptr);
   // If the key is zero, this terminates our chain of HashData objects for this
@@ -468,7 +469,12 @@ DWARFMappedHash::MemoryTable::AppendHashDataForRegularExpression(
   if (count > 0 &&
       m_data.ValidOffsetForDataOfSize(*hash_data_offset_ptr,
                                       min_total_hash_data_size)) {
-    const bool match = regex.Execute(llvm::StringRef(strp_cstr));
+    // Checking the literals first is much cheaper than running the regular
+    // expression, and rules out almost every name.
+    llvm::StringRef name(strp_cstr);
+    const bool match =
+        lldb_private::TrigramIndex::ContainsLiterals(name, literals) &&
+        regex.Execute(name);
 
     if (!match && m_header.header_data.HashDataHasFixedByteSize()) {
       // If the regex doesn't match and we have fixed size data, we can just
@@ -511,13 +517,15 @@ size_t DWARFMappedHash::MemoryTable::AppendAllDIEsThatMatchingRegex(
     const lldb_private::RegularExpression &regex,
     DIEInfoArray &die_info_array) const {
   const uint32_t hash_count = m_header.hashes_count;
+  std::vector<std::string> literals;
+  lldb_private::TrigramIndex::GetRequiredLiterals(regex.GetText(), literals);
   Pair pair;
   for (uint32_t offset_idx = 0; offset_idx < hash_count; ++offset_idx) {
     lldb::offset_t hash_data_offset = GetHashDataOffset(offset_idx);
     while (hash_data_offset != UINT32_MAX) {
       const lldb::offset_t prev_hash_data_offset = hash_data_offset;
-      Result hash_result =
-          AppendHashDataForRegularExpression(regex, &hash_data_offset, pair);
+      Result hash_result = AppendHashDataForRegularExpression(
+          regex, literals, &hash_data_offset, pair);
       if (prev_hash_data_offset == hash_data_offset)
         break;
 
@@ -15,6 +15,7 @@
 #include "lldb/Core/MappedHash.h"
 #include "lldb/Core/dwarf.h"
 #include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/TrigramIndex.h"
 #include "lldb/lldb-defines.h"
 
 #include "DWARFDefines.h"
@@ -155,6 +156,7 @@ public:
   protected:
     Result AppendHashDataForRegularExpression(
         const lldb_private::RegularExpression &regex,
+        llvm::ArrayRef<std::string> literals,
         lldb::offset_t *hash_data_offset_ptr, Pair &pair) const;
 
     size_t FindByName(llvm::StringRef name, DIEInfoArray &die_info_array);
@@ -24,19 +24,48 @@ using namespace lldb_private;
 void NameToDIE::Finalize() {
   m_map.Sort();
   m_map.SizeToFit();
+  std::lock_guard<std::mutex> guard(m_regex_index_mutex);
+  m_regex_index.reset();
 }
 
 void NameToDIE::Insert(const ConstString &name, const DIERef &die_ref) {
   m_map.Append(name, die_ref);
 }
 
+const NameToDIE::RegexIndex &NameToDIE::GetRegexIndex() const {
+  std::lock_guard<std::mutex> guard(m_regex_index_mutex);
+  if (!m_regex_index) {
+    // Sorting put the entries of each name next to each other.
+    m_regex_index.reset(new RegexIndex());
+    const uint32_t size = m_map.GetSize();
+    for (uint32_t i = 0; i < size; ++i) {
+      ConstString name = m_map.GetCStringAtIndexUnchecked(i);
+      if (i > 0 && name == m_map.GetCStringAtIndexUnchecked(i - 1))
+        continue;
+      m_regex_index->names.Append(name.GetStringRef());
+      m_regex_index->first_entry.push_back(i);
+    }
+    m_regex_index->first_entry.push_back(size);
+    m_regex_index->names.Finalize();
+  }
+  return *m_regex_index;
+}
+
 size_t NameToDIE::Find(const ConstString &name, DIEArray &info_array) const {
   return m_map.GetValues(name, info_array);
 }
 
 size_t NameToDIE::Find(const RegularExpression &regex,
                        DIEArray &info_array) const {
-  return m_map.GetValues(regex, info_array);
+  const size_t initial_size = info_array.size();
+  const RegexIndex &index = GetRegexIndex();
+  std::vector<uint32_t> name_ids;
+  index.names.Find(regex, name_ids);
+  for (uint32_t id : name_ids)
+    for (uint32_t i = index.first_entry[id]; i < index.first_entry[id + 1];
+         ++i)
+      info_array.push_back(m_map.GetValueAtIndexUnchecked(i));
+  return info_array.size() - initial_size;
 }
 
 size_t NameToDIE::FindAllEntriesForCompileUnit(dw_offset_t cu_offset,
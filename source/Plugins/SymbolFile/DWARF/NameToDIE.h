@@ -11,10 +11,13 @@
 #define SymbolFileDWARF_NameToDIE_h_
 
 #include <functional>
+#include <memory>
+#include <mutex>
 
 #include "DIERef.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/Core/dwarf.h"
+#include "lldb/Utility/TrigramIndex.h"
 #include "lldb/lldb-defines.h"
 
 class SymbolFileDWARF;
@@ -48,7 +51,20 @@ public:
               &callback) const;
 
 protected:
+  // The names of m_map and where each one's entries start in it, for
+  // regular expression lookups.
+  struct RegexIndex {
+    lldb_private::TrigramIndex names;
+    std::vector<uint32_t> first_entry;
+  };
+
+  const RegexIndex &GetRegexIndex() const;
+
   lldb_private::UniqueCStringMap<DIERef> m_map;
+  // Built on the first regular expression lookup, which only some
+  // sessions ever do.
+  mutable std::mutex m_regex_index_mutex;
+  mutable std::unique_ptr<RegexIndex> m_regex_index;
 };
 
 #endif // SymbolFileDWARF_NameToDIE_h_
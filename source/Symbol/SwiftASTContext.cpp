@@ -56,7 +56,9 @@
 #include "clang/Basic/TargetOptions.h"
 #include "clang/Driver/Driver.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/LLVMContext.h"
@@ -1837,131 +1839,11 @@ lldb::TypeSystemSP SwiftASTContext::CreateInstance(lldb::LanguageType language,
   ConfigureResourceDirs(swift_ast_sp->GetCompilerInvocation(),
                         FileSpec(resource_dir, false), triple);
 
-  const bool use_all_compiler_flags =
+  swift_ast_sp->m_use_all_compiler_flags =
       !got_serialized_options || target.GetUseAllCompilerFlags();
 
-  std::function<void(ModuleSP &&)> process_one_module =
-      [&target, &swift_ast_sp, use_all_compiler_flags](ModuleSP &&module_sp) {
-        const FileSpec &module_file = module_sp->GetFileSpec();
-
-        std::string module_path = module_file.GetPath();
-
-        // Add the containing framework to the framework search path.  Don't
-        // do that if this is the executable module, since it might be
-        // buried in some framework that we don't care about.
-        if (use_all_compiler_flags &&
-            target.GetExecutableModulePointer() != module_sp.get()) {
-          size_t framework_offset = module_path.rfind(".framework/");
-
-          if (framework_offset != std::string::npos) {
-            // Sometimes the version of the framework that got loaded has been
-            // stripped and in that case, adding it to the framework search
-            // path will just short-cut a clang search that might otherwise
-            // find the needed headers. So don't add these paths.
-            std::string framework_path =
-                module_path.substr(0, framework_offset);
-            framework_path.append(".framework");
-            FileSpec path_spec(framework_path, true);
-            FileSpec headers_spec =
-                path_spec.CopyByAppendingPathComponent("Headers");
-            bool add_it = false;
-            if (headers_spec.Exists())
-              add_it = true;
-            if (!add_it) {
-              FileSpec module_spec =
-                  path_spec.CopyByAppendingPathComponent("Modules");
-              if (module_spec.Exists())
-                add_it = true;
-            }
-
-            if (!add_it) {
-              Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES));
-              if (log)
-                log->Printf("process_one_module rejecting framework path"
-                            " \"%s\" as it has no Headers "
-                            "or Modules subdirectories.",
-                            framework_path.c_str());
-            }
-
-            if (add_it) {
-              while (framework_offset && (module_path[framework_offset] != '/'))
-                framework_offset--;
-
-              if (module_path[framework_offset] == '/') {
-                // framework_offset now points to the '/';
-
-                std::string parent_path =
-                    module_path.substr(0, framework_offset);
-
-                if (strncmp(parent_path.c_str(), "/System/Library",
-                            strlen("/System/Library")) &&
-                    !IsDeviceSupport(parent_path.c_str())) {
-                  swift_ast_sp->AddFrameworkSearchPath(parent_path.c_str());
-                }
-              }
-            }
-          }
-        }
-
-        // Skip images without a serialized Swift AST.
-        if (!HasSwiftModules(*module_sp))
-          return;
-
-        SymbolVendor *sym_vendor = module_sp->GetSymbolVendor();
-        if (!sym_vendor)
-          return;
-
-        std::vector<std::string> module_names;
-        SymbolFile *sym_file = sym_vendor->GetSymbolFile();
-        if (!sym_file)
-          return;
-
-        Status sym_file_error;
-        SwiftASTContext *ast_context = llvm::dyn_cast_or_null<SwiftASTContext>(
-            sym_file->GetTypeSystemForLanguage(lldb::eLanguageTypeSwift));
-        if (ast_context && !ast_context->HasErrors()) {
-          if (use_all_compiler_flags ||
-              target.GetExecutableModulePointer() == module_sp.get()) {
-            for (size_t msi = 0, mse = ast_context->GetNumModuleSearchPaths();
-                 msi < mse; ++msi) {
-              const char *search_path =
-                  ast_context->GetModuleSearchPathAtIndex(msi);
-              swift_ast_sp->AddModuleSearchPath(search_path);
-            }
-
-            for (size_t fsi = 0,
-                        fse = ast_context->GetNumFrameworkSearchPaths();
-                 fsi < fse; ++fsi) {
-              const char *search_path =
-                  ast_context->GetFrameworkSearchPathAtIndex(fsi);
-              swift_ast_sp->AddFrameworkSearchPath(search_path);
-            }
-
-            std::string clang_argument;
-            for (size_t osi = 0, ose = ast_context->GetNumClangArguments();
-                 osi < ose; ++osi) {
-              // Join multi-arg -D and -U options for uniquing.
-              clang_argument += ast_context->GetClangArgumentAtIndex(osi);
-              if (clang_argument == "-D" || clang_argument == "-U")
-                continue;
-
-              // Enable uniquing for -D and -U options.
-              bool force = true;
-              if (clang_argument.size() >= 2 && clang_argument[0] == '-' &&
-                  (clang_argument[1] == 'D' || clang_argument[1] == 'U'))
-                force = false;
-
-              swift_ast_sp->AddClangArgument(clang_argument, force);
-              clang_argument.clear();
-            }
-          }
-
-          swift_ast_sp->RegisterSectionModules(*module_sp, module_names);
-        }
-      };
-
   for (size_t mi = 0; mi != num_images; ++mi) {
-    process_one_module(target.GetImages().GetModuleAtIndex(mi));
+    swift_ast_sp->AddImage(target.GetImages().GetModuleAtIndex(mi));
   }
 
   FileSpecList &framework_search_paths = target.GetSwiftFrameworkSearchPaths();
@@ -3391,12 +3273,169 @@ GetLibrarySearchPaths(std::vector<std::string> &paths,
   paths.push_back(search_path_opts.RuntimeLibraryPath);
 }
 
+// A framework is loaded if there is an image named after it inside
+// Name.framework.
+static bool IsFrameworkLoaded(Target &target, llvm::StringRef library_name) {
+  ConstString library_cstr(library_name);
+  std::string framework_name = library_name.str() + ".framework";
+  for (auto module : target.GetImages().Modules()) {
+    FileSpec module_file = module->GetFileSpec();
+    if (module_file.GetFilename() == library_cstr &&
+        module_file.GetPath().rfind(framework_name) != std::string::npos)
+      return true;
+  }
+  return false;
+}
+
+static std::vector<std::string>
+UniquePaths(const std::vector<std::string> &paths) {
+  // The search dirs as they come from the AST context often have duplicate
+  // entries, don't try to load along the same path twice.
+  std::unordered_set<std::string> seen_paths;
+  std::vector<std::string> uniqued_paths;
+  for (const std::string &path : paths)
+    if (seen_paths.insert(path).second)
+      uniqued_paths.push_back(path);
+  return uniqued_paths;
+}
+
+//----------------------------------------------------------------------
+// Try the first place we'd look for each of the link libraries -- the
+// @rpath for frameworks, the library search paths for libraries -- with
+// one LoadImages call per kind, rather than running a dlopen expression in
+// the process for each library.
+//
+// Libraries that were loaded go in \a loaded.  For the ones that weren't,
+// \a failures gets the errors to report if they aren't found anywhere else
+// either.  Libraries that don't need loading, or that are in the negative
+// cache, are left out of both.
+//----------------------------------------------------------------------
+static void PreloadLinkLibraries(
+    Process &process, llvm::ArrayRef<swift::LinkLibrary> link_libraries,
+    const std::vector<std::string> &library_search_paths,
+    llvm::StringSet<> &loaded, llvm::StringMap<std::string> &failures) {
+  PlatformSP platform_sp(process.GetTarget().GetPlatform());
+  SwiftLanguageRuntime *runtime = process.GetSwiftLanguageRuntime();
+  if (!platform_sp || !runtime)
+    return;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_TYPES));
+  Target &target = process.GetTarget();
+  std::vector<FileSpec> framework_specs, library_specs;
+  std::vector<llvm::StringRef> framework_names, library_names;
+
+  for (const swift::LinkLibrary &link_lib : link_libraries) {
+    llvm::StringRef library_name = link_lib.getName();
+    if (library_name.empty() ||
+        runtime->IsInLibraryNegativeCache(library_name.str().c_str()))
+      continue;
+
+    switch (link_lib.getKind()) {
+    case swift::LibraryKind::Framework: {
+      if (IsFrameworkLoaded(target, library_name))
+        continue;
+      std::string framework_path = "@rpath/" + library_name.str() +
+                                   ".framework/" + library_name.str();
+      framework_specs.emplace_back(framework_path, false);
+      framework_names.push_back(library_name);
+    } break;
+    case swift::LibraryKind::Library: {
+      // LoadLibraryUsingPaths explains why we never load the standard
+      // library.
+      if (ConstString::Equals(runtime->GetStandardLibraryBaseName(),
+                              ConstString(library_name)))
+        continue;
+      ConstString library_fullname =
+          platform_sp->GetFullNameForDylib(ConstString(library_name));
+      ModuleSpec module_spec;
+      module_spec.GetFileSpec().GetFilename() = library_fullname;
+      lldb_private::ModuleList matching_module_list;
+      if (target.GetImages().FindModules(module_spec, matching_module_list))
+        continue;
+      library_specs.emplace_back(library_fullname.GetStringRef(), false);
+      library_names.push_back(library_name);
+    } break;
+    }
+  }
+
+  std::vector<Status> errors;
+  if (!framework_specs.empty()) {
+    std::vector<uint32_t> tokens =
+        platform_sp->LoadImages(&process, framework_specs, errors);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      std::string framework_path = framework_specs[i].GetPath();
+      if (tokens[i] != LLDB_INVALID_IMAGE_TOKEN) {
+        if (log)
+          log->Printf("Found framework at: %s.", framework_path.c_str());
+        loaded.insert(framework_names[i]);
+        continue;
+      }
+      StreamString error_text;
+      error_text.Printf("Looking for \"%s\", error: %s\n",
+                        framework_path.c_str(), errors[i].AsCString());
+      failures[framework_names[i]] = error_text.GetString().str();
+    }
+  }
+
+  if (!library_specs.empty()) {
+    std::vector<std::string> uniqued_paths = UniquePaths(library_search_paths);
+    std::vector<uint32_t> tokens = platform_sp->LoadImagesUsingPaths(
+        &process, library_specs, uniqued_paths, errors);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      const char *library_fullname = library_specs[i].GetCString();
+      if (tokens[i] != LLDB_INVALID_IMAGE_TOKEN) {
+        if (log)
+          log->Printf("Found library %s along the search paths.",
+                      library_fullname);
+        loaded.insert(library_names[i]);
+        continue;
+      }
+      StreamString error_text;
+      error_text.Printf("Failed to find \"%s\" in paths:\n", library_fullname);
+      for (const std::string &search_dir : uniqued_paths)
+        error_text.Printf("  %s\n", search_dir.c_str());
+      failures[library_names[i]] = error_text.GetString().str();
+    }
+  }
+}
+
 void SwiftASTContext::LoadModule(swift::ModuleDecl *swift_module,
                                  Process &process, Status &error) {
   VALID_OR_RETURN_VOID();
 
+  // The link libraries of a module only need to be loaded into a process
+  // once; after that every expression importing the module would just find
+  // them already loaded.
+  if (process.GetUniqueID() != m_loaded_modules_process_id) {
+    m_modules_loaded_into_process.clear();
+    m_loaded_modules_process_id = process.GetUniqueID();
+  }
+  if (m_modules_loaded_into_process.count(swift_module))
+    return;
+
+  // Collect the link libraries up front, so the first place to look for
+  // all of them can be tried at once.
+  std::vector<swift::LinkLibrary> link_libraries;
+  llvm::StringSet<> seen_libraries;
+  swift_module->forAllVisibleModules(
+      {}, [&](swift::ModuleDecl::ImportedModule import) {
+        import.second->collectLinkLibraries([&](swift::LinkLibrary link_lib) {
+          if (seen_libraries.insert(link_lib.getName()).second)
+            link_libraries.push_back(link_lib);
+        });
+        return true;
+      });
+
+  std::vector<std::string> library_search_paths;
+  GetLibrarySearchPaths(library_search_paths,
+                        swift_module->getASTContext().SearchPathOpts);
+  llvm::StringSet<> preloaded;
+  llvm::StringMap<std::string> preload_failures;
+  PreloadLinkLibraries(process, link_libraries, library_search_paths,
+                       preloaded, preload_failures);
+
   Status current_error;
-  auto addLinkLibrary = [&](swift::LinkLibrary link_lib) {
+  auto addLinkLibrary = [&](const swift::LinkLibrary &link_lib) {
     Status load_image_error;
     StreamString all_dlopen_errors;
     const char *library_name = link_lib.getName().data();
@@ -3458,22 +3497,13 @@ void SwiftASTContext::LoadModule(swift::ModuleDecl *swift_module,
         return;
       }
 
-      for (auto module : process.GetTarget().GetImages().Modules()) {
-        FileSpec module_file = module->GetFileSpec();
-        if (module_file.GetFilename() == library_cstr) {
-          std::string module_path = module_file.GetPath();
-
-          size_t framework_offset = module_path.rfind(framework_name);
-
-          if (framework_offset != std::string::npos) {
-            // The Framework is already loaded, so we don't need to try to load
-            // it again.
-            if (log)
-              log->Printf("Skipping load of %s as it is already loaded.",
-                          framework_name.c_str());
-            return;
-          }
-        }
+      if (IsFrameworkLoaded(process.GetTarget(), library_name)) {
+        // The Framework is already loaded, so we don't need to try to load
+        // it again.
+        if (log)
+          log->Printf("Skipping load of %s as it is already loaded.",
+                      framework_name.c_str());
+        return;
       }
 
       std::string framework_path("@rpath/");
@@ -3482,7 +3512,11 @@ void SwiftASTContext::LoadModule(swift::ModuleDecl *swift_module,
       framework_path.append(library_name);
       FileSpec framework_spec(framework_path.c_str(), false);
 
-      if (LoadOneImage(process, framework_spec, load_image_error)) {
+      // PreloadLinkLibraries has already looked on the @rpath.
+      auto preload_failure = preload_failures.find(library_name);
+      if (preload_failure != preload_failures.end())
+        all_dlopen_errors.PutCString(preload_failure->second);
+      else if (LoadOneImage(process, framework_spec, load_image_error)) {
         if (log)
           log->Printf("Found framework at: %s.", framework_path.c_str());
 
@@ -3557,13 +3591,14 @@ void SwiftASTContext::LoadModule(swift::ModuleDecl *swift_module,
                                  load_image_error.AsCString());
     } break;
     case swift::LibraryKind::Library: {
-      std::vector<std::string> search_paths;
-
-      GetLibrarySearchPaths(search_paths,
-                            swift_module->getASTContext().SearchPathOpts);
-
-      if (LoadLibraryUsingPaths(process, library_name, search_paths, true,
-                                all_dlopen_errors))
+      // PreloadLinkLibraries has already looked along the search paths.
+      auto preload_failure = preload_failures.find(library_name);
+      bool searched = preload_failure != preload_failures.end();
+      if (searched)
+        all_dlopen_errors.PutCString(preload_failure->second);
+
+      if (LoadLibraryUsingPaths(process, library_name, library_search_paths,
+                                true, all_dlopen_errors, !searched))
         return;
     } break;
     }
@@ -3579,18 +3614,18 @@ void SwiftASTContext::LoadModule(swift::ModuleDecl *swift_module,
         all_dlopen_errors.GetData());
   };
 
-  swift_module->forAllVisibleModules(
-      {}, [&](swift::ModuleDecl::ImportedModule import) {
-        import.second->collectLinkLibraries(addLinkLibrary);
-        return true;
-      });
+  for (const swift::LinkLibrary &link_lib : link_libraries)
+    if (!preloaded.count(link_lib.getName()))
+      addLinkLibrary(link_lib);
   error = current_error;
+  if (error.Success())
+    m_modules_loaded_into_process.insert(swift_module);
 }
 
 bool SwiftASTContext::LoadLibraryUsingPaths(
     Process &process, llvm::StringRef library_name,
     std::vector<std::string> &search_paths, bool check_rpath,
-    StreamString &all_dlopen_errors) {
+    StreamString &all_dlopen_errors, bool check_search_paths) {
   VALID_OR_RETURN(false);
 
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_TYPES));
@@ -3647,39 +3682,30 @@ bool SwiftASTContext::LoadLibraryUsingPaths(
   }
 
   std::string library_path;
-  std::unordered_set<std::string> seen_paths;
   Status load_image_error;
-  std::vector<std::string> uniqued_paths;
-  
-  for (const std::string &library_search_dir : search_paths) {
-    // The library search dir as it comes from the AST context often has
-    // duplicate entries, so lets unique the path list before we send it
-    // down to the target.
-
-    std::pair<std::unordered_set<std::string>::iterator, bool> insert_result =
-        seen_paths.insert(library_search_dir);
-    if (insert_result.second)
-      uniqued_paths.push_back(library_search_dir);
-  }
 
-  FileSpec library_spec(library_fullname, false);
-  FileSpec found_library;
-  uint32_t token = LLDB_INVALID_IMAGE_TOKEN;
-  Status error;
-  if (platform_sp)
-    token = platform_sp->LoadImageUsingPaths(&process, library_spec, 
-                                             uniqued_paths,
-                                             error,
-                                             &found_library);
-  if (token != LLDB_INVALID_IMAGE_TOKEN) {
-      if (log)
-        log->Printf("Found library at: %s.", found_library.GetCString());
-      return true;
-  } else {
-    all_dlopen_errors.Printf("Failed to find \"%s\" in paths:\n,",
-                             library_fullname.c_str());
-    for (const std::string &search_dir : uniqued_paths)
-      all_dlopen_errors.Printf("  %s\n", search_dir.c_str());
+  if (check_search_paths) {
+    std::vector<std::string> uniqued_paths = UniquePaths(search_paths);
+
+    FileSpec library_spec(library_fullname, false);
+    FileSpec found_library;
+    uint32_t token = LLDB_INVALID_IMAGE_TOKEN;
+    Status error;
+    if (platform_sp)
+      token = platform_sp->LoadImageUsingPaths(&process, library_spec,
+                                               uniqued_paths,
+                                               error,
+                                               &found_library);
+    if (token != LLDB_INVALID_IMAGE_TOKEN) {
+        if (log)
+          log->Printf("Found library at: %s.", found_library.GetCString());
+        return true;
+    } else {
+      all_dlopen_errors.Printf("Failed to find \"%s\" in paths:\n,",
+                               library_fullname.c_str());
+      for (const std::string &search_dir : uniqued_paths)
+        all_dlopen_errors.Printf("  %s\n", search_dir.c_str());
+    }
   }
 
   if (check_rpath) {
@@ -3706,23 +3732,37 @@ void SwiftASTContext::LoadExtraDylibs(Process &process, Status &error) {
 
   error.Clear();
   swift::IRGenOptions &irgen_options = GetIRGenOptions();
-  for (const swift::LinkLibrary &link_lib : irgen_options.LinkLibraries) {
-    // We don't have to do frameworks here, they actually record their link
-    // libraries properly.
-    if (link_lib.getKind() == swift::LibraryKind::Library) {
-      const char *library_name = link_lib.getName().data();
-      StreamString errors;
-
-      std::vector<std::string> search_paths;
-
-      GetLibrarySearchPaths(search_paths,
-                            m_compiler_invocation_ap->getSearchPathOptions());
-
-      bool success = LoadLibraryUsingPaths(process, library_name, search_paths,
-                                           false, errors);
-      if (!success) {
-        error.SetErrorString(errors.GetData());
-      }
+  // We don't have to do frameworks here, they actually record their link
+  // libraries properly.
+  std::vector<swift::LinkLibrary> link_libraries;
+  for (const swift::LinkLibrary &link_lib : irgen_options.LinkLibraries)
+    if (link_lib.getKind() == swift::LibraryKind::Library)
+      link_libraries.push_back(link_lib);
+
+  std::vector<std::string> search_paths;
+  GetLibrarySearchPaths(search_paths,
+                        m_compiler_invocation_ap->getSearchPathOptions());
+
+  llvm::StringSet<> preloaded;
+  llvm::StringMap<std::string> preload_failures;
+  PreloadLinkLibraries(process, link_libraries, search_paths, preloaded,
+                       preload_failures);
+
+  for (const swift::LinkLibrary &link_lib : link_libraries) {
+    const char *library_name = link_lib.getName().data();
+    if (preloaded.count(library_name))
+      continue;
+
+    StreamString errors;
+    auto preload_failure = preload_failures.find(library_name);
+    bool searched = preload_failure != preload_failures.end();
+    if (searched)
+      errors.PutCString(preload_failure->second);
+
+    bool success = LoadLibraryUsingPaths(process, library_name, search_paths,
+                                         false, errors, !searched);
+    if (!success) {
+      error.SetErrorString(errors.GetData());
     }
   }
 }
@@ -8033,6 +8073,185 @@ SwiftASTContextForExpressions::GetPersistentExpressionState() {
   return m_persistent_state_up.get();
 }
 
+void SwiftASTContextForExpressions::AddImage(const ModuleSP &module_sp) {
+  TargetSP target_sp = m_target_wp.lock();
+  if (!target_sp || !module_sp)
+    return;
+  Target &target = *target_sp;
+
+  {
+    std::lock_guard<std::mutex> guard(m_images_mutex);
+    auto pos = m_images.find(module_sp.get());
+    if (pos != m_images.end() && pos->second.lock() == module_sp)
+      return;
+    m_images[module_sp.get()] = module_sp;
+  }
+
+  const FileSpec &module_file = module_sp->GetFileSpec();
+
+  std::string module_path = module_file.GetPath();
+
+  // Add the containing framework to the framework search path.  Don't
+  // do that if this is the executable module, since it might be
+  // buried in some framework that we don't care about.
+  if (m_use_all_compiler_flags &&
+      target.GetExecutableModulePointer() != module_sp.get()) {
+    size_t framework_offset = module_path.rfind(".framework/");
+
+    if (framework_offset != std::string::npos) {
+      // Sometimes the version of the framework that got loaded has been
+      // stripped and in that case, adding it to the framework search
+      // path will just short-cut a clang search that might otherwise
+      // find the needed headers. So don't add these paths.
+      std::string framework_path = module_path.substr(0, framework_offset);
+      framework_path.append(".framework");
+      FileSpec path_spec(framework_path, true);
+      FileSpec headers_spec = path_spec.CopyByAppendingPathComponent("Headers");
+      bool add_it = false;
+      if (headers_spec.Exists())
+        add_it = true;
+      if (!add_it) {
+        FileSpec module_spec =
+            path_spec.CopyByAppendingPathComponent("Modules");
+        if (module_spec.Exists())
+          add_it = true;
+      }
+
+      if (!add_it) {
+        Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_TYPES));
+        if (log)
+          log->Printf("AddImage rejecting framework path"
+                      " \"%s\" as it has no Headers "
+                      "or Modules subdirectories.",
+                      framework_path.c_str());
+      }
+
+      if (add_it) {
+        while (framework_offset && (module_path[framework_offset] != '/'))
+          framework_offset--;
+
+        if (module_path[framework_offset] == '/') {
+          // framework_offset now points to the '/';
+
+          std::string parent_path = module_path.substr(0, framework_offset);
+
+          if (strncmp(parent_path.c_str(), "/System/Library",
+                      strlen("/System/Library")) &&
+              !IsDeviceSupport(parent_path.c_str())) {
+            AddFrameworkSearchPath(parent_path.c_str());
+          }
+        }
+      }
+    }
+  }
+
+  // Skip images without a serialized Swift AST.
+  if (!HasSwiftModules(*module_sp))
+    return;
+
+  SymbolVendor *sym_vendor = module_sp->GetSymbolVendor();
+  if (!sym_vendor)
+    return;
+
+  std::vector<std::string> module_names;
+  SymbolFile *sym_file = sym_vendor->GetSymbolFile();
+  if (!sym_file)
+    return;
+
+  Status sym_file_error;
+  SwiftASTContext *ast_context = llvm::dyn_cast_or_null<SwiftASTContext>(
+      sym_file->GetTypeSystemForLanguage(lldb::eLanguageTypeSwift));
+  if (ast_context && !ast_context->HasErrors()) {
+    if (m_use_all_compiler_flags ||
+        target.GetExecutableModulePointer() == module_sp.get()) {
+      for (size_t msi = 0, mse = ast_context->GetNumModuleSearchPaths();
+           msi < mse; ++msi) {
+        const char *search_path = ast_context->GetModuleSearchPathAtIndex(msi);
+        AddModuleSearchPath(search_path);
+      }
+
+      for (size_t fsi = 0, fse = ast_context->GetNumFrameworkSearchPaths();
+           fsi < fse; ++fsi) {
+        const char *search_path =
+            ast_context->GetFrameworkSearchPathAtIndex(fsi);
+        AddFrameworkSearchPath(search_path);
+      }
+
+      std::string clang_argument;
+      for (size_t osi = 0, ose = ast_context->GetNumClangArguments();
+           osi < ose; ++osi) {
+        // Join multi-arg -D and -U options for uniquing.
+        clang_argument += ast_context->GetClangArgumentAtIndex(osi);
+        if (clang_argument == "-D" || clang_argument == "-U")
+          continue;
+
+        // Enable uniquing for -D and -U options.
+        bool force = true;
+        if (clang_argument.size() >= 2 && clang_argument[0] == '-' &&
+            (clang_argument[1] == 'D' || clang_argument[1] == 'U'))
+          force = false;
+
+        AddClangArgument(clang_argument, force);
+        clang_argument.clear();
+      }
+    }
+
+    RegisterSectionModules(*module_sp, module_names);
+    m_swift_images.push_back(module_sp);
+  }
+}
+
+void SwiftASTContextForExpressions::ModulesDidLoad(ModuleList &module_list) {
+  SwiftASTContext::ModulesDidLoad(module_list);
+
+  // Deserializing the Swift modules of a newly loaded image, and building
+  // the Clang modules they import, happens in the image's own type system
+  // and can be done in parallel, as CreateInstance does.  Only registering
+  // the results with this context has to be serial.
+  TargetSP target_sp = m_target_wp.lock();
+  if (target_sp && target_sp->GetSwiftCreateModuleContextsInParallel() &&
+      module_list.GetSize() > 1) {
+    llvm::ThreadPool pool;
+    module_list.ForEach([&pool](const ModuleSP &module_sp) {
+      if (HasSwiftModules(*module_sp))
+        pool.async([=] {
+          module_sp->GetTypeSystemForLanguage(lldb::eLanguageTypeSwift);
+        });
+      return true;
+    });
+    pool.wait();
+  }
+
+  // Register the Swift modules of images loaded since the context was
+  // created, without touching anything that was already imported.
+  module_list.ForEach([this](const ModuleSP &module_sp) {
+    AddImage(module_sp);
+    return true;
+  });
+}
+
+bool SwiftASTContextForExpressions::AdoptCurrentProcess() {
+  TargetSP target_sp = m_target_wp.lock();
+  if (!target_sp || HasFatalErrors())
+    return false;
+
+  // If any image the context took Swift modules from was replaced, e.g.
+  // because the program was rebuilt, the imported modules are stale.
+  const ModuleList &images = target_sp->GetImages();
+  {
+    std::lock_guard<std::mutex> guard(m_images_mutex);
+    for (const lldb::ModuleWP &image_wp : m_swift_images) {
+      ModuleSP image_sp = image_wp.lock();
+      if (!image_sp || !images.FindModule(image_sp.get()))
+        return false;
+    }
+  }
+
+  m_process = target_sp->GetProcessSP().get();
+  ClearModuleDependentCaches();
+  return true;
+}
+
 void lldb_private::printASTValidationInfo(
     const swift::serialization::ValidationInfo &ast_info,
     const swift::serialization::ExtendedValidationInfo &ext_ast_info,
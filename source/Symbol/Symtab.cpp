@@ -26,6 +26,7 @@
 
 #include "lldb/Target/SwiftLanguageRuntime.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 
 using namespace lldb;
@@ -48,6 +49,7 @@ Symbol *Symtab::Resize(size_t count) {
   // Clients should grab the mutex from this symbol table and lock it manually
   // when calling this function to avoid performance issues.
   m_symbols.resize(count);
+  m_regex_index.reset();
   return m_symbols.empty() ? nullptr : &m_symbols[0];
 }
 
@@ -60,6 +62,7 @@ uint32_t Symtab::AddSymbol(const Symbol &symbol) {
   m_symbols.push_back(symbol);
   m_file_addr_to_index_computed = false;
   m_name_indexes_computed = false;
+  m_regex_index.reset();
   return symbol_idx;
 }
 
@@ -735,23 +738,71 @@ uint32_t Symtab::AppendSymbolIndexesWithNameAndType(
   return indexes.size();
 }
 
+const Symtab::RegexIndex &Symtab::GetRegexIndex() {
+  if (m_regex_index)
+    return *m_regex_index;
+
+  static Timer::Category func_cat(LLVM_PRETTY_FUNCTION);
+  Timer scoped_timer(func_cat, "%s", LLVM_PRETTY_FUNCTION);
+  m_regex_index.reset(new RegexIndex());
+  RegexIndex &index = *m_regex_index;
+
+  // Give every distinct name an ID, then group the symbols by it.
+  const uint32_t sym_end = m_symbols.size();
+  std::vector<uint32_t> name_ids(sym_end, UINT32_MAX);
+  std::vector<uint32_t> counts;
+  llvm::DenseMap<const char *, uint32_t> ids_by_name;
+  for (uint32_t i = 0; i < sym_end; i++) {
+    ConstString name = m_symbols[i].GetName();
+    if (!name)
+      continue;
+    auto insert_result =
+        ids_by_name.insert(std::make_pair(name.GetCString(), counts.size()));
+    if (insert_result.second) {
+      index.names.Append(name.GetStringRef());
+      counts.push_back(0);
+    }
+    name_ids[i] = insert_result.first->second;
+    ++counts[name_ids[i]];
+  }
+  index.names.Finalize();
+
+  index.first_symbol.resize(counts.size() + 1, 0);
+  for (uint32_t id = 0; id < counts.size(); ++id)
+    index.first_symbol[id + 1] = index.first_symbol[id] + counts[id];
+  index.symbol_indexes.resize(index.first_symbol.back());
+  std::vector<uint32_t> next(index.first_symbol.begin(),
+                             index.first_symbol.end() - 1);
+  for (uint32_t i = 0; i < sym_end; i++)
+    if (name_ids[i] != UINT32_MAX)
+      index.symbol_indexes[next[name_ids[i]]++] = i;
+  return index;
+}
+
+void Symtab::FindSymbolIndexesMatchingRegex(const RegularExpression &regex,
+                                            std::vector<uint32_t> &indexes) {
+  const RegexIndex &index = GetRegexIndex();
+  std::vector<uint32_t> name_ids;
+  index.names.Find(regex, name_ids);
+  for (uint32_t id : name_ids)
+    indexes.insert(indexes.end(),
+                   index.symbol_indexes.begin() + index.first_symbol[id],
+                   index.symbol_indexes.begin() + index.first_symbol[id + 1]);
+  std::sort(indexes.begin(), indexes.end());
+}
+
 uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
     const RegularExpression &regexp, SymbolType symbol_type,
     std::vector<uint32_t> &indexes) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
   uint32_t prev_size = indexes.size();
-  uint32_t sym_end = m_symbols.size();
-
-  for (uint32_t i = 0; i < sym_end; i++) {
+  std::vector<uint32_t> matches;
+  FindSymbolIndexesMatchingRegex(regexp, matches);
+  for (uint32_t i : matches) {
     if (symbol_type == eSymbolTypeAny ||
-        m_symbols[i].GetType() == symbol_type) {
-      const char *name = m_symbols[i].GetName().AsCString();
-      if (name) {
-        if (regexp.Execute(name))
-          indexes.push_back(i);
-      }
-    }
+        m_symbols[i].GetType() == symbol_type)
+      indexes.push_back(i);
   }
   return indexes.size() - prev_size;
 }
@@ -763,19 +814,14 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
   uint32_t prev_size = indexes.size();
-  uint32_t sym_end = m_symbols.size();
-
-  for (uint32_t i = 0; i < sym_end; i++) {
+  std::vector<uint32_t> matches;
+  FindSymbolIndexesMatchingRegex(regexp, matches);
+  for (uint32_t i : matches) {
     if (symbol_type == eSymbolTypeAny ||
         m_symbols[i].GetType() == symbol_type) {
       if (CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility) == false)
         continue;
-
-      const char *name = m_symbols[i].GetName().AsCString();
-      if (name) {
-        if (regexp.Execute(name))
-          indexes.push_back(i);
-      }
+      indexes.push_back(i);
     }
   }
   return indexes.size() - prev_size;
@@ -11,10 +11,12 @@
 // C Includes
 #include <inttypes.h>
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/RangeMap.h"
 #include "lldb/Core/State.h"
+#include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/Log.h"
@@ -28,7 +30,12 @@ using namespace lldb_private;
 MemoryCache::MemoryCache(Process &process)
     : m_mutex(), m_L1_cache(), m_L2_cache(), m_invalid_ranges(),
       m_process(process),
-      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()) {}
+      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()),
+      m_max_fill_lines(std::max<uint64_t>(
+          1, process.GetMemoryCachePrefetchSize() / m_L2_cache_line_byte_size)),
+      m_fill_lines(1), m_last_fill(), m_region_kinds(),
+      m_region_info_supported(true), m_getting_region_info(false),
+      m_stats() {}
 
 //----------------------------------------------------------------------
 // Destructor
@@ -39,9 +46,22 @@ void MemoryCache::Clear(bool clear_invalid_ranges) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   m_L1_cache.clear();
   m_L2_cache.clear();
-  if (clear_invalid_ranges)
+  if (clear_invalid_ranges) {
     m_invalid_ranges.Clear();
+    m_region_info_supported = true;
+  }
   m_L2_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
+  m_max_fill_lines = std::max<uint64_t>(
+      1, m_process.GetMemoryCachePrefetchSize() / m_L2_cache_line_byte_size);
+  m_fill_lines = 1;
+  m_last_fill.Clear();
+  // The inferior may have mapped or unmapped memory while it ran.
+  m_region_kinds.Clear();
+}
+
+MemoryCache::Statistics MemoryCache::GetStatistics() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return m_stats;
 }
 
 void MemoryCache::AddL1CacheData(lldb::addr_t addr, const void *src,
@@ -141,6 +161,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   // when reading from them (no partial reads from the L1 cache).
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  ++m_stats.reads;
   if (!m_L1_cache.empty()) {
     AddrRange read_range(addr, dst_len);
     BlockMap::iterator pos = m_L1_cache.upper_bound(addr);
@@ -165,6 +186,9 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   if (dst && dst_len > m_L2_cache_line_byte_size) {
     size_t bytes_read =
         m_process.ReadMemoryFromInferior(addr, dst, dst_len, error);
+    ++m_stats.misses;
+    ++m_stats.inferior_reads;
+    m_stats.bytes_read += bytes_read;
     // Add this non block sized range to the L1 cache if we actually read
     // anything
     if (bytes_read > 0)
@@ -177,6 +201,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
     uint8_t *dst_buf = (uint8_t *)dst;
     addr_t curr_addr = addr - (addr % cache_line_byte_size);
     addr_t cache_offset = addr - curr_addr;
+    bool missed = false;
 
     while (bytes_left > 0) {
       if (m_invalid_ranges.FindEntryThatContains(curr_addr)) {
@@ -231,17 +256,12 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
 
       if (bytes_left > 0) {
         assert((curr_addr % cache_line_byte_size) == 0);
-        std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(
-            new DataBufferHeap(cache_line_byte_size, 0));
-        size_t process_bytes_read = m_process.ReadMemoryFromInferior(
-            curr_addr, data_buffer_heap_ap->GetBytes(),
-            data_buffer_heap_ap->GetByteSize(), error);
-        if (process_bytes_read == 0)
+        if (!missed) {
+          ++m_stats.misses;
+          missed = true;
+        }
+        if (!FillL2Cache(curr_addr, cache_offset + bytes_left, error))
           return dst_len - bytes_left;
-
-        if (process_bytes_read != cache_line_byte_size)
-          data_buffer_heap_ap->SetByteSize(process_bytes_read);
-        m_L2_cache[curr_addr] = DataBufferSP(data_buffer_heap_ap.release());
         // We have read data and put it into the cache, continue through the
         // loop again to get the data out of the cache...
       }
@@ -251,6 +271,157 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   return dst_len - bytes_left;
 }
 
+bool MemoryCache::FillL2Cache(addr_t line_addr, size_t bytes_needed,
+                              Status &error) {
+  const addr_t line_size = m_L2_cache_line_byte_size;
+  const addr_t needed_lines = (bytes_needed + line_size - 1) / line_size;
+
+  // Grow the read every time a miss picks up right where the last one
+  // stopped, in either direction: unwinding walks the stack one way and
+  // string summaries walk forward.  Anything else starts over at the size
+  // the region suggests, if an earlier walk looked it up, so scattered reads
+  // like hash table buckets stay one line each.
+  addr_t lines_before = 0;
+  addr_t lines_after = needed_lines - 1;
+  AddrRange region;
+  if (m_max_fill_lines > 1) {
+    const bool after =
+        m_last_fill.IsValid() && line_addr == m_last_fill.GetRangeEnd();
+    const bool before = m_last_fill.IsValid() &&
+                        line_addr + line_size == m_last_fill.GetRangeBase();
+    // Asking the process about a region can cost a round trip to the stub
+    // after every stop, so wait until the misses walk through memory.
+    const RegionKind kind = GetRegionKind(line_addr, region, after || before);
+    bool forward = true;
+    if (after) {
+      m_fill_lines = std::min(m_fill_lines * 2, m_max_fill_lines);
+    } else if (before) {
+      m_fill_lines = std::min(m_fill_lines * 2, m_max_fill_lines);
+      forward = false;
+    } else {
+      switch (kind) {
+      case eRegionKindText:
+        m_fill_lines = 4;
+        break;
+      case eRegionKindStack:
+        m_fill_lines = 2;
+        break;
+      default:
+        m_fill_lines = 1;
+        break;
+      }
+      m_fill_lines = std::min(m_fill_lines, m_max_fill_lines);
+    }
+    if (forward)
+      lines_after = std::max<addr_t>(lines_after, m_fill_lines - 1);
+    else
+      lines_before = m_fill_lines - 1;
+  }
+
+  // Only read ahead into lines that are in the same region, that we don't
+  // already have and that aren't known to be unreadable.
+  addr_t start = line_addr;
+  addr_t end = line_addr + line_size;
+  for (; lines_after > 0 && CanPrefetchL2Line(end, region); --lines_after)
+    end += line_size;
+  for (; lines_before > 0 && start >= line_size &&
+         CanPrefetchL2Line(start - line_size, region);
+       --lines_before)
+    start -= line_size;
+
+  DataBufferHeap data(end - start, 0);
+  size_t bytes_read = m_process.ReadMemoryFromInferior(
+      start, data.GetBytes(), data.GetByteSize(), error);
+  ++m_stats.inferior_reads;
+  m_stats.bytes_read += bytes_read;
+  if (end - start > line_size && start + bytes_read < line_addr + line_size) {
+    // A process may fail the whole read if any line read ahead of or behind
+    // the one we need isn't readable.  If we came up short of the end of
+    // that line, read just the line.
+    start = line_addr;
+    end = line_addr + line_size;
+    data.SetByteSize(line_size);
+    bytes_read = m_process.ReadMemoryFromInferior(start, data.GetBytes(),
+                                                  line_size, error);
+    ++m_stats.inferior_reads;
+    m_stats.bytes_read += bytes_read;
+  }
+  if (bytes_read == 0) {
+    m_last_fill.Clear();
+    return false;
+  }
+  // A read that came up short past the line we need isn't an error.
+  if (start + bytes_read >= line_addr + line_size)
+    error.Clear();
+
+  const addr_t needed_end = line_addr + needed_lines * line_size;
+  for (addr_t offset = 0; offset < bytes_read; offset += line_size) {
+    const addr_t curr_addr = start + offset;
+    const size_t curr_size = std::min<addr_t>(line_size, bytes_read - offset);
+    if (curr_addr < line_addr || curr_addr >= needed_end)
+      m_stats.bytes_prefetched += curr_size;
+    m_L2_cache[curr_addr] = DataBufferSP(
+        new DataBufferHeap(data.GetBytes() + offset, curr_size));
+  }
+  m_last_fill = AddrRange(start, end - start);
+  return true;
+}
+
+bool MemoryCache::CanPrefetchL2Line(addr_t line_addr,
+                                    const AddrRange &region) const {
+  const addr_t line_size = m_L2_cache_line_byte_size;
+  if (line_addr > LLDB_INVALID_ADDRESS - line_size)
+    return false;
+  if (region.IsValid() &&
+      !region.DoesIntersect(AddrRange(line_addr, line_size)))
+    return false;
+  if (m_invalid_ranges.FindEntryThatContains(line_addr))
+    return false;
+  return m_L2_cache.find(line_addr) == m_L2_cache.end();
+}
+
+MemoryCache::RegionKind MemoryCache::GetRegionKind(addr_t addr,
+                                                   AddrRange &region,
+                                                   bool ask_process) {
+  region.Clear();
+  if (const RegionKinds::Entry *entry =
+          m_region_kinds.FindEntryThatContains(addr)) {
+    region = AddrRange(entry->GetRangeBase(), entry->GetByteSize());
+    return entry->data;
+  }
+
+  // Some plug-ins read memory to answer, which brings them back here.
+  if (!ask_process || !m_region_info_supported || m_getting_region_info)
+    return eRegionKindUnknown;
+
+  MemoryRegionInfo region_info;
+  m_getting_region_info = true;
+  Status error = m_process.GetMemoryRegionInfo(addr, region_info);
+  m_getting_region_info = false;
+  if (error.Fail()) {
+    m_region_info_supported = false;
+    return eRegionKindUnknown;
+  }
+  if (!region_info.GetRange().Contains(addr))
+    return eRegionKindUnknown;
+
+  RegionKind kind = eRegionKindUnknown;
+  if (region_info.GetMapped() != MemoryRegionInfo::eNo) {
+    if (region_info.GetName().GetStringRef().startswith("[stack"))
+      kind = eRegionKindStack;
+    else if (region_info.GetExecutable() == MemoryRegionInfo::eYes)
+      kind = eRegionKindText;
+    else
+      kind = eRegionKindData;
+  }
+  region = AddrRange(region_info.GetRange().GetRangeBase(),
+                     region_info.GetRange().GetByteSize());
+  m_region_kinds.Append(RegionKinds::Entry(region.GetRangeBase(),
+                                           region.GetByteSize(), kind));
+  m_region_kinds.Sort();
+  return kind;
+}
+
 AllocatedBlock::AllocatedBlock(lldb::addr_t addr, uint32_t byte_size,
                                uint32_t permissions, uint32_t chunk_size)
     : m_range(addr, byte_size), m_permissions(permissions),
@@ -1788,6 +1788,42 @@ uint32_t Platform::LoadImageUsingPaths(lldb_private::Process *process,
   return DoLoadImage(process, file_to_use, &paths, error, loaded_path);
 }
 
+std::vector<uint32_t>
+Platform::LoadImages(lldb_private::Process *process,
+                     const std::vector<lldb_private::FileSpec> &remote_files,
+                     std::vector<lldb_private::Status> &errors) {
+  return DoLoadImages(process, remote_files, nullptr, errors);
+}
+
+std::vector<uint32_t> Platform::LoadImagesUsingPaths(
+    lldb_private::Process *process,
+    const std::vector<lldb_private::FileSpec> &library_names,
+    const std::vector<std::string> &paths,
+    std::vector<lldb_private::Status> &errors) {
+  std::vector<FileSpec> files_to_use;
+  files_to_use.reserve(library_names.size());
+  for (const FileSpec &library_name : library_names) {
+    if (library_name.IsAbsolute())
+      files_to_use.emplace_back(library_name.GetFilename().GetStringRef(),
+                                false, library_name.GetPathStyle());
+    else
+      files_to_use.push_back(library_name);
+  }
+  return DoLoadImages(process, files_to_use, &paths, errors);
+}
+
+std::vector<uint32_t>
+Platform::DoLoadImages(lldb_private::Process *process,
+                       const std::vector<lldb_private::FileSpec> &remote_files,
+                       const std::vector<std::string> *paths,
+                       std::vector<lldb_private::Status> &errors) {
+  std::vector<uint32_t> tokens;
+  errors.assign(remote_files.size(), Status());
+  for (size_t i = 0; i < remote_files.size(); ++i)
+    tokens.push_back(DoLoadImage(process, remote_files[i], paths, errors[i]));
+  return tokens;
+}
+
 Status Platform::UnloadImage(lldb_private::Process *process,
                              uint32_t image_token) {
   return Status("UnloadImage is not supported on the current platform");
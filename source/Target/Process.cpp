@@ -25,6 +25,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Expression/DiagnosticManager.h"
@@ -43,6 +44,7 @@
 #include "lldb/Interpreter/OptionArgParser.h"
 #include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/CPPLanguageRuntime.h"
@@ -143,12 +145,20 @@ static constexpr PropertyDefinition g_properties[] = {
      {}, "If true, detach will attempt to keep the process stopped."},
     {"memory-cache-line-size", OptionValue::eTypeUInt64, false, 512, nullptr,
      {}, "The memory cache line size"},
+    {"memory-cache-prefetch-size", OptionValue::eTypeUInt64, false, 8192,
+     nullptr, {}, "The most bytes the memory cache reads at once when it sees "
+                  "memory being read in order.  Set it to the memory cache "
+                  "line size or less to turn read-ahead off."},
     {"optimization-warnings", OptionValue::eTypeBoolean, false, true, nullptr,
      {}, "If true, warn when stopped in code that is optimized where "
          "stepping and variable availability may not behave as expected."},
     {"stop-on-exec", OptionValue::eTypeBoolean, true, true,
      nullptr, {},
-     "If true, stop when a shared library is loaded or unloaded."}};
+     "If true, stop when a shared library is loaded or unloaded."},
+    {"read-text-from-object-files", OptionValue::eTypeBoolean, false, true,
+     nullptr, {}, "If true, read-only code in loaded modules is read from "
+                  "the module's object file instead of the process, as long "
+                  "as samples of it match what is in the process."}};
 
 enum {
   ePropertyDisableMemCache,
@@ -159,8 +169,10 @@ enum {
   ePropertyStopOnSharedLibraryEvents,
   ePropertyDetachKeepsStopped,
   ePropertyMemCacheLineSize,
+  ePropertyMemCachePrefetchSize,
   ePropertyWarningOptimization,
-  ePropertyStopOnExec
+  ePropertyStopOnExec,
+  ePropertyReadTextFromObjectFiles
 };
 
 ProcessProperties::ProcessProperties(lldb_private::Process *process)
@@ -205,6 +217,12 @@ uint64_t ProcessProperties::GetMemoryCacheLineSize() const {
       nullptr, idx, g_properties[idx].default_uint_value);
 }
 
+uint64_t ProcessProperties::GetMemoryCachePrefetchSize() const {
+  const uint32_t idx = ePropertyMemCachePrefetchSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
 Args ProcessProperties::GetExtraStartupCommands() const {
   Args args;
   const uint32_t idx = ePropertyExtraStartCommand;
@@ -283,6 +301,12 @@ bool ProcessProperties::GetStopOnExec() const {
       nullptr, idx, g_properties[idx].default_uint_value != 0);
 }
 
+bool ProcessProperties::GetReadTextFromObjectFiles() const {
+  const uint32_t idx = ePropertyReadTextFromObjectFiles;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
 void ProcessInstanceInfo::Dump(Stream &s, Platform *platform) const {
   const char *cstr;
   if (m_pid != LLDB_INVALID_PROCESS_ID)
@@ -745,6 +769,8 @@ Process::Process(lldb::TargetSP target_sp, ListenerSP listener_sp,
       m_stdin_forward(false), m_stdout_data(), m_stderr_data(),
       m_profile_data_comm_mutex(), m_profile_data(), m_iohandler_sync(0),
       m_memory_cache(*this), m_allocated_memory_cache(*this),
+      m_object_file_text(), m_object_file_text_mutex(),
+      m_object_file_text_reads(0),
       m_should_detach(false), m_next_event_action_ap(), m_public_run_lock(),
       m_private_run_lock(), m_finalizing(false), m_finalize_called(false),
       m_clear_thread_plans_on_stop(false), m_force_next_event_delivery(false),
@@ -2044,6 +2070,7 @@ Process::CreateBreakpointSite(const BreakpointLocationSP &owner,
     if (bp_site_sp) {
       bp_site_sp->AddOwner(owner);
       owner->SetBreakpointSite(bp_site_sp);
+      UpdateBreakpointSiteConditions(bp_site_sp.get());
       return bp_site_sp->GetID();
     } else {
       bp_site_sp.reset(new BreakpointSite(&m_breakpoint_site_list, owner,
@@ -2070,6 +2097,19 @@ Process::CreateBreakpointSite(const BreakpointLocationSP &owner,
   return LLDB_INVALID_BREAK_ID;
 }
 
+Status Process::GetTracepointRecords(std::vector<TracepointRecord> &records,
+                                     uint64_t &num_dropped) {
+  num_dropped = 0;
+  Status error = DoGetTracepointRecords(records, num_dropped);
+
+  std::vector<uint8_t> data;
+  m_tracepoint_buffer.Drain(SIZE_MAX, data);
+  num_dropped += m_tracepoint_buffer.TakeNumDropped();
+  if (!TracepointBuffer::Decode(data, records) && error.Success())
+    error.SetErrorString("malformed tracepoint records");
+  return error;
+}
+
 void Process::RemoveOwnerFromBreakpointSite(lldb::user_id_t owner_id,
                                             lldb::user_id_t owner_loc_id,
                                             BreakpointSiteSP &bp_site_sp) {
@@ -2079,6 +2119,8 @@ void Process::RemoveOwnerFromBreakpointSite(lldb::user_id_t owner_id,
     if (IsAlive())
       DisableBreakpointSite(bp_site_sp.get());
     m_breakpoint_site_list.RemoveByAddress(bp_site_sp->GetLoadAddress());
+  } else if (IsAlive()) {
+    UpdateBreakpointSiteConditions(bp_site_sp.get());
   }
 }
 
@@ -2291,6 +2333,9 @@ Status Process::DisableSoftwareBreakpoint(BreakpointSite *bp_site) {
 
 size_t Process::ReadMemory(addr_t addr, void *buf, size_t size, Status &error) {
   error.Clear();
+  if (size_t bytes_read = ReadMemoryFromObjectFileText(addr, buf, size))
+    return bytes_read;
+
   if (!GetDisableMemoryCache()) {
 #if defined(VERIFY_MEMORY_READS)
     // Memory caching is enabled, with debug verification
@@ -2330,6 +2375,120 @@ size_t Process::ReadMemory(addr_t addr, void *buf, size_t size, Status &error) {
   }
 }
 
+void Process::AddObjectFileText(const SectionList &sections) {
+  const size_t num_sections = sections.GetSize();
+  for (size_t i = 0; i < num_sections; ++i) {
+    SectionSP section_sp = sections.GetSectionAtIndex(i);
+    if (!section_sp)
+      continue;
+    // Use the sections inside segments, the segments can hold data that the
+    // loader changes.
+    if (section_sp->GetChildren().GetSize() > 0) {
+      AddObjectFileText(section_sp->GetChildren());
+      continue;
+    }
+    const uint32_t permissions = section_sp->GetPermissions();
+    if (section_sp->GetType() != eSectionTypeCode ||
+        (permissions & ePermissionsExecutable) == 0 ||
+        (permissions & ePermissionsWritable) != 0 ||
+        section_sp->IsEncrypted() || section_sp->IsThreadSpecific() ||
+        section_sp->GetByteSize() == 0 ||
+        section_sp->GetFileSize() < section_sp->GetByteSize())
+      continue;
+    const addr_t load_addr = section_sp->GetLoadBaseAddress(&GetTarget());
+    if (load_addr == LLDB_INVALID_ADDRESS)
+      continue;
+    ObjectFileText &text = m_object_file_text[load_addr];
+    text.end = load_addr + section_sp->GetByteSize();
+    text.section_wp = section_sp;
+    text.matches_process = eLazyBoolCalculate;
+  }
+}
+
+size_t Process::ReadMemoryFromObjectFileText(addr_t addr, void *buf,
+                                             size_t size) {
+  if (buf == nullptr || size == 0)
+    return 0;
+
+  std::lock_guard<std::mutex> guard(m_object_file_text_mutex);
+  auto pos = m_object_file_text.upper_bound(addr);
+  if (pos == m_object_file_text.begin())
+    return 0;
+  --pos;
+  const addr_t base = pos->first;
+  ObjectFileText &text = pos->second;
+  if (addr + size > text.end || addr + size < addr)
+    return 0;
+
+  // The module may have been unloaded or slid since we saw it load.
+  SectionSP section_sp = text.section_wp.lock();
+  if (!section_sp || section_sp->GetLoadBaseAddress(&GetTarget()) != base) {
+    m_object_file_text.erase(pos);
+    return 0;
+  }
+  if (!GetReadTextFromObjectFiles())
+    return 0;
+
+  // Check once per load, the first time the section is read, so modules
+  // nobody looks at cost nothing.
+  if (text.matches_process == eLazyBoolCalculate)
+    text.matches_process =
+        ObjectFileTextMatchesProcess(*section_sp, base, text.end)
+            ? eLazyBoolYes
+            : eLazyBoolNo;
+  if (text.matches_process != eLazyBoolYes)
+    return 0;
+
+  ObjectFile *objfile = section_sp->GetObjectFile();
+  if (!objfile ||
+      objfile->ReadSectionData(section_sp.get(), addr - base, buf, size) !=
+          size)
+    return 0;
+  ++m_object_file_text_reads;
+  return size;
+}
+
+bool Process::ObjectFileTextMatchesProcess(Section &section, addr_t base,
+                                           addr_t end) {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+  ObjectFile *objfile = section.GetObjectFile();
+  if (!objfile || objfile->IsInMemory())
+    return false;
+
+  // Compare a page at the start, middle and end of the section.  Code the
+  // loader or a debugger before us rewrote, or a file that isn't the one
+  // that was loaded, shows up in at least one of them.
+  const addr_t page_size = 4096;
+  const addr_t sample_addrs[] = {
+      base, base + ((end - base) / 2 & ~(page_size - 1)),
+      end - base > page_size ? end - page_size : base};
+  std::vector<uint8_t> file_bytes(page_size);
+  std::vector<uint8_t> process_bytes(page_size);
+  for (addr_t sample_addr : sample_addrs) {
+    const size_t sample_size = std::min<addr_t>(page_size, end - sample_addr);
+    Status error;
+    if (objfile->ReadSectionData(&section, sample_addr - base,
+                                 file_bytes.data(),
+                                 sample_size) != sample_size ||
+        ReadMemoryFromInferior(sample_addr, process_bytes.data(), sample_size,
+                               error) != sample_size ||
+        memcmp(file_bytes.data(), process_bytes.data(), sample_size) != 0) {
+      if (log)
+        log->Printf("Process::%s section %s at 0x%" PRIx64
+                    " doesn't match the process at 0x%" PRIx64,
+                    __FUNCTION__, section.GetName().AsCString("<unnamed>"),
+                    base, sample_addr);
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t Process::GetObjectFileTextReadCount() {
+  std::lock_guard<std::mutex> guard(m_object_file_text_mutex);
+  return m_object_file_text_reads;
+}
+
 size_t Process::ReadCStringFromMemory(addr_t addr, std::string &out_str,
                                       Status &error) {
   char buf[256];
@@ -2540,6 +2699,18 @@ size_t Process::WriteMemory(addr_t addr, const void *buf, size_t size,
   if (buf == nullptr || size == 0)
     return 0;
 
+  // Code we write over no longer matches its object file.
+  {
+    std::lock_guard<std::mutex> guard(m_object_file_text_mutex);
+    auto pos = m_object_file_text.upper_bound(addr + size - 1);
+    while (pos != m_object_file_text.begin()) {
+      --pos;
+      if (pos->second.end <= addr)
+        break;
+      pos->second.matches_process = eLazyBoolNo;
+    }
+  }
+
   m_mod_id.BumpMemoryID();
 
   // We need to write any data that would go where any current software traps
@@ -5944,6 +6115,10 @@ void Process::DidExec() {
   m_instrumentation_runtimes.clear();
   m_thread_list.DiscardThreadPlans();
   m_memory_cache.Clear(true);
+  {
+    std::lock_guard<std::mutex> guard(m_object_file_text_mutex);
+    m_object_file_text.clear();
+  }
   DoDidExec();
   CompleteAttach();
   // Flush the process (threads and all stack frames) after running
@@ -5985,6 +6160,18 @@ addr_t Process::ResolveIndirectFunction(const Address *address, Status &error) {
 }
 
 void Process::ModulesDidLoad(ModuleList &module_list) {
+  if (GetReadTextFromObjectFiles()) {
+    std::lock_guard<std::mutex> guard(m_object_file_text_mutex);
+    const size_t num_modules = module_list.GetSize();
+    for (size_t i = 0; i < num_modules; ++i) {
+      ModuleSP module_sp = module_list.GetModuleAtIndex(i);
+      if (!module_sp)
+        continue;
+      if (SectionList *sections = module_sp->GetSectionList())
+        AddObjectFileText(*sections);
+    }
+  }
+
   SystemRuntime *sys_runtime = GetSystemRuntime();
   if (sys_runtime) {
     sys_runtime->ModulesDidLoad(module_list);
@@ -337,6 +337,15 @@ Status RegisterContext::ReadRegisterValueFromMemory(
 
   ProcessSP process_sp(m_thread.GetProcess());
   if (process_sp) {
+    // Use the process's own copy of the memory if it will share it, which
+    // saves a copy for every register the unwinder restores from a core.
+    DataExtractor shared_data;
+    if (process_sp->GetSharedMemoryData(src_addr, src_len, shared_data)) {
+      reg_value.SetFromMemoryData(reg_info, shared_data.GetDataStart(),
+                                  src_len, process_sp->GetByteOrder(), error);
+      return error;
+    }
+
     uint8_t src[RegisterValue::kMaxRegisterByteSize];
 
     // Read the memory
@@ -465,6 +465,17 @@ protected:
               }
             }
 
+            // A tracepoint records the hit and carries on.  If the stub
+            // records its hits itself, we only got here because another
+            // location at this site stopped, and there is nothing to do.
+            if (bp_loc_sp->IsTracepoint()) {
+              if (log)
+                log->Printf("Collected tracepoint %s, continuing.",
+                            loc_desc.GetData());
+              bp_loc_sp->CollectTracepoint(exe_ctx);
+              continue;
+            }
+
             // Check the auto-continue bit on the location, do this before the
             // callback since it may change this, but that would be for the
             // NEXT hit.  Note, you might think you could check auto-continue
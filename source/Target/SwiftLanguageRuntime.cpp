@@ -209,6 +209,12 @@ void SwiftLanguageRuntime::SetupExclusivity() {
 }
 
 void SwiftLanguageRuntime::ModulesDidLoad(const ModuleList &module_list) {
+  // A newly loaded image may have been mapped where the metadata of an
+  // unloaded one used to live.
+  {
+    std::lock_guard<std::mutex> lock(m_dynamic_types_mutex);
+    m_dynamic_types.clear();
+  }
   module_list.ForEach([&](const ModuleSP &module_sp) -> bool {
   auto *obj_file = module_sp->GetObjectFile();
     if (!obj_file)
@@ -1404,6 +1410,22 @@ SwiftLanguageRuntime::GetRemoteASTContext(SwiftASTContext &swift_ast_ctx) {
 void SwiftLanguageRuntime::ReleaseAssociatedRemoteASTContext(
     swift::ASTContext *ctx) {
   m_remote_ast_contexts.erase(ctx);
+  // The types cached for this context are about to be freed.
+  std::lock_guard<std::mutex> lock(m_dynamic_types_mutex);
+  for (auto it = m_dynamic_types.begin(); it != m_dynamic_types.end();) {
+    if (std::get<0>(it->first) == ctx)
+      it = m_dynamic_types.erase(it);
+    else
+      ++it;
+  }
+}
+
+SwiftLanguageRuntime::DynamicTypeCacheStatistics
+SwiftLanguageRuntime::GetDynamicTypeCacheStatistics() const {
+  std::lock_guard<std::mutex> lock(m_dynamic_types_mutex);
+  DynamicTypeCacheStatistics stats = m_dynamic_types_stats;
+  stats.size = m_dynamic_types.size();
+  return stats;
 }
 
 llvm::Optional<uint64_t>
@@ -1609,6 +1631,21 @@ bool SwiftLanguageRuntime::GetDynamicTypeAndAddress_Class(
     return false;
   }
 
+  // Many instances share the same metadata; only ask RemoteAST once.
+  auto key = std::make_tuple(scratch_ctx.GetASTContext(),
+                             metadata_address.getValue());
+  {
+    std::lock_guard<std::mutex> lock(m_dynamic_types_mutex);
+    auto cached = m_dynamic_types.find(key);
+    if (cached != m_dynamic_types.end()) {
+      ++m_dynamic_types_stats.hits;
+      // The read lock must have been acquired by the caller.
+      class_type_or_name.SetCompilerType({&scratch_ctx, cached->second});
+      return true;
+    }
+    ++m_dynamic_types_stats.misses;
+  }
+
   auto instance_type =
       remote_ast.getTypeForRemoteTypeMetadata(metadata_address.getValue(),
                                               /*skipArtificial=*/true);
@@ -1621,6 +1658,11 @@ bool SwiftLanguageRuntime::GetDynamicTypeAndAddress_Class(
     return false;
   }
 
+  {
+    std::lock_guard<std::mutex> lock(m_dynamic_types_mutex);
+    m_dynamic_types.emplace(key, instance_type.getValue().getPointer());
+  }
+
   // The read lock must have been acquired by the caller.
   class_type_or_name.SetCompilerType(
       {&scratch_ctx, instance_type.getValue().getPointer()});
@@ -4272,6 +4314,39 @@ protected:
   }
 };
 
+class CommandObjectSwift_Statistics : public CommandObjectParsed {
+public:
+  CommandObjectSwift_Statistics(CommandInterpreter &interpreter)
+      : CommandObjectParsed(
+            interpreter, "statistics",
+            "Show the hit rate of the Swift runtime's dynamic type cache",
+            "language swift statistics",
+            eCommandRequiresProcess) {}
+
+  ~CommandObjectSwift_Statistics() {}
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) {
+    SwiftLanguageRuntime *runtime =
+        m_exe_ctx.GetProcessRef().GetSwiftLanguageRuntime();
+    if (!runtime) {
+      result.AppendError("no Swift language runtime in this process");
+      result.SetStatus(lldb::eReturnStatusFailed);
+      return false;
+    }
+
+    auto stats = runtime->GetDynamicTypeCacheStatistics();
+    const uint64_t lookups = stats.hits + stats.misses;
+    result.AppendMessageWithFormat(
+        "dynamic type cache: %zu entries, %" PRIu64 " hits, %" PRIu64
+        " misses (%.1f%% hit rate)\n",
+        stats.size, stats.hits, stats.misses,
+        lookups ? 100.0 * stats.hits / lookups : 0.0);
+    result.SetStatus(lldb::eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
 class CommandObjectMultiwordSwift : public CommandObjectMultiword {
 public:
   CommandObjectMultiwordSwift(CommandInterpreter &interpreter)
@@ -4283,6 +4358,8 @@ public:
                                    interpreter)));
     LoadSubCommand("refcount", CommandObjectSP(new CommandObjectSwift_RefCount(
                                    interpreter)));
+    LoadSubCommand("statistics", CommandObjectSP(new CommandObjectSwift_Statistics(
+                                     interpreter)));
   }
 
   virtual ~CommandObjectMultiwordSwift() {}
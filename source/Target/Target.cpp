@@ -9,6 +9,7 @@
 
 // C Includes
 // C++ Includes
+#include <chrono>
 #include <mutex>
 // Other libraries and framework includes
 #include "swift/Frontend/Frontend.h"
@@ -1638,10 +1639,34 @@ void Target::ModuleUpdated(const ModuleList &module_list,
   }
 }
 
+void Target::ResolveBreakpointsInLoadedModules(ModuleList &module_list,
+                                               const char *reason) {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  const auto start = std::chrono::steady_clock::now();
+
+  // User and internal breakpoints are resolved against the whole batch of
+  // modules at once, so each lookup they have in common runs once per
+  // module.
+  m_function_lookup_cache.BeginBatch();
+  m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+  m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+  const size_t num_lookups = m_function_lookup_cache.GetNumLookups();
+  const size_t num_reused = m_function_lookup_cache.GetNumReused();
+  m_function_lookup_cache.EndBatch();
+
+  if (log) {
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    log->Printf("Target::%s: resolved breakpoints in %zu modules in %.3f ms "
+                "(%zu function lookups, %zu reused)",
+                reason, module_list.GetSize(), elapsed.count(), num_lookups,
+                num_reused);
+  }
+}
+
 void Target::ModulesDidLoad(ModuleList &module_list) {
   if (m_valid && module_list.GetSize()) {
-    m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
-    m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+    ResolveBreakpointsInLoadedModules(module_list, "ModulesDidLoad");
     if (m_process_sp) {
       m_process_sp->ModulesDidLoad(module_list);
     }
@@ -1671,8 +1696,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
       }
     }
 
-    m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
-    m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
+    ResolveBreakpointsInLoadedModules(module_list, "SymbolsDidLoad");
     BroadcastEvent(eBroadcastBitSymbolsLoaded,
                    new TargetEventData(this->shared_from_this(), module_list));
   }
@@ -2208,8 +2232,12 @@ TypeSystem *Target::GetScratchTypeSystemForLanguage(
   if (language == eLanguageTypeSwift) {
     if (SwiftASTContext *swift_ast_ctx =
             llvm::dyn_cast_or_null<SwiftASTContext>(type_system)) {
-      if (swift_ast_ctx->CheckProcessChanged() ||
-          swift_ast_ctx->HasFatalErrors()) {
+      // A new process running the same program can keep using the
+      // modules the scratch context has already imported.
+      bool needs_new_context = swift_ast_ctx->HasFatalErrors();
+      if (!needs_new_context && swift_ast_ctx->CheckProcessChanged())
+        needs_new_context = !swift_ast_ctx->AdoptCurrentProcess();
+      if (needs_new_context) {
         // If it is safe to replace the scratch context, do so. If
         // try_lock() fails, then higher stack frame (or another
         // thread) is holding a read lock to the scratch context and
@@ -3774,6 +3802,10 @@ static constexpr PropertyDefinition g_properties[] = {
      {}, "Print the fixed expression text."},
     {"save-jit-objects", OptionValue::eTypeBoolean, false, false, nullptr,
      {}, "Save intermediate object files generated by the LLVM JIT"},
+    {"expression-cache-path", OptionValue::eTypeFileSpec, false, 0, nullptr,
+     {}, "Directory in which object code compiled for expressions is kept "
+         "between debug sessions, so the same expression isn't compiled "
+         "again.  Caching is off if this is empty."},
     {"max-children-count", OptionValue::eTypeSInt64, false, 256, nullptr,
      {}, "Maximum number of children to expand in any level of depth."},
     {"max-string-summary-length", OptionValue::eTypeSInt64, false, 1024,
@@ -3811,6 +3843,10 @@ static constexpr PropertyDefinition g_properties[] = {
               "loses connection with lldb."},
     {"preload-symbols", OptionValue::eTypeBoolean, false, true, nullptr, {},
      "Enable loading of symbol tables before they are needed."},
+    {"parallel-module-load", OptionValue::eTypeBoolean, false, true, nullptr,
+     {}, "If true, when the dynamic loader reports many libraries at once, "
+         "read their object files and preload their symbols on several "
+         "threads before adding them to the target."},
     {"disable-aslr", OptionValue::eTypeBoolean, false, true, nullptr, {},
      "Disable Address Space Layout Randomization (ASLR)"},
     {"disable-stdio", OptionValue::eTypeBoolean, false, false, nullptr, {},
@@ -3912,6 +3948,7 @@ enum {
   ePropertyAutoApplyFixIts,
   ePropertyNotifyAboutFixIts,
   ePropertySaveObjects,
+  ePropertyExpressionCachePath,
   ePropertyMaxChildrenCount,
   ePropertyMaxSummaryLength,
   ePropertyMaxMemReadSize,
@@ -3925,6 +3962,7 @@ enum {
   ePropertyErrorPath,
   ePropertyDetachOnError,
   ePropertyPreloadSymbols,
+  ePropertyParallelModuleLoad,
   ePropertyDisableASLR,
   ePropertyDisableSTDIO,
   ePropertyInlineStrategy,
@@ -4029,12 +4067,24 @@ static constexpr PropertyDefinition g_experimental_properties[]{
      {}, "If true, use Clang's modern type lookup infrastructure."},
     {"swift-create-module-contexts-in-parallel", OptionValue::eTypeBoolean,
      false, true, nullptr, {},
-     "Create the per-module Swift AST contexts in parallel."}};
+     "Create the per-module Swift AST contexts in parallel."},
+    {"use-interpreter-bytecode", OptionValue::eTypeBoolean, false, true,
+     nullptr, {},
+     "If true, the IR interpreter lowers an expression to register bytecode "
+     "once and runs that, instead of walking the LLVM IR every time the "
+     "expression is evaluated."},
+    {"batch-materialization", OptionValue::eTypeBoolean, false, true, nullptr,
+     {},
+     "If true, the arguments of a JIT-compiled expression are written to the "
+     "process with a single memory write, and read back with a single read, "
+     "rather than one access per variable."}};
 
 enum {
   ePropertyInjectLocalVars = 0,
   ePropertyUseModernTypeLookup,
   ePropertySwiftCreateModuleContextsInParallel,
+  ePropertyUseInterpreterBytecode,
+  ePropertyBatchMaterialization,
 };
 
 class TargetExperimentalOptionValueProperties : public OptionValueProperties {
@@ -4170,6 +4220,30 @@ bool TargetProperties::GetSwiftCreateModuleContextsInParallel() const {
     return true;
 }
 
+bool TargetProperties::GetUseInterpreterBytecode() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyUseInterpreterBytecode, true);
+  else
+    return true;
+}
+
+bool TargetProperties::GetBatchMaterialization() const {
+  const Property *exp_property = m_collection_sp->GetPropertyAtIndex(
+      nullptr, false, ePropertyExperimental);
+  OptionValueProperties *exp_values =
+      exp_property->GetValue()->GetAsProperties();
+  if (exp_values)
+    return exp_values->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyBatchMaterialization, true);
+  else
+    return true;
+}
+
 ArchSpec TargetProperties::GetDefaultArchitecture() const {
   OptionValueArch *value = m_collection_sp->GetPropertyAtIndexAsOptionValueArch(
       nullptr, ePropertyDefaultArch);
@@ -4214,6 +4288,12 @@ void TargetProperties::SetPreloadSymbols(bool b) {
   m_collection_sp->SetPropertyAtIndexAsBoolean(nullptr, idx, b);
 }
 
+bool TargetProperties::GetParallelModuleLoad() const {
+  const uint32_t idx = ePropertyParallelModuleLoad;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetDisableASLR() const {
   const uint32_t idx = ePropertyDisableASLR;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -4401,6 +4481,11 @@ bool TargetProperties::GetEnableSaveObjects() const {
       nullptr, idx, g_properties[idx].default_uint_value != 0);
 }
 
+FileSpec TargetProperties::GetExpressionCachePath() const {
+  const uint32_t idx = ePropertyExpressionCachePath;
+  return m_collection_sp->GetPropertyAtIndexAsFileSpec(nullptr, idx);
+}
+
 bool TargetProperties::GetEnableSyntheticValue() const {
   const uint32_t idx = ePropertyEnableSynthetic;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
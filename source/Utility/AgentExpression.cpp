@@ -0,0 +1,397 @@
+//===-- AgentExpression.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+
+#include <assert.h>
+#include <inttypes.h>
+
+#include <utility>
+
+using namespace lldb;
+using namespace lldb_private;
+
+// Returns the number of operand bytes that follow \a op, or -1 if the opcode
+// isn't one we support.
+static int GetOperandSize(uint8_t op) {
+  switch (op) {
+  case AgentExpression::eOpExt:
+  case AgentExpression::eOpZeroExt:
+  case AgentExpression::eOpConst8:
+    return 1;
+  case AgentExpression::eOpIfGoto:
+  case AgentExpression::eOpGoto:
+  case AgentExpression::eOpConst16:
+  case AgentExpression::eOpReg:
+    return 2;
+  case AgentExpression::eOpConst32:
+    return 4;
+  case AgentExpression::eOpConst64:
+    return 8;
+  case AgentExpression::eOpAdd:
+  case AgentExpression::eOpSub:
+  case AgentExpression::eOpMul:
+  case AgentExpression::eOpDivSigned:
+  case AgentExpression::eOpDivUnsigned:
+  case AgentExpression::eOpRemSigned:
+  case AgentExpression::eOpRemUnsigned:
+  case AgentExpression::eOpLsh:
+  case AgentExpression::eOpRshSigned:
+  case AgentExpression::eOpRshUnsigned:
+  case AgentExpression::eOpLogNot:
+  case AgentExpression::eOpBitAnd:
+  case AgentExpression::eOpBitOr:
+  case AgentExpression::eOpBitXor:
+  case AgentExpression::eOpBitNot:
+  case AgentExpression::eOpEqual:
+  case AgentExpression::eOpLessSigned:
+  case AgentExpression::eOpLessUnsigned:
+  case AgentExpression::eOpRef8:
+  case AgentExpression::eOpRef16:
+  case AgentExpression::eOpRef32:
+  case AgentExpression::eOpRef64:
+  case AgentExpression::eOpEnd:
+  case AgentExpression::eOpDup:
+  case AgentExpression::eOpPop:
+  case AgentExpression::eOpSwap:
+    return 0;
+  }
+  return -1;
+}
+
+static uint64_t ReadBigEndian(const uint8_t *bytes, size_t byte_size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < byte_size; ++i)
+    value = (value << 8) | bytes[i];
+  return value;
+}
+
+static uint64_t SignExtend(uint64_t value, uint8_t bits) {
+  if (bits == 0 || bits >= 64)
+    return value;
+  const uint64_t sign_bit = 1ULL << (bits - 1);
+  value &= (sign_bit << 1) - 1;
+  return (value ^ sign_bit) - sign_bit;
+}
+
+static uint64_t ZeroExtend(uint64_t value, uint8_t bits) {
+  if (bits == 0 || bits >= 64)
+    return value;
+  return value & ((1ULL << bits) - 1);
+}
+
+void AgentExpression::AppendBigEndian(uint64_t value, size_t byte_size) {
+  for (size_t i = byte_size; i > 0; --i)
+    m_bytes.push_back(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+}
+
+void AgentExpression::AppendConstant(uint64_t value) {
+  if (value <= UINT8_MAX) {
+    AppendOpcode(eOpConst8);
+    AppendBigEndian(value, 1);
+  } else if (value <= UINT16_MAX) {
+    AppendOpcode(eOpConst16);
+    AppendBigEndian(value, 2);
+  } else if (value <= UINT32_MAX) {
+    AppendOpcode(eOpConst32);
+    AppendBigEndian(value, 4);
+  } else {
+    AppendOpcode(eOpConst64);
+    AppendBigEndian(value, 8);
+  }
+}
+
+void AgentExpression::AppendRegister(uint16_t reg_num) {
+  AppendOpcode(eOpReg);
+  AppendBigEndian(reg_num, 2);
+}
+
+bool AgentExpression::AppendDereference(size_t byte_size) {
+  switch (byte_size) {
+  case 1:
+    AppendOpcode(eOpRef8);
+    return true;
+  case 2:
+    AppendOpcode(eOpRef16);
+    return true;
+  case 4:
+    AppendOpcode(eOpRef32);
+    return true;
+  case 8:
+    AppendOpcode(eOpRef64);
+    return true;
+  }
+  return false;
+}
+
+void AgentExpression::AppendSignExtend(uint8_t bits) {
+  AppendOpcode(eOpExt);
+  AppendBigEndian(bits, 1);
+}
+
+void AgentExpression::AppendZeroExtend(uint8_t bits) {
+  AppendOpcode(eOpZeroExt);
+  AppendBigEndian(bits, 1);
+}
+
+size_t AgentExpression::AppendJump(Opcode op) {
+  assert((op == eOpGoto || op == eOpIfGoto) && "not a jump opcode");
+  const size_t jump_offset = m_bytes.size();
+  AppendOpcode(op);
+  AppendBigEndian(0, 2);
+  return jump_offset;
+}
+
+void AgentExpression::PatchJump(size_t jump_offset, size_t destination) {
+  assert(jump_offset + 2 < m_bytes.size() && "jump offset out of range");
+  m_bytes[jump_offset + 1] = static_cast<uint8_t>(destination >> 8);
+  m_bytes[jump_offset + 2] = static_cast<uint8_t>(destination);
+}
+
+void AgentExpression::AppendExpression(const AgentExpression &rhs) {
+  const size_t base = m_bytes.size();
+  size_t offset = 0;
+  while (offset < rhs.m_bytes.size()) {
+    const uint8_t op = rhs.m_bytes[offset];
+    const int operand_size = GetOperandSize(op);
+    assert(operand_size >= 0 && "appending malformed agent expression");
+    if (op == eOpEnd && offset + 1 == rhs.m_bytes.size())
+      break;
+    const size_t end = offset + 1 + operand_size;
+    m_bytes.insert(m_bytes.end(), rhs.m_bytes.begin() + offset,
+                   rhs.m_bytes.begin() + end);
+    if (op == eOpGoto || op == eOpIfGoto) {
+      const size_t destination =
+          ReadBigEndian(&rhs.m_bytes[offset + 1], 2) + base;
+      PatchJump(base + offset, destination);
+    }
+    offset = end;
+  }
+}
+
+Status AgentExpression::Evaluate(Context &context, uint64_t &result) const {
+  Status error;
+  uint64_t stack[kMaxStackDepth];
+  size_t depth = 0;
+  size_t pc = 0;
+
+  for (size_t steps = 0; steps < kMaxSteps; ++steps) {
+    if (pc >= m_bytes.size()) {
+      error.SetErrorString("agent expression ran past its end");
+      return error;
+    }
+
+    const uint8_t op = m_bytes[pc];
+    const int operand_size = GetOperandSize(op);
+    if (operand_size < 0) {
+      error.SetErrorStringWithFormat("unsupported agent expression opcode "
+                                     "0x%2.2x",
+                                     op);
+      return error;
+    }
+    if (pc + 1 + operand_size > m_bytes.size()) {
+      error.SetErrorString("truncated agent expression operand");
+      return error;
+    }
+    const uint64_t operand = ReadBigEndian(&m_bytes[pc + 1], operand_size);
+    pc += 1 + operand_size;
+
+    // Check the stack depth every opcode needs up front, so the cases below
+    // can index the stack freely.
+    size_t pops = 0;
+    size_t pushes = 0;
+    switch (op) {
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64:
+    case eOpReg:
+      pushes = 1;
+      break;
+    case eOpDup:
+      pops = 1;
+      pushes = 2;
+      break;
+    case eOpEnd:
+    case eOpIfGoto:
+    case eOpPop:
+      pops = 1;
+      break;
+    case eOpGoto:
+      break;
+    case eOpExt:
+    case eOpZeroExt:
+    case eOpLogNot:
+    case eOpBitNot:
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64:
+      pops = 1;
+      pushes = 1;
+      break;
+    case eOpSwap:
+      pops = 2;
+      pushes = 2;
+      break;
+    default:
+      pops = 2;
+      pushes = 1;
+      break;
+    }
+    if (depth < pops) {
+      error.SetErrorString("agent expression stack underflow");
+      return error;
+    }
+    if (depth - pops + pushes > kMaxStackDepth) {
+      error.SetErrorString("agent expression stack overflow");
+      return error;
+    }
+
+    uint64_t &top = depth > 0 ? stack[depth - 1] : stack[0];
+    switch (op) {
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64:
+      stack[depth++] = operand;
+      break;
+
+    case eOpReg: {
+      uint64_t value = 0;
+      if (!context.ReadRegister(operand, value)) {
+        error.SetErrorStringWithFormat("failed to read register %u",
+                                       static_cast<uint32_t>(operand));
+        return error;
+      }
+      stack[depth++] = value;
+    } break;
+
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64: {
+      const size_t byte_size = 1U << (op - eOpRef8);
+      uint64_t value = 0;
+      if (!context.ReadUnsigned(top, byte_size, value)) {
+        error.SetErrorStringWithFormat("failed to read %zu bytes at 0x%" PRIx64,
+                                       byte_size, top);
+        return error;
+      }
+      top = value;
+    } break;
+
+    case eOpExt:
+      top = SignExtend(top, operand);
+      break;
+    case eOpZeroExt:
+      top = ZeroExtend(top, operand);
+      break;
+    case eOpLogNot:
+      top = top == 0;
+      break;
+    case eOpBitNot:
+      top = ~top;
+      break;
+
+    case eOpDup:
+      stack[depth] = top;
+      ++depth;
+      break;
+    case eOpPop:
+      --depth;
+      break;
+    case eOpSwap:
+      std::swap(stack[depth - 1], stack[depth - 2]);
+      break;
+
+    case eOpGoto:
+      pc = operand;
+      break;
+    case eOpIfGoto:
+      if (stack[--depth] != 0)
+        pc = operand;
+      break;
+
+    case eOpEnd:
+      result = top;
+      return error;
+
+    default: {
+      // Binary operators: "a b op" computes "a op b".
+      const uint64_t b = stack[--depth];
+      uint64_t &a = stack[depth - 1];
+      switch (op) {
+      case eOpAdd:
+        a += b;
+        break;
+      case eOpSub:
+        a -= b;
+        break;
+      case eOpMul:
+        a *= b;
+        break;
+      case eOpDivSigned:
+      case eOpDivUnsigned:
+      case eOpRemSigned:
+      case eOpRemUnsigned:
+        if (b == 0) {
+          error.SetErrorString("division by zero in agent expression");
+          return error;
+        }
+        if (op == eOpDivUnsigned)
+          a /= b;
+        else if (op == eOpRemUnsigned)
+          a %= b;
+        else if (static_cast<int64_t>(b) == -1)
+          // INT64_MIN / -1 overflows; the wrapped result is what the target
+          // would compute.
+          a = op == eOpDivSigned ? 0 - a : 0;
+        else if (op == eOpDivSigned)
+          a = static_cast<uint64_t>(static_cast<int64_t>(a) /
+                                    static_cast<int64_t>(b));
+        else
+          a = static_cast<uint64_t>(static_cast<int64_t>(a) %
+                                    static_cast<int64_t>(b));
+        break;
+      case eOpLsh:
+        a = b < 64 ? a << b : 0;
+        break;
+      case eOpRshSigned:
+        a = static_cast<uint64_t>(static_cast<int64_t>(a) >> (b < 64 ? b : 63));
+        break;
+      case eOpRshUnsigned:
+        a = b < 64 ? a >> b : 0;
+        break;
+      case eOpBitAnd:
+        a &= b;
+        break;
+      case eOpBitOr:
+        a |= b;
+        break;
+      case eOpBitXor:
+        a ^= b;
+        break;
+      case eOpEqual:
+        a = a == b;
+        break;
+      case eOpLessSigned:
+        a = static_cast<int64_t>(a) < static_cast<int64_t>(b);
+        break;
+      case eOpLessUnsigned:
+        a = a < b;
+        break;
+      }
+    } break;
+    }
+  }
+
+  error.SetErrorString("agent expression exceeded its step limit");
+  return error;
+}
@@ -149,6 +149,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
     case 'T':
       if (PACKET_MATCHES("QThreadSuffixSupported"))
         return eServerPacketType_QThreadSuffixSupported;
+      if (PACKET_STARTS_WITH("QTracepoint:"))
+        return eServerPacketType_QTracepoint;
       break;
     }
     break;
@@ -266,6 +268,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
         return eServerPacketType_qThreadExtraInfo;
       if (PACKET_STARTS_WITH("qThreadStopInfo"))
         return eServerPacketType_qThreadStopInfo;
+      if (PACKET_STARTS_WITH("qTracepointBuffer:"))
+        return eServerPacketType_qTracepointBuffer;
       break;
 
     case 'U':
@@ -293,6 +297,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
     break;
 
   case 'j':
+    if (PACKET_MATCHES("jMemoryRegions"))
+      return eServerPacketType_jMemoryRegions;
     if (PACKET_STARTS_WITH("jModulesInfo:"))
       return eServerPacketType_jModulesInfo;
     if (PACKET_MATCHES("jSignalsInfo"))
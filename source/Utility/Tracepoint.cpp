@@ -0,0 +1,202 @@
+//===-- Tracepoint.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/Tracepoint.h"
+
+using namespace lldb_private;
+
+static constexpr size_t kRecordHeaderSize = 4 + 8 + 8 + 8 + 4;
+static constexpr uint32_t kNotCollected = UINT32_MAX;
+
+static void PutLittleEndian(std::vector<uint8_t> &data, uint64_t value,
+                            size_t byte_size) {
+  for (size_t i = 0; i < byte_size; ++i)
+    data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+static bool GetLittleEndian(llvm::ArrayRef<uint8_t> &data, size_t byte_size,
+                            uint64_t &value) {
+  if (data.size() < byte_size)
+    return false;
+  value = 0;
+  for (size_t i = 0; i < byte_size; ++i)
+    value |= static_cast<uint64_t>(data[i]) << (i * 8);
+  data = data.drop_front(byte_size);
+  return true;
+}
+
+bool TracepointSpec::ShouldCollect(AgentExpression::Context &context) const {
+  if (condition.IsEmpty())
+    return true;
+  uint64_t result = 0;
+  return condition.Evaluate(context, result).Fail() || result != 0;
+}
+
+void TracepointSpec::Collect(TracepointContext &context,
+                             TracepointRecord &record) const {
+  record.values.clear();
+  record.values.resize(actions.size());
+  for (size_t i = 0; i < actions.size(); ++i) {
+    const TracepointAction &action = actions[i];
+    TracepointRecord::Value &value = record.values[i];
+    switch (action.kind) {
+    case TracepointAction::eKindRegister:
+      value.collected = context.ReadRegisterBytes(action.reg_num, value.bytes);
+      break;
+
+    case TracepointAction::eKindValue: {
+      uint64_t result = 0;
+      if (action.size == 0 || action.size > sizeof(result) ||
+          action.expr.Evaluate(context, result).Fail())
+        break;
+      value.bytes.resize(action.size);
+      const bool big_endian = context.GetByteOrder() == lldb::eByteOrderBig;
+      for (uint32_t byte = 0; byte < action.size; ++byte) {
+        const uint32_t index = big_endian ? action.size - 1 - byte : byte;
+        value.bytes[index] = static_cast<uint8_t>(result >> (byte * 8));
+      }
+      value.collected = true;
+      break;
+    }
+
+    case TracepointAction::eKindMemory: {
+      uint64_t addr = 0;
+      if (action.size == 0 || action.size > TracepointAction::kMaxMemorySize ||
+          action.expr.Evaluate(context, addr).Fail())
+        break;
+      value.collected = context.ReadMemory(addr, action.size, value.bytes);
+      break;
+    }
+    }
+    if (!value.collected)
+      value.bytes.clear();
+  }
+}
+
+void TracepointBuffer::Encode(const TracepointRecord &record,
+                              std::vector<uint8_t> &data) {
+  const size_t start = data.size();
+  PutLittleEndian(data, 0, 4); // Patched below.
+  PutLittleEndian(data, record.id, 8);
+  PutLittleEndian(data, record.tid, 8);
+  PutLittleEndian(data, record.pc, 8);
+  PutLittleEndian(data, record.values.size(), 4);
+  for (const TracepointRecord::Value &value : record.values) {
+    if (!value.collected) {
+      PutLittleEndian(data, kNotCollected, 4);
+      continue;
+    }
+    PutLittleEndian(data, value.bytes.size(), 4);
+    data.insert(data.end(), value.bytes.begin(), value.bytes.end());
+  }
+
+  const uint64_t record_size = data.size() - start;
+  for (size_t i = 0; i < 4; ++i)
+    data[start + i] = static_cast<uint8_t>(record_size >> (i * 8));
+}
+
+bool TracepointBuffer::Decode(llvm::ArrayRef<uint8_t> data,
+                              std::vector<TracepointRecord> &records) {
+  while (!data.empty()) {
+    uint64_t record_size = 0;
+    llvm::ArrayRef<uint8_t> header = data;
+    if (!GetLittleEndian(header, 4, record_size) ||
+        record_size < kRecordHeaderSize || record_size > data.size())
+      return false;
+    llvm::ArrayRef<uint8_t> record_data =
+        data.slice(4, record_size - 4);
+    data = data.drop_front(record_size);
+
+    TracepointRecord record;
+    uint64_t tid = 0, pc = 0, num_values = 0;
+    GetLittleEndian(record_data, 8, record.id);
+    GetLittleEndian(record_data, 8, tid);
+    GetLittleEndian(record_data, 8, pc);
+    GetLittleEndian(record_data, 4, num_values);
+    record.tid = tid;
+    record.pc = pc;
+    // Each value takes at least its byte count.
+    if (num_values > record_data.size() / 4)
+      return false;
+    record.values.resize(num_values);
+    for (TracepointRecord::Value &value : record.values) {
+      uint64_t byte_size = 0;
+      if (!GetLittleEndian(record_data, 4, byte_size))
+        return false;
+      if (byte_size == kNotCollected)
+        continue;
+      if (byte_size > record_data.size())
+        return false;
+      value.collected = true;
+      value.bytes.assign(record_data.begin(),
+                         record_data.begin() + byte_size);
+      record_data = record_data.drop_front(byte_size);
+    }
+    if (!record_data.empty())
+      return false;
+    records.push_back(std::move(record));
+  }
+  return true;
+}
+
+void TracepointBuffer::Append(const TracepointRecord &record) {
+  std::vector<uint8_t> encoded;
+  Encode(record, encoded);
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  // Make room by dropping the oldest records.  A record that is bigger than
+  // the whole buffer is dropped itself.
+  if (encoded.size() > m_capacity) {
+    ++m_num_dropped;
+    return;
+  }
+  while (!m_records.empty() && m_num_bytes + encoded.size() > m_capacity) {
+    m_num_bytes -= m_records.front().size();
+    m_records.pop_front();
+    ++m_num_dropped;
+  }
+  m_num_bytes += encoded.size();
+  m_records.push_back(std::move(encoded));
+}
+
+size_t TracepointBuffer::Drain(size_t max_bytes, std::vector<uint8_t> &data) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  size_t num_records = 0;
+  size_t num_bytes = 0;
+  while (!m_records.empty()) {
+    const std::vector<uint8_t> &encoded = m_records.front();
+    if (num_records > 0 && num_bytes + encoded.size() > max_bytes)
+      break;
+    data.insert(data.end(), encoded.begin(), encoded.end());
+    num_bytes += encoded.size();
+    m_num_bytes -= encoded.size();
+    m_records.pop_front();
+    ++num_records;
+  }
+  return num_records;
+}
+
+uint64_t TracepointBuffer::TakeNumDropped() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const uint64_t num_dropped = m_num_dropped;
+  m_num_dropped = 0;
+  return num_dropped;
+}
+
+size_t TracepointBuffer::GetNumBytes() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_num_bytes;
+}
+
+void TracepointBuffer::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_records.clear();
+  m_num_bytes = 0;
+  m_num_dropped = 0;
+}
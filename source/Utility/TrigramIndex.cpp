@@ -0,0 +1,299 @@
+//===-- TrigramIndex.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/TrigramIndex.h"
+#include "lldb/Utility/RegularExpression.h"
+
+#include "llvm/ADT/DenseMap.h"
+
+#include <algorithm>
+
+using namespace lldb_private;
+
+uint32_t TrigramIndex::Append(llvm::StringRef name) {
+  m_names.push_back(name);
+  return m_names.size() - 1;
+}
+
+TrigramIndex::Trigram TrigramIndex::MakeTrigram(const char *chars) {
+  return (static_cast<uint8_t>(chars[0]) << 16) |
+         (static_cast<uint8_t>(chars[1]) << 8) | static_cast<uint8_t>(chars[2]);
+}
+
+void TrigramIndex::GetTrigrams(llvm::StringRef name,
+                               std::vector<Trigram> &trigrams) {
+  trigrams.clear();
+  for (size_t i = 0; i + 3 <= name.size(); ++i)
+    trigrams.push_back(MakeTrigram(name.data() + i));
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+}
+
+void TrigramIndex::Finalize() {
+  // Count the names of every trigram first, so the postings can be written
+  // straight to their place instead of sorting (trigram, ID) pairs, which
+  // took twice the memory of the index itself.
+  llvm::DenseMap<Trigram, uint32_t> counts;
+  std::vector<Trigram> trigrams;
+  for (llvm::StringRef name : m_names) {
+    GetTrigrams(name, trigrams);
+    for (Trigram trigram : trigrams)
+      ++counts[trigram];
+  }
+
+  m_trigrams.clear();
+  m_trigrams.reserve(counts.size());
+  for (const auto &entry : counts)
+    m_trigrams.push_back(entry.first);
+  std::sort(m_trigrams.begin(), m_trigrams.end());
+
+  // Turn the counts into the positions the next ID of each trigram goes
+  // to. Names are visited in ID order, so every list ends up sorted.
+  m_offsets.clear();
+  m_offsets.reserve(m_trigrams.size() + 1);
+  uint32_t num_postings = 0;
+  for (Trigram trigram : m_trigrams) {
+    m_offsets.push_back(num_postings);
+    uint32_t &count = counts[trigram];
+    num_postings += count;
+    count = m_offsets.back();
+  }
+  m_offsets.push_back(num_postings);
+
+  m_postings.clear();
+  m_postings.resize(num_postings);
+  for (uint32_t id = 0; id < m_names.size(); ++id) {
+    GetTrigrams(m_names[id], trigrams);
+    for (Trigram trigram : trigrams)
+      m_postings[counts[trigram]++] = id;
+  }
+}
+
+bool TrigramIndex::GetCandidates(llvm::ArrayRef<std::string> literals,
+                                 std::vector<uint32_t> &ids) const {
+  std::vector<Trigram> trigrams;
+  for (const std::string &literal : literals)
+    for (size_t i = 0; i + 3 <= literal.size(); ++i)
+      trigrams.push_back(MakeTrigram(literal.data() + i));
+  if (trigrams.empty())
+    return false;
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+
+  typedef llvm::ArrayRef<uint32_t> Postings;
+  std::vector<Postings> lists;
+  for (Trigram trigram : trigrams) {
+    auto pos = std::lower_bound(m_trigrams.begin(), m_trigrams.end(), trigram);
+    // A trigram no name has means nothing can match.
+    if (pos == m_trigrams.end() || *pos != trigram)
+      return true;
+    const size_t index = pos - m_trigrams.begin();
+    lists.push_back(Postings(m_postings).slice(
+        m_offsets[index], m_offsets[index + 1] - m_offsets[index]));
+  }
+
+  // Intersect the shortest lists first, so the candidates shrink as fast
+  // as possible.  Once they are much fewer than the entries of a list,
+  // looking each one up beats walking the list.
+  std::sort(lists.begin(), lists.end(),
+            [](Postings lhs, Postings rhs) { return lhs.size() < rhs.size(); });
+  ids.assign(lists.front().begin(), lists.front().end());
+  for (Postings list : llvm::makeArrayRef(lists).drop_front()) {
+    if (ids.empty())
+      break;
+    auto end = ids.begin();
+    if (list.size() > 16 * ids.size()) {
+      for (uint32_t id : ids)
+        if (std::binary_search(list.begin(), list.end(), id))
+          *end++ = id;
+    } else {
+      end = std::set_intersection(ids.begin(), ids.end(), list.begin(),
+                                  list.end(), ids.begin());
+    }
+    ids.erase(end, ids.end());
+  }
+  return true;
+}
+
+void TrigramIndex::Find(const RegularExpression &regex,
+                        std::vector<uint32_t> &ids) const {
+  std::vector<std::string> literals;
+  GetRequiredLiterals(regex.GetText(), literals);
+
+  std::vector<uint32_t> candidates;
+  if (GetCandidates(literals, candidates)) {
+    for (uint32_t id : candidates)
+      if (ContainsLiterals(m_names[id], literals) &&
+          regex.Execute(m_names[id]))
+        ids.push_back(id);
+    return;
+  }
+
+  for (uint32_t id = 0; id < m_names.size(); ++id)
+    if (ContainsLiterals(m_names[id], literals) && regex.Execute(m_names[id]))
+      ids.push_back(id);
+}
+
+bool TrigramIndex::ContainsLiterals(llvm::StringRef name,
+                                    llvm::ArrayRef<std::string> literals) {
+  for (const std::string &literal : literals)
+    if (name.find(literal) == llvm::StringRef::npos)
+      return false;
+  return true;
+}
+
+// Return the position just past the bracket expression starting at
+// regex[pos], or npos if it isn't terminated.
+static size_t SkipBracketExpression(llvm::StringRef regex, size_t pos) {
+  ++pos; // '['
+  if (pos < regex.size() && regex[pos] == '^')
+    ++pos;
+  // A ']' right at the start is part of the set.
+  if (pos < regex.size() && regex[pos] == ']')
+    ++pos;
+  while (pos < regex.size()) {
+    const char c = regex[pos];
+    if (c == ']')
+      return pos + 1;
+    if (c == '[' && pos + 1 < regex.size() &&
+        (regex[pos + 1] == ':' || regex[pos + 1] == '.' ||
+         regex[pos + 1] == '=')) {
+      // "[:alpha:]", "[.x.]" and "[=x=]" end with the same character and
+      // a ']'.
+      const char terminator[3] = {regex[pos + 1], ']', '\0'};
+      const size_t end = regex.find(terminator, pos + 2);
+      if (end == llvm::StringRef::npos)
+        return llvm::StringRef::npos;
+      pos = end + 2;
+      continue;
+    }
+    ++pos;
+  }
+  return llvm::StringRef::npos;
+}
+
+// Return the position just past the group starting at regex[pos], or npos
+// if it isn't terminated.
+static size_t SkipGroup(llvm::StringRef regex, size_t pos) {
+  int depth = 0;
+  while (pos < regex.size()) {
+    const char c = regex[pos];
+    if (c == '\\') {
+      pos += 2;
+      continue;
+    }
+    if (c == '[') {
+      pos = SkipBracketExpression(regex, pos);
+      if (pos == llvm::StringRef::npos)
+        return pos;
+      continue;
+    }
+    if (c == '(')
+      ++depth;
+    else if (c == ')' && --depth == 0)
+      return pos + 1;
+    ++pos;
+  }
+  return llvm::StringRef::npos;
+}
+
+void TrigramIndex::GetRequiredLiterals(llvm::StringRef regex,
+                                       std::vector<std::string> &literals) {
+  literals.clear();
+  std::vector<std::string> result;
+  std::string run;
+  auto end_run = [&]() {
+    if (!run.empty())
+      result.push_back(run);
+    run.clear();
+  };
+
+  size_t pos = 0;
+  while (pos < regex.size()) {
+    const char c = regex[pos];
+    switch (c) {
+    case '|':
+      // Each alternative may match without the others' literals.
+      return;
+
+    case '\\':
+      if (pos + 1 >= regex.size())
+        return;
+      // "\." is a literal '.', but other escapes can be classes, anchors
+      // like "\<" and "\`", or back references.
+      if (llvm::StringRef(".[]()*+?{}|^$\\/").find(regex[pos + 1]) !=
+          llvm::StringRef::npos)
+        run.push_back(regex[pos + 1]);
+      else
+        end_run();
+      pos += 2;
+      continue;
+
+    case '[':
+      end_run();
+      pos = SkipBracketExpression(regex, pos);
+      if (pos == llvm::StringRef::npos)
+        return;
+      continue;
+
+    case '(':
+      end_run();
+      pos = SkipGroup(regex, pos);
+      if (pos == llvm::StringRef::npos)
+        return;
+      continue;
+
+    case '*':
+    case '?':
+    case '{':
+      // The character before may be missing.
+      if (!run.empty())
+        run.pop_back();
+      end_run();
+      if (c == '{') {
+        pos = regex.find('}', pos);
+        if (pos == llvm::StringRef::npos)
+          return;
+      }
+      ++pos;
+      continue;
+
+    case '+': {
+      // The character before may repeat, so what follows it continues a
+      // new run that starts with it.
+      if (run.empty()) {
+        ++pos;
+        continue;
+      }
+      const char repeated = run.back();
+      end_run();
+      run.push_back(repeated);
+      ++pos;
+      continue;
+    }
+
+    case '.':
+    case '^':
+    case '$':
+    case ')':
+      end_run();
+      ++pos;
+      continue;
+
+    default:
+      run.push_back(c);
+      ++pos;
+      continue;
+    }
+  }
+  end_run();
+  literals.swap(result);
+}
@@ -27,10 +27,15 @@
 #include "lldb/Symbol/TypeList.h"
 #include "lldb/Symbol/VariableList.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Target/ThreadList.h"
 #include "lldb/Utility/CleanUp.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/StreamString.h"
+#include "lldb/Utility/StructuredData.h"
 
 #include "llvm/ADT/IntervalMap.h"
 #include "llvm/ADT/StringRef.h"
@@ -41,7 +46,10 @@
 #include "llvm/Support/PrettyStackTrace.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/WithColor.h"
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <mutex>
 #include <thread>
 
 using namespace lldb;
@@ -55,12 +63,15 @@ cl::SubCommand ObjectFileSubcommand("object-file",
                                     "Display LLDB object file information");
 cl::SubCommand SymbolsSubcommand("symbols", "Dump symbols for an object file");
 cl::SubCommand IRMemoryMapSubcommand("ir-memory-map", "Test IRMemoryMap");
+cl::SubCommand CoreBacktraceSubcommand(
+    "core-backtrace", "Print the backtrace of the crashed thread of cores");
 
 cl::opt<std::string> Log("log", cl::desc("Path to a log file"), cl::init(""),
                          cl::sub(BreakpointSubcommand),
                          cl::sub(ObjectFileSubcommand),
                          cl::sub(SymbolsSubcommand),
-                         cl::sub(IRMemoryMapSubcommand));
+                         cl::sub(IRMemoryMapSubcommand),
+                         cl::sub(CoreBacktraceSubcommand));
 
 /// Create a target using the file pointed to by \p Filename, or abort.
 TargetSP createTarget(Debugger &Dbg, const std::string &Filename);
@@ -203,6 +214,37 @@ bool evalFree(StringRef Line, IRMemoryMapTestState &State);
 int evaluateMemoryMapCommands(Debugger &Dbg);
 } // namespace irmemorymap
 
+namespace corebacktrace {
+static cl::list<std::string> Cores(cl::Positional, cl::desc("<core files>"),
+                                   cl::OneOrMore,
+                                   cl::sub(CoreBacktraceSubcommand));
+static cl::opt<std::string>
+    Executable("executable",
+               cl::desc("The executable the cores were created from"),
+               cl::init(""), cl::sub(CoreBacktraceSubcommand));
+static cl::opt<bool> LoadModulesOnDemand(
+    "load-modules-on-demand",
+    cl::desc("Load shared libraries only when a frame is in one of them"),
+    cl::sub(CoreBacktraceSubcommand));
+static cl::opt<bool> JSON("json",
+                          cl::desc("Print a JSON object on a line per core"),
+                          cl::sub(CoreBacktraceSubcommand));
+static cl::opt<unsigned>
+    Jobs("jobs", cl::desc("Number of cores to load at once (0 = one per CPU)"),
+         cl::init(1), cl::sub(CoreBacktraceSubcommand));
+static cl::opt<bool> Timings("timings",
+                             cl::desc("Print how long each step took"),
+                             cl::sub(CoreBacktraceSubcommand));
+
+struct CoreBacktrace {
+  std::string Text;
+  StructuredData::DictionarySP JSON;
+};
+
+static CoreBacktrace backtraceCore(Debugger &Dbg, const std::string &Core);
+static int dumpCoreBacktraces(Debugger &Dbg);
+} // namespace corebacktrace
+
 } // namespace opts
 
 template <typename... Args>
@@ -826,6 +868,174 @@ int opts::irmemorymap::evaluateMemoryMapCommands(Debugger &Dbg) {
   return 0;
 }
 
+typedef std::chrono::steady_clock Clock;
+
+static double millisecondsSince(Clock::time_point Start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - Start)
+      .count();
+}
+
+opts::corebacktrace::CoreBacktrace
+opts::corebacktrace::backtraceCore(Debugger &Dbg, const std::string &Core) {
+  CoreBacktrace Result;
+  Result.JSON = std::make_shared<StructuredData::Dictionary>();
+  Result.JSON->AddStringItem("core", Core);
+  auto Fail = [&](const std::string &Message) {
+    Result.Text = formatv("Core: {0}\nerror: {1}\n", Core, Message).str();
+    Result.JSON->AddStringItem("error", Message);
+    return Result;
+  };
+
+  // Every core gets its own target, but they all share modules through
+  // the shared module list, so each library is only parsed once.
+  Clock::time_point Start = Clock::now();
+  TargetSP Target = opts::createTarget(Dbg, Executable);
+  CleanUp DeleteTarget([&] {
+    Target->Destroy();
+    Dbg.GetTargetList().DeleteTarget(Target);
+  });
+  FileSpec CoreSpec(Core, true);
+  ProcessSP Process = Target->CreateProcess(Dbg.GetListener(), "", &CoreSpec);
+  if (!Process)
+    return Fail("no process plug-in can load the core");
+  Status ST = Process->LoadCore();
+  if (ST.Fail())
+    return Fail(ST.AsCString("unable to load the core"));
+  double LoadTime = millisecondsSince(Start);
+
+  Start = Clock::now();
+  ThreadList &Threads = Process->GetThreadList();
+  ThreadSP Crashed;
+  for (uint32_t i = 0, e = Threads.GetSize(); i < e && !Crashed; ++i) {
+    ThreadSP Thread = Threads.GetThreadAtIndex(i);
+    if (Thread->GetStopReason() != eStopReasonNone)
+      Crashed = Thread;
+  }
+  if (!Crashed)
+    return Fail("no thread in the core stopped for a reason");
+
+  lldb_private::StreamString Stream;
+  Stream.Format("Core: {0}\nthread #{1}, tid = {2:x}\n", Core,
+                Crashed->GetIndexID(), Crashed->GetID());
+  auto Frames = std::make_shared<StructuredData::Array>();
+  for (uint32_t i = 0;; ++i) {
+    StackFrameSP Frame = Crashed->GetStackFrameAtIndex(i);
+    if (!Frame)
+      break;
+    Frame->DumpUsingSettingsFormat(&Stream);
+
+    const SymbolContext &SC = Frame->GetSymbolContext(
+        eSymbolContextModule | eSymbolContextFunction | eSymbolContextBlock |
+        eSymbolContextSymbol | eSymbolContextLineEntry);
+    auto FrameJSON = std::make_shared<StructuredData::Dictionary>();
+    FrameJSON->AddIntegerItem("index", i);
+    FrameJSON->AddIntegerItem(
+        "pc", Frame->GetFrameCodeAddress().GetLoadAddress(Target.get()));
+    if (SC.module_sp)
+      FrameJSON->AddStringItem(
+          "module", SC.module_sp->GetFileSpec().GetFilename().GetStringRef());
+    if (ConstString Name = SC.GetFunctionName())
+      FrameJSON->AddStringItem("function", Name.GetStringRef());
+    if (SC.line_entry.IsValid()) {
+      FrameJSON->AddStringItem("file", SC.line_entry.file.GetPath());
+      FrameJSON->AddIntegerItem("line", SC.line_entry.line);
+    }
+    Frames->AddItem(FrameJSON);
+  }
+  double BacktraceTime = millisecondsSince(Start);
+
+  if (Timings) {
+    Stream.Format("Threads: {0}\n", Threads.GetSize());
+    Stream.Format("Modules loaded: {0}\n", Target->GetImages().GetSize());
+    Stream.Format("Core load time: {0:f3} ms\n", LoadTime);
+    Stream.Format("Backtrace time: {0:f3} ms\n", BacktraceTime);
+  }
+  Result.Text = Stream.GetString();
+
+  Result.JSON->AddIntegerItem("pid", Process->GetID());
+  Result.JSON->AddIntegerItem("tid", Crashed->GetID());
+  StopInfoSP StopInfo = Crashed->GetStopInfo();
+  if (StopInfo && StopInfo->GetDescription())
+    Result.JSON->AddStringItem("stop_reason", StopInfo->GetDescription());
+  Result.JSON->AddItem("frames", Frames);
+  Result.JSON->AddIntegerItem("threads", Threads.GetSize());
+  Result.JSON->AddIntegerItem("modules", Target->GetImages().GetSize());
+  if (Timings) {
+    Result.JSON->AddFloatItem("load_time_ms", LoadTime);
+    Result.JSON->AddFloatItem("backtrace_time_ms", BacktraceTime);
+  }
+  return Result;
+}
+
+int opts::corebacktrace::dumpCoreBacktraces(Debugger &Dbg) {
+  if (LoadModulesOnDemand) {
+    Status ST = Dbg.SetPropertyValue(
+        nullptr, eVarSetOperationAssign,
+        "plugin.process.elf-core.load-modules-on-demand", "true");
+    if (ST.Fail()) {
+      errs() << formatv("Failed to load modules on demand: {0}\n", ST);
+      return 1;
+    }
+  }
+
+  // Print the backtraces in the order the cores were given, each as soon
+  // as it and all the ones before it are done.  The workers aren't on the
+  // task pool, which the symbol file parsers use while a core is loaded.
+  std::mutex OutputMutex;
+  std::vector<std::string> Outputs(Cores.size());
+  std::vector<bool> Done(Cores.size(), false);
+  size_t NextOutput = 0;
+  std::atomic<size_t> NextCore{0};
+  std::atomic<bool> HadErrors{false};
+  auto Worker = [&] {
+    for (size_t i = NextCore++; i < Cores.size(); i = NextCore++) {
+      CoreBacktrace Result = backtraceCore(Dbg, Cores[i]);
+      if (Result.JSON->HasKey("error"))
+        HadErrors = true;
+      lldb_private::StreamString Stream;
+      if (JSON) {
+        Result.JSON->Dump(Stream, /*pretty_print*/ false);
+        Stream.PutChar('\n');
+      } else {
+        Stream.PutCString(Result.Text);
+      }
+      std::lock_guard<std::mutex> Lock(OutputMutex);
+      Outputs[i] = Stream.GetString();
+      Done[i] = true;
+      for (; NextOutput < Cores.size() && Done[NextOutput]; ++NextOutput) {
+        outs() << Outputs[NextOutput];
+        Outputs[NextOutput].clear();
+      }
+      outs().flush();
+    }
+  };
+
+  Clock::time_point Start = Clock::now();
+  unsigned NumJobs = Jobs ? Jobs : std::thread::hardware_concurrency();
+  NumJobs = std::max(1u, std::min<unsigned>(NumJobs, Cores.size()));
+  std::vector<std::thread> Workers;
+  for (unsigned i = 1; i < NumJobs; ++i)
+    Workers.emplace_back(Worker);
+  Worker();
+  for (std::thread &Thread : Workers)
+    Thread.join();
+  double TotalTime = millisecondsSince(Start);
+
+  if (Timings && Cores.size() > 1) {
+    lldb_private::StreamString Stream;
+    Stream.Format("Cores: {0}\n", Cores.size());
+    Stream.Format("Jobs: {0}\n", NumJobs);
+    Stream.Format("Total time: {0:f3} ms\n", TotalTime);
+    Stream.Format("Throughput: {0:f1} cores/minute\n",
+                  Cores.size() * 60000.0 / TotalTime);
+    if (JSON)
+      errs() << Stream.GetString();
+    else
+      outs() << Stream.GetString();
+  }
+  return HadErrors ? 1 : 0;
+}
+
 int main(int argc, const char *argv[]) {
   StringRef ToolName = argv[0];
   sys::PrintStackTraceOnErrorSignal(ToolName);
@@ -852,6 +1062,8 @@ int main(int argc, const char *argv[]) {
     return opts::symbols::dumpSymbols(*Dbg);
   if (opts::IRMemoryMapSubcommand)
     return opts::irmemorymap::evaluateMemoryMapCommands(*Dbg);
+  if (opts::CoreBacktraceSubcommand)
+    return opts::corebacktrace::dumpCoreBacktraces(*Dbg);
 
   WithColor::error() << "No command specified.\n";
   return 1;
@@ -0,0 +1,79 @@
+//===-- StringPrinterTests.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/DataFormatters/StringPrinter.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/StreamString.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+static std::string Dump(llvm::StringRef input, bool escape = true,
+                        bool zero_is_terminator = true) {
+  DataExtractor data(input.data(), input.size(), eByteOrderLittle, 8);
+  StreamString stream;
+  StringPrinter::ReadBufferAndDumpToStreamOptions options;
+  options.SetData(data);
+  options.SetStream(&stream);
+  options.SetSourceSize(input.size());
+  options.SetEscapeNonPrintables(escape);
+  options.SetBinaryZeroIsTerminator(zero_is_terminator);
+  StringPrinter::ReadBufferAndDumpToStream<
+      StringPrinter::StringElementType::UTF8>(options);
+  return stream.GetString();
+}
+
+TEST(StringPrinterTests, PlainASCII) {
+  EXPECT_EQ("\"\"", Dump(""));
+  EXPECT_EQ("\"a\"", Dump("a"));
+  EXPECT_EQ("\"hello, world\"", Dump("hello, world"));
+  // Long enough to go through the wide scanning loops and the tail.
+  std::string long_str(1000, 'x');
+  long_str += "abc";
+  EXPECT_EQ("\"" + long_str + "\"", Dump(long_str));
+}
+
+TEST(StringPrinterTests, Escapes) {
+  EXPECT_EQ(R"("a\"b")", Dump("a\"b"));
+  EXPECT_EQ(R"("a\\b")", Dump("a\\b"));
+  EXPECT_EQ(R"("it's")", Dump("it's"));
+  EXPECT_EQ(R"("\n\t\r")", Dump("\n\t\r"));
+  EXPECT_EQ(R"("\x01\x7f")", Dump("\x01\x7f"));
+
+  // Characters that need escaping at every offset of a long run.
+  for (size_t i = 0; i < 40; ++i) {
+    std::string input(40, 'z');
+    input[i] = '\n';
+    std::string expected = "\"" + std::string(i, 'z') + "\\n" +
+                           std::string(39 - i, 'z') + "\"";
+    EXPECT_EQ(expected, Dump(input)) << "escape at offset " << i;
+  }
+}
+
+TEST(StringPrinterTests, UTF8) {
+  EXPECT_EQ("\"caf\xc3\xa9 au lait\"", Dump("caf\xc3\xa9 au lait"));
+  EXPECT_EQ("\"\xe2\x82\xac" "100\"", Dump("\xe2\x82\xac" "100"));
+  EXPECT_EQ(R"("\U00002028")", Dump("\xe2\x80\xa8"));
+}
+
+TEST(StringPrinterTests, Terminator) {
+  llvm::StringRef with_nul("abc\0def", 7);
+  EXPECT_EQ("\"abc\"", Dump(with_nul));
+  EXPECT_EQ("\"abc\"", Dump(with_nul, /*escape*/ false));
+  EXPECT_EQ(R"("abc\0def")",
+            Dump(with_nul, /*escape*/ true, /*zero_is_terminator*/ false));
+}
+
+TEST(StringPrinterTests, NoEscaping) {
+  EXPECT_EQ("\"a\"b\\c\nd\"", Dump("a\"b\\c\nd", /*escape*/ false));
+}
@@ -2,6 +2,11 @@
 
 #include "lldb/Host/TaskPool.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
 using namespace lldb_private;
 
 TEST(TaskPoolTest, AddTask) {
@@ -43,3 +48,118 @@ TEST(TaskPoolTest, TaskMap) {
   ASSERT_EQ(data[2], 4);
   ASSERT_EQ(data[3], 9);
 }
+
+TEST(TaskPoolTest, NestedTaskMap) {
+  // More outer tasks than there are workers, each of which waits on a map of
+  // its own.
+  const size_t outer = 4 * GetHardwareConcurrencyHint();
+  std::atomic<size_t> count(0);
+  TaskMapOverInt(0, outer, [&count](size_t) {
+    TaskMapOverInt(0, 16, [&count](size_t) { ++count; });
+  });
+
+  ASSERT_EQ(outer * 16, count);
+}
+
+TEST(TaskPoolTest, TaskGroup) {
+  std::atomic<size_t> count(0);
+  TaskGroup group(TaskPriority::High);
+  for (size_t i = 0; i < 64; ++i) {
+    group.Add([&count]() {
+      TaskGroup inner;
+      for (size_t j = 0; j < 8; ++j)
+        inner.Add([&count]() { ++count; });
+      inner.Wait();
+    });
+  }
+  group.Wait();
+
+  ASSERT_EQ(64u * 8u, count);
+}
+
+TEST(TaskPoolTest, WaitOnlyHelpsOwnGroup) {
+  const std::thread::id waiter = std::this_thread::get_id();
+  std::atomic<bool> other_ran_on_waiter(false);
+  TaskGroup other(TaskPriority::Low);
+  for (size_t i = 0; i < 1024; ++i)
+    other.Add([&]() {
+      if (std::this_thread::get_id() == waiter)
+        other_ran_on_waiter = true;
+    });
+
+  // Keep the group busy on a worker for a while, with nothing of its own
+  // left for the waiter to run.
+  std::atomic<bool> started(false);
+  std::atomic<size_t> count(0);
+  TaskGroup group(TaskPriority::High);
+  group.Add([&started, &count]() {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    TaskMapOverInt(0, 64, [&count](size_t) { ++count; });
+  });
+  while (!started)
+    std::this_thread::yield();
+  group.Wait();
+
+  ASSERT_EQ(64u, count);
+  ASSERT_FALSE(other_ran_on_waiter);
+  other.Wait();
+}
+
+TEST(TaskPoolTest, Cancel) {
+  // Keep every worker busy so that the group's tasks stay queued.
+  const size_t num_workers = GetHardwareConcurrencyHint();
+  std::atomic<size_t> started(0);
+  std::atomic<bool> release(false);
+  TaskGroup blockers(TaskPriority::High);
+  for (size_t i = 0; i < num_workers; ++i)
+    blockers.Add([&started, &release]() {
+      ++started;
+      while (!release)
+        std::this_thread::yield();
+    });
+  while (started < num_workers)
+    std::this_thread::yield();
+
+  CancellationToken token;
+  std::atomic<size_t> ran(0);
+  TaskGroup group(TaskPriority::Low, token);
+  for (size_t i = 0; i < 64; ++i)
+    group.Add([&ran]() { ++ran; });
+  token.Cancel();
+  group.Add([&ran]() { ++ran; });
+  release = true;
+  group.Wait();
+  blockers.Wait();
+
+  ASSERT_TRUE(group.GetCancellationToken().IsCancelled());
+  ASSERT_EQ(0u, ran);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare a flat map with a
+// nested one of the same size on this machine.
+TEST(TaskPoolTest, DISABLED_ScalingBenchmark) {
+  const size_t outer = 64, inner = 4096;
+  auto work = [](size_t i) {
+    volatile size_t x = i;
+    for (size_t j = 0; j < 1000; ++j)
+      x = x * 31 + j;
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  TaskMapOverInt(0, outer * inner, work);
+  auto flat = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  TaskMapOverInt(0, outer, [&](size_t i) {
+    TaskMapOverInt(0, inner, [&](size_t j) { work(i * inner + j); });
+  });
+  auto nested = std::chrono::steady_clock::now() - start;
+
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  printf("threads: %u, flat: %lld ms, nested: %lld ms\n",
+         GetHardwareConcurrencyHint(),
+         (long long)duration_cast<milliseconds>(flat).count(),
+         (long long)duration_cast<milliseconds>(nested).count());
+}
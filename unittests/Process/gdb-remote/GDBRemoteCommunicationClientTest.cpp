@@ -329,7 +329,8 @@ TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfo) {
 
   HandlePacket(server,
       "qMemoryRegionInfo:a000",
-      "start:a000;size:2000;permissions:rx;name:2f666f6f2f6261722e736f;");
+      "start:a000;size:2000;permissions:rx;name:2f666f6f2f6261722e736f;"
+      "offset:3000;");
   if (XMLDocument::XMLEnabled()) {
     // In case we have XML support, this will also do a "qXfer:memory-map".
     // Preceeded by a query for supported extensions. Pretend we don't support
@@ -343,6 +344,7 @@ TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfo) {
   EXPECT_EQ(MemoryRegionInfo::eNo, region_info.GetWritable());
   EXPECT_EQ(MemoryRegionInfo::eYes, region_info.GetExecutable());
   EXPECT_EQ("/foo/bar.so", region_info.GetName().GetStringRef());
+  EXPECT_EQ(0x3000u, region_info.GetFileOffset());
 }
 
 TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfoInvalidResponse) {
@@ -362,6 +364,45 @@ TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfoInvalidResponse) {
   EXPECT_FALSE(result.get().Success());
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegions) {
+  std::vector<MemoryRegionInfo> regions;
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    return client.GetMemoryRegions(regions);
+  });
+
+  // "}" is escaped as "}]" on the wire.
+  HandlePacket(
+      server, "jMemoryRegions",
+      R"([{"start":40960,"size":8192,"permissions":"rx",)"
+      R"("name":"/foo/bar.so","offset":12288}],)"
+      R"({"start":4096,"size":4096,"permissions":""}]])");
+  ASSERT_TRUE(result.get().Success());
+  ASSERT_EQ(2u, regions.size());
+  EXPECT_EQ(0x1000u, regions[0].GetRange().GetRangeBase());
+  EXPECT_EQ(MemoryRegionInfo::eNo, regions[0].GetReadable());
+  EXPECT_EQ(MemoryRegionInfo::eYes, regions[0].GetMapped());
+  EXPECT_EQ(LLDB_INVALID_OFFSET, regions[0].GetFileOffset());
+  EXPECT_EQ(0xa000u, regions[1].GetRange().GetRangeBase());
+  EXPECT_EQ(0x2000u, regions[1].GetRange().GetByteSize());
+  EXPECT_EQ(MemoryRegionInfo::eYes, regions[1].GetReadable());
+  EXPECT_EQ(MemoryRegionInfo::eNo, regions[1].GetWritable());
+  EXPECT_EQ(MemoryRegionInfo::eYes, regions[1].GetExecutable());
+  EXPECT_EQ("/foo/bar.so", regions[1].GetName().GetStringRef());
+  EXPECT_EQ(0x3000u, regions[1].GetFileOffset());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionsUnsupported) {
+  std::vector<MemoryRegionInfo> regions;
+  std::future<Status> result = std::async(std::launch::async, [&] {
+    return client.GetMemoryRegions(regions);
+  });
+  HandlePacket(server, "jMemoryRegions", "");
+  EXPECT_FALSE(result.get().Success());
+
+  // The client remembers and doesn't ask again.
+  EXPECT_FALSE(client.GetMemoryRegions(regions).Success());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, SendStartTracePacket) {
   TraceOptions options;
   Status error;
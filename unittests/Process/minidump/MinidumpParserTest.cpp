@@ -18,6 +18,7 @@
 #include "TestingSupport/TestUtilities.h"
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Utility/ArchSpec.h"
+#include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/DataBufferLLVM.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/FileSpec.h"
@@ -322,6 +323,104 @@ TEST_F(MinidumpParserTest, GetMemoryRegionInfo) {
   check_region_info(parser, 0x40000, yes, no, no);
 }
 
+// A full-memory minidump with many small ranges, like the ones Windows
+// writes for large processes.  Looking up every range used to take time
+// quadratic in the number of ranges.
+TEST_F(MinidumpParserTest, ManyMemoryRanges) {
+  const uint64_t num_ranges = 100000;
+  const uint64_t range_size = 16;
+  const uint64_t range_stride = 0x100;
+  const lldb::addr_t first_range = 0x10000;
+
+  const uint32_t directory_rva = sizeof(MinidumpHeader);
+  const uint32_t memory64_rva = directory_rva + 2 * sizeof(MinidumpDirectory);
+  const uint32_t memory64_size =
+      16 + num_ranges * sizeof(MinidumpMemoryDescriptor64);
+  const uint32_t info_rva = memory64_rva + memory64_size;
+  const uint32_t info_size = sizeof(MinidumpMemoryInfoListHeader) +
+                             num_ranges * sizeof(MinidumpMemoryInfo);
+  const uint64_t data_rva = info_rva + info_size;
+
+  std::vector<uint8_t> bytes(data_rva + num_ranges * range_size);
+  auto put = [&bytes](uint64_t offset, const void *src, size_t size) {
+    memcpy(bytes.data() + offset, src, size);
+  };
+
+  MinidumpHeader header = {};
+  header.signature = static_cast<uint32_t>(MinidumpHeaderConstants::Signature);
+  header.version = static_cast<uint32_t>(MinidumpHeaderConstants::Version);
+  header.streams_count = 2;
+  header.stream_directory_rva = directory_rva;
+  put(0, &header, sizeof(header));
+
+  MinidumpDirectory directory[2] = {};
+  directory[0].stream_type =
+      static_cast<uint32_t>(MinidumpStreamType::Memory64List);
+  directory[0].location.data_size = memory64_size;
+  directory[0].location.rva = memory64_rva;
+  directory[1].stream_type =
+      static_cast<uint32_t>(MinidumpStreamType::MemoryInfoList);
+  directory[1].location.data_size = info_size;
+  directory[1].location.rva = info_rva;
+  put(directory_rva, directory, sizeof(directory));
+
+  llvm::support::ulittle64_t list_header[2];
+  list_header[0] = num_ranges;
+  list_header[1] = data_rva;
+  put(memory64_rva, list_header, sizeof(list_header));
+
+  MinidumpMemoryInfoListHeader info_header = {};
+  info_header.size_of_header = sizeof(MinidumpMemoryInfoListHeader);
+  info_header.size_of_entry = sizeof(MinidumpMemoryInfo);
+  info_header.num_of_entries = num_ranges;
+  put(info_rva, &info_header, sizeof(info_header));
+
+  for (uint64_t i = 0; i < num_ranges; ++i) {
+    MinidumpMemoryDescriptor64 desc;
+    desc.start_of_memory_range = first_range + i * range_stride;
+    desc.data_size = range_size;
+    put(memory64_rva + 16 + i * sizeof(desc), &desc, sizeof(desc));
+
+    MinidumpMemoryInfo info = {};
+    info.base_address = first_range + i * range_stride;
+    info.region_size = range_size;
+    info.state = static_cast<uint32_t>(MinidumpMemoryInfoState::MemCommit);
+    info.protect = static_cast<uint32_t>(
+        MinidumpMemoryProtectionContants::PageReadWrite);
+    put(info_rva + sizeof(info_header) + i * sizeof(info), &info,
+        sizeof(info));
+
+    memset(bytes.data() + data_rva + i * range_size, i & 0xff, range_size);
+  }
+
+  auto buffer_sp =
+      std::make_shared<DataBufferHeap>(bytes.data(), bytes.size());
+  llvm::Optional<MinidumpParser> optional_parser =
+      MinidumpParser::Create(buffer_sp);
+  ASSERT_TRUE(optional_parser.hasValue());
+  parser.reset(new MinidumpParser(optional_parser.getValue()));
+  ASSERT_TRUE(parser->Initialize().Success());
+
+  // Look up the ranges in the same order a linear scan would find them
+  // slowest in, last to first.
+  for (uint64_t i = num_ranges; i-- > 0;) {
+    const lldb::addr_t start = first_range + i * range_stride;
+    llvm::ArrayRef<uint8_t> mem = parser->GetMemory(start + 4, 64);
+    ASSERT_EQ(range_size - 4, mem.size()) << i;
+    EXPECT_EQ(i & 0xff, mem[0]) << i;
+    EXPECT_TRUE(parser->GetMemory(start + range_size, 1).empty()) << i;
+
+    auto region = parser->GetMemoryRegionInfo(start + range_size);
+    ASSERT_TRUE(region.hasValue());
+    EXPECT_EQ(MemoryRegionInfo::eNo, region->GetMapped());
+    EXPECT_EQ(i + 1 < num_ranges ? start + range_stride
+                                 : LLDB_INVALID_ADDRESS,
+              region->GetRange().GetRangeEnd());
+  }
+  check_region_info(parser, first_range, MemoryRegionInfo::eYes,
+                    MemoryRegionInfo::eYes, MemoryRegionInfo::eNo);
+}
+
 // Windows Minidump tests
 // fizzbuzz_no_heap.dmp is copied from the WinMiniDump tests
 TEST_F(MinidumpParserTest, GetArchitectureWindows) {
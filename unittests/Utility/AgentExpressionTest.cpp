@@ -0,0 +1,194 @@
+//===-- AgentExpressionTest.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/AgentExpression.h"
+
+#include <map>
+
+using namespace lldb_private;
+
+namespace {
+class TestContext : public AgentExpression::Context {
+public:
+  bool ReadRegister(uint32_t reg_num, uint64_t &value) override {
+    auto pos = registers.find(reg_num);
+    if (pos == registers.end())
+      return false;
+    value = pos->second;
+    return true;
+  }
+
+  bool ReadUnsigned(lldb::addr_t addr, size_t byte_size,
+                    uint64_t &value) override {
+    auto pos = memory.find(addr);
+    if (pos == memory.end())
+      return false;
+    value = byte_size == 8 ? pos->second
+                           : pos->second & ((1ULL << (byte_size * 8)) - 1);
+    return true;
+  }
+
+  std::map<uint32_t, uint64_t> registers;
+  std::map<lldb::addr_t, uint64_t> memory;
+};
+} // namespace
+
+static uint64_t Evaluate(const AgentExpression &expr, TestContext &context) {
+  uint64_t result = 0;
+  Status error = expr.Evaluate(context, result);
+  EXPECT_TRUE(error.Success()) << error.AsCString();
+  return result;
+}
+
+TEST(AgentExpressionTest, Constants) {
+  TestContext context;
+  for (uint64_t value : {0ULL, 0x7fULL, 0x1234ULL, 0x12345678ULL,
+                         0x123456789abcdef0ULL}) {
+    AgentExpression expr;
+    expr.AppendConstant(value);
+    expr.AppendOpcode(AgentExpression::eOpEnd);
+    EXPECT_EQ(value, Evaluate(expr, context));
+  }
+}
+
+TEST(AgentExpressionTest, Encoding) {
+  AgentExpression expr;
+  expr.AppendRegister(0x102);
+  expr.AppendConstant(0x1234);
+  expr.AppendOpcode(AgentExpression::eOpEnd);
+  const uint8_t expected[] = {AgentExpression::eOpReg,     0x01, 0x02,
+                              AgentExpression::eOpConst16, 0x12, 0x34,
+                              AgentExpression::eOpEnd};
+  EXPECT_EQ(llvm::makeArrayRef(expected), expr.GetBytes());
+}
+
+TEST(AgentExpressionTest, LocalCompare) {
+  // "*(int32_t *)($r6 - 4) == -3"
+  TestContext context;
+  context.registers[6] = 0x1000;
+  context.memory[0x0ffc] = 0xfffffffd;
+
+  AgentExpression expr;
+  expr.AppendRegister(6);
+  expr.AppendConstant(4);
+  expr.AppendOpcode(AgentExpression::eOpSub);
+  ASSERT_TRUE(expr.AppendDereference(4));
+  expr.AppendSignExtend(32);
+  expr.AppendConstant(3);
+  expr.AppendOpcode(AgentExpression::eOpBitNot);
+  expr.AppendConstant(1);
+  expr.AppendOpcode(AgentExpression::eOpAdd);
+  expr.AppendOpcode(AgentExpression::eOpEqual);
+  expr.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_EQ(1U, Evaluate(expr, context));
+
+  context.memory[0x0ffc] = 3;
+  EXPECT_EQ(0U, Evaluate(expr, context));
+}
+
+TEST(AgentExpressionTest, SignedAndUnsignedCompare) {
+  TestContext context;
+  AgentExpression signed_less;
+  signed_less.AppendConstant(UINT64_MAX);
+  signed_less.AppendConstant(1);
+  signed_less.AppendOpcode(AgentExpression::eOpLessSigned);
+  signed_less.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_EQ(1U, Evaluate(signed_less, context));
+
+  AgentExpression unsigned_less;
+  unsigned_less.AppendConstant(UINT64_MAX);
+  unsigned_less.AppendConstant(1);
+  unsigned_less.AppendOpcode(AgentExpression::eOpLessUnsigned);
+  unsigned_less.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_EQ(0U, Evaluate(unsigned_less, context));
+}
+
+TEST(AgentExpressionTest, Jumps) {
+  // "$r0 != 0 || $r1 != 0" with a short circuit.
+  TestContext context;
+  AgentExpression expr;
+  expr.AppendRegister(0);
+  expr.AppendOpcode(AgentExpression::eOpDup);
+  const size_t skip = expr.AppendJump(AgentExpression::eOpIfGoto);
+  expr.AppendOpcode(AgentExpression::eOpPop);
+  expr.AppendRegister(1);
+  expr.PatchJump(skip, expr.GetCurrentOffset());
+  expr.AppendOpcode(AgentExpression::eOpLogNot);
+  expr.AppendOpcode(AgentExpression::eOpLogNot);
+  expr.AppendOpcode(AgentExpression::eOpEnd);
+
+  context.registers[0] = 5;
+  EXPECT_EQ(1U, Evaluate(expr, context));
+
+  context.registers[0] = 0;
+  context.registers[1] = 0;
+  EXPECT_EQ(0U, Evaluate(expr, context));
+
+  context.registers[1] = 7;
+  EXPECT_EQ(1U, Evaluate(expr, context));
+
+  // The same code spliced after a prefix must still jump to the right place.
+  AgentExpression spliced;
+  spliced.AppendConstant(0x1234);
+  spliced.AppendOpcode(AgentExpression::eOpPop);
+  spliced.AppendExpression(expr);
+  spliced.AppendOpcode(AgentExpression::eOpEnd);
+  context.registers[0] = 0;
+  context.registers[1] = 0;
+  EXPECT_EQ(0U, Evaluate(spliced, context));
+  context.registers[0] = 3;
+  EXPECT_EQ(1U, Evaluate(spliced, context));
+}
+
+TEST(AgentExpressionTest, Errors) {
+  TestContext context;
+  uint64_t result;
+
+  AgentExpression underflow;
+  underflow.AppendOpcode(AgentExpression::eOpAdd);
+  underflow.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_TRUE(underflow.Evaluate(context, result).Fail());
+
+  AgentExpression no_end;
+  no_end.AppendConstant(1);
+  EXPECT_TRUE(no_end.Evaluate(context, result).Fail());
+
+  AgentExpression truncated(llvm::ArrayRef<uint8_t>(
+      {AgentExpression::eOpConst32, 0x00, 0x01}));
+  EXPECT_TRUE(truncated.Evaluate(context, result).Fail());
+
+  AgentExpression unsupported(llvm::ArrayRef<uint8_t>({0xff}));
+  EXPECT_TRUE(unsupported.Evaluate(context, result).Fail());
+
+  AgentExpression div_zero;
+  div_zero.AppendConstant(1);
+  div_zero.AppendConstant(0);
+  div_zero.AppendOpcode(AgentExpression::eOpDivUnsigned);
+  div_zero.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_TRUE(div_zero.Evaluate(context, result).Fail());
+
+  AgentExpression bad_register;
+  bad_register.AppendRegister(42);
+  bad_register.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_TRUE(bad_register.Evaluate(context, result).Fail());
+
+  AgentExpression bad_memory;
+  bad_memory.AppendConstant(0x1000);
+  bad_memory.AppendDereference(8);
+  bad_memory.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_TRUE(bad_memory.Evaluate(context, result).Fail());
+
+  // An infinite loop stops at the step limit.
+  AgentExpression loop;
+  const size_t jump = loop.AppendJump(AgentExpression::eOpGoto);
+  loop.PatchJump(jump, 0);
+  EXPECT_TRUE(loop.Evaluate(context, result).Fail());
+}
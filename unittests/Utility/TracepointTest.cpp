@@ -0,0 +1,191 @@
+//===-- TracepointTest.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/Tracepoint.h"
+
+using namespace lldb_private;
+
+static TracepointRecord MakeRecord(uint64_t id, size_t value_size) {
+  TracepointRecord record;
+  record.id = id;
+  record.tid = 0x1234;
+  record.pc = 0x400000 + id;
+  TracepointRecord::Value value;
+  value.collected = true;
+  value.bytes.assign(value_size, static_cast<uint8_t>(id));
+  record.values.push_back(value);
+  record.values.push_back(TracepointRecord::Value());
+  return record;
+}
+
+TEST(TracepointTest, EncodeDecode) {
+  std::vector<uint8_t> data;
+  TracepointBuffer::Encode(MakeRecord(1, 8), data);
+  TracepointBuffer::Encode(MakeRecord(2, 0), data);
+
+  std::vector<TracepointRecord> records;
+  ASSERT_TRUE(TracepointBuffer::Decode(data, records));
+  ASSERT_EQ(2u, records.size());
+  EXPECT_EQ(1u, records[0].id);
+  EXPECT_EQ(0x1234u, records[0].tid);
+  EXPECT_EQ(0x400001u, records[0].pc);
+  ASSERT_EQ(2u, records[0].values.size());
+  EXPECT_TRUE(records[0].values[0].collected);
+  EXPECT_EQ(std::vector<uint8_t>(8, 1), records[0].values[0].bytes);
+  EXPECT_FALSE(records[0].values[1].collected);
+  EXPECT_TRUE(records[1].values[0].collected);
+  EXPECT_TRUE(records[1].values[0].bytes.empty());
+}
+
+TEST(TracepointTest, DecodeMalformed) {
+  std::vector<uint8_t> data;
+  TracepointBuffer::Encode(MakeRecord(1, 8), data);
+
+  std::vector<TracepointRecord> records;
+  EXPECT_FALSE(TracepointBuffer::Decode(
+      llvm::makeArrayRef(data).drop_back(1), records));
+  data[0] = 4;
+  EXPECT_FALSE(TracepointBuffer::Decode(data, records));
+}
+
+TEST(TracepointTest, Drain) {
+  TracepointBuffer buffer;
+  EXPECT_TRUE(buffer.IsEmpty());
+  for (uint64_t id = 0; id < 10; ++id)
+    buffer.Append(MakeRecord(id, 16));
+
+  std::vector<uint8_t> record;
+  TracepointBuffer::Encode(MakeRecord(0, 16), record);
+  EXPECT_EQ(10 * record.size(), buffer.GetNumBytes());
+
+  // Only whole records are drained, in the order they were appended.
+  std::vector<uint8_t> data;
+  EXPECT_EQ(3u, buffer.Drain(3 * record.size() + 1, data));
+  EXPECT_EQ(7u, buffer.Drain(SIZE_MAX, data));
+  EXPECT_TRUE(buffer.IsEmpty());
+
+  std::vector<TracepointRecord> records;
+  ASSERT_TRUE(TracepointBuffer::Decode(data, records));
+  ASSERT_EQ(10u, records.size());
+  for (uint64_t id = 0; id < 10; ++id)
+    EXPECT_EQ(id, records[id].id);
+
+  // A record bigger than the limit still comes out.
+  buffer.Append(MakeRecord(1, 64));
+  data.clear();
+  EXPECT_EQ(1u, buffer.Drain(1, data));
+  EXPECT_EQ(0u, buffer.Drain(1, data));
+}
+
+TEST(TracepointTest, DropsOldest) {
+  std::vector<uint8_t> record;
+  TracepointBuffer::Encode(MakeRecord(0, 16), record);
+
+  TracepointBuffer buffer(4 * record.size());
+  for (uint64_t id = 0; id < 6; ++id)
+    buffer.Append(MakeRecord(id, 16));
+  EXPECT_EQ(2u, buffer.TakeNumDropped());
+  EXPECT_EQ(0u, buffer.TakeNumDropped());
+
+  std::vector<uint8_t> data;
+  EXPECT_EQ(4u, buffer.Drain(SIZE_MAX, data));
+  std::vector<TracepointRecord> records;
+  ASSERT_TRUE(TracepointBuffer::Decode(data, records));
+  ASSERT_EQ(4u, records.size());
+  EXPECT_EQ(2u, records[0].id);
+  EXPECT_EQ(5u, records[3].id);
+
+  // A record that can never fit is dropped on its own.
+  buffer.Append(MakeRecord(7, 4 * record.size()));
+  EXPECT_EQ(1u, buffer.TakeNumDropped());
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+namespace {
+class TestContext : public TracepointContext {
+public:
+  bool ReadRegister(uint32_t reg_num, uint64_t &value) override {
+    if (reg_num != 1)
+      return false;
+    value = 0x1000;
+    return true;
+  }
+
+  bool ReadUnsigned(lldb::addr_t addr, size_t byte_size,
+                    uint64_t &value) override {
+    return false;
+  }
+
+  bool ReadRegisterBytes(uint32_t reg_num,
+                         std::vector<uint8_t> &bytes) override {
+    if (reg_num != 1)
+      return false;
+    bytes = {0x00, 0x10, 0, 0, 0, 0, 0, 0};
+    return true;
+  }
+
+  bool ReadMemory(lldb::addr_t addr, size_t size,
+                  std::vector<uint8_t> &bytes) override {
+    if (addr < 0x1000 || addr + size > 0x1100)
+      return false;
+    bytes.resize(size);
+    for (size_t i = 0; i < size; ++i)
+      bytes[i] = static_cast<uint8_t>(addr + i);
+    return true;
+  }
+
+  lldb::ByteOrder GetByteOrder() override { return lldb::eByteOrderLittle; }
+};
+} // namespace
+
+TEST(TracepointTest, Collect) {
+  TracepointSpec spec;
+  TracepointAction action;
+  action.kind = TracepointAction::eKindRegister;
+  action.reg_num = 1;
+  spec.actions.push_back(action);
+
+  // $r1 + 4, as a 2 byte value and as the address of 4 bytes of memory.
+  action.expr.AppendRegister(1);
+  action.expr.AppendConstant(4);
+  action.expr.AppendOpcode(AgentExpression::eOpAdd);
+  action.expr.AppendOpcode(AgentExpression::eOpEnd);
+  action.kind = TracepointAction::eKindValue;
+  action.size = 2;
+  spec.actions.push_back(action);
+  action.kind = TracepointAction::eKindMemory;
+  action.size = 4;
+  spec.actions.push_back(action);
+
+  // A register that can't be read.
+  action.kind = TracepointAction::eKindRegister;
+  action.reg_num = 2;
+  spec.actions.push_back(action);
+
+  TestContext context;
+  EXPECT_TRUE(spec.ShouldCollect(context));
+  TracepointRecord record;
+  spec.Collect(context, record);
+  ASSERT_EQ(4u, record.values.size());
+  EXPECT_TRUE(record.values[0].collected);
+  EXPECT_EQ(std::vector<uint8_t>({0x00, 0x10, 0, 0, 0, 0, 0, 0}),
+            record.values[0].bytes);
+  EXPECT_TRUE(record.values[1].collected);
+  EXPECT_EQ(std::vector<uint8_t>({0x04, 0x10}), record.values[1].bytes);
+  EXPECT_TRUE(record.values[2].collected);
+  EXPECT_EQ(std::vector<uint8_t>({0x04, 0x05, 0x06, 0x07}),
+            record.values[2].bytes);
+  EXPECT_FALSE(record.values[3].collected);
+
+  spec.condition.AppendConstant(0);
+  spec.condition.AppendOpcode(AgentExpression::eOpEnd);
+  EXPECT_FALSE(spec.ShouldCollect(context));
+}
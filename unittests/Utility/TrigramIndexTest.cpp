@@ -0,0 +1,148 @@
+//===-- TrigramIndexTest.cpp ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/TrigramIndex.h"
+
+using namespace lldb_private;
+
+static std::vector<std::string> GetLiterals(llvm::StringRef regex) {
+  std::vector<std::string> literals;
+  TrigramIndex::GetRequiredLiterals(regex, literals);
+  return literals;
+}
+
+typedef std::vector<std::string> Literals;
+
+TEST(TrigramIndexTest, RequiredLiterals) {
+  EXPECT_EQ(Literals({"main"}), GetLiterals("main"));
+  EXPECT_EQ(Literals({"Foo::", "Bar"}), GetLiterals("^Foo::.*Bar$"));
+  EXPECT_EQ(Literals({"std::vector<", ">::push_back"}),
+            GetLiterals("std::vector<.*>::push_back"));
+  EXPECT_EQ(Literals({"a.b"}), GetLiterals("a\\.b"));
+  EXPECT_EQ(Literals({"get", "Value"}), GetLiterals("get[A-Z_]Value"));
+  EXPECT_EQ(Literals({"get", "Value"}), GetLiterals("get[]x]Value"));
+  EXPECT_EQ(Literals({"is", "Name"}), GetLiterals("is[[:upper:]]Name"));
+
+  // Optional and repeated characters.
+  EXPECT_EQ(Literals({"ab", "d"}), GetLiterals("abc?d"));
+  EXPECT_EQ(Literals({"ab", "d"}), GetLiterals("abc*d"));
+  EXPECT_EQ(Literals({"ab", "d"}), GetLiterals("abc{0,2}d"));
+  EXPECT_EQ(Literals({"abc", "cd"}), GetLiterals("abc+d"));
+
+  // Groups, alternations and classes contribute nothing.
+  EXPECT_EQ(Literals({"foo", "bar"}), GetLiterals("foo(x|y)bar"));
+  EXPECT_EQ(Literals({"foo", "bar"}), GetLiterals("foo(x(y)z)?bar"));
+  EXPECT_EQ(Literals(), GetLiterals("foo|bar"));
+  EXPECT_EQ(Literals({"foo", "bar"}), GetLiterals("foo\\wbar"));
+  EXPECT_EQ(Literals(), GetLiterals(".*"));
+
+  // Only escaped metacharacters are literal; the rest can be anchors.
+  EXPECT_EQ(Literals({"foo"}), GetLiterals("\\<foo\\>"));
+  EXPECT_EQ(Literals({"foo"}), GetLiterals("\\`foo"));
+  EXPECT_EQ(Literals({"foo"}), GetLiterals("foo\\'"));
+  EXPECT_EQ(Literals({"a/b\\c"}), GetLiterals("a\\/b\\\\c"));
+
+  // Malformed expressions.
+  EXPECT_EQ(Literals(), GetLiterals("foo[bar"));
+  EXPECT_EQ(Literals(), GetLiterals("foo(bar"));
+  EXPECT_EQ(Literals(), GetLiterals("foo\\"));
+}
+
+TEST(TrigramIndexTest, ContainsLiterals) {
+  EXPECT_TRUE(TrigramIndex::ContainsLiterals("Foo::Bar", {"Foo", "Bar"}));
+  EXPECT_FALSE(TrigramIndex::ContainsLiterals("Foo::Baz", {"Foo", "Bar"}));
+  EXPECT_TRUE(TrigramIndex::ContainsLiterals("anything", {}));
+}
+
+// Patterns people use with "breakpoint set --func-regex", checked against
+// running the regular expression on every name.
+TEST(TrigramIndexTest, MatchesLinearScan) {
+  const char *names[] = {"main",
+                         "_start",
+                         "foo",
+                         "Foo::Foo()",
+                         "Foo::~Foo()",
+                         "Foo::bar(int)",
+                         "Foo::baz() const",
+                         "ns::Foo::bar(int)",
+                         "std::vector<int, std::allocator<int> >::push_back",
+                         "std::vector<Foo, std::allocator<Foo> >::push_back",
+                         "std::vector<int, std::allocator<int> >::size",
+                         "-[NSObject init]",
+                         "-[MyView drawRect:]",
+                         "+[MyView layerClass]",
+                         "getValue",
+                         "get_value",
+                         "setValue",
+                         "test_abc",
+                         "test_abbbc",
+                         "test_ac",
+                         "a.b",
+                         "axb",
+                         "",
+                         "xy"};
+
+  TrigramIndex index;
+  for (const char *name : names)
+    index.Append(name);
+  index.Finalize();
+  ASSERT_EQ(llvm::array_lengthof(names), index.GetSize());
+
+  const char *patterns[] = {"main",
+                            "^main$",
+                            "^Foo::",
+                            "Foo::.*\\(int\\)",
+                            "::bar\\(",
+                            "~",
+                            "push_back$",
+                            "std::vector<.*>::push_back",
+                            "^std::vector<Foo,",
+                            "\\[MyView ",
+                            "^[-+]\\[MyView",
+                            "[gs]etValue",
+                            "get_?[vV]alue",
+                            "test_ab+c",
+                            "test_ab*c",
+                            "a\\.b",
+                            "a.b",
+                            "(Foo|Bar)::bar",
+                            "bar|baz",
+                            ".",
+                            "^$",
+                            "xy",
+                            "zzz",
+                            "Foo::Foo\\(\\)",
+                            "\\<main\\>",
+                            "\\<Foo\\>::bar"};
+
+  for (const char *pattern : patterns) {
+    RegularExpression regex(pattern);
+    ASSERT_TRUE(regex.IsValid()) << pattern;
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 0; id < index.GetSize(); ++id)
+      if (regex.Execute(index.GetName(id)))
+        expected.push_back(id);
+
+    std::vector<uint32_t> ids;
+    index.Find(regex, ids);
+    EXPECT_EQ(expected, ids) << pattern;
+  }
+}
+
+TEST(TrigramIndexTest, Empty) {
+  TrigramIndex index;
+  index.Finalize();
+  std::vector<uint32_t> ids;
+  index.Find(RegularExpression("foo"), ids);
+  index.Find(RegularExpression(".*"), ids);
+  EXPECT_TRUE(ids.empty());
+}